@@ -17,9 +17,14 @@
  */
 
 
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
 #include <unistd.h>
 #include <assert.h>
 #include <getopt.h>
@@ -28,19 +33,47 @@
 #include "model/datatypes.h"
 #include "model/memory_utils.h"
 #include "model/print_utils.h"
+#include "model/memory_stats.h"
+#include "saturation/checkpoint.h"
+#include "utils/compressed_file.h"
+#include "parser/imports.h"
 
 void usage(char* program) {
 	fprintf(stderr, "Usage: %s -i ontology -o output -c\n", program);
 }
 
 int main(int argc, char *argv[]) {
-	FILE* input_ontology;
-	FILE* output;
+	// the input and the output are decompressed and compressed on the fly
+	CompressedFile* input_ontology;
+	CompressedFile* input_abox;
+	CompressedFile* output;
 
 	int c, reasoning_task_flag = 0, input_flag = 0, output_flag = 0, wrong_argument_flag = 0, verbose_flag = 0;
+	// number of threads for loading the ontology
+	int threads = 1;
+	// index the told axioms while parsing
+	char pipelined = 0;
 	char *reasoning_task = "", *ontology_file_name = "", *output_file = "";
-	static char usage[] = "Usage: %s -i ontology -o output -r[classification|realisation|consistency]\n";
-	while ((c = getopt(argc, argv, "r:i:o:v")) != -1)
+	// the snapshot of the KB to be written or to be read instead of the ontology
+	char *save_kb_file_name = NULL, *load_kb_file_name = NULL;
+	// the ABoxes in N-Triples or Turtle, loaded after the ontology
+	char **abox_file_names = (char**) malloc(argc * sizeof(char*));
+	int abox_count = 0, i;
+	assert(abox_file_names != NULL);
+	// the local files of the imported ontologies
+	Catalog* catalog = catalog_create();
+	char *directory_end, *directory;
+	static struct option long_options[] = {
+		{"save-kb", required_argument, NULL, 'S'},
+		{"load-kb", required_argument, NULL, 'L'},
+		{"cache-dir", required_argument, NULL, 'C'},
+		{"abox", required_argument, NULL, 'A'},
+		{"catalog", required_argument, NULL, 'c'},
+		{"import-dir", required_argument, NULL, 'I'},
+		{NULL, 0, NULL, 0}
+	};
+	static char usage[] = "Usage: %s -i ontology | --load-kb snapshot -o output -r[classification|realisation|consistency] [-t threads] [-p] [--catalog file]... [--import-dir directory]... [--abox triples]... [--save-kb snapshot] [--cache-dir directory]\n";
+	while ((c = getopt_long(argc, argv, "r:i:o:t:pv", long_options, NULL)) != -1)
 		switch (c) {
 		case 'r':
 			reasoning_task_flag = 1;
@@ -54,29 +87,69 @@ int main(int argc, char *argv[]) {
 			output_flag = 1;
 			output_file = optarg;
 			break;
+		case 't':
+			threads = atoi(optarg);
+			if (threads < 1)
+				wrong_argument_flag = 1;
+			break;
+		case 'p':
+			pipelined = 1;
+			break;
 		case 'v':
 			verbose_flag = 1;
 			break;
+		case 'S':
+			save_kb_file_name = optarg;
+			break;
+		case 'L':
+			load_kb_file_name = optarg;
+			break;
+		case 'C':
+			// reuse the results of earlier runs on the same KB
+			if (!enable_checkpoints(optarg)) {
+				fprintf(stderr, "%s: cannot use the cache directory %s: %s\n", argv[0], optarg, strerror(errno));
+				wrong_argument_flag = 1;
+			}
+			break;
+		case 'A':
+			abox_file_names[abox_count++] = optarg;
+			break;
+		case 'c':
+			if (!catalog_add_file(catalog, optarg)) {
+				fprintf(stderr, "%s: cannot read the catalog %s\n", argv[0], optarg);
+				wrong_argument_flag = 1;
+			}
+			break;
+		case 'I':
+			catalog_add_directory(catalog, optarg);
+			break;
 		case '?':
 			wrong_argument_flag = 1;
 			break;
 		}
-	if (input_flag == 0) {
+	if (input_flag == 0 && load_kb_file_name == NULL) {
 		fprintf(stderr, "%s: Provide an input ontology\n", argv[0]);
 		fprintf(stderr, usage, argv[0]);
 		exit(EXIT_FAILURE);
 	}
-	if (output_flag == 0) {
+	if (input_flag && load_kb_file_name != NULL) {
+		fprintf(stderr, "%s: Provide either an input ontology or a KB snapshot\n", argv[0]);
+		fprintf(stderr, usage, argv[0]);
+		exit(EXIT_FAILURE);
+	}
+	// only saving a snapshot does not need a reasoning task
+	char save_only = (save_kb_file_name != NULL && reasoning_task_flag == 0 && output_flag == 0);
+	if (output_flag == 0 && !save_only) {
 		fprintf(stderr, "%s: Provide an output file\n", argv[0]);
 		fprintf(stderr, usage, argv[0]);
 		exit(EXIT_FAILURE);
 	}
-	if (reasoning_task_flag == 0) {
+	if (reasoning_task_flag == 0 && !save_only) {
 		fprintf(stderr, "%s: Provide one of the reasoning tasks: classification | realisation | consistency\n", argv[0]);
 		fprintf(stderr, usage, argv[0]);
 		exit(EXIT_FAILURE);
 	}
-	if (strcmp(reasoning_task, "classification") != 0 && strcmp(reasoning_task, "realisation") != 0 && strcmp(reasoning_task, "consistency") != 0) {
+	if (!save_only && strcmp(reasoning_task, "classification") != 0 && strcmp(reasoning_task, "realisation") != 0 && strcmp(reasoning_task, "consistency") != 0) {
 		fprintf(stderr, "%s: Provide one of the reasoning tasks: classification | realisation | consistency\n", argv[0]);
 		fprintf(stderr, usage, argv[0]);
 		exit(EXIT_FAILURE);
@@ -85,16 +158,69 @@ int main(int argc, char *argv[]) {
 		fprintf(stderr, usage, argv[0]);
 		exit(EXIT_FAILURE);
 	}
-	// open the ontology file
-	input_ontology = fopen(ontology_file_name, "r");
-	assert(input_ontology != NULL);
 
-	// initialize global variables, allocate space for the ontology
-	KB* kb = init_kb();
+	// record the memory usage of the phases
+	if (verbose_flag)
+		enable_memory_stats();
+
+	KB* kb;
+	if (load_kb_file_name != NULL)
+		// create the KB from a snapshot, nothing is parsed
+		kb = load_kb(load_kb_file_name);
+	else {
+		// open the ontology file
+		input_ontology = compressed_file_open(ontology_file_name, "r");
+		if (input_ontology == NULL)
+			exit(EXIT_FAILURE);
 
-	// read and parse the ontology
-	read_kb(input_ontology, kb);
-	fclose(input_ontology);
+		// initialize global variables, allocate space for the ontology.
+		// the tables are sized for the counts of a pre-scan of the input.
+		kb = create_kb(compressed_file_stream(input_ontology));
+
+		// the imported ontologies are also looked up in the directory of the
+		// ontology and in the catalog Protégé writes there
+		directory_end = strrchr(ontology_file_name, '/');
+		if (directory_end == NULL)
+			directory = strdup(".");
+		else
+			directory = strndup(ontology_file_name, directory_end - ontology_file_name);
+		assert(directory != NULL);
+		catalog_add_directory(catalog, directory);
+		free(directory);
+		directory = (char*) malloc(strlen(ontology_file_name) + 32);
+		assert(directory != NULL);
+		sprintf(directory, "%.*scatalog-v001.xml", (directory_end == NULL) ? 0 : (int) (directory_end - ontology_file_name + 1), ontology_file_name);
+		catalog_add_file(catalog, directory);
+		free(directory);
+
+		// read and parse the ontology and its imports
+		read_kb(compressed_file_stream(input_ontology), catalog, threads, pipelined, kb);
+		// the reason has been printed when the input was read
+		if (compressed_file_close(input_ontology) != 0)
+			exit(EXIT_FAILURE);
+	}
+
+	// add the triples to the ABox
+	for (i = 0; i < abox_count; ++i) {
+		input_abox = compressed_file_open(abox_file_names[i], "r");
+		if (input_abox == NULL)
+			exit(EXIT_FAILURE);
+		read_abox(compressed_file_stream(input_abox), kb);
+		if (compressed_file_close(input_abox) != 0)
+			exit(EXIT_FAILURE);
+	}
+	free(abox_file_names);
+	catalog_free(catalog);
+
+	// the snapshot is taken before the KB is modified by preprocessing
+	if (save_kb_file_name != NULL)
+		save_kb(kb, save_kb_file_name);
+
+	if (save_only) {
+		int freed_bytes = free_kb(kb);
+		printf("Freed bytes:%d\n", freed_bytes);
+		return 0;
+	}
 
 	// display kb information
 	if (verbose_flag) {
@@ -102,30 +228,34 @@ int main(int argc, char *argv[]) {
 	}
 
 	// open the output file
-	output = fopen(output_file, "w");
-	assert(output != NULL);
+	output = compressed_file_open(output_file, "w");
+	if (output == NULL)
+		exit(EXIT_FAILURE);
 
 	if (!strcmp(reasoning_task, "classification")) {
 		// classify the ontology
 		classify(kb);
 		// print the class hierarchy to the output file
-		print_concept_hierarchy(kb, output);
+		print_concept_hierarchy(kb, compressed_file_stream(output));
 	}
 	else if (!strcmp(reasoning_task, "consistency")) {
 		if (check_consistency(kb))
-			fprintf(output, "false\n");
+			fprintf(compressed_file_stream(output), "false\n");
 		else
-			fprintf(output, "true\n");
+			fprintf(compressed_file_stream(output), "true\n");
 	}
 	else if (!strcmp(reasoning_task, "realisation")) {
 		// realize the kb
 		realize_kb(kb);
 		// print the individual types to the output file
-		print_individual_types(kb, output);
+		print_individual_types(kb, compressed_file_stream(output));
 	}
 
 	// close the output file
-	fclose(output);
+	if (compressed_file_close(output) != 0) {
+		fprintf(stderr, "%s: the output cannot be written\n", output_file);
+		exit(EXIT_FAILURE);
+	}
 
 	// display saturation information
 	if (verbose_flag) {
@@ -138,6 +268,11 @@ int main(int argc, char *argv[]) {
 				"Unique links.......................: %d\n",
 				saturation_total_link_count,
 				saturation_unique_link_count);
+		record_memory_usage(kb, PHASE_END);
+		print_memory_stats(stdout);
+#ifdef HASH_STATS
+		print_hash_stats(kb, stdout);
+#endif
 	}
 
 	// free the kb
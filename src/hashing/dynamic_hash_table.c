@@ -28,14 +28,24 @@
 /**
  * A dynamic hash table implementation for storing keys only, no associated values.
  * The allocated space is doubled once the load factor reaches 0.75.
- * Uses open addressing with linear probing.
+ * Uses open addressing with linear probing and backward shift deletion.
  * Keys cannot be NULL.
- * Allocated space is not shrunk after a removal.
+ * Allocated space is not shrunk after a removal, unless dynamic_hash_table_shrink
+ * is called.
+ * Tables that are initialized with a size of at most DYNAMIC_HASH_TABLE_INLINE_SIZE
+ * keep their keys in the struct and allocate a table only once they outgrow it.
  */
 
 
 void dynamic_hash_table_init(DynamicHashTable* hash_table, unsigned int size) {
 
+	hash_table->element_count = 0;
+	if (size <= DYNAMIC_HASH_TABLE_INLINE_SIZE) {
+		// small table, keep the keys inline until it outgrows the inline space
+		hash_table->size = 0;
+		return;
+	}
+
 	if (size < 8)
 		size = 8;
 	else
@@ -46,7 +56,6 @@ void dynamic_hash_table_init(DynamicHashTable* hash_table, unsigned int size) {
 	hash_table->end_indexes = (unsigned int*) calloc(size, sizeof(unsigned int));
 	assert(hash_table->end_indexes != NULL);
 	hash_table->size = size;
-	hash_table->element_count = 0;
 	int i;
 	for (i = 0; i < hash_table->size; ++i)
 		// each chain initially ends at its starting point
@@ -56,25 +65,93 @@ void dynamic_hash_table_init(DynamicHashTable* hash_table, unsigned int size) {
 }
 
 DynamicHashTable* dynamic_hash_table_create(unsigned int size) {
-	if (size < 8)
-		size = 8;
-	else
-		size = roundup_pow2(size);
 	DynamicHashTable* hash_table = (DynamicHashTable*) malloc(sizeof(DynamicHashTable));
 	assert(hash_table != NULL);
 
-	hash_table->elements = (void**) calloc(size, sizeof(void*));
-	assert(hash_table->elements != NULL);
-	hash_table->end_indexes = (unsigned int*) calloc(size, sizeof(unsigned int));
+	dynamic_hash_table_init(hash_table, size);
+
+	return hash_table;
+}
+
+void dynamic_hash_table_spill(DynamicHashTable* hash_table) {
+	void* keys[DYNAMIC_HASH_TABLE_INLINE_SIZE];
+	int i, count = hash_table->element_count;
+
+	for (i = 0; i < count; ++i)
+		keys[i] = hash_table->inline_elements[i];
+
+	// the inline space is overwritten here
+	dynamic_hash_table_init(hash_table, 2 * DYNAMIC_HASH_TABLE_INLINE_SIZE);
+	for (i = 0; i < count; ++i)
+		dynamic_hash_table_insert(keys[i], hash_table);
+}
+
+void dynamic_hash_table_resize(DynamicHashTable* hash_table, unsigned int new_size) {
+	int i, j;
+	size_t start_index;
+
+	void **tmp_elements = (void**) calloc(new_size, sizeof(void*));
+	assert(tmp_elements != NULL);
+
+	// free the end indexes, allocate and initialize new
+	free(hash_table->end_indexes);
+	hash_table->end_indexes = (unsigned int*) calloc(new_size, sizeof(unsigned int));
 	assert(hash_table->end_indexes != NULL);
-	hash_table->size = size;
-	hash_table->element_count = 0;
-	int i;
-	for (i = 0; i < hash_table->size; ++i)
-		// each chain initially ends at its starting point
+	for (i = 0; i < new_size; ++i)
 		hash_table->end_indexes[i] = i;
 
-	return hash_table;
+	// re-populate
+	for (i = 0; i < hash_table->size; ++i)
+		if (hash_table->elements[i] != HASH_TABLE_EMPTY_KEY) {
+			start_index = HASH_POINTER(hash_table->elements[i]) & (new_size - 1);
+			for (j = start_index; ; j = (j + 1) & (new_size - 1))
+				if (tmp_elements[j] == HASH_TABLE_EMPTY_KEY) {
+					tmp_elements[j] = hash_table->elements[i];
+					break;
+				}
+			hash_table->end_indexes[start_index] = (j + 1) & (new_size - 1);
+		}
+
+	// change the size, the element count does not change
+	hash_table->size = new_size;
+
+	// free the existing elements
+	free(hash_table->elements);
+
+	// the new elements
+	hash_table->elements = tmp_elements;
+}
+
+int dynamic_hash_table_shrink(DynamicHashTable* hash_table) {
+	int i, j;
+	unsigned int new_size, old_size = hash_table->size;
+
+	if (old_size == 0)
+		return 0;
+
+	if (hash_table->element_count <= DYNAMIC_HASH_TABLE_INLINE_SIZE) {
+		// the keys fit inline, give up the table
+		void** elements = hash_table->elements;
+		unsigned int* end_indexes = hash_table->end_indexes;
+		for (i = 0, j = 0; i < old_size; ++i)
+			if (elements[i] != HASH_TABLE_EMPTY_KEY)
+				hash_table->inline_elements[j++] = elements[i];
+		hash_table->size = 0;
+		free(elements);
+		free(end_indexes);
+		return old_size * (sizeof(void*) + sizeof(unsigned int));
+	}
+
+	// the smallest size that keeps the load factor below 0.75
+	new_size = roundup_pow2(hash_table->element_count * 4 / 3 + 1);
+	if (new_size < 8)
+		new_size = 8;
+	if (new_size >= old_size)
+		return 0;
+
+	dynamic_hash_table_resize(hash_table, new_size);
+
+	return (old_size - new_size) * (sizeof(void*) + sizeof(unsigned int));
 }
 
 extern inline char dynamic_hash_table_insert(void* key, DynamicHashTable* hash_table);
@@ -99,14 +176,7 @@ extern inline void* dynamic_hash_table_iterator_next(DynamicHashTableIterator* i
 
 
 int dynamic_hash_table_free(DynamicHashTable* hash_table) {
-	int i;
-	int freed_bytes = 0;
-
-	free(hash_table->elements);
-	freed_bytes += hash_table->size * sizeof(void*);
-
-	free(hash_table->end_indexes);
-	freed_bytes += hash_table->size * sizeof(unsigned int);
+	int freed_bytes = dynamic_hash_table_reset(hash_table);
 
 	free(hash_table);
 	freed_bytes += sizeof(DynamicHashTable);
@@ -115,9 +185,14 @@ int dynamic_hash_table_free(DynamicHashTable* hash_table) {
 }
 
 int dynamic_hash_table_reset(DynamicHashTable* hash_table) {
-	int i;
 	int freed_bytes = 0;
 
+	if (hash_table->size == 0) {
+		// nothing allocated for inline keys
+		hash_table->element_count = 0;
+		return 0;
+	}
+
 	free(hash_table->elements);
 	freed_bytes += hash_table->size * sizeof(void*);
 
@@ -130,6 +205,13 @@ int dynamic_hash_table_reset(DynamicHashTable* hash_table) {
 	return freed_bytes;
 }
 
+size_t dynamic_hash_table_memory(DynamicHashTable* hash_table) {
+	if (hash_table->size == 0)
+		// the keys are inline
+		return 0;
+	return hash_table->size * (sizeof(void*) + sizeof(unsigned int));
+}
+
 inline int dynamic_hash_table_iterator_free(DynamicHashTableIterator* iterator) {
 	free(iterator);
 
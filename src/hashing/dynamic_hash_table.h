@@ -33,15 +33,28 @@ typedef struct dynamic_hash_table DynamicHashTable;
 typedef struct dynamic_hash_table_iterator DynamicHashTableIterator;
 
 #define HASH_TABLE_EMPTY_KEY		NULL
-#define HASH_TABLE_DELETED_KEY		((void*) -1)
+
+/**
+ * Number of keys that are stored inline in the hash table struct itself.
+ * A hash table initialized with at most this size does not allocate any
+ * space until it gets more keys than this. Most of the subsumer and link
+ * sets in saturation never get that many.
+ */
+#define DYNAMIC_HASH_TABLE_INLINE_SIZE	4
 
 /**
  * Hash table.
  */
 struct dynamic_hash_table {
-	void** elements;			// the buckets
-	unsigned int* end_indexes;	// the end indexes of chains
-	unsigned int size;			// size of the hash table
+	union {
+		struct {
+			void** elements;			// the buckets
+			unsigned int* end_indexes;	// the end indexes of chains
+		};
+		// the keys as long as they fit inline, i.e., while size is 0
+		void* inline_elements[DYNAMIC_HASH_TABLE_INLINE_SIZE];
+	};
+	unsigned int size;			// size of the hash table, 0 if the keys are stored inline
 	unsigned int element_count;	// the number of elements
 };
 
@@ -51,6 +64,7 @@ struct dynamic_hash_table {
 struct dynamic_hash_table_iterator {
 	DynamicHashTable* hash_table;
 	unsigned int current_index;	// index of the current slot
+	unsigned int remaining_slots;	// number of slots not visited yet
 };
 
 DynamicHashTable* dynamic_hash_table_create(unsigned int size);
@@ -71,15 +85,54 @@ int dynamic_hash_table_free(DynamicHashTable* hash_table);
  */
 int dynamic_hash_table_reset(DynamicHashTable* hash_table);
 
+/**
+ * Returns the number of bytes allocated for the elements of the given hash table.
+ * The space for the hash table itself is not included.
+ */
+size_t dynamic_hash_table_memory(DynamicHashTable* hash_table);
+
+/**
+ * Move the inline keys of the given hash table to a newly allocated table.
+ * Called when the inline space is full.
+ */
+void dynamic_hash_table_spill(DynamicHashTable* hash_table);
+
+/**
+ * Re-populate the keys of the given hash table in a table of the given size.
+ * The new size is a power of 2 that is large enough for the keys.
+ */
+void dynamic_hash_table_resize(DynamicHashTable* hash_table, unsigned int new_size);
+
+/**
+ * Shrink the allocated space to the smallest size that keeps the load factor
+ * below 0.75, or move the keys inline if they fit. Tables are never shrunk
+ * implicitly, since this invalidates iterators.
+ * Returns the number of freed bytes.
+ */
+int dynamic_hash_table_shrink(DynamicHashTable* hash_table);
+
 /**
  * Insert the given key into the hash table. The key cannot be NULL.
  * Returns 1 if the key is inserted, 0 if it already existed.
  */
 inline char dynamic_hash_table_insert(void* key, DynamicHashTable* hash_table) {
-	int i, j, new_size;
+	int i;
 	size_t start_index;
 
-	assert(key != HASH_TABLE_EMPTY_KEY && key != HASH_TABLE_DELETED_KEY);
+	assert(key != HASH_TABLE_EMPTY_KEY);
+
+	if (hash_table->size == 0) {
+		// the keys are stored inline
+		for (i = 0; i < hash_table->element_count; ++i)
+			if (hash_table->inline_elements[i] == key)
+				return 0;
+		if (hash_table->element_count < DYNAMIC_HASH_TABLE_INLINE_SIZE) {
+			hash_table->inline_elements[hash_table->element_count++] = key;
+			return 1;
+		}
+		// no more inline space, continue with a real hash table
+		dynamic_hash_table_spill(hash_table);
+	}
 
 	start_index = HASH_POINTER(key) & (hash_table->size - 1);
 	for (i = start_index; ; i = (i + 1) & (hash_table->size - 1)) {
@@ -98,61 +151,56 @@ inline char dynamic_hash_table_insert(void* key, DynamicHashTable* hash_table) {
 	}
 
 	// check if we need to resize. load factor 0.75
-	if (hash_table->element_count * 4 >= hash_table->size * 3) {
-		// the load factor is reached, resize
-		new_size = 2 * hash_table->size;
-		void **tmp_elements = (void**) calloc(new_size, sizeof(void*));
-		assert(tmp_elements != NULL);
-
-		// free the end indexes, allocate and initialize new
-		free(hash_table->end_indexes);
-		hash_table->end_indexes = (unsigned int*) calloc(new_size, sizeof(unsigned int));
-		assert(hash_table->end_indexes != NULL);
-		for (i = 0; i < new_size; ++i)
-			hash_table->end_indexes[i] = i;
-
-		// re-populate
-		for (i = 0; i < hash_table->size; ++i)
-			if (hash_table->elements[i] != NULL) {
-				start_index = HASH_POINTER(hash_table->elements[i]) & (new_size - 1);
-				for (j = start_index; ; j = (j + 1) & (new_size - 1))
-					if (tmp_elements[j] == HASH_TABLE_EMPTY_KEY) {
-						tmp_elements[j] = hash_table->elements[i];
-						break;
-					}
-				hash_table->end_indexes[start_index] = (j + 1) & (new_size - 1);
-			}
-
-		// change the size, the element count does not change
-		hash_table->size = new_size;
-
-		// free the existing elements
-		free(hash_table->elements);
+	if (hash_table->element_count * 4 >= hash_table->size * 3)
+		dynamic_hash_table_resize(hash_table, 2 * hash_table->size);
 
-		// the new elements
-		hash_table->elements = tmp_elements;
-	}
-
-	// to suppress warnings
 	return 1;
 }
 
 
 /**
- * Removes a given key from the given hash table. The slot is marked as empty afterwards.
- * We do not shrink the allocated space after a removal.
+ * Removes a given key from the given hash table. The keys following it in the same
+ * cluster are shifted backwards into the free slot, as long as this does not move them
+ * in front of their start index. This way no tombstones are left behind and lookups
+ * can stop at the first empty slot.
+ * We do not shrink the allocated space after a removal, see dynamic_hash_table_shrink.
+ * Removing the key that has just been returned by an iterator does not disturb the iteration.
  * Returns 1 if the key is removed, 0 otherwise.
  */
 inline char dynamic_hash_table_remove(void* key, DynamicHashTable* hash_table) {
 	assert(key != NULL);
 
-	int i;
-	size_t start_index = HASH_POINTER(key) & (hash_table->size - 1);
+	unsigned int i;
+	if (hash_table->size == 0) {
+		// the keys are stored inline. the last key takes the place of the removed one.
+		// the iterator traverses the inline keys backwards, so this has already been visited.
+		for (i = 0; i < hash_table->element_count; ++i)
+			if (hash_table->inline_elements[i] == key) {
+				hash_table->inline_elements[i] = hash_table->inline_elements[--hash_table->element_count];
+				return 1;
+			}
+		return 0;
+	}
 
-	for (i = start_index; i != hash_table->end_indexes[start_index]; i = (i + 1) & (hash_table->size - 1)) {
+	size_t mask = hash_table->size - 1;
+	size_t start_index = HASH_POINTER(key) & mask;
+	size_t j, k;
+
+	for (i = start_index; i != hash_table->end_indexes[start_index]; i = (i + 1) & mask) {
+		if (hash_table->elements[i] == HASH_TABLE_EMPTY_KEY)
+			return 0;
 		if (hash_table->elements[i] == key) {
-			// key found, mark it as empty
-			hash_table->elements[i] = HASH_TABLE_DELETED_KEY;
+			// key found, close the gap
+			for (j = (i + 1) & mask; hash_table->elements[j] != HASH_TABLE_EMPTY_KEY; j = (j + 1) & mask) {
+				k = HASH_POINTER(hash_table->elements[j]) & mask;
+				// the key at j can move to i only if its start index is not in (i, j]
+				if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j))
+					continue;
+				hash_table->elements[i] = hash_table->elements[j];
+				i = j;
+			}
+			hash_table->elements[i] = HASH_TABLE_EMPTY_KEY;
+			--hash_table->element_count;
 			return 1;
 		}
 	}
@@ -166,41 +214,73 @@ inline char dynamic_hash_table_remove(void* key, DynamicHashTable* hash_table) {
  */
 inline char dynamic_hash_table_contains(void* key, DynamicHashTable* hash_table) {
 	// assert(key != NULL);
+	int i;
+	if (hash_table->size == 0) {
+		for (i = 0; i < hash_table->element_count; ++i)
+			if (hash_table->inline_elements[i] == key)
+				return 1;
+		return 0;
+	}
+
 	size_t start_index = HASH_POINTER(key) & (hash_table->size - 1);
 
-	int i;
 	for (i = start_index; i != hash_table->end_indexes[start_index]; i = (i + 1) & (hash_table->size - 1)) {
 		if (hash_table->elements[i] == key)
 			return 1;
+		if (hash_table->elements[i] == HASH_TABLE_EMPTY_KEY)
+			return 0;
 	}
 	return 0;
 }
 
-inline DynamicHashTableIterator* dynamic_hash_table_iterator_create(DynamicHashTable* hash_table) {
-	DynamicHashTableIterator* iterator = (DynamicHashTableIterator*) malloc(sizeof(DynamicHashTableIterator));
-	assert(iterator != NULL);
-	iterator->hash_table = hash_table;
-	iterator->current_index = 0;
-
-	return iterator;
-}
-
+/**
+ * Initialize an iterator for the given hash table.
+ * The slots are traversed backwards, starting in front of an empty slot. Backward
+ * shifting in dynamic_hash_table_remove then only moves keys that have already been
+ * visited. Therefore the key that has just been returned can be removed during iteration.
+ * Removing other keys, or inserting keys, is not safe.
+ */
 inline void dynamic_hash_table_iterator_init(DynamicHashTableIterator* iterator, DynamicHashTable* hash_table) {
 
 	iterator->hash_table = hash_table;
+	if (hash_table->size == 0) {
+		// inline keys are traversed backwards as well
+		iterator->current_index = hash_table->element_count;
+		iterator->remaining_slots = hash_table->element_count;
+		return;
+	}
+
+	// there is always an empty slot since the load factor is below 0.75
 	iterator->current_index = 0;
+	while (hash_table->elements[iterator->current_index] != HASH_TABLE_EMPTY_KEY)
+		++iterator->current_index;
+	iterator->remaining_slots = hash_table->size - 1;
 
 	return;
 }
 
+inline DynamicHashTableIterator* dynamic_hash_table_iterator_create(DynamicHashTable* hash_table) {
+	DynamicHashTableIterator* iterator = (DynamicHashTableIterator*) malloc(sizeof(DynamicHashTableIterator));
+	assert(iterator != NULL);
+	dynamic_hash_table_iterator_init(iterator, hash_table);
+
+	return iterator;
+}
+
 inline void* dynamic_hash_table_iterator_next(DynamicHashTableIterator* iterator) {
 
-	int i;
-	for (i = iterator->current_index; i < iterator->hash_table->size; ++i)
-		if (iterator->hash_table->elements[i] != HASH_TABLE_EMPTY_KEY && iterator->hash_table->elements[i] != HASH_TABLE_DELETED_KEY) {
-			iterator->current_index = i + 1;
-			return iterator->hash_table->elements[i];
-		}
+	if (iterator->hash_table->size == 0) {
+		if (iterator->current_index == 0)
+			return NULL;
+		return iterator->hash_table->inline_elements[--iterator->current_index];
+	}
+
+	while (iterator->remaining_slots > 0) {
+		iterator->current_index = (iterator->current_index - 1) & (iterator->hash_table->size - 1);
+		--iterator->remaining_slots;
+		if (iterator->hash_table->elements[iterator->current_index] != HASH_TABLE_EMPTY_KEY)
+			return iterator->hash_table->elements[iterator->current_index];
+	}
 
 	return NULL;
 }
@@ -0,0 +1,164 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "dynamic_id_hash_table.h"
+#include "utils.h"
+
+/**
+ * Open addressing with linear probing and backward shift deletion, like
+ * DynamicHashTable. Empty slots are filled with all 1 bits.
+ */
+
+static inline uint32_t* allocate_elements(uint32_t size) {
+	uint32_t* elements = (uint32_t*) malloc(size * sizeof(uint32_t));
+	assert(elements != NULL);
+	// sets every slot to ID_HASH_TABLE_EMPTY_KEY
+	memset(elements, 0xFF, size * sizeof(uint32_t));
+
+	return elements;
+}
+
+void dynamic_id_hash_table_init(DynamicIdHashTable* hash_table, uint32_t size) {
+
+	hash_table->element_count = 0;
+	if (size <= DYNAMIC_ID_HASH_TABLE_INLINE_SIZE) {
+		hash_table->size = 0;
+		return;
+	}
+
+	if (size < 8)
+		size = 8;
+	else
+		size = roundup_pow2(size);
+
+	hash_table->elements = allocate_elements(size);
+	hash_table->size = size;
+}
+
+DynamicIdHashTable* dynamic_id_hash_table_create(uint32_t size) {
+	DynamicIdHashTable* hash_table = (DynamicIdHashTable*) malloc(sizeof(DynamicIdHashTable));
+	assert(hash_table != NULL);
+
+	dynamic_id_hash_table_init(hash_table, size);
+
+	return hash_table;
+}
+
+void dynamic_id_hash_table_spill(DynamicIdHashTable* hash_table) {
+	uint32_t keys[DYNAMIC_ID_HASH_TABLE_INLINE_SIZE];
+	uint32_t i, count = hash_table->element_count;
+
+	for (i = 0; i < count; ++i)
+		keys[i] = hash_table->inline_elements[i];
+
+	// the inline space is overwritten here
+	dynamic_id_hash_table_init(hash_table, 2 * DYNAMIC_ID_HASH_TABLE_INLINE_SIZE);
+	for (i = 0; i < count; ++i)
+		dynamic_id_hash_table_insert(keys[i], hash_table);
+}
+
+void dynamic_id_hash_table_resize(DynamicIdHashTable* hash_table, uint32_t new_size) {
+	uint32_t i, j;
+	uint32_t* tmp_elements = allocate_elements(new_size);
+
+	// re-populate
+	for (i = 0; i < hash_table->size; ++i)
+		if (hash_table->elements[i] != ID_HASH_TABLE_EMPTY_KEY) {
+			for (j = HASH_UINT64(hash_table->elements[i]) & (new_size - 1); tmp_elements[j] != ID_HASH_TABLE_EMPTY_KEY; j = (j + 1) & (new_size - 1))
+				;
+			tmp_elements[j] = hash_table->elements[i];
+		}
+
+	// change the size, the element count does not change
+	hash_table->size = new_size;
+	free(hash_table->elements);
+	hash_table->elements = tmp_elements;
+}
+
+int dynamic_id_hash_table_shrink(DynamicIdHashTable* hash_table) {
+	uint32_t i, j;
+	uint32_t new_size, old_size = hash_table->size;
+
+	if (old_size == 0)
+		return 0;
+
+	if (hash_table->element_count <= DYNAMIC_ID_HASH_TABLE_INLINE_SIZE) {
+		// the ids fit inline, give up the table
+		uint32_t* elements = hash_table->elements;
+		for (i = 0, j = 0; i < old_size; ++i)
+			if (elements[i] != ID_HASH_TABLE_EMPTY_KEY)
+				hash_table->inline_elements[j++] = elements[i];
+		hash_table->size = 0;
+		free(elements);
+		return old_size * sizeof(uint32_t);
+	}
+
+	// the smallest size that keeps the load factor below 0.75
+	new_size = roundup_pow2(hash_table->element_count * 4 / 3 + 1);
+	if (new_size < 8)
+		new_size = 8;
+	if (new_size >= old_size)
+		return 0;
+
+	dynamic_id_hash_table_resize(hash_table, new_size);
+
+	return (old_size - new_size) * sizeof(uint32_t);
+}
+
+extern inline char dynamic_id_hash_table_insert(uint32_t key, DynamicIdHashTable* hash_table);
+
+extern inline char dynamic_id_hash_table_contains(uint32_t key, DynamicIdHashTable* hash_table);
+
+extern inline char dynamic_id_hash_table_remove(uint32_t key, DynamicIdHashTable* hash_table);
+
+extern inline void dynamic_id_hash_table_iterator_init(DynamicIdHashTableIterator* iterator, DynamicIdHashTable* hash_table);
+
+extern inline uint32_t dynamic_id_hash_table_iterator_next(DynamicIdHashTableIterator* iterator);
+
+int dynamic_id_hash_table_free(DynamicIdHashTable* hash_table) {
+	int freed_bytes = dynamic_id_hash_table_reset(hash_table);
+
+	free(hash_table);
+	freed_bytes += sizeof(DynamicIdHashTable);
+
+	return freed_bytes;
+}
+
+int dynamic_id_hash_table_reset(DynamicIdHashTable* hash_table) {
+	int freed_bytes = 0;
+
+	if (hash_table->size != 0) {
+		free(hash_table->elements);
+		freed_bytes = hash_table->size * sizeof(uint32_t);
+	}
+	hash_table->element_count = 0;
+	hash_table->size = 0;
+
+	return freed_bytes;
+}
+
+size_t dynamic_id_hash_table_memory(DynamicIdHashTable* hash_table) {
+	// 0 if the ids are inline
+	return hash_table->size * sizeof(uint32_t);
+}
@@ -0,0 +1,255 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DYNAMIC_ID_HASH_TABLE_H_
+#define DYNAMIC_ID_HASH_TABLE_H_
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "utils.h"
+
+/**
+ * A hash table for storing 32-bit ids, no associated values.
+ * Same as DynamicHashTable, but the keys take half the space of a pointer.
+ * Since lookups stop at the first empty slot, no end indexes are stored.
+ * The id UINT32_MAX cannot be stored, it marks empty slots.
+ */
+
+typedef struct dynamic_id_hash_table DynamicIdHashTable;
+typedef struct dynamic_id_hash_table_iterator DynamicIdHashTableIterator;
+
+#define ID_HASH_TABLE_EMPTY_KEY		UINT32_MAX
+
+/**
+ * Number of ids that are stored inline in the hash table struct itself.
+ */
+#define DYNAMIC_ID_HASH_TABLE_INLINE_SIZE	4
+
+/**
+ * Hash table.
+ */
+struct dynamic_id_hash_table {
+	union {
+		uint32_t* elements;			// the buckets
+		// the ids as long as they fit inline, i.e., while size is 0
+		uint32_t inline_elements[DYNAMIC_ID_HASH_TABLE_INLINE_SIZE];
+	};
+	uint32_t size;					// size of the hash table, 0 if the ids are stored inline
+	uint32_t element_count;			// the number of elements
+};
+
+/**
+ * Iterator for hash table.
+ */
+struct dynamic_id_hash_table_iterator {
+	DynamicIdHashTable* hash_table;
+	uint32_t current_index;		// index of the current slot
+	uint32_t remaining_slots;	// number of slots not visited yet
+};
+
+DynamicIdHashTable* dynamic_id_hash_table_create(uint32_t size);
+
+/**
+ * Initialize a hash table with a given initial size.
+ */
+void dynamic_id_hash_table_init(DynamicIdHashTable* hash_table, uint32_t size);
+
+/**
+ * Free the space for the given hash table.
+ */
+int dynamic_id_hash_table_free(DynamicIdHashTable* hash_table);
+
+/**
+ * Free the space for the elements of the given hash table. Intended for
+ * hash tables that are not dynamically created, but only initialized.
+ */
+int dynamic_id_hash_table_reset(DynamicIdHashTable* hash_table);
+
+/**
+ * Returns the number of bytes allocated for the elements of the given hash table.
+ * The space for the hash table itself is not included.
+ */
+size_t dynamic_id_hash_table_memory(DynamicIdHashTable* hash_table);
+
+/**
+ * Move the inline ids of the given hash table to a newly allocated table.
+ * Called when the inline space is full.
+ */
+void dynamic_id_hash_table_spill(DynamicIdHashTable* hash_table);
+
+/**
+ * Re-populate the ids of the given hash table in a table of the given size.
+ * The new size is a power of 2 that is large enough for the ids.
+ */
+void dynamic_id_hash_table_resize(DynamicIdHashTable* hash_table, uint32_t new_size);
+
+/**
+ * Shrink the allocated space to the smallest size that keeps the load factor
+ * below 0.75, or move the ids inline if they fit.
+ * Returns the number of freed bytes.
+ */
+int dynamic_id_hash_table_shrink(DynamicIdHashTable* hash_table);
+
+/**
+ * Insert the given id into the hash table.
+ * Returns 1 if the id is inserted, 0 if it already existed.
+ */
+inline char dynamic_id_hash_table_insert(uint32_t key, DynamicIdHashTable* hash_table) {
+	uint32_t i, mask;
+
+	assert(key != ID_HASH_TABLE_EMPTY_KEY);
+
+	if (hash_table->size == 0) {
+		// the ids are stored inline
+		for (i = 0; i < hash_table->element_count; ++i)
+			if (hash_table->inline_elements[i] == key)
+				return 0;
+		if (hash_table->element_count < DYNAMIC_ID_HASH_TABLE_INLINE_SIZE) {
+			hash_table->inline_elements[hash_table->element_count++] = key;
+			return 1;
+		}
+		// no more inline space, continue with a real hash table
+		dynamic_id_hash_table_spill(hash_table);
+	}
+
+	mask = hash_table->size - 1;
+	for (i = HASH_UINT64(key) & mask; ; i = (i + 1) & mask) {
+		if (hash_table->elements[i] == key)
+			// the id already exists
+			return 0;
+
+		if (hash_table->elements[i] == ID_HASH_TABLE_EMPTY_KEY) {
+			// an empty slot is found, insert the id here
+			hash_table->elements[i] = key;
+			++hash_table->element_count;
+			break;
+		}
+	}
+
+	// check if we need to resize. load factor 0.75
+	if (hash_table->element_count * 4 >= hash_table->size * 3)
+		dynamic_id_hash_table_resize(hash_table, 2 * hash_table->size);
+
+	return 1;
+}
+
+/**
+ * Removes a given id from the given hash table by backward shifting the ids
+ * following it in the same cluster, see dynamic_hash_table_remove.
+ * Removing the id that has just been returned by an iterator does not disturb the iteration.
+ * Returns 1 if the id is removed, 0 otherwise.
+ */
+inline char dynamic_id_hash_table_remove(uint32_t key, DynamicIdHashTable* hash_table) {
+	uint32_t i, j, k, mask;
+
+	if (hash_table->size == 0) {
+		// the last id takes the place of the removed one
+		for (i = 0; i < hash_table->element_count; ++i)
+			if (hash_table->inline_elements[i] == key) {
+				hash_table->inline_elements[i] = hash_table->inline_elements[--hash_table->element_count];
+				return 1;
+			}
+		return 0;
+	}
+
+	mask = hash_table->size - 1;
+	for (i = HASH_UINT64(key) & mask; hash_table->elements[i] != ID_HASH_TABLE_EMPTY_KEY; i = (i + 1) & mask) {
+		if (hash_table->elements[i] == key) {
+			// id found, close the gap
+			for (j = (i + 1) & mask; hash_table->elements[j] != ID_HASH_TABLE_EMPTY_KEY; j = (j + 1) & mask) {
+				k = HASH_UINT64(hash_table->elements[j]) & mask;
+				// the id at j can move to i only if its start index is not in (i, j]
+				if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j))
+					continue;
+				hash_table->elements[i] = hash_table->elements[j];
+				i = j;
+			}
+			hash_table->elements[i] = ID_HASH_TABLE_EMPTY_KEY;
+			--hash_table->element_count;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Check whether the given id exists in the hash table.
+ * Returns 1 if so, 0 otherwise.
+ */
+inline char dynamic_id_hash_table_contains(uint32_t key, DynamicIdHashTable* hash_table) {
+	uint32_t i, mask;
+
+	if (hash_table->size == 0) {
+		for (i = 0; i < hash_table->element_count; ++i)
+			if (hash_table->inline_elements[i] == key)
+				return 1;
+		return 0;
+	}
+
+	mask = hash_table->size - 1;
+	for (i = HASH_UINT64(key) & mask; hash_table->elements[i] != ID_HASH_TABLE_EMPTY_KEY; i = (i + 1) & mask)
+		if (hash_table->elements[i] == key)
+			return 1;
+	return 0;
+}
+
+/**
+ * Initialize an iterator for the given hash table.
+ * The slots are traversed backwards as in dynamic_hash_table_iterator_init.
+ * The id that has just been returned can be removed during iteration.
+ */
+inline void dynamic_id_hash_table_iterator_init(DynamicIdHashTableIterator* iterator, DynamicIdHashTable* hash_table) {
+
+	iterator->hash_table = hash_table;
+	if (hash_table->size == 0) {
+		iterator->current_index = hash_table->element_count;
+		iterator->remaining_slots = hash_table->element_count;
+		return;
+	}
+
+	// there is always an empty slot since the load factor is below 0.75
+	iterator->current_index = 0;
+	while (hash_table->elements[iterator->current_index] != ID_HASH_TABLE_EMPTY_KEY)
+		++iterator->current_index;
+	iterator->remaining_slots = hash_table->size - 1;
+}
+
+/**
+ * Get the next id.
+ * Returns ID_HASH_TABLE_EMPTY_KEY if there is no next id.
+ */
+inline uint32_t dynamic_id_hash_table_iterator_next(DynamicIdHashTableIterator* iterator) {
+
+	if (iterator->hash_table->size == 0) {
+		if (iterator->current_index == 0)
+			return ID_HASH_TABLE_EMPTY_KEY;
+		return iterator->hash_table->inline_elements[--iterator->current_index];
+	}
+
+	while (iterator->remaining_slots > 0) {
+		iterator->current_index = (iterator->current_index - 1) & (iterator->hash_table->size - 1);
+		--iterator->remaining_slots;
+		if (iterator->hash_table->elements[iterator->current_index] != ID_HASH_TABLE_EMPTY_KEY)
+			return iterator->hash_table->elements[iterator->current_index];
+	}
+
+	return ID_HASH_TABLE_EMPTY_KEY;
+}
+
+#endif
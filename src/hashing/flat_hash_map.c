@@ -0,0 +1,114 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "flat_hash_map.h"
+
+void flat_hash_map_init(FlatHashMap* hash_map, unsigned int size) {
+	if (size < 16)
+		size = 16;
+	else
+		size = roundup_pow2(size);
+
+	hash_map->slots = (uint32_t*) malloc(size * sizeof(uint32_t));
+	assert(hash_map->slots != NULL);
+	// sets every slot to FLAT_HASH_MAP_EMPTY_SLOT
+	memset(hash_map->slots, 0xFF, size * sizeof(uint32_t));
+	hash_map->size = size;
+
+	// the elements are allocated on the first put
+	hash_map->elements = NULL;
+	hash_map->element_count = 0;
+	hash_map->capacity = 0;
+}
+
+FlatHashMap* flat_hash_map_create(unsigned int size) {
+	FlatHashMap* hash_map = (FlatHashMap*) malloc(sizeof(FlatHashMap));
+	assert(hash_map != NULL);
+
+	flat_hash_map_init(hash_map, size);
+
+	return hash_map;
+}
+
+void flat_hash_map_resize(FlatHashMap* hash_map) {
+	unsigned int i, j, new_size = 2 * hash_map->size;
+	uint32_t* slots = (uint32_t*) malloc(new_size * sizeof(uint32_t));
+	assert(slots != NULL);
+	memset(slots, 0xFF, new_size * sizeof(uint32_t));
+
+	// the positions of the elements do not change, only the index is rebuilt
+	for (i = 0; i < hash_map->element_count; ++i) {
+		for (j = FLAT_HASH_MAP_HASH(hash_map->elements[i].key) & (new_size - 1); slots[j] != FLAT_HASH_MAP_EMPTY_SLOT; j = (j + 1) & (new_size - 1))
+			;
+		slots[j] = i;
+	}
+
+	free(hash_map->slots);
+	hash_map->slots = slots;
+	hash_map->size = new_size;
+}
+
+void flat_hash_map_grow(FlatHashMap* hash_map) {
+	unsigned int new_capacity = (hash_map->capacity == 0) ? 16 : 2 * hash_map->capacity;
+	FlatHashMapElement* tmp = realloc(hash_map->elements, new_capacity * sizeof(FlatHashMapElement));
+	assert(tmp != NULL);
+
+	hash_map->elements = tmp;
+	hash_map->capacity = new_capacity;
+}
+
+extern inline uint32_t flat_hash_map_find_slot(FlatHashMap* hash_map, uint64_t key);
+
+extern inline int flat_hash_map_put(FlatHashMap* hash_map, uint64_t key, void* value);
+
+extern inline void* flat_hash_map_get(FlatHashMap* hash_map, uint64_t key);
+
+extern inline void flat_hash_map_iterator_init(FlatHashMapIterator* iterator, FlatHashMap* hash_map);
+
+extern inline void* flat_hash_map_iterator_next(FlatHashMapIterator* iterator);
+
+int flat_hash_map_free(FlatHashMap* hash_map) {
+	int freed_bytes = flat_hash_map_reset(hash_map);
+
+	free(hash_map);
+	freed_bytes += sizeof(FlatHashMap);
+
+	return freed_bytes;
+}
+
+int flat_hash_map_reset(FlatHashMap* hash_map) {
+	int freed_bytes = hash_map->capacity * sizeof(FlatHashMapElement) + hash_map->size * sizeof(uint32_t);
+
+	free(hash_map->elements);
+	free(hash_map->slots);
+	hash_map->elements = NULL;
+	hash_map->slots = NULL;
+	hash_map->element_count = 0;
+	hash_map->capacity = 0;
+	hash_map->size = 0;
+
+	return freed_bytes;
+}
+
+size_t flat_hash_map_memory(FlatHashMap* hash_map) {
+	return hash_map->capacity * sizeof(FlatHashMapElement) + hash_map->size * sizeof(uint32_t);
+}
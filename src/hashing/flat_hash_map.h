@@ -0,0 +1,173 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLAT_HASH_MAP_H_
+#define FLAT_HASH_MAP_H_
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "utils.h"
+
+/**
+ * A hash map without a node per element. The key value pairs are stored in an
+ * array in the order of insertion, an open addressing index (linear probing)
+ * holds their positions in the array. Like HashMap, it iterates the elements in
+ * the backward order of insertion, and the elements inserted during an iteration
+ * are not visited by it. Elements cannot be removed.
+ */
+
+typedef struct flat_hash_map FlatHashMap;
+typedef struct flat_hash_map_element FlatHashMapElement;
+typedef struct flat_hash_map_iterator FlatHashMapIterator;
+
+#define FLAT_HASH_MAP_EMPTY_SLOT		UINT32_MAX
+
+/**
+ * The keys are often two ids packed into 64 bits. Linear probing on their
+ * low bits builds long clusters, therefore they are always mixed,
+ * independent of HASH_MIXER.
+ */
+#define FLAT_HASH_MAP_HASH(key)		hash_fmix64(key)
+
+struct flat_hash_map_element {
+	uint64_t key;
+	void* value;
+};
+
+struct flat_hash_map {
+	FlatHashMapElement* elements;	// the elements in the order of insertion
+	unsigned int element_count;		// the number of elements
+	unsigned int capacity;			// number of elements the allocated space can hold
+	uint32_t* slots;				// the index, positions in elements
+	unsigned int size;				// number of slots
+};
+
+/**
+ * Iterator for hash map.
+ */
+struct flat_hash_map_iterator {
+	FlatHashMap* hash_map;
+	unsigned int current_index;		// position of the last returned element
+};
+
+/**
+ * Create a hash map with the given number of slots.
+ */
+FlatHashMap* flat_hash_map_create(unsigned int size);
+
+/**
+ * Initialize a hash map with the given number of slots.
+ */
+void flat_hash_map_init(FlatHashMap* hash_map, unsigned int size);
+
+/**
+ * Free the space allocated for the given hash map.
+ */
+int flat_hash_map_free(FlatHashMap* hash_map);
+
+/**
+ * Free the space allocated for the elements of a given hash map.
+ * Does not free the space allocated for the hash map itself.
+ */
+int flat_hash_map_reset(FlatHashMap* hash_map);
+
+/**
+ * Returns the number of bytes allocated for the elements of the given map.
+ * The space for the map itself is not included.
+ */
+size_t flat_hash_map_memory(FlatHashMap* hash_map);
+
+/**
+ * Double the number of slots of the index.
+ */
+void flat_hash_map_resize(FlatHashMap* hash_map);
+
+/**
+ * Double the space for the elements.
+ */
+void flat_hash_map_grow(FlatHashMap* hash_map);
+
+/**
+ * Returns the slot of the given key, or the empty slot where it should go.
+ */
+inline uint32_t flat_hash_map_find_slot(FlatHashMap* hash_map, uint64_t key) {
+	uint32_t i, mask = hash_map->size - 1;
+
+	for (i = FLAT_HASH_MAP_HASH(key) & mask; hash_map->slots[i] != FLAT_HASH_MAP_EMPTY_SLOT; i = (i + 1) & mask)
+		if (hash_map->elements[hash_map->slots[i]].key == key)
+			break;
+	return i;
+}
+
+/**
+ * Insert a key value pair to the hash map. If the key already exists, the
+ * value is overwritten, as in HashMap.
+ * Returns 1 if the key value pair is inserted, 0 otherwise.
+ */
+inline int flat_hash_map_put(FlatHashMap* hash_map, uint64_t key, void* value) {
+	uint32_t slot = flat_hash_map_find_slot(hash_map, key);
+
+	if (hash_map->slots[slot] != FLAT_HASH_MAP_EMPTY_SLOT) {
+		hash_map->elements[hash_map->slots[slot]].value = value;
+		return 0;
+	}
+
+	if (hash_map->element_count == hash_map->capacity)
+		flat_hash_map_grow(hash_map);
+	hash_map->elements[hash_map->element_count].key = key;
+	hash_map->elements[hash_map->element_count].value = value;
+	hash_map->slots[slot] = hash_map->element_count++;
+
+	// load factor 0.75
+	if (hash_map->element_count * 4 >= hash_map->size * 3)
+		flat_hash_map_resize(hash_map);
+
+	return 1;
+}
+
+/**
+ * Returns the value for the given key, it it exists, NULL if it does not exist.
+ */
+inline void* flat_hash_map_get(FlatHashMap* hash_map, uint64_t key) {
+	uint32_t slot = flat_hash_map_find_slot(hash_map, key);
+
+	if (hash_map->slots[slot] == FLAT_HASH_MAP_EMPTY_SLOT)
+		return NULL;
+	return hash_map->elements[hash_map->slots[slot]].value;
+}
+
+/**
+ * Reset a given hash map iterator.
+ */
+inline void flat_hash_map_iterator_init(FlatHashMapIterator* iterator, FlatHashMap* hash_map) {
+	iterator->hash_map = hash_map;
+	iterator->current_index = hash_map->element_count;
+}
+
+/**
+ * Get the next element.
+ * Returns NULL if there is no next element.
+ */
+inline void* flat_hash_map_iterator_next(FlatHashMapIterator* iterator) {
+	if (iterator->current_index == 0)
+		return NULL;
+	return iterator->hash_map->elements[--iterator->current_index].value;
+}
+
+#endif
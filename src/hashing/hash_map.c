@@ -135,6 +135,17 @@ int hash_map_reset(HashMap* hash_map) {
 	return freed_bytes;
 }
 
+size_t hash_map_memory(HashMap* hash_map) {
+	size_t bytes = hash_map->bucket_count * (sizeof(HashMapElement**) + sizeof(unsigned int));
+	unsigned int i;
+
+	for (i = 0; i < hash_map->bucket_count; ++i)
+		if (hash_map->buckets[i] != NULL)
+			bytes += hash_map->chain_sizes[i] * (sizeof(HashMapElement*) + sizeof(HashMapElement));
+
+	return bytes;
+}
+
 extern inline int hash_map_put(HashMap* hash_map, uint64_t key, void* value);
 
 extern inline void* hash_map_get(HashMap* hash_map, uint64_t key);
@@ -22,6 +22,7 @@
 #include <stdint.h>
 #include <assert.h>
 #include <stdlib.h>
+#include "utils.h"
 
 typedef struct hash_map HashMap;
 typedef struct hash_map_element HashMapElement;
@@ -71,6 +72,12 @@ int hash_map_free(HashMap* hash_map);
  */
 int hash_map_reset(HashMap* hash_map);
 
+/**
+ * Returns the number of bytes allocated for the elements of the given map.
+ * The space for the map itself is not included.
+ */
+size_t hash_map_memory(HashMap* hash_map);
+
 /**
  * Insert a key value pair to the hash map. If the key already exists, the given
  * value is not inserted, i.e., the existing value is not overwritten.
@@ -78,8 +85,7 @@ int hash_map_reset(HashMap* hash_map);
  */
 inline int hash_map_put(HashMap* hash_map, uint64_t key, void* value) {
 
-	int hash_value = key & (hash_map->bucket_count - 1);
-	// int hash_value = HASH_UNSIGNED(key) & (hash_map->bucket_count - 1);
+	int hash_value = HASH_UINT64(key) & (hash_map->bucket_count - 1);
 	HashMapElement** bucket = hash_map->buckets[hash_value];
 	int chain_size = hash_map->chain_sizes[hash_value];
 
@@ -114,7 +120,7 @@ inline int hash_map_put(HashMap* hash_map, uint64_t key, void* value) {
  * Returns the value for the given key, it it exists, NULL if it does not exist.
  */
 inline void* hash_map_get(HashMap* hash_map, uint64_t key) {
-	int bucket_index = key & (hash_map->bucket_count - 1);
+	int bucket_index = HASH_UINT64(key) & (hash_map->bucket_count - 1);
 	HashMapElement** bucket = hash_map->buckets[bucket_index];
 	int chain_size = hash_map->chain_sizes[bucket_index];
 
@@ -0,0 +1,157 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include "hash_stats.h"
+#include "utils.h"
+
+void hash_stats_init(HashStats* stats) {
+	memset(stats, 0, sizeof(HashStats));
+}
+
+static inline void add_probe_length(HashStats* stats, unsigned int probe_length) {
+	++stats->element_count;
+	stats->probe_length_sum += probe_length;
+	if (probe_length > stats->max_probe_length)
+		stats->max_probe_length = probe_length;
+	if (probe_length > HASH_STATS_MAX_PROBE_LENGTH)
+		probe_length = HASH_STATS_MAX_PROBE_LENGTH;
+	++stats->probe_length_histogram[probe_length];
+}
+
+void dynamic_hash_table_collect_stats(DynamicHashTable* hash_table, HashStats* stats) {
+	unsigned int i;
+
+	++stats->table_count;
+	if (hash_table->size == 0) {
+		// inline keys are found by a linear scan
+		++stats->inline_table_count;
+		stats->slot_count += DYNAMIC_HASH_TABLE_INLINE_SIZE;
+		for (i = 0; i < hash_table->element_count; ++i)
+			add_probe_length(stats, i);
+		return;
+	}
+
+	stats->slot_count += hash_table->size;
+	for (i = 0; i < hash_table->size; ++i)
+		if (hash_table->elements[i] != HASH_TABLE_EMPTY_KEY)
+			add_probe_length(stats, (i - (HASH_POINTER(hash_table->elements[i]) & (hash_table->size - 1))) & (hash_table->size - 1));
+}
+
+void dynamic_id_hash_table_collect_stats(DynamicIdHashTable* hash_table, HashStats* stats) {
+	unsigned int i;
+
+	++stats->table_count;
+	if (hash_table->size == 0) {
+		++stats->inline_table_count;
+		stats->slot_count += DYNAMIC_ID_HASH_TABLE_INLINE_SIZE;
+		for (i = 0; i < hash_table->element_count; ++i)
+			add_probe_length(stats, i);
+		return;
+	}
+
+	stats->slot_count += hash_table->size;
+	for (i = 0; i < hash_table->size; ++i)
+		if (hash_table->elements[i] != ID_HASH_TABLE_EMPTY_KEY)
+			add_probe_length(stats, (i - (HASH_UINT64(hash_table->elements[i]) & (hash_table->size - 1))) & (hash_table->size - 1));
+}
+
+// number of groups between the first group of the probe sequence of the hash value and the given group
+static inline unsigned int swiss_probe_length(uint64_t hash, uint32_t group, uint32_t size) {
+	uint32_t group_mask = size / SWISS_GROUP_SIZE - 1;
+	uint32_t g, step;
+
+	for (g = SWISS_H1(hash) & group_mask, step = 1; g != group; g = (g + step++) & group_mask)
+		;
+	return step - 1;
+}
+
+void swiss_hash_table_collect_stats(SwissHashTable* hash_table, HashStats* stats) {
+	uint32_t i;
+
+	++stats->table_count;
+	stats->slot_count += hash_table->size;
+	for (i = 0; i < hash_table->size; ++i)
+		if ((hash_table->ctrl[i] & 0x80) == 0)
+			add_probe_length(stats, swiss_probe_length(SWISS_HASH_POINTER(hash_table->elements[i]), i / SWISS_GROUP_SIZE, hash_table->size));
+}
+
+void swiss_id_hash_table_collect_stats(SwissIdHashTable* hash_table, HashStats* stats) {
+	uint32_t i;
+
+	++stats->table_count;
+	stats->slot_count += hash_table->size;
+	for (i = 0; i < hash_table->size; ++i)
+		if ((hash_table->ctrl[i] & 0x80) == 0)
+			add_probe_length(stats, swiss_probe_length(SWISS_HASH_ID(hash_table->elements[i]), i / SWISS_GROUP_SIZE, hash_table->size));
+}
+
+void id_bitset_collect_stats(IdBitset* bitset, HashStats* stats) {
+	uint32_t i, probe_length, count;
+
+	++stats->table_count;
+	stats->slot_count += 64 * (unsigned long) bitset->size;
+	for (i = 0; i < bitset->size; ++i)
+		if (bitset->blocks[i] != ID_BITSET_EMPTY_BLOCK) {
+			probe_length = (i - (HASH_UINT64(bitset->blocks[i]) & (bitset->size - 1))) & (bitset->size - 1);
+			for (count = __builtin_popcountll(bitset->words[i]); count > 0; --count)
+				add_probe_length(stats, probe_length);
+		}
+}
+
+void hash_map_collect_stats(HashMap* hash_map, HashStats* stats) {
+	unsigned int i, j;
+
+	++stats->table_count;
+	stats->slot_count += hash_map->bucket_count;
+	for (i = 0; i < hash_map->bucket_count; ++i)
+		for (j = 0; j < hash_map->chain_sizes[i]; ++j)
+			add_probe_length(stats, j);
+}
+
+void flat_hash_map_collect_stats(FlatHashMap* hash_map, HashStats* stats) {
+	unsigned int i;
+
+	++stats->table_count;
+	stats->slot_count += hash_map->size;
+	for (i = 0; i < hash_map->size; ++i)
+		if (hash_map->slots[i] != FLAT_HASH_MAP_EMPTY_SLOT)
+			add_probe_length(stats, (i - (FLAT_HASH_MAP_HASH(hash_map->elements[hash_map->slots[i]].key) & (hash_map->size - 1))) & (hash_map->size - 1));
+}
+
+void hash_stats_print(HashStats* stats, char* name, FILE* fp) {
+	int i;
+
+	fprintf(fp, "%s: %u tables (%u inline), %lu elements, %lu slots, load factor %.3f, mean probe length %.3f, max probe length %u\n",
+			name,
+			stats->table_count,
+			stats->inline_table_count,
+			stats->element_count,
+			stats->slot_count,
+			stats->slot_count == 0 ? 0.0 : (double) stats->element_count / stats->slot_count,
+			stats->element_count == 0 ? 0.0 : (double) stats->probe_length_sum / stats->element_count,
+			stats->max_probe_length);
+	for (i = 0; i <= HASH_STATS_MAX_PROBE_LENGTH; ++i)
+		if (stats->probe_length_histogram[i] > 0)
+			fprintf(fp, "\tprobe length %s%2d: %lu (%.2f%%)\n",
+					i == HASH_STATS_MAX_PROBE_LENGTH ? ">=" : "  ",
+					i,
+					stats->probe_length_histogram[i],
+					100.0 * stats->probe_length_histogram[i] / stats->element_count);
+}
@@ -0,0 +1,103 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HASH_STATS_H_
+#define HASH_STATS_H_
+
+#include <stdio.h>
+
+#include "dynamic_hash_table.h"
+#include "dynamic_id_hash_table.h"
+#include "swiss_hash_table.h"
+#include "swiss_id_hash_table.h"
+#include "id_bitset.h"
+#include "hash_map.h"
+#include "flat_hash_map.h"
+
+/**
+ * Statistics about the clustering in hash tables and hash maps. The statistics
+ * of several tables can be accumulated, for instance over the subsumer sets of
+ * all class expressions.
+ * The probe length of a key is the number of slots that are visited before it is
+ * found: its distance from the start index in a DynamicHashTable, its position in
+ * the chain in a HashMap. In a SwissHashTable it is the number of groups
+ * visited before the key's group, in an IdBitset it is the probe length of
+ * the block, counted for each of its ids.
+ */
+
+typedef struct hash_stats HashStats;
+
+// probe lengths at least this large are counted together
+#define HASH_STATS_MAX_PROBE_LENGTH		16
+
+struct hash_stats {
+	unsigned int table_count;		// number of tables
+	unsigned int inline_table_count;// number of tables that store their keys inline
+	unsigned long slot_count;		// total number of slots (buckets for hash maps)
+	unsigned long element_count;	// total number of keys
+	unsigned long probe_length_sum;	// sum of the probe lengths of all keys
+	unsigned int max_probe_length;	// the longest probe length
+	unsigned long probe_length_histogram[HASH_STATS_MAX_PROBE_LENGTH + 1];
+};
+
+/**
+ * Initialize the given statistics.
+ */
+void hash_stats_init(HashStats* stats);
+
+/**
+ * Add the probe lengths and the load of the given hash table to the statistics.
+ */
+void dynamic_hash_table_collect_stats(DynamicHashTable* hash_table, HashStats* stats);
+
+/**
+ * Add the probe lengths and the load of the given id hash table to the statistics.
+ */
+void dynamic_id_hash_table_collect_stats(DynamicIdHashTable* hash_table, HashStats* stats);
+
+/**
+ * Add the probe lengths and the load of the given swiss hash table to the statistics.
+ */
+void swiss_hash_table_collect_stats(SwissHashTable* hash_table, HashStats* stats);
+
+/**
+ * Add the probe lengths and the load of the given swiss id hash table to the statistics.
+ */
+void swiss_id_hash_table_collect_stats(SwissIdHashTable* hash_table, HashStats* stats);
+
+/**
+ * Add the probe lengths and the load of the given id bitset to the statistics.
+ * The slots are counted in ids, 64 per block.
+ */
+void id_bitset_collect_stats(IdBitset* bitset, HashStats* stats);
+
+/**
+ * Add the probe lengths and the load of the given hash map to the statistics.
+ */
+void hash_map_collect_stats(HashMap* hash_map, HashStats* stats);
+
+/**
+ * Add the probe lengths and the load of the given flat hash map to the statistics.
+ */
+void flat_hash_map_collect_stats(FlatHashMap* hash_map, HashStats* stats);
+
+/**
+ * Print the load factor and the probe length histogram.
+ */
+void hash_stats_print(HashStats* stats, char* name, FILE* fp);
+
+#endif /* HASH_STATS_H_ */
@@ -0,0 +1,136 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "id_bitset.h"
+
+#define SLOT_SIZE		(sizeof(uint32_t) + sizeof(uint64_t))
+
+// the smallest table size that keeps the load factor below 0.75 for the given number of blocks
+static inline uint32_t size_for(uint32_t block_count) {
+	uint32_t size = roundup_pow2(block_count * 4 / 3 + 1);
+
+	return size < 8 ? 8 : size;
+}
+
+void id_bitset_init(IdBitset* bitset, uint32_t size) {
+	bitset->blocks = NULL;
+	bitset->words = NULL;
+	bitset->size = 0;
+	bitset->block_count = 0;
+	bitset->element_count = 0;
+	// the size is given in ids, assume that they are spread over different blocks
+	if (size > 8)
+		id_bitset_resize(bitset, size_for(size));
+}
+
+IdBitset* id_bitset_create(uint32_t size) {
+	IdBitset* bitset = (IdBitset*) malloc(sizeof(IdBitset));
+	assert(bitset != NULL);
+
+	id_bitset_init(bitset, size);
+
+	return bitset;
+}
+
+void id_bitset_resize(IdBitset* bitset, uint32_t new_size) {
+	uint32_t i, j;
+	// the block numbers and the words in one allocation, the words first for alignment
+	uint64_t* words = (uint64_t*) malloc(new_size * SLOT_SIZE);
+	uint32_t* blocks = (uint32_t*) (words + new_size);
+	assert(words != NULL);
+	memset(words, 0, new_size * sizeof(uint64_t));
+	memset(blocks, 0xFF, new_size * sizeof(uint32_t));
+
+	// re-populate, the empty blocks are dropped
+	bitset->block_count = 0;
+	for (i = 0; i < bitset->size; ++i)
+		if (bitset->blocks[i] != ID_BITSET_EMPTY_BLOCK && bitset->words[i] != 0) {
+			for (j = HASH_UINT64(bitset->blocks[i]) & (new_size - 1); blocks[j] != ID_BITSET_EMPTY_BLOCK; j = (j + 1) & (new_size - 1))
+				;
+			blocks[j] = bitset->blocks[i];
+			words[j] = bitset->words[i];
+			++bitset->block_count;
+		}
+
+	free(bitset->words);
+	bitset->words = words;
+	bitset->blocks = blocks;
+	bitset->size = new_size;
+}
+
+int id_bitset_shrink(IdBitset* bitset) {
+	uint32_t i, block_count = 0, new_size, old_size = bitset->size;
+
+	if (old_size == 0)
+		return 0;
+
+	if (bitset->element_count == 0)
+		return id_bitset_reset(bitset);
+
+	for (i = 0; i < old_size; ++i)
+		block_count += (bitset->words[i] != 0);
+	new_size = size_for(block_count);
+	if (new_size >= old_size)
+		return 0;
+
+	id_bitset_resize(bitset, new_size);
+
+	return (old_size - new_size) * SLOT_SIZE;
+}
+
+extern inline uint32_t id_bitset_find_block(uint32_t block, IdBitset* bitset);
+
+extern inline char id_bitset_insert(uint32_t key, IdBitset* bitset);
+
+extern inline char id_bitset_contains(uint32_t key, IdBitset* bitset);
+
+extern inline char id_bitset_remove(uint32_t key, IdBitset* bitset);
+
+extern inline void id_bitset_iterator_init(IdBitsetIterator* iterator, IdBitset* bitset);
+
+extern inline uint32_t id_bitset_iterator_next(IdBitsetIterator* iterator);
+
+int id_bitset_free(IdBitset* bitset) {
+	int freed_bytes = id_bitset_reset(bitset);
+
+	free(bitset);
+	freed_bytes += sizeof(IdBitset);
+
+	return freed_bytes;
+}
+
+int id_bitset_reset(IdBitset* bitset) {
+	int freed_bytes = bitset->size * SLOT_SIZE;
+
+	free(bitset->words);
+	bitset->words = NULL;
+	bitset->blocks = NULL;
+	bitset->size = 0;
+	bitset->block_count = 0;
+	bitset->element_count = 0;
+
+	return freed_bytes;
+}
+
+size_t id_bitset_memory(IdBitset* bitset) {
+	return bitset->size * SLOT_SIZE;
+}
@@ -0,0 +1,201 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ID_BITSET_H_
+#define ID_BITSET_H_
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "utils.h"
+
+/**
+ * A sparse bitset for storing 32-bit ids. The ids are grouped into blocks of 64,
+ * a block is stored as a 64-bit word in a hash table keyed by the block number
+ * (open addressing, linear probing). Sets of ids that are close to each other,
+ * like the subsumers of a class after the ids are renumbered in hierarchy order,
+ * take a few bits per id.
+ * Blocks whose ids are all removed stay in the table until it is resized, so that
+ * removing during iteration does not move the blocks.
+ * The id UINT32_MAX cannot be stored, it marks the end of iteration.
+ */
+
+typedef struct id_bitset IdBitset;
+typedef struct id_bitset_iterator IdBitsetIterator;
+
+#define ID_BITSET_END				UINT32_MAX
+#define ID_BITSET_EMPTY_BLOCK		UINT32_MAX
+
+#define ID_BITSET_BLOCK(id)			((id) >> 6)
+#define ID_BITSET_BIT(id)			(((uint64_t) 1) << ((id) & 63))
+
+struct id_bitset {
+	uint32_t* blocks;			// the block numbers, ID_BITSET_EMPTY_BLOCK for empty slots
+	uint64_t* words;			// the bits of the blocks
+	uint32_t size;				// number of slots, 0 if nothing is allocated
+	uint32_t block_count;		// number of used slots
+	uint32_t element_count;		// number of ids
+};
+
+struct id_bitset_iterator {
+	IdBitset* bitset;
+	uint32_t current_index;		// the slot of the current block
+	uint64_t remaining_bits;	// the bits of the current block that are not returned yet
+};
+
+IdBitset* id_bitset_create(uint32_t size);
+
+/**
+ * Initialize a bitset for about the given number of ids.
+ */
+void id_bitset_init(IdBitset* bitset, uint32_t size);
+
+/**
+ * Free the space for the given bitset.
+ */
+int id_bitset_free(IdBitset* bitset);
+
+/**
+ * Free the space for the blocks of the given bitset.
+ */
+int id_bitset_reset(IdBitset* bitset);
+
+/**
+ * Returns the number of bytes allocated for the elements of the given bitset.
+ * The space for the bitset itself is not included.
+ */
+size_t id_bitset_memory(IdBitset* bitset);
+
+/**
+ * Re-populate the non-empty blocks in a table of the given size.
+ */
+void id_bitset_resize(IdBitset* bitset, uint32_t new_size);
+
+/**
+ * Shrink the table to the smallest size that keeps the load factor below 0.75,
+ * dropping the empty blocks. Iterators of the bitset become invalid.
+ * Returns the number of freed bytes.
+ */
+int id_bitset_shrink(IdBitset* bitset);
+
+/**
+ * Returns the slot of the given block, or the empty slot where it should go.
+ */
+inline uint32_t id_bitset_find_block(uint32_t block, IdBitset* bitset) {
+	uint32_t i, mask = bitset->size - 1;
+
+	for (i = HASH_UINT64(block) & mask; bitset->blocks[i] != ID_BITSET_EMPTY_BLOCK && bitset->blocks[i] != block; i = (i + 1) & mask)
+		;
+	return i;
+}
+
+/**
+ * Insert the given id into the bitset.
+ * Returns 1 if the id is inserted, 0 if it already existed.
+ */
+inline char id_bitset_insert(uint32_t key, IdBitset* bitset) {
+	uint32_t slot, block = ID_BITSET_BLOCK(key);
+
+	assert(key != ID_BITSET_END);
+
+	if (bitset->size == 0)
+		id_bitset_resize(bitset, 8);
+
+	slot = id_bitset_find_block(block, bitset);
+	if (bitset->blocks[slot] == ID_BITSET_EMPTY_BLOCK) {
+		// a new block. load factor 0.75
+		if ((bitset->block_count + 1) * 4 >= bitset->size * 3) {
+			id_bitset_resize(bitset, 2 * bitset->size);
+			slot = id_bitset_find_block(block, bitset);
+		}
+		bitset->blocks[slot] = block;
+		bitset->words[slot] = 0;
+		++bitset->block_count;
+	}
+	else if (bitset->words[slot] & ID_BITSET_BIT(key))
+		return 0;
+
+	bitset->words[slot] |= ID_BITSET_BIT(key);
+	++bitset->element_count;
+	return 1;
+}
+
+/**
+ * Check whether the given id exists in the bitset.
+ * Returns 1 if so, 0 otherwise.
+ */
+inline char id_bitset_contains(uint32_t key, IdBitset* bitset) {
+	uint32_t slot;
+
+	if (bitset->size == 0)
+		return 0;
+
+	slot = id_bitset_find_block(ID_BITSET_BLOCK(key), bitset);
+	return bitset->blocks[slot] != ID_BITSET_EMPTY_BLOCK && (bitset->words[slot] & ID_BITSET_BIT(key)) != 0;
+}
+
+/**
+ * Remove the given id from the bitset. Its block stays, see above.
+ * Returns 1 if the id is removed, 0 otherwise.
+ */
+inline char id_bitset_remove(uint32_t key, IdBitset* bitset) {
+	uint32_t slot;
+
+	if (bitset->size == 0)
+		return 0;
+
+	slot = id_bitset_find_block(ID_BITSET_BLOCK(key), bitset);
+	if (bitset->blocks[slot] == ID_BITSET_EMPTY_BLOCK || (bitset->words[slot] & ID_BITSET_BIT(key)) == 0)
+		return 0;
+
+	bitset->words[slot] &= ~ID_BITSET_BIT(key);
+	--bitset->element_count;
+	return 1;
+}
+
+/**
+ * Initialize an iterator for the given bitset. The ids of a block are
+ * returned in increasing order, the blocks in the order of the table.
+ */
+inline void id_bitset_iterator_init(IdBitsetIterator* iterator, IdBitset* bitset) {
+	iterator->bitset = bitset;
+	iterator->current_index = 0;
+	iterator->remaining_bits = (bitset->size == 0) ? 0 : bitset->words[0];
+}
+
+/**
+ * Get the next id.
+ * Returns ID_BITSET_END if there is no next id.
+ */
+inline uint32_t id_bitset_iterator_next(IdBitsetIterator* iterator) {
+	IdBitset* bitset = iterator->bitset;
+	uint32_t bit;
+
+	while (iterator->remaining_bits == 0) {
+		if (++iterator->current_index >= bitset->size)
+			return ID_BITSET_END;
+		// the words of empty slots are 0
+		iterator->remaining_bits = bitset->words[iterator->current_index];
+	}
+	bit = __builtin_ctzll(iterator->remaining_bits);
+	iterator->remaining_bits &= iterator->remaining_bits - 1;
+
+	return (bitset->blocks[iterator->current_index] << 6) | bit;
+}
+
+#endif
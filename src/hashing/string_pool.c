@@ -0,0 +1,202 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "string_pool.h"
+#include "utils.h"
+
+// size of an entry for a string of the given length, rounded up to a multiple of 4
+#define ENTRY_SIZE(length)		((sizeof(StringPoolEntry) + (length) + 1 + 3) & ~((size_t) 3))
+
+// hash value of a string of the given length
+#define HASH(str, length)		STRING_POOL_HASH(str, length)
+
+// the entry the given reference points to
+#define ENTRY(pool, ref)		((StringPoolEntry*) ((pool)->blocks[(ref) >> STRING_POOL_OFFSET_BITS] + (((ref) & ((1 << STRING_POOL_OFFSET_BITS) - 1)) << 2)))
+
+static inline uint32_t* allocate_slots(uint32_t size) {
+	uint32_t* slots = (uint32_t*) malloc(size * sizeof(uint32_t));
+	assert(slots != NULL);
+	// sets every slot to STRING_POOL_EMPTY_SLOT
+	memset(slots, 0xFF, size * sizeof(uint32_t));
+
+	return slots;
+}
+
+void string_pool_init(StringPool* pool, uint32_t size, size_t block_size) {
+	pool->blocks = NULL;
+	pool->block_count = 0;
+	pool->current_block = 0;
+	pool->free_space = NULL;
+	pool->free_bytes = 0;
+	// the offsets of the entries do not reach beyond a full block
+	pool->block_size = (block_size == 0 || block_size > STRING_POOL_BLOCK_SIZE) ? STRING_POOL_BLOCK_SIZE : block_size;
+
+	if (size < 8)
+		size = 8;
+	else
+		size = roundup_pow2(size);
+	pool->slots = allocate_slots(size);
+	pool->size = size;
+	pool->string_count = 0;
+	pool->string_bytes = 0;
+	pool->arena_bytes = 0;
+}
+
+// allocate space for an entry of the given size in the arena, returns the reference to it
+static uint32_t allocate_entry(StringPool* pool, size_t entry_size) {
+	char* block;
+	char** tmp;
+	uint32_t ref;
+
+	if (entry_size > pool->free_bytes) {
+		// start a new block. a string that does not fit in a block gets its own one,
+		// the current block stays in use then.
+		size_t block_size = entry_size > pool->block_size ? entry_size : pool->block_size;
+		assert(pool->block_count < (1 << (32 - STRING_POOL_OFFSET_BITS)) - 1);
+		tmp = realloc(pool->blocks, (pool->block_count + 1) * sizeof(char*));
+		assert(tmp != NULL);
+		pool->blocks = tmp;
+		block = (char*) malloc(block_size);
+		assert(block != NULL);
+		pool->blocks[pool->block_count] = block;
+		pool->arena_bytes += block_size;
+		if (block_size > pool->block_size)
+			return (pool->block_count++) << STRING_POOL_OFFSET_BITS;
+		pool->current_block = pool->block_count++;
+		pool->free_space = block;
+		pool->free_bytes = block_size;
+		// only the first block is sized for the pool
+		pool->block_size = STRING_POOL_BLOCK_SIZE;
+	}
+
+	ref = (pool->current_block << STRING_POOL_OFFSET_BITS) | ((pool->free_space - pool->blocks[pool->current_block]) >> 2);
+	pool->free_space += entry_size;
+	pool->free_bytes -= entry_size;
+
+	return ref;
+}
+
+static void resize_index(StringPool* pool) {
+	uint32_t i, j, new_size = 2 * pool->size;
+	StringPoolEntry* entry;
+	uint32_t* new_slots = allocate_slots(new_size);
+
+	for (i = 0; i < pool->size; ++i)
+		if (pool->slots[i] != STRING_POOL_EMPTY_SLOT) {
+			// the hash values are not stored, compute them again
+			entry = ENTRY(pool, pool->slots[i]);
+			for (j = HASH(entry->string, entry->length) & (new_size - 1); new_slots[j] != STRING_POOL_EMPTY_SLOT; j = (j + 1) & (new_size - 1))
+				;
+			new_slots[j] = pool->slots[i];
+		}
+
+	free(pool->slots);
+	pool->slots = new_slots;
+	pool->size = new_size;
+}
+
+// returns the slot where the given string is, or the empty slot where it should go
+static inline uint32_t find_slot(StringPool* pool, const char* str, uint32_t length, uint32_t hash) {
+	uint32_t i, mask = pool->size - 1;
+	StringPoolEntry* entry;
+
+	for (i = hash & mask; pool->slots[i] != STRING_POOL_EMPTY_SLOT; i = (i + 1) & mask) {
+		entry = ENTRY(pool, pool->slots[i]);
+		if (entry->length == length && memcmp(entry->string, str, length) == 0)
+			break;
+	}
+
+	return i;
+}
+
+StringPoolEntry* string_pool_get(StringPool* pool, const char* str, uint32_t length) {
+	uint32_t slot = find_slot(pool, str, length, HASH(str, length));
+
+	if (pool->slots[slot] == STRING_POOL_EMPTY_SLOT)
+		return NULL;
+	return ENTRY(pool, pool->slots[slot]);
+}
+
+StringPoolEntry* string_pool_intern(StringPool* pool, const char* str, uint32_t length) {
+	return string_pool_intern_hash(pool, str, length, HASH(str, length));
+}
+
+StringPoolEntry* string_pool_intern_hash(StringPool* pool, const char* str, uint32_t length, uint32_t hash) {
+	uint32_t slot = find_slot(pool, str, length, hash);
+	StringPoolEntry* entry;
+
+	if (pool->slots[slot] != STRING_POOL_EMPTY_SLOT)
+		return ENTRY(pool, pool->slots[slot]);
+
+	// not interned yet, copy it to the arena
+	size_t entry_size = ENTRY_SIZE(length);
+	pool->slots[slot] = allocate_entry(pool, entry_size);
+	entry = ENTRY(pool, pool->slots[slot]);
+	entry->id = pool->string_count++;
+	entry->length = length;
+	memcpy(entry->string, str, length);
+	entry->string[length] = '\0';
+	pool->string_bytes += entry_size;
+
+	// load factor 0.75
+	if (pool->string_count * 4 >= pool->size * 3)
+		resize_index(pool);
+
+	return entry;
+}
+
+void string_pool_entries(StringPool* pool, StringPoolEntry** entries) {
+	uint32_t i;
+	StringPoolEntry* entry;
+
+	for (i = 0; i < pool->size; ++i)
+		if (pool->slots[i] != STRING_POOL_EMPTY_SLOT) {
+			entry = ENTRY(pool, pool->slots[i]);
+			entries[entry->id] = entry;
+		}
+}
+
+int string_pool_reset(StringPool* pool) {
+	int freed_bytes = 0;
+	uint32_t i;
+
+	for (i = 0; i < pool->block_count; ++i)
+		free(pool->blocks[i]);
+	free(pool->blocks);
+	freed_bytes += pool->arena_bytes + pool->block_count * sizeof(char*);
+
+	free(pool->slots);
+	freed_bytes += pool->size * sizeof(uint32_t);
+
+	pool->blocks = NULL;
+	pool->block_count = 0;
+	pool->free_space = NULL;
+	pool->free_bytes = 0;
+	pool->block_size = STRING_POOL_BLOCK_SIZE;
+	pool->slots = NULL;
+	pool->size = 0;
+	pool->string_count = 0;
+	pool->string_bytes = 0;
+	pool->arena_bytes = 0;
+
+	return freed_bytes;
+}
@@ -0,0 +1,133 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STRING_POOL_H_
+#define STRING_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "utils.h"
+
+/**
+ * A pool for interning strings. Every distinct string is stored exactly once.
+ * The strings are copied into large blocks (the arena) one after the other, each
+ * preceded by its length and id. The ids are dense,
+ * in the order the strings are interned, so they can be used as map keys.
+ * Lookups compare the full string, two strings with the same hash value are
+ * never confused.
+ * The strings cannot be freed individually, only together with the pool.
+ */
+
+typedef struct string_pool StringPool;
+typedef struct string_pool_entry StringPoolEntry;
+
+/**
+ * Size of an arena block. The first block can be smaller, see
+ * string_pool_init. Longer strings get a block of their own.
+ */
+#define STRING_POOL_BLOCK_SIZE		(1 << 20)
+
+/**
+ * The index refers to an entry with 32 bits: the block number in the upper bits,
+ * the offset in the block divided by 4 in the lower STRING_POOL_OFFSET_BITS bits.
+ * This allows 2^14 blocks, i.e., 16 GB of strings. The offset limits the
+ * blocks to STRING_POOL_BLOCK_SIZE.
+ */
+#define STRING_POOL_OFFSET_BITS		18
+#define STRING_POOL_EMPTY_SLOT		UINT32_MAX
+
+/**
+ * An interned string. The entries are 4-byte aligned in the arena.
+ */
+struct string_pool_entry {
+	uint32_t id;		// unique id of the string in this pool
+	uint32_t length;	// length of the string without the terminating '\0'
+	char string[];		// the string itself, '\0' terminated
+};
+
+struct string_pool {
+	// the arena
+	char** blocks;
+	uint32_t block_count;
+	uint32_t current_block;		// the block where new strings are added
+	char* free_space;			// start of the free space in the current block
+	size_t free_bytes;			// number of free bytes in the current block
+	size_t block_size;			// size of the next block
+
+	// the index, open addressing with linear probing. the slots
+	// refer to the entries as described above.
+	uint32_t* slots;
+	uint32_t size;				// number of slots
+	uint32_t string_count;		// number of interned strings, also the next id
+
+	size_t string_bytes;		// total size of the entries in the arena
+	size_t arena_bytes;			// total size of the blocks
+};
+
+/**
+ * Hash value of a string of the given length in the pool. Callers that have
+ * already computed it, like the lexer, pass it to string_pool_intern_hash.
+ */
+#define STRING_POOL_HASH(str, length)	((uint32_t) HASH_STRING_LENGTH(str, length))
+
+/**
+ * Returns the entry of an interned string.
+ */
+#define STRING_POOL_ENTRY(str)		((StringPoolEntry*) ((str) - offsetof(StringPoolEntry, string)))
+
+/**
+ * Initialize a string pool with an index of the given size, and a first
+ * block of the given size in bytes for the strings. 0, or a size over
+ * STRING_POOL_BLOCK_SIZE, is taken as STRING_POOL_BLOCK_SIZE. The next
+ * blocks have the full size.
+ */
+void string_pool_init(StringPool* pool, uint32_t size, size_t block_size);
+
+/**
+ * Returns the entry for the given string of the given length. The string does not
+ * need to be '\0' terminated. It is copied to the pool if it is not already there.
+ */
+StringPoolEntry* string_pool_intern(StringPool* pool, const char* str, uint32_t length);
+
+/**
+ * Same as string_pool_intern, for a string whose hash value is already
+ * known. It has to be STRING_POOL_HASH(str, length).
+ */
+StringPoolEntry* string_pool_intern_hash(StringPool* pool, const char* str, uint32_t length, uint32_t hash);
+
+/**
+ * Returns the entry for the given string of the given length,
+ * NULL if it has not been interned.
+ */
+StringPoolEntry* string_pool_get(StringPool* pool, const char* str, uint32_t length);
+
+/**
+ * Store the entries of the pool in the given array, indexed by their ids.
+ * The array has to have space for string_count entries.
+ */
+void string_pool_entries(StringPool* pool, StringPoolEntry** entries);
+
+/**
+ * Free the arena and the index of the given pool. All interned strings
+ * become invalid. The space for the pool itself is not freed.
+ * Returns the number of freed bytes.
+ */
+int string_pool_reset(StringPool* pool);
+
+#endif /* STRING_POOL_H_ */
@@ -0,0 +1,153 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "swiss_hash_table.h"
+
+// allocate the control bytes and the slots of a table of the given size in one block
+static inline void allocate_slots(SwissHashTable* hash_table, uint32_t size) {
+	hash_table->ctrl = (uint8_t*) malloc(size * (sizeof(uint8_t) + sizeof(void*)));
+	assert(hash_table->ctrl != NULL);
+	memset(hash_table->ctrl, SWISS_CTRL_EMPTY, size);
+	hash_table->elements = (void**) (hash_table->ctrl + size);
+	hash_table->size = size;
+	hash_table->growth_left = SWISS_CAPACITY(size);
+}
+
+// the smallest size whose capacity is enough for the given number of keys
+static inline uint32_t size_for(uint32_t key_count) {
+	uint32_t size = SWISS_GROUP_SIZE;
+
+	while (SWISS_CAPACITY(size) < key_count)
+		size *= 2;
+	return size;
+}
+
+void swiss_hash_table_init(SwissHashTable* hash_table, uint32_t size) {
+	hash_table->element_count = 0;
+	if (size < SWISS_CAPACITY(SWISS_GROUP_SIZE)) {
+		// small tables are allocated on the first insert
+		hash_table->ctrl = NULL;
+		hash_table->elements = NULL;
+		hash_table->size = 0;
+		hash_table->growth_left = 0;
+		return;
+	}
+	allocate_slots(hash_table, size_for(size));
+}
+
+SwissHashTable* swiss_hash_table_create(uint32_t size) {
+	SwissHashTable* hash_table = (SwissHashTable*) malloc(sizeof(SwissHashTable));
+	assert(hash_table != NULL);
+
+	swiss_hash_table_init(hash_table, size);
+
+	return hash_table;
+}
+
+void swiss_hash_table_resize(SwissHashTable* hash_table, uint32_t new_size) {
+	uint8_t* old_ctrl = hash_table->ctrl;
+	void** old_elements = hash_table->elements;
+	uint32_t i, old_size = hash_table->size;
+
+	allocate_slots(hash_table, new_size);
+	hash_table->element_count = 0;
+	// re-populate, the deleted slots are not migrated
+	for (i = 0; i < old_size; ++i)
+		if ((old_ctrl[i] & 0x80) == 0)
+			swiss_hash_table_insert(old_elements[i], hash_table);
+	free(old_ctrl);
+}
+
+int swiss_hash_table_shrink(SwissHashTable* hash_table) {
+	uint32_t new_size, old_size = hash_table->size;
+
+	if (old_size == 0)
+		return 0;
+
+	if (hash_table->element_count == 0) {
+		swiss_hash_table_reset(hash_table);
+		return old_size * (sizeof(uint8_t) + sizeof(void*));
+	}
+
+	new_size = size_for(hash_table->element_count);
+	if (new_size >= old_size)
+		return 0;
+
+	swiss_hash_table_resize(hash_table, new_size);
+
+	return (old_size - new_size) * (sizeof(uint8_t) + sizeof(void*));
+}
+
+extern inline uint32_t swiss_group_match(const uint8_t* group, uint8_t c);
+
+extern inline uint32_t swiss_group_match_free(const uint8_t* group);
+
+extern inline char swiss_hash_table_insert(void* key, SwissHashTable* hash_table);
+
+extern inline char swiss_hash_table_contains(void* key, SwissHashTable* hash_table);
+
+extern inline char swiss_hash_table_remove(void* key, SwissHashTable* hash_table);
+
+SwissHashTableIterator* swiss_hash_table_iterator_create(SwissHashTable* hash_table) {
+	SwissHashTableIterator* iterator = (SwissHashTableIterator*) malloc(sizeof(SwissHashTableIterator));
+	assert(iterator != NULL);
+
+	swiss_hash_table_iterator_init(iterator, hash_table);
+
+	return iterator;
+}
+
+extern inline void swiss_hash_table_iterator_init(SwissHashTableIterator* iterator, SwissHashTable* hash_table);
+
+extern inline void* swiss_hash_table_iterator_next(SwissHashTableIterator* iterator);
+
+int swiss_hash_table_iterator_free(SwissHashTableIterator* iterator) {
+	free(iterator);
+
+	return sizeof(SwissHashTableIterator);
+}
+
+int swiss_hash_table_free(SwissHashTable* hash_table) {
+	int freed_bytes = swiss_hash_table_reset(hash_table);
+
+	free(hash_table);
+	freed_bytes += sizeof(SwissHashTable);
+
+	return freed_bytes;
+}
+
+int swiss_hash_table_reset(SwissHashTable* hash_table) {
+	int freed_bytes = hash_table->size * (sizeof(uint8_t) + sizeof(void*));
+
+	free(hash_table->ctrl);
+	hash_table->ctrl = NULL;
+	hash_table->elements = NULL;
+	hash_table->size = 0;
+	hash_table->element_count = 0;
+	hash_table->growth_left = 0;
+
+	return freed_bytes;
+}
+
+size_t swiss_hash_table_memory(SwissHashTable* hash_table) {
+	return hash_table->size * (sizeof(uint8_t) + sizeof(void*));
+}
@@ -0,0 +1,296 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SWISS_HASH_TABLE_H_
+#define SWISS_HASH_TABLE_H_
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "utils.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * A hash table for storing keys only, in the style of the SwissTable of Abseil.
+ * Every slot has a control byte that is either empty, deleted or the lower 7 bits
+ * of the hash value of its key. The control bytes are probed in aligned groups
+ * of 16, with SSE2 a group is compared to the 7 bits of the searched key in one
+ * instruction. The keys are compared only where the 7 bits match. The table is
+ * resized at load factor 7/8, deleted slots included.
+ * Keys cannot be NULL. The table does not allocate anything until the first key
+ * is inserted.
+ */
+
+typedef struct swiss_hash_table SwissHashTable;
+typedef struct swiss_hash_table_iterator SwissHashTableIterator;
+
+#define SWISS_GROUP_SIZE		16
+
+// control bytes. full slots have the 7 bits of the hash value, high bit 0
+#define SWISS_CTRL_EMPTY		((uint8_t) 0x80)
+#define SWISS_CTRL_DELETED		((uint8_t) 0xFE)
+
+// the group index is taken from the upper bits, the control byte from the lower 7
+#define SWISS_H1(hash)			((hash) >> 7)
+#define SWISS_H2(hash)			((uint8_t) ((hash) & 0x7F))
+
+// the hash value of a key. the mixer is always applied, the lower 7 bits
+// of an unmixed pointer or id hardly vary
+#define SWISS_HASH_POINTER(key)	hash_fmix64(((size_t) (key)) >> 3)
+#define SWISS_HASH_ID(key)		hash_fmix64(key)
+
+/**
+ * Hash table.
+ */
+struct swiss_hash_table {
+	uint8_t* ctrl;				// the control bytes, the keys follow them in the same block
+	void** elements;			// the slots
+	uint32_t size;				// number of slots, a multiple of SWISS_GROUP_SIZE, 0 if nothing is allocated
+	uint32_t element_count;		// the number of elements
+	uint32_t growth_left;		// number of empty slots that can be filled before resizing
+};
+
+/**
+ * Iterator for hash table.
+ */
+struct swiss_hash_table_iterator {
+	SwissHashTable* hash_table;
+	uint32_t current_index;		// index of the next slot
+};
+
+/**
+ * Bit i of the result is set if the control byte i of the group is c.
+ */
+inline uint32_t swiss_group_match(const uint8_t* group, uint8_t c) {
+#ifdef __SSE2__
+	return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) group), _mm_set1_epi8((char) c)));
+#else
+	uint32_t i, mask = 0;
+	for (i = 0; i < SWISS_GROUP_SIZE; ++i)
+		mask |= (uint32_t) (group[i] == c) << i;
+	return mask;
+#endif
+}
+
+/**
+ * Bit i of the result is set if the slot i of the group is empty or deleted.
+ */
+inline uint32_t swiss_group_match_free(const uint8_t* group) {
+#ifdef __SSE2__
+	// the high bit is set only in empty and deleted slots
+	return (uint32_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) group));
+#else
+	uint32_t i, mask = 0;
+	for (i = 0; i < SWISS_GROUP_SIZE; ++i)
+		mask |= (uint32_t) (group[i] >> 7) << i;
+	return mask;
+#endif
+}
+
+/**
+ * Number of slots a table can fill before it is resized.
+ */
+#define SWISS_CAPACITY(size)	((size) - (size) / 8)
+
+SwissHashTable* swiss_hash_table_create(uint32_t size);
+
+/**
+ * Initialize a hash table for the given number of keys.
+ */
+void swiss_hash_table_init(SwissHashTable* hash_table, uint32_t size);
+
+/**
+ * Free the space for the given hash table.
+ */
+int swiss_hash_table_free(SwissHashTable* hash_table);
+
+/**
+ * Free the space for the elements of the given hash table.
+ */
+int swiss_hash_table_reset(SwissHashTable* hash_table);
+
+/**
+ * Returns the number of bytes allocated for the elements of the given hash table.
+ * The space for the hash table itself is not included.
+ */
+size_t swiss_hash_table_memory(SwissHashTable* hash_table);
+
+/**
+ * Re-populate the keys of the given hash table in a table of the given size,
+ * which is a multiple of SWISS_GROUP_SIZE. Deleted slots are dropped.
+ */
+void swiss_hash_table_resize(SwissHashTable* hash_table, uint32_t new_size);
+
+/**
+ * Shrink the allocated space to the smallest size that keeps the load factor
+ * below 7/8. Iterators of the table become invalid.
+ * Returns the number of freed bytes.
+ */
+int swiss_hash_table_shrink(SwissHashTable* hash_table);
+
+/**
+ * Insert the given key into the hash table. The key cannot be NULL.
+ * Returns 1 if the key is inserted, 0 if it already existed.
+ */
+inline char swiss_hash_table_insert(void* key, SwissHashTable* hash_table) {
+	uint64_t hash = SWISS_HASH_POINTER(key);
+	uint32_t group_mask, group, step, match, slot, target = UINT32_MAX;
+	uint8_t h2 = SWISS_H2(hash);
+
+	assert(key != NULL);
+
+	if (hash_table->size != 0) {
+		group_mask = hash_table->size / SWISS_GROUP_SIZE - 1;
+		// triangular probing over the groups visits every group
+		for (group = SWISS_H1(hash) & group_mask, step = 1; step <= group_mask + 1; group = (group + step++) & group_mask) {
+			const uint8_t* ctrl = hash_table->ctrl + group * SWISS_GROUP_SIZE;
+			for (match = swiss_group_match(ctrl, h2); match != 0; match &= match - 1) {
+				slot = group * SWISS_GROUP_SIZE + __builtin_ctz(match);
+				if (hash_table->elements[slot] == key)
+					// the key already exists
+					return 0;
+			}
+			match = swiss_group_match_free(ctrl);
+			if (target == UINT32_MAX && match != 0)
+				// the first free slot on the way, the key goes here unless it is found later
+				target = group * SWISS_GROUP_SIZE + __builtin_ctz(match);
+			if (swiss_group_match(ctrl, SWISS_CTRL_EMPTY) != 0)
+				// an empty slot ends the probe sequence
+				break;
+		}
+	}
+
+	if (target == UINT32_MAX || (hash_table->ctrl[target] == SWISS_CTRL_EMPTY && hash_table->growth_left == 0)) {
+		// no space left. double the size, unless the table is mainly full of deleted slots
+		if (hash_table->size == 0)
+			swiss_hash_table_resize(hash_table, SWISS_GROUP_SIZE);
+		else if (hash_table->element_count * 2 < SWISS_CAPACITY(hash_table->size))
+			swiss_hash_table_resize(hash_table, hash_table->size);
+		else
+			swiss_hash_table_resize(hash_table, 2 * hash_table->size);
+		return swiss_hash_table_insert(key, hash_table);
+	}
+
+	if (hash_table->ctrl[target] == SWISS_CTRL_EMPTY)
+		--hash_table->growth_left;
+	hash_table->ctrl[target] = h2;
+	hash_table->elements[target] = key;
+	++hash_table->element_count;
+
+	return 1;
+}
+
+/**
+ * Check whether the given key exists in the hash table.
+ * Returns 1 if so, 0 otherwise.
+ */
+inline char swiss_hash_table_contains(void* key, SwissHashTable* hash_table) {
+	uint64_t hash = SWISS_HASH_POINTER(key);
+	uint32_t group_mask, group, step, match;
+	uint8_t h2 = SWISS_H2(hash);
+
+	if (hash_table->size == 0)
+		return 0;
+
+	group_mask = hash_table->size / SWISS_GROUP_SIZE - 1;
+	for (group = SWISS_H1(hash) & group_mask, step = 1; step <= group_mask + 1; group = (group + step++) & group_mask) {
+		const uint8_t* ctrl = hash_table->ctrl + group * SWISS_GROUP_SIZE;
+		for (match = swiss_group_match(ctrl, h2); match != 0; match &= match - 1)
+			if (hash_table->elements[group * SWISS_GROUP_SIZE + __builtin_ctz(match)] == key)
+				return 1;
+		if (swiss_group_match(ctrl, SWISS_CTRL_EMPTY) != 0)
+			return 0;
+	}
+	return 0;
+}
+
+/**
+ * Removes the given key from the hash table. Its slot becomes empty if its group
+ * has an empty slot, since then no probe sequence goes past the group. Otherwise
+ * it is marked deleted. The key that has just been returned by an iterator can be
+ * removed during iteration.
+ * Returns 1 if the key is removed, 0 otherwise.
+ */
+inline char swiss_hash_table_remove(void* key, SwissHashTable* hash_table) {
+	uint64_t hash = SWISS_HASH_POINTER(key);
+	uint32_t group_mask, group, step, match, slot;
+	uint8_t h2 = SWISS_H2(hash);
+
+	if (hash_table->size == 0)
+		return 0;
+
+	group_mask = hash_table->size / SWISS_GROUP_SIZE - 1;
+	for (group = SWISS_H1(hash) & group_mask, step = 1; step <= group_mask + 1; group = (group + step++) & group_mask) {
+		uint8_t* ctrl = hash_table->ctrl + group * SWISS_GROUP_SIZE;
+		for (match = swiss_group_match(ctrl, h2); match != 0; match &= match - 1) {
+			slot = group * SWISS_GROUP_SIZE + __builtin_ctz(match);
+			if (hash_table->elements[slot] == key) {
+				if (swiss_group_match(ctrl, SWISS_CTRL_EMPTY) != 0) {
+					hash_table->ctrl[slot] = SWISS_CTRL_EMPTY;
+					++hash_table->growth_left;
+				}
+				else
+					hash_table->ctrl[slot] = SWISS_CTRL_DELETED;
+				--hash_table->element_count;
+				return 1;
+			}
+		}
+		if (swiss_group_match(ctrl, SWISS_CTRL_EMPTY) != 0)
+			return 0;
+	}
+	return 0;
+}
+
+/**
+ * Create an iterator for the given hash table.
+ */
+SwissHashTableIterator* swiss_hash_table_iterator_create(SwissHashTable* hash_table);
+
+/**
+ * Initialize an iterator for the given hash table.
+ */
+inline void swiss_hash_table_iterator_init(SwissHashTableIterator* iterator, SwissHashTable* hash_table) {
+	iterator->hash_table = hash_table;
+	iterator->current_index = 0;
+}
+
+/**
+ * Get the next element.
+ * Returns NULL if there is no next element.
+ */
+inline void* swiss_hash_table_iterator_next(SwissHashTableIterator* iterator) {
+	SwissHashTable* hash_table = iterator->hash_table;
+
+	while (iterator->current_index < hash_table->size) {
+		uint32_t i = iterator->current_index++;
+		if ((hash_table->ctrl[i] & 0x80) == 0)
+			return hash_table->elements[i];
+	}
+	return NULL;
+}
+
+/**
+ * Free the space allocated for a hash table iterator.
+ * Returns the number of freed bytes.
+ */
+int swiss_hash_table_iterator_free(SwissHashTableIterator* iterator);
+
+#endif
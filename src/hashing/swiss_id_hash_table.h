@@ -0,0 +1,239 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SWISS_ID_HASH_TABLE_H_
+#define SWISS_ID_HASH_TABLE_H_
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "swiss_hash_table.h"
+
+/**
+ * A SwissHashTable for storing 32-bit ids, see swiss_hash_table.h.
+ * The id UINT32_MAX cannot be stored, it marks the end of iteration.
+ */
+
+typedef struct swiss_id_hash_table SwissIdHashTable;
+typedef struct swiss_id_hash_table_iterator SwissIdHashTableIterator;
+
+#define SWISS_ID_HASH_TABLE_END		UINT32_MAX
+
+/**
+ * Hash table.
+ */
+struct swiss_id_hash_table {
+	uint8_t* ctrl;				// the control bytes, the keys follow them in the same block
+	uint32_t* elements;			// the slots
+	uint32_t size;				// number of slots, a multiple of SWISS_GROUP_SIZE, 0 if nothing is allocated
+	uint32_t element_count;		// the number of elements
+	uint32_t growth_left;		// number of empty slots that can be filled before resizing
+};
+
+/**
+ * Iterator for hash table.
+ */
+struct swiss_id_hash_table_iterator {
+	SwissIdHashTable* hash_table;
+	uint32_t current_index;		// index of the next slot
+};
+
+SwissIdHashTable* swiss_id_hash_table_create(uint32_t size);
+
+/**
+ * Initialize a hash table for the given number of keys.
+ */
+void swiss_id_hash_table_init(SwissIdHashTable* hash_table, uint32_t size);
+
+/**
+ * Free the space for the given hash table.
+ */
+int swiss_id_hash_table_free(SwissIdHashTable* hash_table);
+
+/**
+ * Free the space for the elements of the given hash table.
+ */
+int swiss_id_hash_table_reset(SwissIdHashTable* hash_table);
+
+/**
+ * Returns the number of bytes allocated for the elements of the given hash table.
+ * The space for the hash table itself is not included.
+ */
+size_t swiss_id_hash_table_memory(SwissIdHashTable* hash_table);
+
+/**
+ * Re-populate the keys of the given hash table in a table of the given size,
+ * which is a multiple of SWISS_GROUP_SIZE. Deleted slots are dropped.
+ */
+void swiss_id_hash_table_resize(SwissIdHashTable* hash_table, uint32_t new_size);
+
+/**
+ * Shrink the allocated space to the smallest size that keeps the load factor
+ * below 7/8. Iterators of the table become invalid.
+ * Returns the number of freed bytes.
+ */
+int swiss_id_hash_table_shrink(SwissIdHashTable* hash_table);
+
+/**
+ * Insert the given id into the hash table. The id cannot be UINT32_MAX.
+ * Returns 1 if the key is inserted, 0 if it already existed.
+ */
+inline char swiss_id_hash_table_insert(uint32_t key, SwissIdHashTable* hash_table) {
+	uint64_t hash = SWISS_HASH_ID(key);
+	uint32_t group_mask, group, step, match, slot, target = UINT32_MAX;
+	uint8_t h2 = SWISS_H2(hash);
+
+	assert(key != SWISS_ID_HASH_TABLE_END);
+
+	if (hash_table->size != 0) {
+		group_mask = hash_table->size / SWISS_GROUP_SIZE - 1;
+		// triangular probing over the groups visits every group
+		for (group = SWISS_H1(hash) & group_mask, step = 1; step <= group_mask + 1; group = (group + step++) & group_mask) {
+			const uint8_t* ctrl = hash_table->ctrl + group * SWISS_GROUP_SIZE;
+			for (match = swiss_group_match(ctrl, h2); match != 0; match &= match - 1) {
+				slot = group * SWISS_GROUP_SIZE + __builtin_ctz(match);
+				if (hash_table->elements[slot] == key)
+					// the key already exists
+					return 0;
+			}
+			match = swiss_group_match_free(ctrl);
+			if (target == UINT32_MAX && match != 0)
+				// the first free slot on the way, the key goes here unless it is found later
+				target = group * SWISS_GROUP_SIZE + __builtin_ctz(match);
+			if (swiss_group_match(ctrl, SWISS_CTRL_EMPTY) != 0)
+				// an empty slot ends the probe sequence
+				break;
+		}
+	}
+
+	if (target == UINT32_MAX || (hash_table->ctrl[target] == SWISS_CTRL_EMPTY && hash_table->growth_left == 0)) {
+		// no space left. double the size, unless the table is mainly full of deleted slots
+		if (hash_table->size == 0)
+			swiss_id_hash_table_resize(hash_table, SWISS_GROUP_SIZE);
+		else if (hash_table->element_count * 2 < SWISS_CAPACITY(hash_table->size))
+			swiss_id_hash_table_resize(hash_table, hash_table->size);
+		else
+			swiss_id_hash_table_resize(hash_table, 2 * hash_table->size);
+		return swiss_id_hash_table_insert(key, hash_table);
+	}
+
+	if (hash_table->ctrl[target] == SWISS_CTRL_EMPTY)
+		--hash_table->growth_left;
+	hash_table->ctrl[target] = h2;
+	hash_table->elements[target] = key;
+	++hash_table->element_count;
+
+	return 1;
+}
+
+/**
+ * Check whether the given key exists in the hash table.
+ * Returns 1 if so, 0 otherwise.
+ */
+inline char swiss_id_hash_table_contains(uint32_t key, SwissIdHashTable* hash_table) {
+	uint64_t hash = SWISS_HASH_ID(key);
+	uint32_t group_mask, group, step, match;
+	uint8_t h2 = SWISS_H2(hash);
+
+	if (hash_table->size == 0)
+		return 0;
+
+	group_mask = hash_table->size / SWISS_GROUP_SIZE - 1;
+	for (group = SWISS_H1(hash) & group_mask, step = 1; step <= group_mask + 1; group = (group + step++) & group_mask) {
+		const uint8_t* ctrl = hash_table->ctrl + group * SWISS_GROUP_SIZE;
+		for (match = swiss_group_match(ctrl, h2); match != 0; match &= match - 1)
+			if (hash_table->elements[group * SWISS_GROUP_SIZE + __builtin_ctz(match)] == key)
+				return 1;
+		if (swiss_group_match(ctrl, SWISS_CTRL_EMPTY) != 0)
+			return 0;
+	}
+	return 0;
+}
+
+/**
+ * Removes the given key from the hash table. Its slot becomes empty if its group
+ * has an empty slot, since then no probe sequence goes past the group. Otherwise
+ * it is marked deleted. The key that has just been returned by an iterator can be
+ * removed during iteration.
+ * Returns 1 if the key is removed, 0 otherwise.
+ */
+inline char swiss_id_hash_table_remove(uint32_t key, SwissIdHashTable* hash_table) {
+	uint64_t hash = SWISS_HASH_ID(key);
+	uint32_t group_mask, group, step, match, slot;
+	uint8_t h2 = SWISS_H2(hash);
+
+	if (hash_table->size == 0)
+		return 0;
+
+	group_mask = hash_table->size / SWISS_GROUP_SIZE - 1;
+	for (group = SWISS_H1(hash) & group_mask, step = 1; step <= group_mask + 1; group = (group + step++) & group_mask) {
+		uint8_t* ctrl = hash_table->ctrl + group * SWISS_GROUP_SIZE;
+		for (match = swiss_group_match(ctrl, h2); match != 0; match &= match - 1) {
+			slot = group * SWISS_GROUP_SIZE + __builtin_ctz(match);
+			if (hash_table->elements[slot] == key) {
+				if (swiss_group_match(ctrl, SWISS_CTRL_EMPTY) != 0) {
+					hash_table->ctrl[slot] = SWISS_CTRL_EMPTY;
+					++hash_table->growth_left;
+				}
+				else
+					hash_table->ctrl[slot] = SWISS_CTRL_DELETED;
+				--hash_table->element_count;
+				return 1;
+			}
+		}
+		if (swiss_group_match(ctrl, SWISS_CTRL_EMPTY) != 0)
+			return 0;
+	}
+	return 0;
+}
+
+/**
+ * Create an iterator for the given hash table.
+ */
+SwissIdHashTableIterator* swiss_id_hash_table_iterator_create(SwissIdHashTable* hash_table);
+
+/**
+ * Initialize an iterator for the given hash table.
+ */
+inline void swiss_id_hash_table_iterator_init(SwissIdHashTableIterator* iterator, SwissIdHashTable* hash_table) {
+	iterator->hash_table = hash_table;
+	iterator->current_index = 0;
+}
+
+/**
+ * Get the next id.
+ * Returns SWISS_ID_HASH_TABLE_END if there is no next id.
+ */
+inline uint32_t swiss_id_hash_table_iterator_next(SwissIdHashTableIterator* iterator) {
+	SwissIdHashTable* hash_table = iterator->hash_table;
+
+	while (iterator->current_index < hash_table->size) {
+		uint32_t i = iterator->current_index++;
+		if ((hash_table->ctrl[i] & 0x80) == 0)
+			return hash_table->elements[i];
+	}
+	return SWISS_ID_HASH_TABLE_END;
+}
+
+/**
+ * Free the space allocated for a hash table iterator.
+ * Returns the number of freed bytes.
+ */
+int swiss_id_hash_table_iterator_free(SwissIdHashTableIterator* iterator);
+
+#endif
@@ -31,6 +31,8 @@
  */
 extern inline uint32_t roundup_pow2(uint32_t value);
 
+extern inline uint64_t hash_fmix64(uint64_t key);
+
 /*
  * The Jenkins hash algorithm. Originally 32-bit, modified here to 64-bit.
  * Switched to the Murmur3 algorithm due to collisions in class names in large
@@ -16,18 +16,71 @@
  * limitations under the License.
  */
 
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
 #include <stdint.h>
 
+#include <string.h>
+
 #include "murmur3.h"
+#include "wyhash.h"
 
 #ifndef HASHING_UTILS_H_
 #define HASHING_UTILS_H_
 
+/**
+ * Mixers for pointer and 64-bit integer keys. Tables compute the slot by masking
+ * the low bits of the hash value, so keys whose low bits follow a pattern (malloc'd
+ * structs of the same size, packed 32-bit ids) cluster unless they are mixed first.
+ * The mixer is selected at build time, see --with-hash-mixer in configure.ac.
+ *
+ * Without mixing, a set of pointers is only fast as long as the objects happen
+ * to be spread evenly over the low bits of their addresses. Another allocation
+ * pattern before or while the KB is loaded can make the axiom sets probe long
+ * runs of occupied slots. Fibonacci hashing spreads any stride evenly at the
+ * cost of one multiplication.
+ */
+#define HASH_MIXER_IDENTITY			0	// no mixing
+#define HASH_MIXER_FIBONACCI		1	// multiply with 2^64 / golden ratio, take the high 32 bits
+#define HASH_MIXER_MURMUR			2	// the 64-bit finalizer of Murmur3
+
+#ifndef HASH_MIXER
+#define HASH_MIXER					HASH_MIXER_FIBONACCI
+#endif
+
+/**
+ * The Murmur3 64-bit finalizer.
+ */
+inline uint64_t hash_fmix64(uint64_t key) {
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ULL;
+	key ^= key >> 33;
+
+	return key;
+}
+
+#if HASH_MIXER == HASH_MIXER_FIBONACCI
+#define HASH_MIX64(key)				((((uint64_t) (key)) * 0x9E3779B97F4A7C15ULL) >> 32)
+#elif HASH_MIXER == HASH_MIXER_MURMUR
+#define HASH_MIX64(key)				hash_fmix64((uint64_t) (key))
+#else
+#define HASH_MIX64(key)				((uint64_t) (key))
+#endif
+
 /**
  * Hash function for hashing a pointer.
- * TODO: improve and check 32-bit/64-bit differences
+ * The low 3 bits are dropped since they are always 0 for malloc'd memory.
  */
-#define HASH_POINTER(key)			((size_t) key) >> 3	// for 64 bit
+#define HASH_POINTER(key)			HASH_MIX64(((size_t) (key)) >> 3)
+
+/**
+ * Hash function for the 64-bit integer keys of maps.
+ */
+#define HASH_UINT64(key)			HASH_MIX64(key)
 
 /**
  * Simple hash function for hashing an unsigned integer.
@@ -55,9 +108,16 @@ inline uint32_t roundup_pow2(uint32_t value) {
 }
 
 /**
- * Hash a string into a 64-bit unsigned int using the Murmur3 algorithm.
- * 42 is the seed.
+ * Hash a string into a 64-bit unsigned int. Used to be the first 64 bits of
+ * the 128-bit Murmur3 hash, wyhash is about twice as fast on IRIs, see
+ * test_hash_string. 42 is the seed.
+ */
+#define HASH_STRING(key)			wyhash(key, strlen(key), 42)
+
+/**
+ * Same as HASH_STRING, for strings whose length is already known,
+ * like the tokens from the lexer. The string need not be '\0' terminated.
  */
-#define HASH_STRING(key)			MurmurHash3_x64_128(key, strlen(key), 42)
+#define HASH_STRING_LENGTH(key, length)	wyhash(key, length, 42)
 
 #endif
@@ -0,0 +1,17 @@
+//-----------------------------------------------------------------------------
+// Based on wyhash (final version 4) by Wang Yi, https://github.com/wangyi-fudan/wyhash
+// The original is released into the public domain (The Unlicense).
+
+#include "wyhash.h"
+
+extern inline void wyhash_mum(uint64_t* A, uint64_t* B);
+
+extern inline uint64_t wyhash_mix(uint64_t A, uint64_t B);
+
+extern inline uint64_t wyhash_r8(const uint8_t* p);
+
+extern inline uint64_t wyhash_r4(const uint8_t* p);
+
+extern inline uint64_t wyhash_r3(const uint8_t* p, size_t k);
+
+extern inline uint64_t wyhash(const void* key, size_t len, uint64_t seed);
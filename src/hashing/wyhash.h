@@ -0,0 +1,112 @@
+//-----------------------------------------------------------------------------
+// Based on wyhash (final version 4) by Wang Yi, https://github.com/wangyi-fudan/wyhash
+// The original is released into the public domain (The Unlicense).
+// Reduced to the 64-bit hash with the default secret, without the
+// platform specific variants.
+
+#ifndef _WYHASH_H_
+#define _WYHASH_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+
+// 128-bit product of A and B, the low 64 bits in A, the high 64 bits in B
+inline void wyhash_mum(uint64_t* A, uint64_t* B) {
+#ifdef __SIZEOF_INT128__
+	__uint128_t r = *A;
+	r *= *B;
+	*A = (uint64_t) r;
+	*B = (uint64_t) (r >> 64);
+#else
+	uint64_t ha = *A >> 32, hb = *B >> 32, la = (uint32_t) *A, lb = (uint32_t) *B, hi, lo;
+	uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32), c = t < rl;
+	lo = t + (rm1 << 32);
+	c += lo < t;
+	hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+	*A = lo;
+	*B = hi;
+#endif
+}
+
+inline uint64_t wyhash_mix(uint64_t A, uint64_t B) {
+	wyhash_mum(&A, &B);
+	return A ^ B;
+}
+
+// unaligned little endian reads
+inline uint64_t wyhash_r8(const uint8_t* p) {
+	uint64_t v;
+	memcpy(&v, p, 8);
+	return v;
+}
+
+inline uint64_t wyhash_r4(const uint8_t* p) {
+	uint32_t v;
+	memcpy(&v, p, 4);
+	return v;
+}
+
+// reads 1 to 3 bytes
+inline uint64_t wyhash_r3(const uint8_t* p, size_t k) {
+	return (((uint64_t) p[0]) << 16) | (((uint64_t) p[k >> 1]) << 8) | p[k - 1];
+}
+
+#define WYHASH_SECRET0	0x2d358dccaa6c78a5ULL
+#define WYHASH_SECRET1	0x8bb84b93962eacc9ULL
+#define WYHASH_SECRET2	0x4b33a62ed433d4a3ULL
+#define WYHASH_SECRET3	0x4d5a2da51de1aa47ULL
+
+/**
+ * 64-bit hash of len bytes starting at key. The bulk loop consumes 48 bytes per
+ * iteration in three independent multiply chains, keys of at most 16 bytes are
+ * hashed without a loop.
+ */
+inline uint64_t wyhash(const void* key, size_t len, uint64_t seed) {
+	const uint8_t* p = (const uint8_t*) key;
+	uint64_t a, b;
+
+	seed ^= wyhash_mix(seed ^ WYHASH_SECRET0, WYHASH_SECRET1);
+	if (len <= 16) {
+		if (len >= 4) {
+			a = (wyhash_r4(p) << 32) | wyhash_r4(p + ((len >> 3) << 2));
+			b = (wyhash_r4(p + len - 4) << 32) | wyhash_r4(p + len - 4 - ((len >> 3) << 2));
+		} else if (len > 0) {
+			a = wyhash_r3(p, len);
+			b = 0;
+		} else
+			a = b = 0;
+	} else {
+		size_t i = len;
+		if (i > 48) {
+			uint64_t see1 = seed, see2 = seed;
+			do {
+				seed = wyhash_mix(wyhash_r8(p) ^ WYHASH_SECRET1, wyhash_r8(p + 8) ^ seed);
+				see1 = wyhash_mix(wyhash_r8(p + 16) ^ WYHASH_SECRET2, wyhash_r8(p + 24) ^ see1);
+				see2 = wyhash_mix(wyhash_r8(p + 32) ^ WYHASH_SECRET3, wyhash_r8(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while (i > 48);
+			seed ^= see1 ^ see2;
+		}
+		while (i > 16) {
+			seed = wyhash_mix(wyhash_r8(p) ^ WYHASH_SECRET1, wyhash_r8(p + 8) ^ seed);
+			i -= 16;
+			p += 16;
+		}
+		// the last 16 bytes, they may overlap with the ones already consumed
+		a = wyhash_r8(p + i - 16);
+		b = wyhash_r8(p + i - 8);
+	}
+	a ^= WYHASH_SECRET1;
+	b ^= seed;
+	wyhash_mum(&a, &b);
+
+	return wyhash_mix(a ^ WYHASH_SECRET0 ^ len, b ^ WYHASH_SECRET1);
+}
+
+//-----------------------------------------------------------------------------
+
+#endif // _WYHASH_H_
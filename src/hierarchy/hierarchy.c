@@ -34,30 +34,35 @@ void compute_concept_hierarchy(KB* kb) {
 
 	MapIterator map_it;
 	SetIterator direct_subsumers_iterator;
-	SetIterator subsumers_iterator;
+	IdSetIterator subsumers_iterator;
 
 	// Add the top class to the subsumers of every atomic concept.
-	// Whether top is a direct subsumer or not will be computed below
+	// Whether top is a direct subsumer or not will be computed below.
+	// Create the sets for the equivalent classes and the direct subsumers.
+	// They are allocated after saturation, i.e., they do not come between
+	// the class expressions in the arena.
+	ClassHierarchy* hierarchy;
 	MAP_ITERATOR_INIT(&map_it, &(kb->tbox->classes));
 	void* atomic_concept = MAP_ITERATOR_NEXT(&map_it);
 	while (atomic_concept) {
-		// Initialize the set of direct subsumers. It is not initialized during creation of the classes in model.c
-		SET_INIT(&(((ClassExpression*) atomic_concept)->description.atomic.direct_subsumers), DEFAULT_DIRECT_SUBSUMERS_SET_SIZE);
-		// Initialize the set of equivalent classes. It is not initialized during creation of the classes in model.c
-		SET_INIT(&(((ClassExpression*) atomic_concept)->description.atomic.equivalent_classes), DEFAULT_EQUIVALENT_CONCEPTS_SET_SIZE);
-		SET_ADD(kb->tbox->top_concept, &(((ClassExpression*) atomic_concept)->subsumers));
+		ID_SET_ADD(kb->tbox->top_concept->id, &(((ClassExpression*) atomic_concept)->subsumers));
+		hierarchy = (ClassHierarchy*) arena_allocate(kb->tbox->expressions, sizeof(ClassHierarchy));
+		SET_INIT(&(hierarchy->equivalent_classes), DEFAULT_EQUIVALENT_CONCEPTS_SET_SIZE);
+		SET_INIT(&(hierarchy->direct_subsumers), DEFAULT_DIRECT_SUBSUMERS_SET_SIZE);
+		((ClassExpression*) atomic_concept)->description.atomic.hierarchy = hierarchy;
 		atomic_concept = MAP_ITERATOR_NEXT(&map_it);
 	}
 
 	MAP_ITERATOR_INIT(&map_it, &(kb->tbox->classes));
 	atomic_concept = MAP_ITERATOR_NEXT(&map_it);
 	while (atomic_concept) {
-		SET_ITERATOR_INIT(&subsumers_iterator, &(((ClassExpression*) atomic_concept)->subsumers));
-		ClassExpression* subsumer = (ClassExpression*) SET_ITERATOR_NEXT(&subsumers_iterator);
-		while (subsumer != NULL) {
+		ID_SET_ITERATOR_INIT(&subsumers_iterator, &(((ClassExpression*) atomic_concept)->subsumers));
+		uint32_t subsumer_id = ID_SET_ITERATOR_NEXT(&subsumers_iterator);
+		while (subsumer_id != ID_SET_ITERATOR_END) {
+			ClassExpression* subsumer = GET_CLASS_EXPRESSION(subsumer_id, kb->tbox);
 
 			if (subsumer->type != CLASS_TYPE) {
-				subsumer = (ClassExpression*) SET_ITERATOR_NEXT(&subsumers_iterator);
+				subsumer_id = ID_SET_ITERATOR_NEXT(&subsumers_iterator);
 				continue;
 			}
 			// check if tbox->atomic_concept_list[i] is a subsumer of the 'subsumer'
@@ -68,7 +73,7 @@ void compute_concept_hierarchy(KB* kb) {
 			}
 			else {
 				is_direct_subsumer = 1;
-				SET_ITERATOR_INIT(&direct_subsumers_iterator,  &(((ClassExpression*) atomic_concept)->description.atomic.direct_subsumers));
+				SET_ITERATOR_INIT(&direct_subsumers_iterator,  &(((ClassExpression*) atomic_concept)->description.atomic.hierarchy->direct_subsumers));
 				void* direct_subsumer = SET_ITERATOR_NEXT(&direct_subsumers_iterator);
 
 				while (direct_subsumer != NULL) {
@@ -81,7 +86,7 @@ void compute_concept_hierarchy(KB* kb) {
 					// now check if the 'direct_subsumer' is a subsumer of the 'subsumer'
 					// if yes, then the 'direct_subsumer' is not a direct subsumer of tbox->atomic_concept_list[i]
 					// remove it from the list of direct subsumers
-					if (IS_SUBSUMED_BY(subsumer, direct_subsumer))
+					if (IS_SUBSUMED_BY(subsumer, ((ClassExpression*) direct_subsumer)))
 						REMOVE_DIRECT_SUBSUMER(direct_subsumer, ((ClassExpression*) atomic_concept));
 
 					direct_subsumer = SET_ITERATOR_NEXT(&direct_subsumers_iterator);
@@ -90,8 +95,10 @@ void compute_concept_hierarchy(KB* kb) {
 				if (is_direct_subsumer)
 					ADD_DIRECT_SUBSUMER(subsumer, ((ClassExpression*) atomic_concept));
 			}
-			subsumer = (ClassExpression*) SET_ITERATOR_NEXT(&subsumers_iterator);
+			subsumer_id = ID_SET_ITERATOR_NEXT(&subsumers_iterator);
 		}
+		// give back the space of the removed direct subsumers
+		SET_SHRINK(&(((ClassExpression*) atomic_concept)->description.atomic.hierarchy->direct_subsumers));
 		atomic_concept = MAP_ITERATOR_NEXT(&map_it);
 	}
 
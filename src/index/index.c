@@ -19,14 +19,38 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
 #include "../model/datatypes.h"
 #include "../model/utils.h"
 #include "utils.h"
+#include "renumbering.h"
 
 
-void index_class_expression(ClassExpression* c, KB* kb) {
+// marks for the class expressions that have already been indexed, one bit per id.
+// the marks grow with the ids, since the told axioms can be indexed while the
+// class expressions are still being created, see pipeline.c
+static inline char is_indexed(ClassExpression* c, KB* kb) {
+	return (c->id >> 5) < kb->indexed_size && (kb->indexed[c->id >> 5] & (1U << (c->id & 31)));
+}
+
+static inline void mark_indexed(ClassExpression* c, KB* kb) {
+	uint32_t size;
+
+	if ((c->id >> 5) >= kb->indexed_size) {
+		size = 2 * kb->indexed_size;
+		if (size <= (c->id >> 5))
+			size = (c->id >> 5) + 1;
+		kb->indexed = realloc(kb->indexed, size * sizeof(uint32_t));
+		assert(kb->indexed != NULL);
+		memset(kb->indexed + kb->indexed_size, 0, (size - kb->indexed_size) * sizeof(uint32_t));
+		kb->indexed_size = size;
+	}
+	kb->indexed[c->id >> 5] |= 1U << (c->id & 31);
+}
+
+static void index_class_expression(ClassExpression* c, KB* kb) {
 
 	switch (c->type) {
 	case CLASS_TYPE:
@@ -39,12 +63,20 @@ void index_class_expression(ClassExpression* c, KB* kb) {
 	case OBJECT_ONE_OF_TYPE:
 		break;
 	case OBJECT_INTERSECTION_OF_TYPE:
+		// a conjunction can occur in many axioms, it is indexed only once.
+		// this also keeps the conjunct lists free of duplicates.
+		if (is_indexed(c, kb))
+			break;
+		mark_indexed(c, kb);
 		index_class_expression(c->description.conj.conjunct1, kb);
 		index_class_expression(c->description.conj.conjunct2, kb);
 		add_to_first_conjunct_of_list(c->description.conj.conjunct1, c);
 		add_to_second_conjunct_of_list(c->description.conj.conjunct2, c);
 		break;
 	case OBJECT_SOME_VALUES_FROM_TYPE:
+		if (is_indexed(c, kb))
+			break;
+		mark_indexed(c, kb);
 		// add_to_filler_of_list(c->description.exists->filler, c);
 		add_to_negative_exists(c);
 		index_class_expression(c->description.exists.filler, kb);
@@ -59,7 +91,7 @@ void index_class_expression(ClassExpression* c, KB* kb) {
  * Recursively checks if bottom is a given class expression contains bottom as a subexpression.
  * Returns 1 if this is the case, 0 otherwise
  */
-char class_expression_contains_bottom(ClassExpression* c, TBox* tbox)  {
+static char class_expression_contains_bottom(ClassExpression* c, TBox* tbox)  {
 	switch (c->type) {
 	case CLASS_TYPE:
 		if (c == tbox->bottom_concept) {
@@ -108,96 +140,98 @@ void index_role(ObjectPropertyExpression* r) {
 }
 
 
+char index_subclass_axiom(SubClassOfAxiom* ax, KB* kb) {
+	// Check if bottom appears on the rhs. Needed for determining inconsistency already during indexing.
+	if (ax->rhs == kb->tbox->bottom_concept) {
+		// if the top concept or a nominal is subsumed by bottom, the ontology is inconsistent
+		if (ax->lhs->type == OBJECT_ONE_OF_TYPE || ax->lhs == kb->tbox->top_concept)
+			return -1;
+	}
+
+	// no need to add told subsumers of bottom
+	// no need to index the bottom concept
+	if (ax->lhs == kb->tbox->bottom_concept)
+		return 0;
+	// no need to add top as a told subsumer
+	if (ax->rhs == kb->tbox->top_concept) {
+		// still index the lhs, but do not add top to the subsumers of lhs
+		index_class_expression(ax->lhs, kb);
+		return 0;
+	}
+	ADD_TOLD_SUBSUMER_CLASS_EXPRESSION(ax->rhs, ax->lhs);
+	index_class_expression(ax->lhs, kb);
+	if (class_expression_contains_bottom(ax->rhs, kb->tbox))
+		kb->bottom_occurs_on_rhs = 1;
+
+	return 0;
+}
+
+void index_subrole_axiom(SubObjectPropertyOfAxiom* ax) {
+	ADD_TOLD_SUBSUMER_OBJECT_PROPERTY_EXPRESSION(ax->rhs, ax->lhs);
+	index_role(ax->lhs);
+}
+
 /*
  * Index a given ontology: Collect information about told subsumer, negative occurrence of exists restrictions,
- * and conjuncts of the conjunctions.
+ * and conjuncts of the conjunctions. The told axioms are skipped if they have already been indexed
+ * while parsing.
  * Returns:
- * 	-1: if the reasoning task is consistency check, and an atomic concept or the top concept is
- * 	subsumed by bottom. In this case it immediately returns, i.e., the rest of the KB is not indexed!
+ * 	-1: if an atomic concept or the top concept is subsumed by bottom. In this case it immediately
+ * 	returns, i.e., the rest of the KB is not indexed!
  * 	1: if the reasoning task is consistency check, and bottom does not appear on the rhs of any axiom.
  * 	The KB cannot be inconsistent in this case.
  * 	0: if none of the above holds. (In this case, we need to saturate the ontology for checking consistency)
  */
-char index_tbox(KB* kb, ReasoningTask reasoning_task) {
-
+static char index_tbox(KB* kb, ReasoningTask reasoning_task) {
+	char result = 0;
 	int i;
-	SetIterator iterator;
-	SET_ITERATOR_INIT(&iterator, &(kb->tbox->subclass_of_axioms));
-	SubClassOfAxiom* subclass_ax = (SubClassOfAxiom*) SET_ITERATOR_NEXT(&iterator);
-	while (subclass_ax) {
-		// Check if bottom appears on the rhs. Needed for determining inconsistency already during indexing.
-		if (subclass_ax->rhs == kb->tbox->bottom_concept) {
-			// if the top concept or a nominal is subsumed by bottom, the ontology is inconsistent
-			if (subclass_ax->lhs->type == OBJECT_ONE_OF_TYPE || subclass_ax->lhs == kb->tbox->top_concept)
-				// return inconsistent immediately
-				return -1;
-		}
 
-		// no need to add told subsumers of bottom
-		// no need to index the bottom concept
-		if (subclass_ax->lhs == kb->tbox->bottom_concept) {
-			subclass_ax = (SubClassOfAxiom*) SET_ITERATOR_NEXT(&iterator);
-			continue;
-		}
-		// no need to add top as a told subsumer
-		if (subclass_ax->rhs == kb->tbox->top_concept) {
-			// still index the lhs, but do not add top to the subsumers of lhs
-			index_class_expression(subclass_ax->lhs, kb);
-			subclass_ax = (SubClassOfAxiom*) SET_ITERATOR_NEXT(&iterator);
-			continue;
-		}
-		ADD_TOLD_SUBSUMER_CLASS_EXPRESSION(subclass_ax->rhs, subclass_ax->lhs);
-		index_class_expression(subclass_ax->lhs, kb);
-		if (class_expression_contains_bottom(subclass_ax->rhs, kb->tbox) && subclass_ax->lhs != kb->tbox->bottom_concept)
-			kb->bottom_occurs_on_rhs = 1;
-		subclass_ax = (SubClassOfAxiom*) SET_ITERATOR_NEXT(&iterator);
+	// the told axioms have been indexed while parsing, and one of them
+	// made the KB inconsistent
+	if (kb->told_axioms_indexed && kb->inconsistent)
+		result = -1;
+
+	// the marks for the class expressions that exist now
+	if (kb->indexed == NULL) {
+		kb->indexed_size = (kb->tbox->next_class_expression_id + 31) / 32 + 1;
+		kb->indexed = (uint32_t*) calloc(kb->indexed_size, sizeof(uint32_t));
+		assert(kb->indexed != NULL);
+	}
+
+	SetIterator iterator;
+	SubClassOfAxiom* subclass_ax;
+	if (!kb->told_axioms_indexed) {
+		SET_ITERATOR_INIT(&iterator, &(kb->tbox->subclass_of_axioms));
+		while (result == 0 && (subclass_ax = (SubClassOfAxiom*) SET_ITERATOR_NEXT(&iterator)) != NULL)
+			result = index_subclass_axiom(subclass_ax, kb);
 	}
 
 	// Now index the subclass axioms generated during preprocessing
-	for (i = 0; i < kb->generated_subclass_axiom_count; ++i) {
-
-		// Check if bottom appears on the rhs. Needed for consistency
-		if (kb->generated_subclass_axioms[i]->rhs == kb->tbox->bottom_concept)  {
-			// if the top concept or a nominal is subsumed by bottom, the kb is inconsistent
-			if (kb->generated_subclass_axioms[i]->lhs->type == OBJECT_ONE_OF_TYPE || kb->generated_subclass_axioms[i]->lhs == kb->tbox->top_concept)
-				// return inconsistent immediately
-				return -1;
-		}
+	for (i = 0; result == 0 && i < kb->generated_subclass_axiom_count; ++i)
+		result = index_subclass_axiom(kb->generated_subclass_axioms[i], kb);
 
-		// no need to add told subsumers of bottom
-		// no need to index the bottom concept
-		if (kb->generated_subclass_axioms[i]->lhs == kb->tbox->bottom_concept)
-			continue;
-		// no need to add top as a told subsumer
-		if (kb->generated_subclass_axioms[i]->rhs == kb->tbox->top_concept) {
-			// still index the lhs, but do not add top to the lhs of rhs
-			index_class_expression(kb->generated_subclass_axioms[i]->lhs, kb);
-			continue;
-		}
-		ADD_TOLD_SUBSUMER_CLASS_EXPRESSION(kb->generated_subclass_axioms[i]->rhs, kb->generated_subclass_axioms[i]->lhs);
-		index_class_expression(kb->generated_subclass_axioms[i]->lhs, kb);
-		if (class_expression_contains_bottom(kb->generated_subclass_axioms[i]->rhs, kb->tbox) && kb->generated_subclass_axioms[i]->lhs != kb->tbox->bottom_concept)
-			kb->bottom_occurs_on_rhs = 1;
-	}
+	free(kb->indexed);
+	kb->indexed = NULL;
+	kb->indexed_size = 0;
+	// return inconsistent immediately
+	if (result == -1)
+		return -1;
 
 	// If bottom does not appear on the rhs, the KB cannot be inconcsistent, i.e., it is consistent
 	if (reasoning_task == CONSISTENCY && kb->bottom_occurs_on_rhs == 0)
 		return 1;
 
 	// Index subobjectpropertyof axioms
-	SET_ITERATOR_INIT(&iterator, &(kb->tbox->subobjectproperty_of_axioms));
-	SubObjectPropertyOfAxiom* subrole_ax = (SubObjectPropertyOfAxiom*) SET_ITERATOR_NEXT(&iterator);
-	while (subrole_ax) {
-		ADD_TOLD_SUBSUMER_OBJECT_PROPERTY_EXPRESSION(subrole_ax->rhs, subrole_ax->lhs);
-		index_role(subrole_ax->lhs);
-		subrole_ax = (SubObjectPropertyOfAxiom*) SET_ITERATOR_NEXT(&iterator);
+	SubObjectPropertyOfAxiom* subrole_ax;
+	if (!kb->told_axioms_indexed) {
+		SET_ITERATOR_INIT(&iterator, &(kb->tbox->subobjectproperty_of_axioms));
+		while ((subrole_ax = (SubObjectPropertyOfAxiom*) SET_ITERATOR_NEXT(&iterator)) != NULL)
+			index_subrole_axiom(subrole_ax);
 	}
 
 	// Index generated subrole axioms
-	for (i = 0; i < kb->generated_subrole_axiom_count; ++i) {
-		ADD_TOLD_SUBSUMER_OBJECT_PROPERTY_EXPRESSION(kb->generated_subrole_axioms[i]->rhs, kb->generated_subrole_axioms[i]->lhs);
-		index_role(kb->generated_subrole_axioms[i]->lhs);
-	}
+	for (i = 0; i < kb->generated_subrole_axiom_count; ++i)
+		index_subrole_axiom(kb->generated_subrole_axioms[i]);
 
 	return 0;
 }
@@ -218,5 +252,14 @@ void index_abox(ABox* abox) {
 }
 
 char index_kb(KB* kb, ReasoningTask reasoning_task) {
-	return index_tbox(kb, reasoning_task);
+	char result = index_tbox(kb, reasoning_task);
+
+#ifdef RENUMBER_CLASS_EXPRESSIONS
+	// the KB is saturated only in this case, lay out the class
+	// expressions in the order the saturation uses them
+	if (result == 0)
+		renumber_class_expressions(kb);
+#endif
+
+	return result;
 }
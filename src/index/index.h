@@ -36,6 +36,18 @@
 
 void index_role(ObjectPropertyExpression* r);
 
+/*
+ * Index a told or a generated subclass axiom: add the told subsumer and
+ * index the lhs.
+ * Returns -1 if the top concept or a nominal is subsumed by bottom, 0 otherwise.
+ */
+char index_subclass_axiom(SubClassOfAxiom* ax, KB* kb);
+
+/*
+ * Index a told or a generated subrole axiom.
+ */
+void index_subrole_axiom(SubObjectPropertyOfAxiom* ax);
+
 // void index_abox(ABox* abox);
 
 char index_kb(KB* kb, ReasoningTask reasoning_task);
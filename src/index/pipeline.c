@@ -0,0 +1,182 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+#include "../model/datatypes.h"
+#include "index.h"
+#include "pipeline.h"
+
+// number of axioms in the queue, a power of 2
+#define QUEUE_SIZE			(1 << 16)
+// the parser hands the axioms over to the indexing thread in batches of this size
+#define BATCH_SIZE			1024
+
+#define SUBCLASS_AXIOM		0
+#define SUBROLE_AXIOM		1
+
+typedef struct {
+	void* axiom;
+	char type;
+} QueuedAxiom;
+
+struct index_pipeline {
+	KB* kb;
+	// the indexing stops at the first axiom that makes the KB inconsistent
+	char result;
+
+#ifdef HAVE_PTHREAD_H
+	// the queue. the counters only grow, the axioms are at the counters modulo
+	// QUEUE_SIZE. the parser writes at tail without locking, the axioms up to
+	// published are visible to the indexing thread.
+	QueuedAxiom* axioms;
+	uint32_t head;			// the next axiom to be indexed
+	uint32_t published;
+	uint32_t tail;			// the next free slot
+	char done;				// the parser has added the last axiom
+
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t added;	// new axioms have been published
+	pthread_cond_t removed;	// axioms have been indexed
+#endif
+};
+
+static void index_axiom(IndexPipeline* pipeline, void* axiom, char type) {
+	if (type == SUBROLE_AXIOM)
+		index_subrole_axiom((SubObjectPropertyOfAxiom*) axiom);
+	else if (pipeline->result == 0)
+		pipeline->result = index_subclass_axiom((SubClassOfAxiom*) axiom, pipeline->kb);
+}
+
+#ifdef HAVE_PTHREAD_H
+static void* index_axioms(void* arg) {
+	IndexPipeline* pipeline = (IndexPipeline*) arg;
+	QueuedAxiom* queued;
+	uint32_t i, end;
+
+	pthread_mutex_lock(&(pipeline->lock));
+	for (;;) {
+		while (pipeline->head == pipeline->published && !pipeline->done)
+			pthread_cond_wait(&(pipeline->added), &(pipeline->lock));
+		if (pipeline->head == pipeline->published)
+			break;
+		end = pipeline->published;
+		pthread_mutex_unlock(&(pipeline->lock));
+
+		for (i = pipeline->head; i != end; ++i) {
+			queued = &(pipeline->axioms[i & (QUEUE_SIZE - 1)]);
+			index_axiom(pipeline, queued->axiom, queued->type);
+		}
+
+		pthread_mutex_lock(&(pipeline->lock));
+		pipeline->head = end;
+		pthread_cond_signal(&(pipeline->removed));
+	}
+	pthread_mutex_unlock(&(pipeline->lock));
+
+	return NULL;
+}
+
+// make the added axioms visible to the indexing thread, and wait until
+// there is space for the next batch
+static void publish(IndexPipeline* pipeline) {
+	pthread_mutex_lock(&(pipeline->lock));
+	pipeline->published = pipeline->tail;
+	pthread_cond_signal(&(pipeline->added));
+	while (pipeline->tail - pipeline->head > QUEUE_SIZE - BATCH_SIZE)
+		pthread_cond_wait(&(pipeline->removed), &(pipeline->lock));
+	pthread_mutex_unlock(&(pipeline->lock));
+}
+#endif
+
+static void add_axiom(IndexPipeline* pipeline, void* axiom, char type) {
+#ifdef HAVE_PTHREAD_H
+	QueuedAxiom* queued = &(pipeline->axioms[pipeline->tail & (QUEUE_SIZE - 1)]);
+
+	queued->axiom = axiom;
+	queued->type = type;
+	++pipeline->tail;
+	if ((pipeline->tail & (BATCH_SIZE - 1)) == 0)
+		publish(pipeline);
+#else
+	index_axiom(pipeline, axiom, type);
+#endif
+}
+
+IndexPipeline* index_pipeline_create(KB* kb) {
+	IndexPipeline* pipeline = (IndexPipeline*) malloc(sizeof(IndexPipeline));
+	assert(pipeline != NULL);
+
+	pipeline->kb = kb;
+	pipeline->result = 0;
+
+#ifdef HAVE_PTHREAD_H
+	int result;
+
+	pipeline->axioms = (QueuedAxiom*) malloc(QUEUE_SIZE * sizeof(QueuedAxiom));
+	assert(pipeline->axioms != NULL);
+	pipeline->head = 0;
+	pipeline->published = 0;
+	pipeline->tail = 0;
+	pipeline->done = 0;
+	pthread_mutex_init(&(pipeline->lock), NULL);
+	pthread_cond_init(&(pipeline->added), NULL);
+	pthread_cond_init(&(pipeline->removed), NULL);
+	result = pthread_create(&(pipeline->thread), NULL, index_axioms, pipeline);
+	assert(result == 0);
+#endif
+
+	return pipeline;
+}
+
+void index_pipeline_add_subclass_axiom(IndexPipeline* pipeline, SubClassOfAxiom* ax) {
+	add_axiom(pipeline, ax, SUBCLASS_AXIOM);
+}
+
+void index_pipeline_add_subrole_axiom(IndexPipeline* pipeline, SubObjectPropertyOfAxiom* ax) {
+	add_axiom(pipeline, ax, SUBROLE_AXIOM);
+}
+
+void index_pipeline_free(IndexPipeline* pipeline) {
+#ifdef HAVE_PTHREAD_H
+	pthread_mutex_lock(&(pipeline->lock));
+	pipeline->published = pipeline->tail;
+	pipeline->done = 1;
+	pthread_cond_signal(&(pipeline->added));
+	pthread_mutex_unlock(&(pipeline->lock));
+	pthread_join(pipeline->thread, NULL);
+
+	pthread_mutex_destroy(&(pipeline->lock));
+	pthread_cond_destroy(&(pipeline->added));
+	pthread_cond_destroy(&(pipeline->removed));
+	free(pipeline->axioms);
+#endif
+
+	pipeline->kb->told_axioms_indexed = 1;
+	if (pipeline->result == -1)
+		pipeline->kb->inconsistent = 1;
+	free(pipeline);
+}
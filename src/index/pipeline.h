@@ -0,0 +1,57 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PIPELINE_H_
+#define PIPELINE_H_
+
+#include "../model/datatypes.h"
+
+/**
+ * Indexing of the told axioms while the ontology is parsed. The parser
+ * passes the SubClassOf and SubObjectPropertyOf axioms through a bounded
+ * queue to an indexing thread, which adds the told subsumers, the conjunct
+ * lists and the negative existentials as the axioms arrive. index_kb then
+ * only indexes the axioms generated in preprocessing.
+ *
+ * The indexing thread only writes the index fields of the class and object
+ * property expressions, which the parser does not touch after it has
+ * created them. Without threads the axioms are indexed as they are added.
+ */
+typedef struct index_pipeline IndexPipeline;
+
+/**
+ * Start indexing the told axioms of the given KB.
+ * Returns the pipeline created.
+ */
+IndexPipeline* index_pipeline_create(KB* kb);
+
+/**
+ * Add a parsed axiom to the queue of the indexing thread. The parser waits
+ * if the queue is full.
+ */
+void index_pipeline_add_subclass_axiom(IndexPipeline* pipeline, SubClassOfAxiom* ax);
+void index_pipeline_add_subrole_axiom(IndexPipeline* pipeline, SubObjectPropertyOfAxiom* ax);
+
+/**
+ * Wait until the queued axioms are indexed and free the pipeline. The KB is
+ * marked as inconsistent if the top concept or a nominal is subsumed by
+ * bottom in a told axiom.
+ */
+void index_pipeline_free(IndexPipeline* pipeline);
+
+#endif /* PIPELINE_H_ */
@@ -0,0 +1,276 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#include "../model/datatypes.h"
+#include "../model/utils.h"
+#include "../hashing/string_pool.h"
+#include "../utils/arena.h"
+#include "../utils/list.h"
+#include "../utils/map.h"
+#include "renumbering.h"
+
+// the new array of class expressions starts at a cache line
+#define CACHE_LINE_SIZE				64
+
+// marks for the class expressions that have already been visited, one bit per id
+#define IS_VISITED(c, visited)		((visited)[(c)->id >> 5] & (1U << ((c)->id & 31)))
+#define MARK_VISITED(c, visited)	((visited)[(c)->id >> 5] |= (1U << ((c)->id & 31)))
+
+// the order of the traversal. the array is also the queue of the traversal.
+typedef struct {
+	ClassExpression** expressions;
+	uint32_t count;
+	uint32_t* visited;
+} Order;
+
+// the class expressions at their new place, and their new ids indexed by the old ones
+typedef struct {
+	ClassExpression* expressions;
+	uint32_t count;
+	uint32_t* new_ids;
+} Relocation;
+
+static inline void visit(ClassExpression* c, Order* order) {
+	if (IS_VISITED(c, order->visited))
+		return;
+	MARK_VISITED(c, order->visited);
+	order->expressions[order->count++] = c;
+}
+
+static void visit_list(List* l, Order* order) {
+	int i;
+
+	for (i = 0; i < l->size; ++i)
+		visit((ClassExpression*) l->elements[i], order);
+}
+
+// breadth-first traversal starting from c
+static void traverse(ClassExpression* c, Order* order) {
+	uint32_t head = order->count;
+	MapIterator iterator;
+	ClassExpression* ex;
+
+	visit(c, order);
+	while (head < order->count) {
+		c = order->expressions[head++];
+		switch (c->type) {
+		case OBJECT_INTERSECTION_OF_TYPE:
+			visit(c->description.conj.conjunct1, order);
+			visit(c->description.conj.conjunct2, order);
+			break;
+		case OBJECT_SOME_VALUES_FROM_TYPE:
+			visit(c->description.exists.filler, order);
+			break;
+		default:
+			break;
+		}
+		visit_list(&(c->told_subsumers), order);
+		visit_list(&(c->first_conjunct_of_list), order);
+		visit_list(&(c->second_conjunct_of_list), order);
+		if (c->filler_of_negative_exists != NULL) {
+			MAP_ITERATOR_INIT(&iterator, c->filler_of_negative_exists);
+			for (ex = MAP_ITERATOR_NEXT(&iterator); ex != NULL; ex = MAP_ITERATOR_NEXT(&iterator))
+				visit(ex, order);
+		}
+	}
+}
+
+// returns the new place of the given class expression. an expression that
+// has already been moved is returned as it is.
+static inline ClassExpression* relocate(ClassExpression* c, Relocation* relocation) {
+	if (c >= relocation->expressions && c < relocation->expressions + relocation->count)
+		return c;
+	return &(relocation->expressions[relocation->new_ids[c->id]]);
+}
+
+static void relocate_list(List* l, Relocation* relocation) {
+	int i;
+
+	for (i = 0; i < l->size; ++i)
+		l->elements[i] = relocate((ClassExpression*) l->elements[i], relocation);
+}
+
+/******************************************************************************
+ * the keys of the maps, computed from the moved class expressions
+ *****************************************************************************/
+static uint64_t class_key(ClassExpression* c) {
+	return STRING_POOL_ENTRY(c->description.atomic.IRI)->id;
+}
+
+static uint64_t exists_restriction_key(ClassExpression* c) {
+	uint32_t role_id = c->description.exists.role->id;
+	uint32_t filler_id = c->description.exists.filler->id;
+
+	return HASH_INTEGERS(role_id, filler_id);
+}
+
+// the smaller id comes first, see PUT_CONJUNCTION
+static uint64_t conjunction_key(ClassExpression* c) {
+	uint32_t id1 = c->description.conj.conjunct1->id;
+	uint32_t id2 = c->description.conj.conjunct2->id;
+
+	return (id1 <= id2) ? HASH_INTEGERS(id1, id2) : HASH_INTEGERS(id2, id1);
+}
+
+static uint64_t nominal_key(ClassExpression* c) {
+	return c->description.nominal.individual->id;
+}
+
+static uint64_t negative_exists_key(ClassExpression* c) {
+	return c->description.exists.role->id;
+}
+
+// fill the given map again with the moved class expressions. the maps are iterated
+// in the reverse order of insertion, the values are inserted from the last one
+// on so that the iteration order does not change. the output still can, see
+// renumbering.h. the map is sized for the number of its values.
+static void relocate_map(Map* map, uint64_t (*key)(ClassExpression*), Relocation* relocation) {
+	MapIterator iterator;
+	ClassExpression* c;
+	List values;
+	int i;
+
+	LIST_INIT(&values);
+	MAP_ITERATOR_INIT(&iterator, map);
+	for (c = MAP_ITERATOR_NEXT(&iterator); c != NULL; c = MAP_ITERATOR_NEXT(&iterator))
+		list_add(c, &values);
+
+	MAP_RESET(map);
+	MAP_INIT(map, values.size);
+	for (i = values.size - 1; i >= 0; --i) {
+		c = relocate((ClassExpression*) values.elements[i], relocation);
+		MAP_PUT(key(c), c, map);
+	}
+	list_reset(&values);
+}
+
+void renumber_class_expressions(KB* kb) {
+	TBox* tbox = kb->tbox;
+	uint32_t i, n = tbox->next_class_expression_id;
+	Order order;
+	Relocation relocation;
+	MapIterator map_iterator;
+	SetIterator set_iterator;
+	ClassExpression* c;
+	char* block;
+	int j;
+
+	if (n == 0)
+		return;
+
+	order.expressions = (ClassExpression**) malloc(n * sizeof(ClassExpression*));
+	assert(order.expressions != NULL);
+	order.count = 0;
+	order.visited = (uint32_t*) calloc((n + 31) / 32, sizeof(uint32_t));
+	assert(order.visited != NULL);
+
+	// start from the classes, in the order the saturation takes them. then the ones
+	// that cannot be reached from a class, like the nominals.
+	MAP_ITERATOR_INIT(&map_iterator, &(tbox->classes));
+	for (c = MAP_ITERATOR_NEXT(&map_iterator); c != NULL; c = MAP_ITERATOR_NEXT(&map_iterator))
+		traverse(c, &order);
+	for (i = 0; i < n; ++i)
+		traverse(tbox->class_expressions[i], &order);
+	assert(order.count == n);
+
+	// copy the expressions to one array in the new order. the old copies stay
+	// in the arena unused until the KB is freed.
+	block = (char*) arena_allocate(tbox->expressions, n * sizeof(ClassExpression) + CACHE_LINE_SIZE);
+	relocation.expressions = (ClassExpression*) (((uintptr_t) block + CACHE_LINE_SIZE - 1) & ~((uintptr_t) CACHE_LINE_SIZE - 1));
+	relocation.count = n;
+	relocation.new_ids = (uint32_t*) malloc(n * sizeof(uint32_t));
+	assert(relocation.new_ids != NULL);
+	for (i = 0; i < n; ++i)
+		relocation.new_ids[order.expressions[i]->id] = i;
+	for (i = 0; i < n; ++i) {
+		memcpy(&(relocation.expressions[i]), order.expressions[i], sizeof(ClassExpression));
+		relocation.expressions[i].id = i;
+		tbox->class_expressions[i] = &(relocation.expressions[i]);
+	}
+	free(order.expressions);
+	free(order.visited);
+
+	// the references between the class expressions
+	for (i = 0; i < n; ++i) {
+		c = &(relocation.expressions[i]);
+		switch (c->type) {
+		case OBJECT_INTERSECTION_OF_TYPE:
+			c->description.conj.conjunct1 = relocate(c->description.conj.conjunct1, &relocation);
+			c->description.conj.conjunct2 = relocate(c->description.conj.conjunct2, &relocation);
+			break;
+		case OBJECT_SOME_VALUES_FROM_TYPE:
+			c->description.exists.filler = relocate(c->description.exists.filler, &relocation);
+			break;
+		default:
+			break;
+		}
+		relocate_list(&(c->told_subsumers), &relocation);
+		relocate_list(&(c->first_conjunct_of_list), &relocation);
+		relocate_list(&(c->second_conjunct_of_list), &relocation);
+	}
+	for (i = 0; i < n; ++i)
+		if (relocation.expressions[i].filler_of_negative_exists != NULL)
+			relocate_map(relocation.expressions[i].filler_of_negative_exists, negative_exists_key, &relocation);
+
+	tbox->top_concept = relocate(tbox->top_concept, &relocation);
+	tbox->bottom_concept = relocate(tbox->bottom_concept, &relocation);
+
+	// the maps of the TBox and the generated expressions
+	relocate_map(&(tbox->classes), class_key, &relocation);
+	relocate_map(&(tbox->object_some_values_from_exps), exists_restriction_key, &relocation);
+	relocate_map(&(tbox->object_intersection_of_exps), conjunction_key, &relocation);
+	relocate_map(&(tbox->object_one_of_exps), nominal_key, &relocation);
+	relocate_map(&(kb->generated_nominals), nominal_key, &relocation);
+	relocate_map(kb->generated_exists_restrictions, exists_restriction_key, &relocation);
+
+	// the axioms and the assertions
+	SET_ITERATOR_INIT(&set_iterator, &(tbox->subclass_of_axioms));
+	SubClassOfAxiom* subclass_ax;
+	while ((subclass_ax = (SubClassOfAxiom*) SET_ITERATOR_NEXT(&set_iterator)) != NULL) {
+		subclass_ax->lhs = relocate(subclass_ax->lhs, &relocation);
+		subclass_ax->rhs = relocate(subclass_ax->rhs, &relocation);
+	}
+	SET_ITERATOR_INIT(&set_iterator, &(tbox->equivalent_classes_axioms));
+	EquivalentClassesAxiom* eq_ax;
+	while ((eq_ax = (EquivalentClassesAxiom*) SET_ITERATOR_NEXT(&set_iterator)) != NULL) {
+		eq_ax->lhs = relocate(eq_ax->lhs, &relocation);
+		eq_ax->rhs = relocate(eq_ax->rhs, &relocation);
+	}
+	SET_ITERATOR_INIT(&set_iterator, &(tbox->disjoint_classes_axioms));
+	DisjointClassesAxiom* disjoint_ax;
+	while ((disjoint_ax = (DisjointClassesAxiom*) SET_ITERATOR_NEXT(&set_iterator)) != NULL)
+		relocate_list(&(disjoint_ax->classes), &relocation);
+	SET_ITERATOR_INIT(&set_iterator, &(tbox->objectproperty_domain_axioms));
+	ObjectPropertyDomainAxiom* domain_ax;
+	while ((domain_ax = (ObjectPropertyDomainAxiom*) SET_ITERATOR_NEXT(&set_iterator)) != NULL)
+		domain_ax->class_expression = relocate(domain_ax->class_expression, &relocation);
+	for (j = 0; j < kb->generated_subclass_axiom_count; ++j) {
+		kb->generated_subclass_axioms[j]->lhs = relocate(kb->generated_subclass_axioms[j]->lhs, &relocation);
+		kb->generated_subclass_axioms[j]->rhs = relocate(kb->generated_subclass_axioms[j]->rhs, &relocation);
+	}
+	for (j = 0; j < kb->abox->concept_assertion_count; ++j)
+		kb->abox->concept_assertions[j]->concept = relocate(kb->abox->concept_assertions[j]->concept, &relocation);
+
+	free(relocation.new_ids);
+}
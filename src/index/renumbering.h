@@ -0,0 +1,46 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENUMBERING_H_
+#define RENUMBERING_H_
+
+#include "../model/datatypes.h"
+
+/**
+ * Renumber the class expressions of the KB in the order of a breadth-first
+ * traversal of the indexed KB, and move them to one contiguous array in
+ * that order. Starting from the classes, the traversal follows the
+ * subexpressions, the told subsumers, the conjunctions an expression is
+ * a conjunct of and the negative existentials it is the filler of, i.e.,
+ * the expressions the saturation rules look at together.
+ *
+ * Every pointer to a class expression in the KB is updated, and the maps
+ * whose keys are built from class expression ids are filled again. Needs
+ * to be called after indexing and before saturation, since the subsumer
+ * sets and the links are not translated.
+ *
+ * The hierarchy is the same, but the output is not always identical to the
+ * one without renumbering. The subsumers are visited in the order of their
+ * ids when the hierarchy is computed, of the classes that are equivalent to
+ * a direct subsumer the first one visited is the one printed in SubClassOf.
+ * The sets of direct subsumers and equivalent classes are also iterated in
+ * an order that depends on the addresses of the classes.
+ */
+void renumber_class_expressions(KB* kb);
+
+#endif /* RENUMBERING_H_ */
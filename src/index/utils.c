@@ -37,7 +37,7 @@
 // of subsumers. the reason for keeping the subsumers twice
 // is performance in saturation
 int add_to_role_subsumer_list(ObjectPropertyExpression* r, ObjectPropertyExpression* s) {
-	if (SET_ADD(s, &(r->subsumers))) {
+	if (ID_SET_ADD(s->id, &(r->subsumers))) {
 		list_add(s, &(r->subsumer_list));
 
 		return 1;
@@ -47,7 +47,7 @@ int add_to_role_subsumer_list(ObjectPropertyExpression* r, ObjectPropertyExpress
 }
 
 int add_to_role_subsumee_list(ObjectPropertyExpression*r, ObjectPropertyExpression* s) {
-	if (SET_ADD(s, &(r->subsumees)))
+	if (ID_SET_ADD(s->id, &(r->subsumees)))
 		return 1;
 
 	return 0;
@@ -56,32 +56,17 @@ int add_to_role_subsumee_list(ObjectPropertyExpression*r, ObjectPropertyExpressi
 /******************************************************************************
  * functions for adding ...
  *****************************************************************************/
-// add 'conjunction' to the list of conjunctions whose first conjunct is 'concept'
-// note that for performance reasons in saturation, this information is kept twice:
-// once in a hash table, once in a usual array. the hash table is for searching
-// during saturation, the usual array is for iteration on the elements. the memory
-// overhead is worth the performance gain.
-
+// add 'conjunction' to the list of conjunctions whose first conjunct is 'concept'.
+// the list is iterated in saturation. a conjunction is indexed only once (see
+// index_class_expression), so it is not checked for duplicates.
 void add_to_first_conjunct_of_list(ClassExpression* concept, ClassExpression* conjunction) {
-	// create the hash if we are adding it for the first time
-	if (concept->first_conjunct_of == NULL)
-		concept->first_conjunct_of = SET_CREATE(DEFAULT_FIRST_CONJUNCT_OF_HASH_SIZE);
-
-	if (SET_ADD(conjunction, concept->first_conjunct_of)) {
-		list_add(conjunction, &(concept->first_conjunct_of_list));
-	}
+	list_add(conjunction, &(concept->first_conjunct_of_list));
 }
 
 // add 'conjunction' to the list of conjunctions whose second conjunct is 'concept'
 // (see the note for the function add_to_first_conjunct_of_list above)
 void add_to_second_conjunct_of_list(ClassExpression* concept, ClassExpression* conjunction) {
-	// create the hash if we are adding it for the first time
-	if (concept->second_conjunct_of == NULL)
-		concept->second_conjunct_of = SET_CREATE(DEFAULT_SECOND_CONJUNCT_OF_HASH_SIZE);
-
-	if (SET_ADD(conjunction, concept->second_conjunct_of)) {
-		list_add(conjunction, &(concept->second_conjunct_of_list));
-	}
+	list_add(conjunction, &(concept->second_conjunct_of_list));
 }
 
 // add ex to the filler_of_negative_exists hash of the filler of ex.
@@ -100,7 +85,7 @@ void add_to_negative_exists(ClassExpression* ex) {
 void add_role_to_first_component_of_list(ObjectPropertyExpression* role, ObjectPropertyExpression* composition) {
 	ObjectPropertyExpression** tmp;
 
-	if (SET_ADD(composition, &(role->first_component_of))) {
+	if (ID_SET_ADD(composition->id, &(role->first_component_of))) {
 		tmp = realloc(role->first_component_of_list, (role->first_component_of_count + 1) * sizeof(ObjectPropertyExpression*));
 		assert(tmp != NULL);
 		role->first_component_of_list = tmp;
@@ -114,7 +99,7 @@ void add_role_to_first_component_of_list(ObjectPropertyExpression* role, ObjectP
 void add_role_to_second_component_of_list(ObjectPropertyExpression* role, ObjectPropertyExpression* composition) {
 	ObjectPropertyExpression** tmp;
 
-	if (SET_ADD(composition, &(role->second_component_of))) {
+	if (ID_SET_ADD(composition->id, &(role->second_component_of))) {
 		tmp = realloc(role->second_component_of_list, (role->second_component_of_count + 1) * sizeof(ClassExpression*));
 		assert(tmp != NULL);
 		role->second_component_of_list = tmp;
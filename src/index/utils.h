@@ -50,7 +50,7 @@ int add_to_role_subsumee_list(ObjectPropertyExpression*r, ObjectPropertyExpressi
 
 int add_to_role_subsumees(ObjectPropertyExpression* r, ObjectPropertyExpression* s);
 
-#define ADD_TOLD_SUBSUMER_OBJECT_PROPERTY_EXPRESSION(s, r)		SET_ADD(s, &(r->told_subsumers))
+#define ADD_TOLD_SUBSUMER_OBJECT_PROPERTY_EXPRESSION(s, r)		ID_SET_ADD(s->id, &(r->told_subsumers))
 
 /******************************************************************************
  * functions for adding ...
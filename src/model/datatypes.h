@@ -21,14 +21,18 @@
 #define DATATYPES_H_
 
 #include "../utils/set.h"
+#include "../utils/id_set.h"
 #include "../utils/map.h"
 #include "../utils/list.h"
+#include "../utils/arena.h"
 #include "../hashing/hash_table.h"
 #include "../hashing/hash_map.h"
+#include "../hashing/string_pool.h"
 
 
 // Class constructors
 typedef struct class Class;
+typedef struct class_hierarchy ClassHierarchy;
 typedef struct object_intersection_of ObjectIntersectionOf;
 typedef struct object_some_values_from ObjectSomeValuesFrom;
 typedef struct object_one_of ObjectOneOf;
@@ -82,6 +86,13 @@ enum class_expression_type {
 struct class {
 	char* IRI;
 
+	// The place of the class in the class hierarchy. Only needed after
+	// saturation, NULL before. See compute_concept_hierarchy.
+	ClassHierarchy* hierarchy;
+};
+
+// The equivalent classes and the direct subsumers of a class
+struct class_hierarchy {
 	// Set of equivalent classes. Elements are ClassExpression*
 	Set equivalent_classes;
 	// Set of direct subsumers. Elements are ClassExpression*
@@ -107,7 +118,7 @@ struct object_one_of {
 	Individual* individual;
 };
 
-// Class description
+// Class description. All members have the size of two pointers.
 union class_description {
 	Class atomic;
 	ObjectIntersectionOf conj;
@@ -117,6 +128,10 @@ union class_description {
 	
 
 // ClassExpression
+// The saturation rules read most of the fields below for every saturation
+// axiom, the data only needed for the class hierarchy is kept out of it.
+// The fields that are used together are next to each other. With the
+// default set backend the struct takes 128 bytes, i.e., two cache lines.
 struct class_expression {
 	// Unique id
 	// 32-bit unsigned integer. Needed for hashing.
@@ -125,12 +140,18 @@ struct class_expression {
 	enum class_expression_type type;
 	ClassDescription description;
 
-	// List of told subsumers. Elements are ClassExpression*
-	List told_subsumers;
-
 	// Set of subsumers computed during saturation.
-	// Elements are ClassExpression*
-	Set subsumers;
+	// Elements are ClassExpression ids, see GET_CLASS_EXPRESSION
+	IdSet subsumers;
+
+	// List of conjunctions where this concept is the first/second conjunct.
+	// Elements are ClassExpression*. Every conjunction is indexed once,
+	// so the elements are unique.
+	List first_conjunct_of_list;
+	List second_conjunct_of_list;
+
+	// set of negative existentials whose filler is this concept
+	Map* filler_of_negative_exists;
 
 	// 2-dimensional dynamic array for storing predecessors.
 	Link* predecessors;
@@ -139,23 +160,11 @@ struct class_expression {
 
 	// the same data structure to store the successors.
 	// needed for implementing the role composition rule in saturation
-	Link* successors;
 	int successor_r_count;
+	Link* successors;
 
-	// set of negative existentials whose filler is this concept
-	Map* filler_of_negative_exists;
-
-	// List of conjunctions where this concept is the first/second conjunct.
-	// Elements are ClassExpression*
-	List first_conjunct_of_list;
-	List second_conjunct_of_list;
-
-	// The set of conjunctions where this concept is the first/second conjunct.
-	// The reason for storing them once in a list and once in a set is performance
-	// in saturation.
-	Set* first_conjunct_of;
-	Set* second_conjunct_of;
-
+	// List of told subsumers. Elements are ClassExpression*
+	List told_subsumers;
 };
 
 // For keeping successors and predecessors of a  concept
@@ -163,7 +172,8 @@ struct link {
 	ObjectPropertyExpression* role;
 	// ClassExpression** fillers;
 	// int filler_count;
-	Set fillers;
+	// Elements are ClassExpression ids
+	IdSet fillers;
 };
 
 /*****************************************************************************/
@@ -198,16 +208,18 @@ struct object_property_expression {
 	enum object_property_expression_type type;
 	ObjectPropertyDescription description;
 
-	Set told_subsumers;
+	// The sets below store ObjectPropertyExpression ids,
+	// see GET_OBJECTPROPERTY_EXPRESSION
+	IdSet told_subsumers;
 
-	Set subsumers;
+	IdSet subsumers;
 	// List of subsumers of this object property.
 	// Elements are ObjectPropertyExpression*
 	List subsumer_list;
 
 	// Only necessary for optimizing the processing of role compositions
 	// For that we need to access the subsumees
-	Set subsumees;
+	IdSet subsumees;
 
 	// List of role compositions where this role is the first/second component
 	ObjectPropertyExpression** first_component_of_list;
@@ -216,8 +228,8 @@ struct object_property_expression {
 	int second_component_of_count;
 
 	// Same as above. The reason is performance in saturation.
-	Set first_component_of;
-	Set second_component_of;
+	IdSet first_component_of;
+	IdSet second_component_of;
 };
 
 /******************************************************************************/
@@ -281,13 +293,32 @@ struct tbox {
 	uint32_t next_class_expression_id;
 	uint32_t next_objectproperty_expression_id;
 
+	// Class expressions indexed by their ids. The saturation sets
+	// store ids, the objects are looked up here.
+	ClassExpression** class_expressions;
+	// Allocated size of class_expressions
+	uint32_t class_expressions_size;
+
+	// Object property expressions indexed by their ids
+	ObjectPropertyExpression** objectproperty_expressions;
+	// Allocated size of objectproperty_expressions
+	uint32_t objectproperty_expressions_size;
+
 	// Top concept
 	ClassExpression* top_concept;
 	// Bottom concept
 	ClassExpression* bottom_concept;
 
+	// The pool of the KB, where the IRIs are interned
+	StringPool* iris;
+
+	// The arenas of the KB, where the class and object property
+	// expressions and the axioms are allocated
+	Arena* expressions;
+	Arena* axioms;
+
 	// Classes
-	// Key: IRI (char*)
+	// Key: id of the interned IRI
 	// Value: ClassExpression*
 	Map classes;
 
@@ -313,7 +344,7 @@ struct tbox {
 	Map object_one_of_exps;
 
 	// ObjectProperties
-	// Key: IRI (char*)
+	// Key: id of the interned IRI
 	// Value: ObjectPropertyExpression*
 	Map objectproperties;
 
@@ -389,7 +420,17 @@ struct abox {
 	int individual_count;
 	// Individual** individual_list;
 
-	HashMap* individuals;
+	// The pool of the KB, where the IRIs are interned
+	StringPool* iris;
+
+	// The arenas of the KB. The individuals are allocated in the
+	// expressions arena, the assertions in the axioms arena.
+	Arena* expressions;
+	Arena* axioms;
+
+	// Key: id of the interned IRI
+	// Value: Individual*
+	Map* individuals;
 
 	int concept_assertion_count;
 	ClassAssertion** concept_assertions;
@@ -412,10 +453,22 @@ struct knowledge_base {
 	// flag for inconsistency
 	char inconsistent;
 
-	// List for the prefix names
+	// The IRIs of classes, object properties and individuals, the prefix
+	// names and the prefixes. Each of them is stored once. An IRI in the
+	// namespace of a prefix is stored as the name of the prefix and the local
+	// name, also if it has been written in full.
+	StringPool iris;
+
+	// The class and object property expressions and the individuals,
+	// including the ones generated in preprocessing
+	Arena expressions;
+	// The axioms and the assertions, including the generated ones
+	Arena axioms;
+
+	// List for the prefix names. Elements are interned strings.
 	List prefix_names;
 	// Map for prefixes.
-	// Key: prefix name, Value: prefix
+	// Key: id of the interned prefix name, Value: prefix (interned)
 	Map prefixes;
 
 	// The list of subclass axioms that result from converting syntactic
@@ -432,7 +485,7 @@ struct knowledge_base {
 
 	// The hash of existential restrictions that are generated during preprocessing.
 	// They are generated from preprocessing role assertions.
-	HashMap* generated_exists_restrictions;
+	Map* generated_exists_restrictions;
 	int generated_exists_restriction_count;
 
 	// occurrence of owl:Thing on the lhs of an axiom
@@ -440,6 +493,13 @@ struct knowledge_base {
 	// occurrence of owl:Nothing on the rhs of an axiom
 	char bottom_occurs_on_rhs;
 
+	// The class expressions that have already been indexed, one bit per id.
+	// Kept from indexing the told axioms while parsing until index_kb.
+	uint32_t* indexed;
+	uint32_t indexed_size;
+	// 1 if the told axioms have been indexed while parsing, see index/pipeline.h
+	char told_axioms_indexed;
+
 };
 
 #endif
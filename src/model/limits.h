@@ -22,19 +22,9 @@
 
 // configuration parameters
 
-// Maximum lengths/sizes for the parser
-#define MAX_CONJUNCT_COUNT				1024 /* max number of conjuncts in an ObjectIntersectionOf expression */
-#define MAX_EQ_CLASS_EXP_COUNT			1024 /* max number of class expressions in an EquivalentClasses axiom */
-#define MAX_EQ_ROLE_EXP_COUNT			1024 /* max number of object property expressions in an EquivalentObjectProperties axiom */
-#define MAX_ROLE_COMPOSITION_SIZE		1024 /* max size of an ObjectPropertyChain expression */
-// #define MAX_CLASS_NAME_LENGTH			1024 /* max size for class names */
-// #define MAX_OBJECT_PROPERTY_NAME_LENGTH	1024 /* max size for object property names */
-#define MAX_DISJ_CLASS_EXP_COUNT		1024 /* max number of disjoint classes in a DisjointClasses axiom */
-#define MAX_SAME_INDIVIDUAL_COUNT		1024 /* max number of individuals in a SameIndividual axiom */
-#define MAX_DIFFERENT_INDIVIDUALS_COUNT	1024 /* max number of individuals in a DifferentIndividuals axiom */
-
 // Default set/map sizes (per ontology)
 #define DEFAULT_PREFIXES_HASH_SIZE					32
+#define DEFAULT_IRIS_POOL_SIZE						262144
 #define DEFAULT_ATOMIC_CONCEPTS_HASH_SIZE			150000
 #define DEFAULT_ATOMIC_ROLES_HASH_SIZE				200
 #define DEFAULT_INDIVIDUALS_HASH_SIZE				100000
@@ -43,6 +33,14 @@
 #define DEFAULT_NOMINALS_HASH_SIZE					10000
 #define DEFAULT_ROLE_COMPOSITIONS_HASH_SIZE			200
 
+// Initial sizes of the tables for looking up class/object property expressions by id (per ontology)
+#define DEFAULT_CLASS_EXPRESSIONS_TABLE_SIZE		1024
+#define DEFAULT_OBJECTPROPERTY_EXPRESSIONS_TABLE_SIZE	128
+
+// Block sizes of the arenas for the expressions and the axioms (per ontology)
+#define EXPRESSIONS_ARENA_BLOCK_SIZE				(1 << 20)
+#define AXIOMS_ARENA_BLOCK_SIZE						(1 << 18)
+
 // Default set sizes for axioms (per ontology)
 #define DEFAULT_SUBCLASS_OF_AXIOMS_SET_SIZE						1024
 #define DEFAULT_EQUIVALENT_CLASSES_AXIOMS_SET_SIZE				1024
@@ -55,17 +53,18 @@
 #define DEFAULT_DIFFERENT_INDIVIDUALS_AXIOMS_SET_SIZE			128
 
 // Default set/map sizes (per class expression)
+// Sets of size at most DYNAMIC_HASH_TABLE_INLINE_SIZE (4), and id sets of size at most
+// DYNAMIC_ID_HASH_TABLE_INLINE_SIZE (4), keep their elements inline
+// and do not allocate anything before they outgrow it.
 #define DEFAULT_NEGATIVE_FILLER_OF_SET_SIZE			8
-#define DEFAULT_FIRST_CONJUNCT_OF_HASH_SIZE			16
-#define DEFAULT_SECOND_CONJUNCT_OF_HASH_SIZE		16
-#define DEFAULT_SUBSUMERS_HASH_SIZE					8
-#define DEFAULT_DIRECT_SUBSUMERS_SET_SIZE			8
-#define DEFAULT_EQUIVALENT_CONCEPTS_SET_SIZE		8
-#define DEFAULT_PREDECESSORS_SET__SIZE		16
-#define DEFAULT_SUCCESSORS_SET__SIZE		16
+#define DEFAULT_SUBSUMERS_HASH_SIZE					4
+#define DEFAULT_DIRECT_SUBSUMERS_SET_SIZE			4
+#define DEFAULT_EQUIVALENT_CONCEPTS_SET_SIZE		4
+#define DEFAULT_PREDECESSORS_SET__SIZE		4
+#define DEFAULT_SUCCESSORS_SET__SIZE		4
 
 // Default set/map sizes (per objectproperty expression)
-#define DEFAULT_ROLE_TOLD_SUBSUMERS_HASH_SIZE		16
+#define DEFAULT_ROLE_TOLD_SUBSUMERS_HASH_SIZE		4
 #define DEFAULT_ROLE_SUBSUMERS_HASH_SIZE			16
 #define DEFAULT_ROLE_SUBSUMEES_HASH_SIZE			16
 #define DEFAULT_ROLE_FIRST_COMPONENT_OF_HASH_SIZE	16
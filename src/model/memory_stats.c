@@ -0,0 +1,205 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "datatypes.h"
+#include "memory_stats.h"
+#include "../utils/set.h"
+#include "../utils/id_set.h"
+#include "../utils/map.h"
+#include "../utils/list.h"
+#include "../utils/rss.h"
+
+MemoryStats memory_stats;
+
+static const char* tag_names[MEMORY_TAG_COUNT] = {
+		"Strings", "Expressions", "Axioms", "Index", "Subsumers", "Links", "Roles", "Hierarchy"
+};
+
+static const char* phase_names[PHASE_COUNT] = {
+		"load", "preproc", "index", "saturate", "hierarchy", "end"
+};
+
+#define LIST_MEMORY(l)		((size_t) (l)->capacity * sizeof(void*))
+
+void enable_memory_stats() {
+	memset(&memory_stats, 0, sizeof(MemoryStats));
+	memory_stats.enabled = 1;
+}
+
+static size_t axiom_sets_memory(TBox* tbox) {
+	size_t bytes = 0;
+	SetIterator iterator;
+	void* ax;
+
+	bytes += SET_MEMORY(&(tbox->subclass_of_axioms));
+	bytes += SET_MEMORY(&(tbox->equivalent_classes_axioms));
+	bytes += SET_MEMORY(&(tbox->disjoint_classes_axioms));
+	bytes += SET_MEMORY(&(tbox->subobjectproperty_of_axioms));
+	bytes += SET_MEMORY(&(tbox->equivalent_objectproperties_axioms));
+	bytes += SET_MEMORY(&(tbox->transitive_objectproperty_axioms));
+	bytes += SET_MEMORY(&(tbox->objectproperty_domain_axioms));
+	bytes += SET_MEMORY(&(tbox->same_individual_axioms));
+	bytes += SET_MEMORY(&(tbox->different_individuals_axioms));
+
+	// the lists of the n-ary axioms
+	SET_ITERATOR_INIT(&iterator, &(tbox->disjoint_classes_axioms));
+	while ((ax = SET_ITERATOR_NEXT(&iterator)) != NULL)
+		bytes += LIST_MEMORY(&(((DisjointClassesAxiom*) ax)->classes));
+	SET_ITERATOR_INIT(&iterator, &(tbox->same_individual_axioms));
+	while ((ax = SET_ITERATOR_NEXT(&iterator)) != NULL)
+		bytes += LIST_MEMORY(&(((SameIndividualAxiom*) ax)->individuals));
+	SET_ITERATOR_INIT(&iterator, &(tbox->different_individuals_axioms));
+	while ((ax = SET_ITERATOR_NEXT(&iterator)) != NULL)
+		bytes += LIST_MEMORY(&(((DifferentIndividualsAxiom*) ax)->individuals));
+
+	return bytes;
+}
+
+static void class_expression_memory(ClassExpression* c, size_t* bytes) {
+	int i;
+
+	bytes[MEMORY_INDEX] += LIST_MEMORY(&(c->told_subsumers));
+	bytes[MEMORY_INDEX] += LIST_MEMORY(&(c->first_conjunct_of_list));
+	bytes[MEMORY_INDEX] += LIST_MEMORY(&(c->second_conjunct_of_list));
+	if (c->filler_of_negative_exists != NULL)
+		bytes[MEMORY_INDEX] += sizeof(Map) + MAP_MEMORY(c->filler_of_negative_exists);
+
+	bytes[MEMORY_SUBSUMERS] += ID_SET_MEMORY(&(c->subsumers));
+
+	bytes[MEMORY_LINKS] += (c->predecessor_r_count + c->successor_r_count) * sizeof(Link);
+	for (i = 0; i < c->predecessor_r_count; ++i)
+		bytes[MEMORY_LINKS] += ID_SET_MEMORY(&(c->predecessors[i].fillers));
+	for (i = 0; i < c->successor_r_count; ++i)
+		bytes[MEMORY_LINKS] += ID_SET_MEMORY(&(c->successors[i].fillers));
+
+	if (c->type == CLASS_TYPE && c->description.atomic.hierarchy != NULL) {
+		// the hierarchy is in the expressions arena, it is counted here instead
+		bytes[MEMORY_EXPRESSIONS] -= sizeof(ClassHierarchy);
+		bytes[MEMORY_HIERARCHY] += sizeof(ClassHierarchy);
+		bytes[MEMORY_HIERARCHY] += SET_MEMORY(&(c->description.atomic.hierarchy->equivalent_classes));
+		bytes[MEMORY_HIERARCHY] += SET_MEMORY(&(c->description.atomic.hierarchy->direct_subsumers));
+	}
+}
+
+static size_t role_memory(ObjectPropertyExpression* r) {
+	size_t bytes = 0;
+
+	bytes += ID_SET_MEMORY(&(r->told_subsumers));
+	bytes += ID_SET_MEMORY(&(r->subsumers));
+	bytes += LIST_MEMORY(&(r->subsumer_list));
+	bytes += ID_SET_MEMORY(&(r->subsumees));
+	bytes += (r->first_component_of_count + r->second_component_of_count) * sizeof(ObjectPropertyExpression*);
+	bytes += ID_SET_MEMORY(&(r->first_component_of));
+	bytes += ID_SET_MEMORY(&(r->second_component_of));
+
+	return bytes;
+}
+
+void record_memory_usage(KB* kb, enum memory_phase phase) {
+	TBox* tbox = kb->tbox;
+	ABox* abox = kb->abox;
+	size_t* bytes = memory_stats.bytes[phase];
+	uint32_t i;
+
+	if (!memory_stats.enabled)
+		return;
+
+	memset(bytes, 0, MEMORY_TAG_COUNT * sizeof(size_t));
+
+	bytes[MEMORY_STRINGS] = kb->iris.arena_bytes + kb->iris.size * sizeof(uint32_t)
+			+ LIST_MEMORY(&(kb->prefix_names)) + MAP_MEMORY(&(kb->prefixes));
+
+	bytes[MEMORY_EXPRESSIONS] = kb->expressions.arena_bytes
+			+ tbox->class_expressions_size * sizeof(ClassExpression*)
+			+ tbox->objectproperty_expressions_size * sizeof(ObjectPropertyExpression*)
+			+ MAP_MEMORY(&(tbox->classes))
+			+ MAP_MEMORY(&(tbox->object_some_values_from_exps))
+			+ MAP_MEMORY(&(tbox->object_intersection_of_exps))
+			+ MAP_MEMORY(&(tbox->object_one_of_exps))
+			+ MAP_MEMORY(&(tbox->objectproperties))
+			+ MAP_MEMORY(&(tbox->objectproperty_chains))
+			+ MAP_MEMORY(&(kb->generated_nominals))
+			+ MAP_MEMORY(kb->generated_exists_restrictions)
+			+ MAP_MEMORY(abox->individuals);
+
+	bytes[MEMORY_AXIOMS] = kb->axioms.arena_bytes + axiom_sets_memory(tbox)
+			+ kb->generated_subclass_axiom_count * sizeof(SubClassOfAxiom*)
+			+ kb->generated_subrole_axiom_count * sizeof(SubObjectPropertyOfAxiom*)
+			+ abox->concept_assertion_count * sizeof(ClassAssertion*)
+			+ abox->role_assertion_count * sizeof(ObjectPropertyAssertion*);
+
+	for (i = 0; i < tbox->next_class_expression_id; ++i)
+		class_expression_memory(tbox->class_expressions[i], bytes);
+	for (i = 0; i < tbox->next_objectproperty_expression_id; ++i)
+		bytes[MEMORY_ROLES] += role_memory(tbox->objectproperty_expressions[i]);
+
+	memory_stats.rss[phase] = get_current_rss();
+	memory_stats.recorded[phase] = 1;
+}
+
+static void print_row(FILE* fp, const char* name, size_t* values, size_t max) {
+	int phase;
+
+	fprintf(fp, "%-12s", name);
+	for (phase = 0; phase < PHASE_COUNT; ++phase)
+		if (memory_stats.recorded[phase])
+			fprintf(fp, " %10.3f", values[phase] / 1048576.0);
+		else
+			fprintf(fp, " %10s", "-");
+	fprintf(fp, " %10.3f\n", max / 1048576.0);
+}
+
+void print_memory_stats(FILE* fp) {
+	size_t values[PHASE_COUNT], totals[PHASE_COUNT], max, total_max = 0, peak;
+	int tag, phase;
+
+	// the subsystems are only measured at the phase ends, their maximum is
+	// not a high-water mark. the RSS row has the peak of the process.
+	fprintf(fp, "\n------ Memory usage (MB) at the end of each phase ------\n");
+	fprintf(fp, "%-12s", "");
+	for (phase = 0; phase < PHASE_COUNT; ++phase)
+		fprintf(fp, " %10s", phase_names[phase]);
+	fprintf(fp, " %10s\n", "phase max");
+
+	memset(totals, 0, sizeof(totals));
+	for (tag = 0; tag < MEMORY_TAG_COUNT; ++tag) {
+		max = 0;
+		for (phase = 0; phase < PHASE_COUNT; ++phase) {
+			values[phase] = memory_stats.bytes[phase][tag];
+			totals[phase] += values[phase];
+			if (values[phase] > max)
+				max = values[phase];
+		}
+		print_row(fp, tag_names[tag], values, max);
+	}
+
+	for (phase = 0; phase < PHASE_COUNT; ++phase)
+		if (totals[phase] > total_max)
+			total_max = totals[phase];
+	print_row(fp, "Total", totals, total_max);
+
+	// the peak of the process is not necessarily at the end of a phase
+	peak = get_peak_rss();
+	for (phase = 0; phase < PHASE_COUNT; ++phase)
+		if (memory_stats.rss[phase] > peak)
+			peak = memory_stats.rss[phase];
+	print_row(fp, "RSS", memory_stats.rss, peak);
+}
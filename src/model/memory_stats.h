@@ -0,0 +1,94 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MEMORY_STATS_H_
+#define MEMORY_STATS_H_
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "datatypes.h"
+
+/**
+ * Memory usage of the KB per subsystem, recorded at the end of every phase.
+ * The usage is computed from the allocated sizes of the data structures of
+ * the KB, allocations of a phase that are freed before its end (like the
+ * scheduled axioms of the saturation) are not seen. Recording is off unless
+ * it is enabled, e.g., with -v.
+ *
+ * The allocations are not counted as they happen, there is no high-water
+ * mark per subsystem: the maximum of a subsystem is the largest of its
+ * values at the ends of the phases, a subsystem can have used more within
+ * a phase. Only the RSS has a real peak, the one of the process.
+ */
+
+typedef struct memory_stats MemoryStats;
+
+// the subsystems
+enum memory_tag {
+	MEMORY_STRINGS,			// IRIs, prefix names and prefixes
+	MEMORY_EXPRESSIONS,		// class and object property expressions, individuals, their maps and id tables
+	MEMORY_AXIOMS,			// axioms and assertions, including the generated ones
+	MEMORY_INDEX,			// told subsumers, conjunct lists, negative existentials
+	MEMORY_SUBSUMERS,		// subsumer sets of the class expressions
+	MEMORY_LINKS,			// predecessors and successors
+	MEMORY_ROLES,			// told subsumers, subsumers, subsumees and compositions of the roles
+	MEMORY_HIERARCHY,		// equivalent classes and direct subsumers
+	MEMORY_TAG_COUNT
+};
+
+// the phases, recorded at their end
+enum memory_phase {
+	PHASE_LOADING,
+	PHASE_PREPROCESSING,
+	PHASE_INDEXING,
+	PHASE_SATURATION,
+	PHASE_HIERARCHY,
+	// after the output, before the KB is freed
+	PHASE_END,
+	PHASE_COUNT
+};
+
+struct memory_stats {
+	char enabled;
+	char recorded[PHASE_COUNT];
+	size_t bytes[PHASE_COUNT][MEMORY_TAG_COUNT];
+	// resident set size of the process
+	size_t rss[PHASE_COUNT];
+};
+
+extern MemoryStats memory_stats;
+
+/**
+ * Start recording the memory usage.
+ */
+void enable_memory_stats();
+
+/**
+ * Record the memory usage of the given KB at the end of the given phase.
+ * Does nothing if recording is not enabled.
+ */
+void record_memory_usage(KB* kb, enum memory_phase phase);
+
+/**
+ * Print the usage per subsystem and phase, the maximum of every subsystem
+ * at the phase ends, and the peak RSS.
+ */
+void print_memory_stats(FILE* fp);
+
+#endif /* MEMORY_STATS_H_ */
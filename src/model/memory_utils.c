@@ -17,9 +17,16 @@
  */
 
 
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#ifdef HAVE_MALLOC_TRIM
+#include <malloc.h>
+#endif
 
 #include "datatypes.h"
 #include "limits.h"
@@ -28,65 +35,70 @@
 
 
 
-int free_concept(ClassExpression* c, TBox* tbox) {
+// free the data of the given class expression that is only needed in saturation.
+// the subsumers are not freed, the hierarchy and the output need them.
+static int free_concept_saturation_data(ClassExpression* c) {
 	int total_freed_bytes = 0;
 
-	// free the class
-	if (c->type == CLASS_TYPE) {
-		// free the equivalent concepts list
-		total_freed_bytes += SET_RESET(&(c->description.atomic.equivalent_classes));
-
-		// free the direct subsumers set
-		total_freed_bytes += SET_RESET(&(c->description.atomic.direct_subsumers));
-
-		total_freed_bytes += sizeof(char) * strlen(c->description.atomic.IRI);
-		free(c->description.atomic.IRI);
-	}
-
 	// free the told subsumers list
 	total_freed_bytes += list_reset(&(c->told_subsumers));
 
-	// free the subsumers hash
-	total_freed_bytes += SET_RESET(&(c->subsumers));
-
 	// free the predecessors matrix.
 	int i;
 	for (i = 0; i < c->predecessor_r_count; ++i) {
 		// free(c->predecessors[i].fillers);
 		// total_freed_bytes += c->predecessors[i].filler_count * sizeof(ClassExpression*);
-		total_freed_bytes += SET_RESET(&(c->predecessors[i].fillers));
+		total_freed_bytes += ID_SET_RESET(&(c->predecessors[i].fillers));
 	}
 	free(c->predecessors);
 	total_freed_bytes += c->predecessor_r_count  * sizeof(Link);
+	c->predecessors = NULL;
+	c->predecessor_r_count = 0;
 
 	// similarly free the successors hash.
 	for (i = 0; i < c->successor_r_count; ++i) {
 		// free(c->successors[i].fillers);
 		// total_freed_bytes += c->successors[i].filler_count * sizeof(ClassExpression*);
-		total_freed_bytes += SET_RESET(&(c->successors[i].fillers));
+		total_freed_bytes += ID_SET_RESET(&(c->successors[i].fillers));
 	}
 	free(c->successors);
 	total_freed_bytes += c->successor_r_count  * sizeof(Link);
+	c->successors = NULL;
+	c->successor_r_count = 0;
 
 	// free the filler of negative existentials set
-	if (c->filler_of_negative_exists != NULL)
+	if (c->filler_of_negative_exists != NULL) {
 		total_freed_bytes += MAP_FREE(c->filler_of_negative_exists);
+		c->filler_of_negative_exists = NULL;
+	}
 
-	// free the list of conjunctions where this concept occurs
+	// free the lists of conjunctions where this concept occurs
 	total_freed_bytes += list_reset(&(c->first_conjunct_of_list));
-	// free the first_conjunct_of hash, if it exists
-	if (c->first_conjunct_of != NULL)
-		total_freed_bytes += SET_FREE(c->first_conjunct_of);
-
-	// now for the second conjunct
 	total_freed_bytes += list_reset(&(c->second_conjunct_of_list));
-	// free the second_conjunct_of hash, if it exists
-	if (c->second_conjunct_of != NULL)
-		total_freed_bytes += SET_FREE(c->second_conjunct_of);
 
-	// finally free this concept
-	total_freed_bytes += sizeof(ClassExpression);
-	free(c);
+	return total_freed_bytes;
+}
+
+int free_concept(ClassExpression* c, TBox* tbox) {
+	int total_freed_bytes = 0;
+
+	// free the class
+	if (c->type == CLASS_TYPE && c->description.atomic.hierarchy != NULL) {
+		// free the equivalent concepts list
+		total_freed_bytes += SET_RESET(&(c->description.atomic.hierarchy->equivalent_classes));
+
+		// free the direct subsumers set
+		total_freed_bytes += SET_RESET(&(c->description.atomic.hierarchy->direct_subsumers));
+
+		// the IRI is in the string pool, the hierarchy in the expressions arena of the KB
+	}
+
+	total_freed_bytes += free_concept_saturation_data(c);
+
+	// free the subsumers hash
+	total_freed_bytes += ID_SET_RESET(&(c->subsumers));
+
+	// the concept itself is in the expressions arena of the KB
 
 	return total_freed_bytes;
 }
@@ -96,8 +108,7 @@ int free_role(ObjectPropertyExpression* r) {
 
 	switch (r->type) {
 	case OBJECT_PROPERTY_TYPE:
-		total_freed_bytes += sizeof(char) * strlen(r->description.atomic.IRI);
-		free(r->description.atomic.IRI);
+		// the IRI is in the string pool of the KB
 		break;
 	case OBJECT_PROPERTY_CHAIN_TYPE:
 		break;
@@ -106,230 +117,119 @@ int free_role(ObjectPropertyExpression* r) {
 	// free the told subsumers list
 	// total_freed_bytes += sizeof(Role*) * r->told_subsumer_count;
 	// free(r->told_subsumers);
-	total_freed_bytes += SET_RESET(&(r->told_subsumers));
+	total_freed_bytes += ID_SET_RESET(&(r->told_subsumers));
 
 	// free the  subsumers list
 	total_freed_bytes += list_reset(&(r->subsumer_list));
 
 	// free the subsumers hash
-	total_freed_bytes += SET_RESET(&(r->subsumers));
+	total_freed_bytes += ID_SET_RESET(&(r->subsumers));
 
 	// free the subsumees hash
-	total_freed_bytes += SET_RESET(&(r->subsumees));
+	total_freed_bytes += ID_SET_RESET(&(r->subsumees));
 
 	// free the list of role compositions where this role occurs
 	total_freed_bytes += sizeof(ObjectPropertyExpression*) * r->first_component_of_count;
 	free(r->first_component_of_list);
+	r->first_component_of_list = NULL;
+	r->first_component_of_count = 0;
 
-	total_freed_bytes += SET_RESET(&(r->first_component_of));
+	total_freed_bytes += ID_SET_RESET(&(r->first_component_of));
 
 	// now for the second component
 	total_freed_bytes += sizeof(ObjectPropertyExpression*) * r->second_component_of_count;
 	free(r->second_component_of_list);
+	r->second_component_of_list = NULL;
+	r->second_component_of_count = 0;
 
-	total_freed_bytes += SET_RESET(&(r->second_component_of));
+	total_freed_bytes += ID_SET_RESET(&(r->second_component_of));
 
-	// finally free this role
-	total_freed_bytes += sizeof(ObjectPropertyExpression);
-	free(r);
+	// the role itself is in the expressions arena of the KB
 
 	return total_freed_bytes;
 }
 
 int free_tbox(TBox* tbox) {
-	int i, total_freed_bytes = 0;
+	int total_freed_bytes = 0;
+	uint32_t i;
 
+	// the axioms are in the axioms arena of the KB, only the lists
+	// of the n-ary axioms need to be freed
 	SetIterator set_iterator;
-	// free subclass axioms
-	SET_ITERATOR_INIT(&set_iterator, &(tbox->subclass_of_axioms));
-	void* ax = SET_ITERATOR_NEXT(&set_iterator);
-	while (ax) {
-		free(ax);
-		total_freed_bytes += sizeof(SubClassOfAxiom);
-		ax = SET_ITERATOR_NEXT(&set_iterator);
-	}
-	total_freed_bytes += SET_RESET(&(tbox->subclass_of_axioms));
-
-	// free equivalent class axioms
-	SET_ITERATOR_INIT(&set_iterator, &(tbox->equivalent_classes_axioms));
-	ax = SET_ITERATOR_NEXT(&set_iterator);
-	while (ax) {
-		free(ax);
-		total_freed_bytes += sizeof(EquivalentClassesAxiom);
-		ax = SET_ITERATOR_NEXT(&set_iterator);
-	}
-	total_freed_bytes += SET_RESET(&(tbox->equivalent_classes_axioms));
-
-	// free the disjoint classes axioms
+	void* ax;
 	SET_ITERATOR_INIT(&set_iterator, &(tbox->disjoint_classes_axioms));
 	ax = SET_ITERATOR_NEXT(&set_iterator);
 	while (ax) {
 		total_freed_bytes += list_reset(&(((DisjointClassesAxiom*) ax)->classes));
-		free(ax);
-		total_freed_bytes += sizeof(DisjointClassesAxiom);
 		ax = SET_ITERATOR_NEXT(&set_iterator);
 	}
-	total_freed_bytes += SET_RESET(&(tbox->disjoint_classes_axioms));
 
-	// free role subobjectpropertyof axioms
-	SET_ITERATOR_INIT(&set_iterator, &(tbox->subobjectproperty_of_axioms));
+	SET_ITERATOR_INIT(&set_iterator, &(tbox->same_individual_axioms));
 	ax = SET_ITERATOR_NEXT(&set_iterator);
 	while (ax) {
-		free(ax);
-		total_freed_bytes += sizeof(SubObjectPropertyOfAxiom);
+		total_freed_bytes += list_reset(&(((SameIndividualAxiom*) ax)->individuals));
 		ax = SET_ITERATOR_NEXT(&set_iterator);
 	}
-	total_freed_bytes += SET_RESET(&(tbox->subobjectproperty_of_axioms));
 
-	// free equivalent role axioms
-	SET_ITERATOR_INIT(&set_iterator, &(tbox->equivalent_objectproperties_axioms));
+	SET_ITERATOR_INIT(&set_iterator, &(tbox->different_individuals_axioms));
 	ax = SET_ITERATOR_NEXT(&set_iterator);
 	while (ax) {
-		free(ax);
-		total_freed_bytes += sizeof(EquivalentObjectPropertiesAxiom);
+		total_freed_bytes += list_reset(&(((DifferentIndividualsAxiom*) ax)->individuals));
 		ax = SET_ITERATOR_NEXT(&set_iterator);
 	}
-	total_freed_bytes += SET_RESET(&(tbox->equivalent_objectproperties_axioms));
 
-	// free transitive role axioms
-	SET_ITERATOR_INIT(&set_iterator, &(tbox->transitive_objectproperty_axioms));
-	ax = SET_ITERATOR_NEXT(&set_iterator);
-	while (ax) {
-		free(ax);
-		total_freed_bytes += sizeof(TransitiveObjectPropertyAxiom);
-		ax = SET_ITERATOR_NEXT(&set_iterator);
-	}
+	total_freed_bytes += SET_RESET(&(tbox->subclass_of_axioms));
+	total_freed_bytes += SET_RESET(&(tbox->equivalent_classes_axioms));
+	total_freed_bytes += SET_RESET(&(tbox->disjoint_classes_axioms));
+	total_freed_bytes += SET_RESET(&(tbox->subobjectproperty_of_axioms));
+	total_freed_bytes += SET_RESET(&(tbox->equivalent_objectproperties_axioms));
 	total_freed_bytes += SET_RESET(&(tbox->transitive_objectproperty_axioms));
-
-	// free the objectproperty domain axioms
-	SET_ITERATOR_INIT(&set_iterator, &(tbox->objectproperty_domain_axioms));
-	ax = SET_ITERATOR_NEXT(&set_iterator);
-	while (ax) {
-		free(ax);
-		total_freed_bytes += sizeof(ObjectPropertyDomainAxiom);
-		ax = SET_ITERATOR_NEXT(&set_iterator);
-	}
 	total_freed_bytes += SET_RESET(&(tbox->objectproperty_domain_axioms));
-
-	// free the same individual axioms
-	SET_ITERATOR_INIT(&set_iterator, &(tbox->same_individual_axioms));
-	ax = SET_ITERATOR_NEXT(&set_iterator);
-	while (ax) {
-		total_freed_bytes += list_reset(&(((SameIndividualAxiom*) ax)->individuals));
-		free(ax);
-		total_freed_bytes += sizeof(SameIndividualAxiom);
-		ax = SET_ITERATOR_NEXT(&set_iterator);
-	}
 	total_freed_bytes += SET_RESET(&(tbox->same_individual_axioms));
-
+	total_freed_bytes += SET_RESET(&(tbox->different_individuals_axioms));
 
 	/************************************************************/
 
-	// iterate over the existentials hash, free the existentials
-	MapIterator iterator;
-	MAP_ITERATOR_INIT(&iterator, &(tbox->object_some_values_from_exps));
-	void* map_element = MAP_ITERATOR_NEXT(&iterator);
-	while (map_element) {
-		total_freed_bytes += free_concept((ClassExpression*) map_element, tbox);
-		map_element = MAP_ITERATOR_NEXT(&iterator);
-	}
-	// free the existentials map
-	total_freed_bytes += MAP_RESET(&(tbox->object_some_values_from_exps));
+	// free the space allocated by the class expressions and the object property
+	// expressions. every expression has an id, including the ones generated in
+	// preprocessing, so the id tables contain all of them. the expressions
+	// themselves are in the expressions arena of the KB.
+	for (i = 0; i < tbox->next_class_expression_id; ++i)
+		total_freed_bytes += free_concept(tbox->class_expressions[i], tbox);
+	for (i = 0; i < tbox->next_objectproperty_expression_id; ++i)
+		total_freed_bytes += free_role(tbox->objectproperty_expressions[i]);
 
-	// iterate over the conjunctions map, free the conjunctions
-	MAP_ITERATOR_INIT(&iterator, &(tbox->object_intersection_of_exps));
-	map_element = MAP_ITERATOR_NEXT(&iterator);
-	while (map_element) {
-		total_freed_bytes += free_concept((ClassExpression*) map_element, tbox);
-		map_element = MAP_ITERATOR_NEXT(&iterator);
-	}
-	// free the conjunctions map
+	total_freed_bytes += MAP_RESET(&(tbox->object_some_values_from_exps));
 	total_freed_bytes += MAP_RESET(&(tbox->object_intersection_of_exps));
-
-	// iterate over the nominals map, free the nominals
-	MAP_ITERATOR_INIT(&iterator, &(tbox->object_one_of_exps));
-	map_element = MAP_ITERATOR_NEXT(&iterator);
-	while (map_element) {
-		total_freed_bytes += free_concept((ClassExpression*) map_element, tbox);
-		map_element = MAP_ITERATOR_NEXT(&iterator);
-	}
-	// free the nominals hash
 	total_freed_bytes += MAP_RESET(&(tbox->object_one_of_exps));
-
-	// iterate over the atomic concepts map, free the atomic concepts
-	MAP_ITERATOR_INIT(&iterator, &(tbox->classes));
-	map_element = MAP_ITERATOR_NEXT(&iterator);
-	while (map_element) {
-		total_freed_bytes += free_concept((ClassExpression*) map_element, tbox);
-		map_element = MAP_ITERATOR_NEXT(&iterator);
-	}
-	// free the atomic concepts hash
 	total_freed_bytes += MAP_RESET(&(tbox->classes));
-
-	// iterate over the role_compositions hash, free the role compositions
-	MAP_ITERATOR_INIT(&iterator, &(tbox->objectproperty_chains));
-	map_element = MAP_ITERATOR_NEXT(&iterator);
-	while (map_element) {
-		total_freed_bytes += free_role((ObjectPropertyExpression*) map_element);
-		map_element = MAP_ITERATOR_NEXT(&iterator);
-	}
-	// free the role compositions hash
 	total_freed_bytes += MAP_RESET(&(tbox->objectproperty_chains));
-
-	// iterate over atomic roles, free them
-	MAP_ITERATOR_INIT(&iterator, &(tbox->objectproperties));
-	map_element = MAP_ITERATOR_NEXT(&iterator);
-	while (map_element) {
-		total_freed_bytes += free_role((ObjectPropertyExpression*) map_element);
-		map_element = MAP_ITERATOR_NEXT(&iterator);
-	}
-	// free the atomic roles hash
 	total_freed_bytes += MAP_RESET(&(tbox->objectproperties));
 
+	// free the id tables
+	free(tbox->class_expressions);
+	total_freed_bytes += tbox->class_expressions_size * sizeof(ClassExpression*);
+	free(tbox->objectproperty_expressions);
+	total_freed_bytes += tbox->objectproperty_expressions_size * sizeof(ObjectPropertyExpression*);
+
 	// finally free the tbox itself
 	free(tbox);
 
 	return total_freed_bytes;
 }
 
-int free_individual(Individual* ind) {
-	int total_freed_bytes = 0;
-
-	total_freed_bytes += sizeof(char) * strlen(ind->IRI);
-	free(ind->IRI);
-
-	// finally free this individual
-	total_freed_bytes += sizeof(Individual);
-	free(ind);
-
-	return total_freed_bytes;
-}
-
 int free_abox(ABox* abox) {
-	int i, total_freed_bytes = 0;
+	int total_freed_bytes = 0;
 
-	// free concept assertions
-	for (i = 0; i < abox->concept_assertion_count; ++i)
-		free(abox->concept_assertions[i]);
-	total_freed_bytes += sizeof(ClassAssertion) * abox->concept_assertion_count;
+	// the assertions are in the axioms arena of the KB, free the arrays
 	free(abox->concept_assertions);
 	total_freed_bytes += sizeof(ClassAssertion*) * abox->concept_assertion_count;
 
-	// free role assertions
-	for (i = 0; i < abox->role_assertion_count; ++i)
-		free(abox->role_assertions[i]);
-	total_freed_bytes += sizeof(ObjectPropertyAssertion) * abox->role_assertion_count;
 	free(abox->role_assertions);
 	total_freed_bytes += sizeof(ObjectPropertyAssertion*) * abox->role_assertion_count;
 
-	// iterate over the individuals hash, free the individuals
-	HashMapElement* node = HASH_MAP_LAST_ELEMENT(abox->individuals);
-	while (node) {
-		total_freed_bytes += free_individual((Individual*) node->value);
-		node = HASH_MAP_PREVIOUS_ELEMENT(node);
-	}
-	// free the individuals hash
-	total_freed_bytes += hash_map_free(abox->individuals);
+	// the individuals are in the expressions arena of the KB, free the hash
+	total_freed_bytes += MAP_FREE(abox->individuals);
 
 	// finally free the abox itself
 	free(abox);
@@ -343,61 +243,68 @@ int free_kb(KB* kb) {
 	total_freed_bytes += free_tbox(kb->tbox);
 	total_freed_bytes += free_abox(kb->abox);
 
-	// free the prefix names
-	int i;
-	for (i = 0; i < kb->prefix_names.size; ++i) {
-		total_freed_bytes += sizeof(char) * strlen(kb->prefix_names.elements[i]);
-		free(kb->prefix_names.elements[i]);
-	}
+	// free the prefix names list and the prefixes map. the names
+	// and the prefixes themselves are in the string pool.
 	total_freed_bytes += list_reset(&kb->prefix_names);
-
-	// free the prefixes
-	MapIterator map_iterator;
-	void* map_element;
-
-	MAP_ITERATOR_INIT(&map_iterator, &(kb->prefixes));
-	map_element = MAP_ITERATOR_NEXT(&map_iterator);
-	while (map_element) {
-		// the value is prefix (char*), free it
-		total_freed_bytes += sizeof(char) * strlen((char*) map_element);
-		free(map_element);
-		map_element = MAP_ITERATOR_NEXT(&map_iterator);
-	}
-	// free the prefixes map
 	total_freed_bytes += MAP_RESET(&(kb->prefixes));
 
-	// free the generated subclass axioms
-	for (i = 0; i < kb->generated_subclass_axiom_count; ++i)
-		free(kb->generated_subclass_axioms[i]);
-	total_freed_bytes += sizeof(SubClassOfAxiom) * kb->generated_subclass_axiom_count;
+	// free the IRIs, prefix names and prefixes
+	total_freed_bytes += string_pool_reset(&(kb->iris));
+
+	// free the lists of the generated axioms, the axioms themselves are in the axioms arena
 	free(kb->generated_subclass_axioms);
 	total_freed_bytes += sizeof(SubClassOfAxiom*) * kb->generated_subclass_axiom_count;
-
-	// free the generated subrole axioms
-	for (i = 0; i < kb->generated_subrole_axiom_count; ++i)
-		free(kb->generated_subrole_axioms[i]);
-	total_freed_bytes += sizeof(SubObjectPropertyOfAxiom) * kb->generated_subrole_axiom_count;
 	free(kb->generated_subrole_axioms);
 	total_freed_bytes += sizeof(SubObjectPropertyOfAxiom*) * kb->generated_subrole_axiom_count;
 
-	// iterate over the generated nominals hash, free the nominals
-	MAP_ITERATOR_INIT(&map_iterator, &(kb->generated_nominals));
-	map_element = MAP_ITERATOR_NEXT(&map_iterator);
-	while (map_element) {
-		total_freed_bytes += free_concept((ClassExpression*) map_element, kb->tbox);
-		map_element = MAP_ITERATOR_NEXT(&map_iterator);
-	}
-	// free the generated nominals map
+	// the generated nominals and existential restrictions have already been freed
+	// together with the other class expressions in free_tbox
 	total_freed_bytes += MAP_RESET(&(kb->generated_nominals));
+	total_freed_bytes += MAP_FREE(kb->generated_exists_restrictions);
+
+	// free the expressions and the axioms
+	total_freed_bytes += arena_reset(&(kb->expressions));
+	total_freed_bytes += arena_reset(&(kb->axioms));
 
-	// iterate over the generated existential restrictions hash, free them
-	HashMapElement* node = HASH_MAP_LAST_ELEMENT(kb->generated_exists_restrictions);
-	while (node) {
-		total_freed_bytes += free_concept((ClassExpression*) node->value, kb->tbox);
-		node = HASH_MAP_PREVIOUS_ELEMENT(node);
+	return total_freed_bytes;
+}
+
+// give the freed space back to the system, otherwise malloc keeps it for
+// later allocations and the resident set size does not go down
+static void return_freed_memory() {
+#ifdef HAVE_MALLOC_TRIM
+	malloc_trim(0);
+#endif
+}
+
+int free_saturation_data(KB* kb) {
+	int total_freed_bytes = 0;
+	uint32_t i;
+	ClassExpression* c;
+
+	for (i = 0; i < kb->tbox->next_class_expression_id; ++i) {
+		c = kb->tbox->class_expressions[i];
+		total_freed_bytes += free_concept_saturation_data(c);
+		// the subsumers of conjunctions and existentials are not output
+		if (c->type == OBJECT_INTERSECTION_OF_TYPE || c->type == OBJECT_SOME_VALUES_FROM_TYPE)
+			total_freed_bytes += ID_SET_RESET(&(c->subsumers));
 	}
-	// free the generated nominals hash
-	total_freed_bytes += hash_map_free(kb->generated_exists_restrictions);
+	for (i = 0; i < kb->tbox->next_objectproperty_expression_id; ++i)
+		total_freed_bytes += free_role(kb->tbox->objectproperty_expressions[i]);
+
+	return_freed_memory();
+
+	return total_freed_bytes;
+}
+
+int free_subsumers(KB* kb) {
+	int total_freed_bytes = 0;
+	uint32_t i;
+
+	for (i = 0; i < kb->tbox->next_class_expression_id; ++i)
+		total_freed_bytes += ID_SET_RESET(&(kb->tbox->class_expressions[i]->subsumers));
+
+	return_freed_memory();
 
 	return total_freed_bytes;
 }
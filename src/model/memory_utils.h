@@ -28,4 +28,21 @@ int free_abox(ABox* abox);
 
 int free_kb(KB* kb);
 
+/**
+ * Free the data that is only needed in saturation: the links, the told
+ * subsumers, the negative existentials and conjunctions a class expression
+ * occurs in, the subsumers of the conjunctions and existentials, and the
+ * sets of the object property expressions. The subsumers of the classes
+ * and the nominals stay for the class hierarchy and the output.
+ * Returns the number of freed bytes.
+ */
+int free_saturation_data(KB* kb);
+
+/**
+ * Free the subsumers of all class expressions. Called once the class
+ * hierarchy is computed, the output only needs the hierarchy.
+ * Returns the number of freed bytes.
+ */
+int free_subsumers(KB* kb);
+
 #endif /* MEMORY_UTILS_H_ */
@@ -29,42 +29,85 @@
 #include "limits.h"
 
 // create ontology prefix if it does not already exist
-void create_prefix(char* prefix_name, char* prefix, KB* kb) {
-	if (GET_ONTOLOGY_PREFIX(prefix_name, kb) != NULL)
-		return;
+StringPoolEntry* create_prefix(char* prefix_name, uint32_t prefix_name_length, char* prefix, uint32_t prefix_length, KB* kb) {
+	StringPoolEntry* name = string_pool_intern(&(kb->iris), prefix_name, prefix_name_length);
+	char* iri = string_pool_intern(&(kb->iris), prefix, prefix_length)->string;
+	char* name_prefix = GET_ONTOLOGY_PREFIX(name, kb);
+	char new_name[32];
+	int i;
+
+	if (name_prefix == iri)
+		return name;
+	// the prefix already has another name, the IRIs are stored with that one
+	for (i = 0; i < kb->prefix_names.size; ++i)
+		if (GET_ONTOLOGY_PREFIX(STRING_POOL_ENTRY((char*) kb->prefix_names.elements[i]), kb) == iri)
+			return STRING_POOL_ENTRY((char*) kb->prefix_names.elements[i]);
+	// the name is used for another prefix, e.g., in an imported ontology
+	for (i = 1; name_prefix != NULL; ++i) {
+		snprintf(new_name, sizeof(new_name), "ns%d:", i);
+		name = string_pool_intern(&(kb->iris), new_name, strlen(new_name));
+		name_prefix = GET_ONTOLOGY_PREFIX(name, kb);
+	}
+
+	list_add(name->string, &(kb->prefix_names));
+	PUT_ONTOLOGY_PREFIX(name, iri, kb);
+
+	return name;
+}
+
+void assign_class_expression_id(ClassExpression* c, TBox* tbox) {
+	ClassExpression** tmp;
+
+	c->id = tbox->next_class_expression_id++;
+	if (c->id == tbox->class_expressions_size) {
+		// the table is full, double its size
+		tbox->class_expressions_size = (tbox->class_expressions_size == 0) ? DEFAULT_CLASS_EXPRESSIONS_TABLE_SIZE : 2 * tbox->class_expressions_size;
+		tmp = realloc(tbox->class_expressions, tbox->class_expressions_size * sizeof(ClassExpression*));
+		assert(tmp != NULL);
+		tbox->class_expressions = tmp;
+	}
+	tbox->class_expressions[c->id] = c;
+}
+
+void assign_objectproperty_expression_id(ObjectPropertyExpression* r, TBox* tbox) {
+	ObjectPropertyExpression** tmp;
 
-	list_add(prefix_name, &(kb->prefix_names));
-	PUT_ONTOLOGY_PREFIX(prefix_name, prefix, kb);
+	r->id = tbox->next_objectproperty_expression_id++;
+	if (r->id == tbox->objectproperty_expressions_size) {
+		tbox->objectproperty_expressions_size = (tbox->objectproperty_expressions_size == 0) ? DEFAULT_OBJECTPROPERTY_EXPRESSIONS_TABLE_SIZE : 2 * tbox->objectproperty_expressions_size;
+		tmp = realloc(tbox->objectproperty_expressions, tbox->objectproperty_expressions_size * sizeof(ObjectPropertyExpression*));
+		assert(tmp != NULL);
+		tbox->objectproperty_expressions = tmp;
+	}
+	tbox->objectproperty_expressions[r->id] = r;
 }
 
 /******************************************************************************
  * get/create functions for concepts
  *****************************************************************************/
 
-ClassExpression* get_create_atomic_concept(char* IRI, TBox* tbox) {
+ClassExpression* get_create_atomic_concept(StringPoolEntry* iri, TBox* tbox) {
 	ClassExpression* c;
-	ClassExpression** tmp;
 
 	// check if the atomic concept with this name already exists
-	// if ((c = get_atomic_concept((unsigned char*) name, tbox)) != NULL)
-	if ((c = GET_ATOMIC_CONCEPT(IRI, tbox)) != NULL)
+	if ((c = GET_ATOMIC_CONCEPT(iri, tbox)) != NULL)
 		return c;
 
 	// if an atomic concept with the name does not already exist, create it
-	c = (ClassExpression*) malloc(sizeof(ClassExpression));
-	assert(c != NULL);
+	c = (ClassExpression*) arena_allocate(tbox->expressions, sizeof(ClassExpression));
 
-	c->description.atomic.IRI = (char*) malloc((strlen(IRI) + 1) * sizeof(char));
-	assert(c->description.atomic.IRI != NULL);
+	// the IRI is not copied, it stays in the pool
+	c->description.atomic.IRI = iri->string;
 
-	strcpy(c->description.atomic.IRI, IRI);
+	// the direct subsumers and equivalent classes are created in hierarchy computation
+	c->description.atomic.hierarchy = NULL;
 
 	c->type = CLASS_TYPE;
-	c->id = tbox->next_class_expression_id++;
+	assign_class_expression_id(c, tbox);
 
 	LIST_INIT(&(c->told_subsumers));
 
-	SET_INIT(&(c->subsumers), DEFAULT_SUBSUMERS_HASH_SIZE);
+	ID_SET_INIT(&(c->subsumers), DEFAULT_SUBSUMERS_HASH_SIZE);
 
 	c->filler_of_negative_exists = NULL;
 
@@ -76,12 +119,9 @@ ClassExpression* get_create_atomic_concept(char* IRI, TBox* tbox) {
 	c->successor_r_count = 0;
 
 	LIST_INIT(&(c->first_conjunct_of_list));
-	c->first_conjunct_of = NULL;
-
 	LIST_INIT(&(c->second_conjunct_of_list));
-	c->second_conjunct_of = NULL;
 
-	PUT_ATOMIC_CONCEPT(c->description.atomic.IRI, c, tbox);
+	PUT_ATOMIC_CONCEPT(iri, c, tbox);
 
 	return c;
 }
@@ -98,18 +138,17 @@ ClassExpression* get_create_exists_restriction(ObjectPropertyExpression* r, Clas
 		return c;
 
 	// if it does not already exist, create it
-	c = (ClassExpression*) malloc(sizeof(ClassExpression));
-	assert(c != NULL);
+	c = (ClassExpression*) arena_allocate(tbox->expressions, sizeof(ClassExpression));
 
 	c->type = OBJECT_SOME_VALUES_FROM_TYPE;
 
 	c->description.exists.role = r;
 	c->description.exists.filler = f;
-	c->id = tbox->next_class_expression_id++;
+	assign_class_expression_id(c, tbox);
 
 	LIST_INIT(&(c->told_subsumers));
 
-	SET_INIT(&(c->subsumers), DEFAULT_SUBSUMERS_HASH_SIZE);
+	ID_SET_INIT(&(c->subsumers), DEFAULT_SUBSUMERS_HASH_SIZE);
 
 	c->filler_of_negative_exists = NULL;
 
@@ -121,10 +160,7 @@ ClassExpression* get_create_exists_restriction(ObjectPropertyExpression* r, Clas
 	c->successor_r_count = 0;
 
 	LIST_INIT(&(c->first_conjunct_of_list));
-	c->first_conjunct_of = NULL;
-
 	LIST_INIT(&(c->second_conjunct_of_list));
-	c->second_conjunct_of = NULL;
 
 	PUT_EXISTS_RESTRICTION(r->id, f->id, c, tbox);
 
@@ -138,8 +174,7 @@ ClassExpression* get_create_conjunction_binary(ClassExpression* c1, ClassExpress
 	if ((c = GET_CONJUNCTION(c1, c2, tbox)) != NULL)
 		return c;
 
-	c = (ClassExpression*) malloc(sizeof(ClassExpression));
-	assert(c != NULL);
+	c = (ClassExpression*) arena_allocate(tbox->expressions, sizeof(ClassExpression));
 
 	c->type = OBJECT_INTERSECTION_OF_TYPE;
 
@@ -152,11 +187,11 @@ ClassExpression* get_create_conjunction_binary(ClassExpression* c1, ClassExpress
 		c->description.conj.conjunct1 = c2;
 		c->description.conj.conjunct2 = c1;
 	}
-	c->id = tbox->next_class_expression_id++;
+	assign_class_expression_id(c, tbox);
 
 	LIST_INIT(&(c->told_subsumers));
 
-	SET_INIT(&(c->subsumers), DEFAULT_SUBSUMERS_HASH_SIZE);
+	ID_SET_INIT(&(c->subsumers), DEFAULT_SUBSUMERS_HASH_SIZE);
 
 	c->filler_of_negative_exists = NULL;
 
@@ -168,10 +203,7 @@ ClassExpression* get_create_conjunction_binary(ClassExpression* c1, ClassExpress
 	c->successor_r_count = 0;
 
 	LIST_INIT(&(c->first_conjunct_of_list));
-	c->first_conjunct_of = NULL;
-
 	LIST_INIT(&(c->second_conjunct_of_list));
-	c->second_conjunct_of = NULL;
 
 	PUT_CONJUNCTION(c, tbox);
 
@@ -211,17 +243,16 @@ ClassExpression* get_create_nominal(Individual* ind, TBox* tbox) {
 		return c;
 
 	// if a nominal with the individual does not already exist, create it
-	c = (ClassExpression*) malloc(sizeof(ClassExpression));
-	assert(c != NULL);
+	c = (ClassExpression*) arena_allocate(tbox->expressions, sizeof(ClassExpression));
 
 	c->description.nominal.individual = ind;
 
 	c->type = OBJECT_ONE_OF_TYPE;
-	c->id = tbox->next_class_expression_id++;
+	assign_class_expression_id(c, tbox);
 
 	LIST_INIT(&(c->told_subsumers));
 
-	SET_INIT(&(c->subsumers), DEFAULT_SUBSUMERS_HASH_SIZE);
+	ID_SET_INIT(&(c->subsumers), DEFAULT_SUBSUMERS_HASH_SIZE);
 
 	c->filler_of_negative_exists = NULL;
 
@@ -233,10 +264,7 @@ ClassExpression* get_create_nominal(Individual* ind, TBox* tbox) {
 	c->successor_r_count = 0;
 
 	LIST_INIT(&(c->first_conjunct_of_list));
-	c->first_conjunct_of = NULL;
-
 	LIST_INIT(&(c->second_conjunct_of_list));
-	c->second_conjunct_of = NULL;
 
 	PUT_NOMINAL(c, tbox);
 
@@ -246,39 +274,36 @@ ClassExpression* get_create_nominal(Individual* ind, TBox* tbox) {
  * get/create functions for roles
  *****************************************************************************/
 
-ObjectPropertyExpression* get_create_atomic_role(char* IRI, TBox* tbox) {
+ObjectPropertyExpression* get_create_atomic_role(StringPoolEntry* iri, TBox* tbox) {
 	ObjectPropertyExpression* r;
 
 	// check if the atomic role already exists
-	if ((r = GET_ATOMIC_ROLE(IRI, tbox)) != NULL)
+	if ((r = GET_ATOMIC_ROLE(iri, tbox)) != NULL)
 		return r;
 
 	// if it does not already exist, create it
-	r = (ObjectPropertyExpression*) malloc(sizeof(ObjectPropertyExpression));
-	assert(r != NULL);
+	r = (ObjectPropertyExpression*) arena_allocate(tbox->expressions, sizeof(ObjectPropertyExpression));
 
 	r->type = OBJECT_PROPERTY_TYPE;
-	r->description.atomic.IRI = (char*) malloc((strlen(IRI) + 1) * sizeof(char));
-	assert(r->description.atomic.IRI != NULL);
-	strcpy(r->description.atomic.IRI, IRI);
-	r->id = tbox->next_objectproperty_expression_id++;
+	r->description.atomic.IRI = iri->string;
+	assign_objectproperty_expression_id(r, tbox);
 
-	SET_INIT(&(r->told_subsumers), DEFAULT_ROLE_TOLD_SUBSUMERS_HASH_SIZE);
+	ID_SET_INIT(&(r->told_subsumers), DEFAULT_ROLE_TOLD_SUBSUMERS_HASH_SIZE);
 
 	LIST_INIT(&(r->subsumer_list));
-	SET_INIT(&(r->subsumers), DEFAULT_ROLE_SUBSUMERS_HASH_SIZE);
+	ID_SET_INIT(&(r->subsumers), DEFAULT_ROLE_SUBSUMERS_HASH_SIZE);
 
-	SET_INIT(&(r->subsumees), DEFAULT_ROLE_SUBSUMEES_HASH_SIZE);
+	ID_SET_INIT(&(r->subsumees), DEFAULT_ROLE_SUBSUMEES_HASH_SIZE);
 
 	r->first_component_of_count = 0;
 	r->first_component_of_list = NULL;
-	SET_INIT(&(r->first_component_of), DEFAULT_ROLE_FIRST_COMPONENT_OF_HASH_SIZE);
+	ID_SET_INIT(&(r->first_component_of), DEFAULT_ROLE_FIRST_COMPONENT_OF_HASH_SIZE);
 
 	r->second_component_of_count = 0;
 	r->second_component_of_list = NULL;
-	SET_INIT(&(r->second_component_of), DEFAULT_ROLE_SECOND_COMPONENT_OF_HASH_SIZE);
+	ID_SET_INIT(&(r->second_component_of), DEFAULT_ROLE_SECOND_COMPONENT_OF_HASH_SIZE);
 
-	PUT_ATOMIC_ROLE(r->description.atomic.IRI, r, tbox);
+	PUT_ATOMIC_ROLE(iri, r, tbox);
 
 	return r;
 }
@@ -292,29 +317,28 @@ ObjectPropertyExpression* get_create_role_composition_binary(ObjectPropertyExpre
 	if ((r = GET_ROLE_COMPOSITION(r1, r2, tbox)) != NULL)
 		return r;
 
-	r = (ObjectPropertyExpression*) malloc(sizeof(ObjectPropertyExpression));
-	assert(r != NULL);
+	r = (ObjectPropertyExpression*) arena_allocate(tbox->expressions, sizeof(ObjectPropertyExpression));
 
 	r->type = OBJECT_PROPERTY_CHAIN_TYPE;
 	// we DO assume role1 and role2 to be ordered!
 	r->description.object_property_chain.role1 = r1;
 	r->description.object_property_chain.role2 = r2;
-	r->id = tbox->next_objectproperty_expression_id++;
+	assign_objectproperty_expression_id(r, tbox);
 
-	SET_INIT(&(r->told_subsumers), DEFAULT_ROLE_TOLD_SUBSUMERS_HASH_SIZE);
+	ID_SET_INIT(&(r->told_subsumers), DEFAULT_ROLE_TOLD_SUBSUMERS_HASH_SIZE);
 
 	LIST_INIT(&(r->subsumer_list));
-	SET_INIT(&(r->subsumers), DEFAULT_ROLE_SUBSUMERS_HASH_SIZE);
+	ID_SET_INIT(&(r->subsumers), DEFAULT_ROLE_SUBSUMERS_HASH_SIZE);
 
-	SET_INIT(&(r->subsumees), DEFAULT_ROLE_SUBSUMEES_HASH_SIZE);
+	ID_SET_INIT(&(r->subsumees), DEFAULT_ROLE_SUBSUMEES_HASH_SIZE);
 
 	r->first_component_of_count = 0;
 	r->first_component_of_list = NULL;
-	SET_INIT(&(r->first_component_of), DEFAULT_ROLE_FIRST_COMPONENT_OF_HASH_SIZE);
+	ID_SET_INIT(&(r->first_component_of), DEFAULT_ROLE_FIRST_COMPONENT_OF_HASH_SIZE);
 
 	r->second_component_of_count = 0;
 	r->second_component_of_list = NULL;
-	SET_INIT(&(r->second_component_of), DEFAULT_ROLE_SECOND_COMPONENT_OF_HASH_SIZE);
+	ID_SET_INIT(&(r->second_component_of), DEFAULT_ROLE_SECOND_COMPONENT_OF_HASH_SIZE);
 
 	PUT_ROLE_COMPOSITION(r, tbox);
 
@@ -340,33 +364,30 @@ ObjectPropertyExpression* get_create_role_composition(int size, ObjectPropertyEx
  * create functions for axioms
  *****************************************************************************/
 // create the subclass axiom with the given concept descriptions
-SubClassOfAxiom* create_subclass_axiom(ClassExpression* lhs, ClassExpression* rhs) {
-	SubClassOfAxiom* ax = (SubClassOfAxiom*) malloc(sizeof(SubClassOfAxiom));
-	assert(ax != NULL);
+SubClassOfAxiom* create_subclass_axiom(ClassExpression* lhs, ClassExpression* rhs, TBox* tbox) {
+	SubClassOfAxiom* ax = (SubClassOfAxiom*) arena_allocate(tbox->axioms, sizeof(SubClassOfAxiom));
 	ax->lhs = lhs;
 	ax->rhs = rhs;
 	return ax;
 }
 
 // create the equivalent classes axiom with the given concept descriptions
-EquivalentClassesAxiom* create_eqclass_axiom(ClassExpression* lhs, ClassExpression* rhs) {
+EquivalentClassesAxiom* create_eqclass_axiom(ClassExpression* lhs, ClassExpression* rhs, TBox* tbox) {
 	/*
 	if (lhs->type != ATOMIC_CONCEPT) {
 		fprintf(stderr,"the lhs of an equivalent classes axiom must be an atomic concept, aborting\n");
 		exit(EXIT_FAILURE);
 	}
 	*/
-	EquivalentClassesAxiom* ax = (EquivalentClassesAxiom*) malloc(sizeof(EquivalentClassesAxiom));
-	assert(ax != NULL);
+	EquivalentClassesAxiom* ax = (EquivalentClassesAxiom*) arena_allocate(tbox->axioms, sizeof(EquivalentClassesAxiom));
 	ax->lhs = lhs;
 	ax->rhs = rhs;
 	return ax;
 }
 
 // create the disjointclasses axiom with the given concept descriptions
-DisjointClassesAxiom* create_disjointclasses_axiom(int class_count, ClassExpression** classes) {
-	DisjointClassesAxiom* ax = (DisjointClassesAxiom*) calloc(1, sizeof(DisjointClassesAxiom));
-	assert(ax != NULL);
+DisjointClassesAxiom* create_disjointclasses_axiom(int class_count, ClassExpression** classes, TBox* tbox) {
+	DisjointClassesAxiom* ax = (DisjointClassesAxiom*) arena_allocate(tbox->axioms, sizeof(DisjointClassesAxiom));
 	LIST_INIT(&(ax->classes));
 	int i;
 	for (i = 0; i < class_count; ++i)
@@ -376,43 +397,38 @@ DisjointClassesAxiom* create_disjointclasses_axiom(int class_count, ClassExpress
 }
 
 // create the subrole axiom with the given role descriptions
-SubObjectPropertyOfAxiom* create_subrole_axiom(ObjectPropertyExpression* lhs, ObjectPropertyExpression* rhs) {
-	SubObjectPropertyOfAxiom* ax = (SubObjectPropertyOfAxiom*) malloc(sizeof(SubObjectPropertyOfAxiom));
-	assert(ax != NULL);
+SubObjectPropertyOfAxiom* create_subrole_axiom(ObjectPropertyExpression* lhs, ObjectPropertyExpression* rhs, TBox* tbox) {
+	SubObjectPropertyOfAxiom* ax = (SubObjectPropertyOfAxiom*) arena_allocate(tbox->axioms, sizeof(SubObjectPropertyOfAxiom));
 	ax->lhs = lhs;
 	ax->rhs = rhs;
 	return ax;
 }
 
-TransitiveObjectPropertyAxiom* create_transitive_role_axiom(ObjectPropertyExpression* r) {
-	TransitiveObjectPropertyAxiom* ax = (TransitiveObjectPropertyAxiom*) malloc(sizeof(TransitiveObjectPropertyAxiom));
-	assert(ax != NULL);
+TransitiveObjectPropertyAxiom* create_transitive_role_axiom(ObjectPropertyExpression* r, TBox* tbox) {
+	TransitiveObjectPropertyAxiom* ax = (TransitiveObjectPropertyAxiom*) arena_allocate(tbox->axioms, sizeof(TransitiveObjectPropertyAxiom));
 	ax->r = r;
 	return ax;
 }
 
 // create the eqrole axiom with the given role descriptions
-EquivalentObjectPropertiesAxiom* create_eqrole_axiom(ObjectPropertyExpression* lhs, ObjectPropertyExpression* rhs) {
-	EquivalentObjectPropertiesAxiom* ax = (EquivalentObjectPropertiesAxiom*) malloc(sizeof(EquivalentObjectPropertiesAxiom));
-	assert(ax != NULL);
+EquivalentObjectPropertiesAxiom* create_eqrole_axiom(ObjectPropertyExpression* lhs, ObjectPropertyExpression* rhs, TBox* tbox) {
+	EquivalentObjectPropertiesAxiom* ax = (EquivalentObjectPropertiesAxiom*) arena_allocate(tbox->axioms, sizeof(EquivalentObjectPropertiesAxiom));
 	ax->lhs = lhs;
 	ax->rhs = rhs;
 	return ax;
 }
 
 // create an objectproperty domain axiom with the given objectproperty and class expressions
-ObjectPropertyDomainAxiom* create_objectproperty_domain_axiom(ObjectPropertyExpression* ope, ClassExpression* ce) {
-	ObjectPropertyDomainAxiom* ax = (ObjectPropertyDomainAxiom*) malloc(sizeof(ObjectPropertyDomainAxiom));
-	assert(ax != NULL);
+ObjectPropertyDomainAxiom* create_objectproperty_domain_axiom(ObjectPropertyExpression* ope, ClassExpression* ce, TBox* tbox) {
+	ObjectPropertyDomainAxiom* ax = (ObjectPropertyDomainAxiom*) arena_allocate(tbox->axioms, sizeof(ObjectPropertyDomainAxiom));
 	ax->object_property_expression = ope;
 	ax->class_expression = ce;
 	return ax;
 }
 
 // create a SameIndividual axiom with the given list of individuals
-SameIndividualAxiom* create_same_individual_axiom(int individual_count, Individual** individuals) {
-	SameIndividualAxiom* ax = (SameIndividualAxiom*) calloc(1, sizeof(SameIndividualAxiom));
-	assert(ax != NULL);
+SameIndividualAxiom* create_same_individual_axiom(int individual_count, Individual** individuals, TBox* tbox) {
+	SameIndividualAxiom* ax = (SameIndividualAxiom*) arena_allocate(tbox->axioms, sizeof(SameIndividualAxiom));
 	LIST_INIT(&(ax->individuals));
 	int i;
 	for (i = 0; i < individual_count; ++i)
@@ -422,9 +438,8 @@ SameIndividualAxiom* create_same_individual_axiom(int individual_count, Individu
 }
 
 // create a DifferentIndividuals axiom with the given list of individuals
-DifferentIndividualsAxiom* create_different_individuals_axiom(int individual_count, Individual** individuals) {
-	DifferentIndividualsAxiom* ax = (DifferentIndividualsAxiom*) calloc(1, sizeof(DifferentIndividualsAxiom));
-	assert(ax != NULL);
+DifferentIndividualsAxiom* create_different_individuals_axiom(int individual_count, Individual** individuals, TBox* tbox) {
+	DifferentIndividualsAxiom* ax = (DifferentIndividualsAxiom*) arena_allocate(tbox->axioms, sizeof(DifferentIndividualsAxiom));
 	LIST_INIT(&(ax->individuals));
 	int i;
 	for (i = 0; i < individual_count; ++i)
@@ -436,24 +451,21 @@ DifferentIndividualsAxiom* create_different_individuals_axiom(int individual_cou
  * get/create functions for ABox
  *****************************************************************************/
 
-Individual* get_create_individual(char* name, ABox* abox) {
+Individual* get_create_individual(StringPoolEntry* iri, ABox* abox) {
 	Individual* i;
 
 	// check if an individual with this name already exists in the ABox
-	if ((i = (Individual*) GET_INDIVIDUAL(name, abox)) != NULL)
+	if ((i = (Individual*) GET_INDIVIDUAL(iri, abox)) != NULL)
 		return i;
 
 	// if an individual with the name does not already exist, create it
-	i = (Individual*) malloc(sizeof(Individual));
-	assert(i != NULL);
+	i = (Individual*) arena_allocate(abox->expressions, sizeof(Individual));
 
 	i->id = abox->last_individual_id++;
 
-	i->IRI = (char*) malloc((strlen(name) + 1) * sizeof(char));
-	assert(i->IRI != NULL);
-	strcpy(i->IRI, name);
+	i->IRI = iri->string;
 
-	PUT_INDIVIDUAL(i->IRI, i, abox);
+	PUT_INDIVIDUAL(iri, i, abox);
 
 	++abox->individual_count;
 
@@ -464,9 +476,8 @@ Individual* get_create_individual(char* name, ABox* abox) {
  * create functions for assertions
  *****************************************************************************/
 // create the concept assertion with the given individual and concept
-ClassAssertion* create_concept_assertion(Individual* ind, ClassExpression* c) {
-	ClassAssertion* as = (ClassAssertion*) malloc(sizeof(ClassAssertion));
-	assert(as != NULL);
+ClassAssertion* create_concept_assertion(Individual* ind, ClassExpression* c, ABox* abox) {
+	ClassAssertion* as = (ClassAssertion*) arena_allocate(abox->axioms, sizeof(ClassAssertion));
 	as->individual = ind;
 	as->concept = c;
 
@@ -474,9 +485,8 @@ ClassAssertion* create_concept_assertion(Individual* ind, ClassExpression* c) {
 }
 
 // create the role assertion with the given role and individuals
-ObjectPropertyAssertion* create_role_assertion(ObjectPropertyExpression* role, Individual* source_ind, Individual* target_ind) {
-	ObjectPropertyAssertion* as = (ObjectPropertyAssertion*) malloc(sizeof(ObjectPropertyAssertion));
-	assert(as != NULL);
+ObjectPropertyAssertion* create_role_assertion(ObjectPropertyExpression* role, Individual* source_ind, Individual* target_ind, ABox* abox) {
+	ObjectPropertyAssertion* as = (ObjectPropertyAssertion*) arena_allocate(abox->axioms, sizeof(ObjectPropertyAssertion));
 	as->role = role;
 	as->source_individual = source_ind;
 	as->target_individual = target_ind;
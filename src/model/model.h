@@ -27,16 +27,27 @@
 #define OWL_THING	"owl:Thing"
 #define OWL_NOTHING	"owl:Nothing"
 
-// create ontology prefix if it does not already exist
-void create_prefix(char* prefix_name, char* prefix, KB* kb);
+// create ontology prefix if it does not already exist. the prefix name and
+// the prefix of the given lengths need not be '\0' terminated. returns the
+// name of the prefix in the kb, every prefix has one name there: the name
+// it already has, or the given name. if the given name is already used for
+// another prefix, e.g., in an imported ontology, the prefix gets a new name
+// "ns1:", "ns2:", ...
+StringPoolEntry* create_prefix(char* prefix_name, uint32_t prefix_name_length, char* prefix, uint32_t prefix_length, KB* kb);
+
+// assign the next class expression id to c and insert c into the id table of the tbox
+void assign_class_expression_id(ClassExpression* c, TBox* tbox);
+
+// assign the next object property expression id to r and insert r into the id table of the tbox
+void assign_objectproperty_expression_id(ObjectPropertyExpression* r, TBox* tbox);
 
 /******************************************************************************
  * get/create functions for concepts
  *****************************************************************************/
 
-// returns the atomic concept with given name or creates if it does not
-// already exist
-ClassExpression* get_create_atomic_concept(char* name, TBox* tbox);
+// returns the atomic concept with the given IRI or creates it if it does not
+// already exist. the IRI is interned in the string pool of the tbox.
+ClassExpression* get_create_atomic_concept(StringPoolEntry* iri, TBox* tbox);
 
 // get or create the existential restriction with role r and filler f
 ClassExpression* get_create_exists_restriction(ObjectPropertyExpression* r, ClassExpression* f, TBox* tbox);
@@ -53,9 +64,9 @@ ClassExpression* get_create_nominal(Individual* ind, TBox* tbox);
 /******************************************************************************
  * get/create functions for roles
  *****************************************************************************/
-// returns the atomic role with given name or creates if it does not
-// already exist
-ObjectPropertyExpression* get_create_atomic_role(char* name, TBox* tbox);
+// returns the atomic role with the given IRI or creates it if it does not
+// already exist. the IRI is interned in the string pool of the tbox.
+ObjectPropertyExpression* get_create_atomic_role(StringPoolEntry* iri, TBox* tbox);
 
 // get or create the role composition consisting of the given roles.
 // called by the parser.
@@ -66,31 +77,31 @@ ObjectPropertyExpression* get_create_role_composition_binary(ObjectPropertyExpre
  * create functions for axioms
  *****************************************************************************/
 // create the subclass axiom with the given concept descriptions
-SubClassOfAxiom* create_subclass_axiom(ClassExpression* lhs, ClassExpression* rhs);
+SubClassOfAxiom* create_subclass_axiom(ClassExpression* lhs, ClassExpression* rhs, TBox* tbox);
 
 // create the equivalent class axiom with the given concept descriptions
-EquivalentClassesAxiom* create_eqclass_axiom(ClassExpression* lhs, ClassExpression* rhs);
+EquivalentClassesAxiom* create_eqclass_axiom(ClassExpression* lhs, ClassExpression* rhs, TBox* tbox);
 
 // create disjoint classes axiom
-DisjointClassesAxiom* create_disjointclasses_axiom(int class_count, ClassExpression** classes);
+DisjointClassesAxiom* create_disjointclasses_axiom(int class_count, ClassExpression** classes, TBox* tbox);
 
 // create the subrole axiom with the given role descriptions
-SubObjectPropertyOfAxiom* create_subrole_axiom(ObjectPropertyExpression* lhs, ObjectPropertyExpression* rhs);
+SubObjectPropertyOfAxiom* create_subrole_axiom(ObjectPropertyExpression* lhs, ObjectPropertyExpression* rhs, TBox* tbox);
 
 // create transitive role axiom
-TransitiveObjectPropertyAxiom* create_transitive_role_axiom(ObjectPropertyExpression* r);
+TransitiveObjectPropertyAxiom* create_transitive_role_axiom(ObjectPropertyExpression* r, TBox* tbox);
 
 // create the eqrole axiom with the given role descriptions
-EquivalentObjectPropertiesAxiom* create_eqrole_axiom(ObjectPropertyExpression* lhs, ObjectPropertyExpression* rhs);
+EquivalentObjectPropertiesAxiom* create_eqrole_axiom(ObjectPropertyExpression* lhs, ObjectPropertyExpression* rhs, TBox* tbox);
 
 // create an objectproperty domain axiom with the given objectproperty and class expressions
-ObjectPropertyDomainAxiom* create_objectproperty_domain_axiom(ObjectPropertyExpression* ope, ClassExpression* ce);
+ObjectPropertyDomainAxiom* create_objectproperty_domain_axiom(ObjectPropertyExpression* ope, ClassExpression* ce, TBox* tbox);
 
 // create a SameIndividual axiom with the given list of individuals
-SameIndividualAxiom* create_same_individual_axiom(int individual_count, Individual** individuals);
+SameIndividualAxiom* create_same_individual_axiom(int individual_count, Individual** individuals, TBox* tbox);
 
 // create a DifferentIndividuals axiom with the given list of individuals
-DifferentIndividualsAxiom* create_different_individuals_axiom(int individual_count, Individual** individuals);
+DifferentIndividualsAxiom* create_different_individuals_axiom(int individual_count, Individual** individuals, TBox* tbox);
 /******************************************************************************
  * add functions for axioms
 *****************************************************************************/
@@ -124,18 +135,18 @@ DifferentIndividualsAxiom* create_different_individuals_axiom(int individual_cou
  * Get/create functions for ABox
  *****************************************************************************/
 
-// returns the individual with given name or creates if it does not
-// already exist
-Individual* get_create_individual(char* name, ABox* abox);
+// returns the individual with the given IRI or creates it if it does not
+// already exist. the IRI is interned in the string pool of the abox.
+Individual* get_create_individual(StringPoolEntry* iri, ABox* abox);
 
 /******************************************************************************
  * Create functions for ABox assertions
  *****************************************************************************/
 // create the concept assertion axiom with the given concept description and individual
-ClassAssertion* create_concept_assertion(Individual* individual, ClassExpression* concept);
+ClassAssertion* create_concept_assertion(Individual* individual, ClassExpression* concept, ABox* abox);
 
 // create the role assertion with the given role and individuals
-ObjectPropertyAssertion* create_role_assertion(ObjectPropertyExpression* role, Individual* source_ind, Individual* target_ind);
+ObjectPropertyAssertion* create_role_assertion(ObjectPropertyExpression* role, Individual* source_ind, Individual* target_ind, ABox* abox);
 
 /******************************************************************************
  * Add functions for ABox assertions
@@ -65,62 +65,104 @@ char* object_property_expression_to_string(KB* kb, ObjectPropertyExpression* r)
 	}
 }
 	
-char* iri_to_string(KB* kb, char* iri) {
-	char* str;
-
-	// Check of the IRI is a full IRI
-	if (iri[0] == '<') {
-		// it is a full IRI, just return it
-		int iri_length = strlen(iri);
-		str = calloc(1, sizeof(char) * (iri_length + 1/* for the '\0' character */));
-		assert(str != NULL);
-		snprintf(str, iri_length + 1, "%s", iri);
-
-		return str;
+// the prefix of the last prefixed name that has been expanded, most names
+// in a row have the same prefix
+typedef struct {
+	KB* kb;
+	// the prefix name with the ':'
+	char* name;
+	uint32_t name_length;
+	// the prefix without the '>', NULL if the prefix name is not declared
+	char* prefix;
+	uint32_t prefix_length;
+} PrefixCache;
+
+// the prefix name of owl:Thing and owl:Nothing, and its prefix
+#define OWL_PREFIX_NAME			"owl:"
+#define OWL_PREFIX_NAME_LENGTH	(sizeof(OWL_PREFIX_NAME) - 1)
+#define OWL_BUILTIN_PREFIX		"<http://www.w3.org/2002/07/owl#>"
+
+static void prefix_cache_init(PrefixCache* cache, KB* kb) {
+	cache->kb = kb;
+	cache->name = NULL;
+	cache->name_length = 0;
+	cache->prefix = NULL;
+	cache->prefix_length = 0;
+}
 
+// split the given IRI into the prefix and the local name. returns the
+// length of the prefix name with the ':', 0 if the IRI is not a prefixed
+// name with a declared prefix or with owl:. the prefix is then in the cache.
+static uint32_t split_iri(PrefixCache* cache, char* iri, uint32_t length) {
+	char* colon;
+	uint32_t name_length;
+	StringPoolEntry* name;
+
+	// a full IRI
+	if (iri[0] == '<' || (colon = memchr(iri, ':', length)) == NULL)
+		return 0;
+	name_length = colon - iri + 1;
+
+	if (cache->name == NULL || cache->name_length != name_length || memcmp(cache->name, iri, name_length) != 0) {
+		// the prefix name is in the pool if it has been declared
+		name = string_pool_get(&(cache->kb->iris), iri, name_length);
+		cache->prefix = (name == NULL) ? NULL : (char*) GET_ONTOLOGY_PREFIX(name, cache->kb);
+		if (cache->prefix != NULL) {
+			cache->name = name->string;
+			cache->prefix_length = STRING_POOL_ENTRY(cache->prefix)->length - 1;
+		} else if (name_length == OWL_PREFIX_NAME_LENGTH && memcmp(iri, OWL_PREFIX_NAME, name_length) == 0) {
+			// owl:Thing and owl:Nothing are stored with the owl prefix name,
+			// also if the ontology does not declare it
+			cache->name = OWL_PREFIX_NAME;
+			cache->prefix = OWL_BUILTIN_PREFIX;
+			cache->prefix_length = sizeof(OWL_BUILTIN_PREFIX) - 2;
+		} else {
+			cache->name = NULL;
+			return 0;
+		}
+		cache->name_length = name_length;
 	}
-	// Check if the IRI is a prefixed name (search for a ":")
-	int index = 0;
-	for (index = 0; iri[index] != ':' && iri[index] != '\0'; ++index);
 
-	if (iri[index] == '\0') {
-		// The IRI does not have a prefix, just return it
-		str = calloc(1, sizeof(char) * (index + 1 + 1/* for the '\0' character */));
-		assert(str != NULL);
-		snprintf(str, index + 1, "%s", iri);
+	return name_length;
+}
 
-		return str;
+// write the given IRI to the given file, expanded if it is a prefixed name
+static void print_iri(PrefixCache* cache, char* iri, FILE* fp) {
+	uint32_t length = STRING_POOL_ENTRY(iri)->length;
+	uint32_t name_length = split_iri(cache, iri, length);
+
+	if (name_length == 0) {
+		fwrite(iri, 1, length, fp);
+		return;
 	}
+	fwrite(cache->prefix, 1, cache->prefix_length, fp);
+	fwrite(iri + name_length, 1, length - name_length, fp);
+	putc('>', fp);
+}
 
-	// The IRI has a prefix
-	char* prefix = NULL;
-	char* prefix_name = calloc(1, sizeof(char) * (index + 1 /* for the ':' */ + 1 /* for the '\0' character */));
-	assert(prefix_name != NULL);
-	strncpy(prefix_name, iri, index + 1);
+char* iri_to_string(KB* kb, char* iri) {
+	PrefixCache cache;
+	uint32_t length = STRING_POOL_ENTRY(iri)->length;
+	uint32_t name_length;
+	char* str;
 
-	if ((prefix = GET_ONTOLOGY_PREFIX(prefix_name, kb)) != NULL) {
-		int prefix_length = strlen(prefix);
-		str = calloc(1, sizeof(char) * (prefix_length + strlen(iri) - index /* IRI without the prefix name + 1 for the '\0' */));
+	prefix_cache_init(&cache, kb);
+	name_length = split_iri(&cache, iri, length);
+	if (name_length == 0) {
+		// a full IRI, or the prefix is not declared. just return it.
+		str = malloc(length + 1);
 		assert(str != NULL);
-		// copy the prefix
-		strncpy(str, prefix, prefix_length - 1 /* leave out the trailing > sign */);
-		// now copy the IRI without the prefix name (part after the ':')
-		int i;
-		for (i = 0; iri[index + 1 + i] != '\0'; ++i) {
-			str[prefix_length - 1 + i] = iri[index + 1 + i];
-		}
-		// append the '>'
-		str[prefix_length - 1 + i] = '>';
-		// append the '\0'
-		++i;
-		str[prefix_length - 1 + i] = '\0';
-
+		memcpy(str, iri, length + 1);
 		return str;
 	}
-	// it is a prefixed IRI but the prefix name is not found in the prefix names map, just return the IRI
-	str = calloc(1, sizeof (char) * (strlen(iri) + 1));
+
+	// the prefix, the local name, the '>' and the '\0'
+	str = malloc(cache.prefix_length + length - name_length + 2);
 	assert(str != NULL);
-	snprintf(str, strlen(iri), "%s", iri);
+	memcpy(str, cache.prefix, cache.prefix_length);
+	memcpy(str + cache.prefix_length, iri + name_length, length - name_length);
+	str[cache.prefix_length + length - name_length] = '>';
+	str[cache.prefix_length + length - name_length + 1] = '\0';
 
 	return str;
 }
@@ -239,23 +281,38 @@ void print_tbox(KB* kb) {
 	}
 }
 
+static void print_prefixes(KB* kb, FILE* taxonomy_fp) {
+	int i;
+
+	for (i = 0; i < kb->prefix_names.size; ++i)
+		fprintf(taxonomy_fp, "Prefix(%s=%s)\n", (char*) kb->prefix_names.elements[i], (char*) GET_ONTOLOGY_PREFIX(STRING_POOL_ENTRY((char*) kb->prefix_names.elements[i]), kb));
+}
+
+// print EquivalentClasses(owl:Thing, owl:Nothing) for an inconsistent ontology
+static void print_inconsistent(PrefixCache* cache, KB* kb, FILE* taxonomy_fp) {
+	fputs("EquivalentClasses(", taxonomy_fp);
+	print_iri(cache, kb->tbox->top_concept->description.atomic.IRI, taxonomy_fp);
+	putc(' ', taxonomy_fp);
+	print_iri(cache, kb->tbox->bottom_concept->description.atomic.IRI, taxonomy_fp);
+	fputs(")\n", taxonomy_fp);
+}
+
+// the IRIs are written to the file as they are expanded, they are not
+// copied to strings first
 void print_concept_hierarchy(KB* kb, FILE* taxonomy_fp) {
+	PrefixCache cache;
+
+	prefix_cache_init(&cache, kb);
 
 	// the prefixes
-	int i;
-	for (i = 0; i < kb->prefix_names.size; ++i)
-		fprintf(taxonomy_fp, "Prefix(%s=%s)\n", (char*) kb->prefix_names.elements[i], (char*) GET_ONTOLOGY_PREFIX((char*) kb->prefix_names.elements[i], kb));
+	print_prefixes(kb, taxonomy_fp);
 
 	// the ontology tag
 	fprintf(taxonomy_fp, "\nOntology(\n");
 
 	// just print EquivalentClasses(owl:Thing, owl:Nothing) if the ontology is inconsistent
 	if (kb->inconsistent) {
-		char* thing_str = class_expression_to_string(kb, kb->tbox->top_concept);
-		char* nothing_str = class_expression_to_string(kb, kb->tbox->bottom_concept);
-		fprintf(taxonomy_fp, "EquivalentClasses(%s %s)\n", thing_str, nothing_str);
-		free(thing_str);
-		free(nothing_str);
+		print_inconsistent(&cache, kb, taxonomy_fp);
 		// the closing parentheses for the ontology tag
 		fprintf(taxonomy_fp, ")\n");
 		return;
@@ -268,45 +325,42 @@ void print_concept_hierarchy(KB* kb, FILE* taxonomy_fp) {
 	SetIterator equivalent_classes_iterator;
 	MAP_ITERATOR_INIT(&map_it, &(kb->tbox->classes));
 	ClassExpression* atomic_concept = (ClassExpression*) MAP_ITERATOR_NEXT(&map_it);
-	char* atomic_concept_str;
 	SetIterator direct_subsumers_iterator;
 	while (atomic_concept) {
 		// check if the equivalence class is already printed
 		if (!SET_CONTAINS(atomic_concept, printed)) {
-			atomic_concept_str = class_expression_to_string(kb, atomic_concept);
 			// do not print the direct subsumers of bottom
 			if (atomic_concept != kb->tbox->bottom_concept) {
 				// iterate over the direct subsumers and print them
-				SET_ITERATOR_INIT(&direct_subsumers_iterator, &(atomic_concept->description.atomic.direct_subsumers));
+				SET_ITERATOR_INIT(&direct_subsumers_iterator, &(atomic_concept->description.atomic.hierarchy->direct_subsumers));
 				ClassExpression* direct_subsumer = (ClassExpression*) SET_ITERATOR_NEXT(&direct_subsumers_iterator);
-				char* direct_subsumer_str;
 				while (direct_subsumer != NULL) {
-					direct_subsumer_str = class_expression_to_string(kb, direct_subsumer);
-					fprintf(taxonomy_fp, "SubClassOf(%s %s)\n", atomic_concept_str, direct_subsumer_str);
-					free(direct_subsumer_str);
+					fputs("SubClassOf(", taxonomy_fp);
+					print_iri(&cache, atomic_concept->description.atomic.IRI, taxonomy_fp);
+					putc(' ', taxonomy_fp);
+					print_iri(&cache, direct_subsumer->description.atomic.IRI, taxonomy_fp);
+					fputs(")\n", taxonomy_fp);
 					direct_subsumer = SET_ITERATOR_NEXT(&direct_subsumers_iterator);
 				}
 			}
 
 			// print the equivalent classes
-			if (atomic_concept->description.atomic.equivalent_classes.element_count > 0) {
-				fprintf(taxonomy_fp, "EquivalentClasses(%s", atomic_concept_str);
+			if (atomic_concept->description.atomic.hierarchy->equivalent_classes.element_count > 0) {
+				fputs("EquivalentClasses(", taxonomy_fp);
+				print_iri(&cache, atomic_concept->description.atomic.IRI, taxonomy_fp);
 
-				SET_ITERATOR_INIT(&equivalent_classes_iterator, &(atomic_concept->description.atomic.equivalent_classes));
+				SET_ITERATOR_INIT(&equivalent_classes_iterator, &(atomic_concept->description.atomic.hierarchy->equivalent_classes));
 				ClassExpression* equivalent_class = SET_ITERATOR_NEXT(&equivalent_classes_iterator);
-				char* equivalent_class_str;
 				while (equivalent_class != NULL) {
 					// mark the concepts in the equivalent classes as already printed
 					SET_ADD(equivalent_class, printed);
 					// now print it
-					equivalent_class_str = class_expression_to_string(kb, equivalent_class);
-					fprintf(taxonomy_fp, " %s", equivalent_class_str);
-					free(equivalent_class_str);
+					putc(' ', taxonomy_fp);
+					print_iri(&cache, equivalent_class->description.atomic.IRI, taxonomy_fp);
 					equivalent_class = SET_ITERATOR_NEXT(&equivalent_classes_iterator);
 				}
 				fprintf(taxonomy_fp, ")\n");
 			}
-			free(atomic_concept_str);
 		}
 		atomic_concept = MAP_ITERATOR_NEXT(&map_it);
 	}
@@ -319,21 +373,18 @@ void print_concept_hierarchy(KB* kb, FILE* taxonomy_fp) {
 }
 
 void print_individual_types(KB* kb, FILE* taxonomy_fp) {
+	PrefixCache cache;
+
+	prefix_cache_init(&cache, kb);
 
 	// the prefixes
-	int i;
-	for (i = 0; i < kb->prefix_names.size; ++i)
-		fprintf(taxonomy_fp, "Prefix(%s=%s)\n", (char*) kb->prefix_names.elements[i], (char*) GET_ONTOLOGY_PREFIX((char*) kb->prefix_names.elements[i], kb));
+	print_prefixes(kb, taxonomy_fp);
 
 	// the ontology tag
 	fprintf(taxonomy_fp, "\nOntology(\n");
 
 	if (kb->inconsistent) {
-		char* thing_str = class_expression_to_string(kb, kb->tbox->top_concept);
-		char* nothing_str = class_expression_to_string(kb, kb->tbox->bottom_concept);
-		fprintf(taxonomy_fp, "EquivalentClasses(%s %s)\n", thing_str, nothing_str);
-		free(thing_str);
-		free(nothing_str);
+		print_inconsistent(&cache, kb, taxonomy_fp);
 		// the closing parentheses for the ontology tag
 		fprintf(taxonomy_fp, ")\n");
 		return;
@@ -344,22 +395,21 @@ void print_individual_types(KB* kb, FILE* taxonomy_fp) {
 	MapIterator iterator;
 	MAP_ITERATOR_INIT(&iterator, &(kb->generated_nominals));
 	ClassExpression* nominal = (ClassExpression*) MAP_ITERATOR_NEXT(&iterator);
-	SetIterator subsumers_iterator;
-	char* nominal_str;
+	IdSetIterator subsumers_iterator;
 	while (nominal) {
-		char* subsumer_str;
-		nominal_str = iri_to_string(kb, nominal->description.nominal.individual->IRI);
-		SET_ITERATOR_INIT(&subsumers_iterator, &(nominal->subsumers));
-		ClassExpression* subsumer = (ClassExpression*) SET_ITERATOR_NEXT(&subsumers_iterator);
-		while (subsumer != NULL) {
+		ID_SET_ITERATOR_INIT(&subsumers_iterator, &(nominal->subsumers));
+		uint32_t subsumer_id = ID_SET_ITERATOR_NEXT(&subsumers_iterator);
+		while (subsumer_id != ID_SET_ITERATOR_END) {
+			ClassExpression* subsumer = GET_CLASS_EXPRESSION(subsumer_id, kb->tbox);
 			if (subsumer->type == CLASS_TYPE) {
-				subsumer_str = class_expression_to_string(kb, subsumer);
-				fprintf(taxonomy_fp, "ClassAssertion(%s %s)\n", subsumer_str, nominal_str);
-				free(subsumer_str);
+				fputs("ClassAssertion(", taxonomy_fp);
+				print_iri(&cache, subsumer->description.atomic.IRI, taxonomy_fp);
+				putc(' ', taxonomy_fp);
+				print_iri(&cache, nominal->description.nominal.individual->IRI, taxonomy_fp);
+				fputs(")\n", taxonomy_fp);
 			}
-			subsumer = (ClassExpression*) SET_ITERATOR_NEXT(&subsumers_iterator);
+			subsumer_id = ID_SET_ITERATOR_NEXT(&subsumers_iterator);
 		}
-		free(nominal_str);
 		nominal = (ClassExpression*) MAP_ITERATOR_NEXT(&iterator);
 	}
 
@@ -420,3 +470,61 @@ void print_short_stats(KB* kb) {
 			kb->tbox->same_individual_axioms.element_count,
 			kb->tbox->different_individuals_axioms.element_count);
 }
+
+// accumulate the statistics of the subsumer and link sets of all class expressions
+static void collect_class_expression_stats(TBox* tbox, HashStats* subsumers_stats, HashStats* links_stats) {
+	uint32_t id;
+	int i;
+	for (id = 0; id < tbox->next_class_expression_id; ++id) {
+		ClassExpression* c = GET_CLASS_EXPRESSION(id, tbox);
+		ID_SET_COLLECT_STATS(&(c->subsumers), subsumers_stats);
+		for (i = 0; i < c->predecessor_r_count; ++i)
+			ID_SET_COLLECT_STATS(&(c->predecessors[i].fillers), links_stats);
+		for (i = 0; i < c->successor_r_count; ++i)
+			ID_SET_COLLECT_STATS(&(c->successors[i].fillers), links_stats);
+	}
+}
+
+void print_hash_stats(KB* kb, FILE* fp) {
+	HashStats stats, subsumers_stats, links_stats;
+
+	fprintf(fp, "\n------ Hash statistics (mixer %d) ------\n", HASH_MIXER);
+
+	hash_stats_init(&stats);
+	MAP_COLLECT_STATS(&(kb->tbox->classes), &stats);
+	hash_stats_print(&stats, "Classes map", fp);
+
+	hash_stats_init(&stats);
+	MAP_COLLECT_STATS(&(kb->tbox->object_some_values_from_exps), &stats);
+	hash_stats_print(&stats, "ObjectSomeValuesFrom map", fp);
+
+	hash_stats_init(&stats);
+	MAP_COLLECT_STATS(&(kb->tbox->object_intersection_of_exps), &stats);
+	hash_stats_print(&stats, "ObjectIntersectionOf map", fp);
+
+	hash_stats_init(&stats);
+	MAP_COLLECT_STATS(&(kb->tbox->objectproperties), &stats);
+	hash_stats_print(&stats, "ObjectProperties map", fp);
+
+	hash_stats_init(&stats);
+	MAP_COLLECT_STATS(kb->abox->individuals, &stats);
+	hash_stats_print(&stats, "Individuals map", fp);
+
+	hash_stats_init(&subsumers_stats);
+	hash_stats_init(&links_stats);
+	collect_class_expression_stats(kb->tbox, &subsumers_stats, &links_stats);
+	hash_stats_print(&subsumers_stats, "Subsumer sets", fp);
+	hash_stats_print(&links_stats, "Link filler sets", fp);
+
+	hash_stats_init(&stats);
+	MapIterator it;
+	MAP_ITERATOR_INIT(&it, &(kb->tbox->classes));
+	ClassExpression* c = (ClassExpression*) MAP_ITERATOR_NEXT(&it);
+	while (c) {
+		// the hierarchy is not computed for every reasoning task
+		if (c->description.atomic.hierarchy != NULL)
+			SET_COLLECT_STATS(&(c->description.atomic.hierarchy->direct_subsumers), &stats);
+		c = (ClassExpression*) MAP_ITERATOR_NEXT(&it);
+	}
+	hash_stats_print(&stats, "Direct subsumer sets", fp);
+}
@@ -43,4 +43,7 @@ void print_individual_types(KB* kb, FILE* taxonomy_fp);
 // void print_short_stats(TBox* tbox, ABox* abox);
 void print_short_stats(KB* kb);
 
+// print the load factors and probe length histograms of the maps and sets of the kb
+void print_hash_stats(KB* kb, FILE* fp);
+
 #endif
@@ -0,0 +1,644 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <sys/stat.h>
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
+#include "datatypes.h"
+#include "model.h"
+#include "utils.h"
+#include "snapshot.h"
+
+// the strings are padded to a multiple of 4 bytes
+#define PADDED_LENGTH(length)		(((length) + 3) & ~((uint32_t) 3))
+
+/******************************************************************************
+ * writing
+ *****************************************************************************/
+static inline void write_id(uint32_t id, FILE* file) {
+	fwrite(&id, sizeof(uint32_t), 1, file);
+}
+
+static void write_strings(KB* kb, KBSnapshotHeader* header, FILE* file) {
+	StringPoolEntry** entries;
+	uint32_t i, zero = 0;
+
+	header->string_count = kb->iris.string_count;
+	entries = (StringPoolEntry**) malloc(header->string_count * sizeof(StringPoolEntry*));
+	assert(entries != NULL);
+	string_pool_entries(&(kb->iris), entries);
+	for (i = 0; i < header->string_count; ++i) {
+		write_id(entries[i]->length, file);
+		write_id(STRING_POOL_HASH(entries[i]->string, entries[i]->length), file);
+		fwrite(entries[i]->string, 1, entries[i]->length, file);
+		fwrite(&zero, 1, PADDED_LENGTH(entries[i]->length) - entries[i]->length, file);
+	}
+	free(entries);
+}
+
+static void write_prefixes(KB* kb, KBSnapshotHeader* header, FILE* file) {
+	StringPoolEntry* name;
+	int i;
+
+	header->prefix_count = kb->prefix_names.size;
+	for (i = 0; i < kb->prefix_names.size; ++i) {
+		name = STRING_POOL_ENTRY((char*) kb->prefix_names.elements[i]);
+		write_id(name->id, file);
+		write_id(STRING_POOL_ENTRY((char*) GET_ONTOLOGY_PREFIX(name, kb))->id, file);
+	}
+}
+
+static void write_individuals(KB* kb, KBSnapshotHeader* header, FILE* file) {
+	Individual** individuals;
+	Individual* individual;
+	MapIterator iterator;
+	uint32_t i;
+
+	// in the order of their ids, which start at 1
+	header->individual_count = kb->abox->individual_count;
+	individuals = (Individual**) malloc((header->individual_count + 1) * sizeof(Individual*));
+	assert(individuals != NULL);
+	MAP_ITERATOR_INIT(&iterator, kb->abox->individuals);
+	for (individual = MAP_ITERATOR_NEXT(&iterator); individual != NULL; individual = MAP_ITERATOR_NEXT(&iterator))
+		individuals[individual->id] = individual;
+	for (i = 1; i <= header->individual_count; ++i)
+		write_id(STRING_POOL_ENTRY(individuals[i]->IRI)->id, file);
+	free(individuals);
+}
+
+static void write_objectproperty_expressions(TBox* tbox, KBSnapshotHeader* header, FILE* file) {
+	ObjectPropertyExpression* r;
+	uint32_t i;
+
+	header->objectproperty_expression_count = tbox->next_objectproperty_expression_id;
+	for (i = 0; i < header->objectproperty_expression_count; ++i) {
+		r = tbox->objectproperty_expressions[i];
+		write_id(r->type, file);
+		switch (r->type) {
+		case OBJECT_PROPERTY_TYPE:
+			++header->object_properties;
+			write_id(STRING_POOL_ENTRY(r->description.atomic.IRI)->id, file);
+			write_id(0, file);
+			break;
+		case OBJECT_PROPERTY_CHAIN_TYPE:
+			++header->object_property_chains;
+			write_id(r->description.object_property_chain.role1->id, file);
+			write_id(r->description.object_property_chain.role2->id, file);
+			break;
+		}
+	}
+}
+
+static void write_class_expressions(TBox* tbox, KBSnapshotHeader* header, FILE* file) {
+	ClassExpression* c;
+	uint32_t i;
+
+	header->class_expression_count = tbox->next_class_expression_id;
+	for (i = 0; i < header->class_expression_count; ++i) {
+		c = tbox->class_expressions[i];
+		write_id(c->type, file);
+		switch (c->type) {
+		case CLASS_TYPE:
+			++header->classes;
+			write_id(STRING_POOL_ENTRY(c->description.atomic.IRI)->id, file);
+			write_id(0, file);
+			break;
+		case OBJECT_INTERSECTION_OF_TYPE:
+			++header->object_intersection_of;
+			write_id(c->description.conj.conjunct1->id, file);
+			write_id(c->description.conj.conjunct2->id, file);
+			break;
+		case OBJECT_SOME_VALUES_FROM_TYPE:
+			++header->object_some_values_from;
+			write_id(c->description.exists.role->id, file);
+			write_id(c->description.exists.filler->id, file);
+			break;
+		case OBJECT_ONE_OF_TYPE:
+			++header->object_one_of;
+			write_id(c->description.nominal.individual->id, file);
+			write_id(0, file);
+			break;
+		}
+	}
+}
+
+// the class expressions in the given list, preceded by their number
+static void write_class_list(List* classes, FILE* file) {
+	int i;
+
+	write_id(classes->size, file);
+	for (i = 0; i < classes->size; ++i)
+		write_id(((ClassExpression*) classes->elements[i])->id, file);
+}
+
+// the individuals in the given list, preceded by their number
+static void write_individual_list(List* individuals, FILE* file) {
+	int i;
+
+	write_id(individuals->size, file);
+	for (i = 0; i < individuals->size; ++i)
+		write_id(((Individual*) individuals->elements[i])->id, file);
+}
+
+static void write_axioms(TBox* tbox, KBSnapshotHeader* header, FILE* file) {
+	SetIterator iterator;
+	void* ax;
+
+	SET_ITERATOR_INIT(&iterator, &(tbox->subclass_of_axioms));
+	for (ax = SET_ITERATOR_NEXT(&iterator); ax != NULL; ax = SET_ITERATOR_NEXT(&iterator)) {
+		write_id(((SubClassOfAxiom*) ax)->lhs->id, file);
+		write_id(((SubClassOfAxiom*) ax)->rhs->id, file);
+		++header->subclass_of_axioms;
+	}
+	SET_ITERATOR_INIT(&iterator, &(tbox->equivalent_classes_axioms));
+	for (ax = SET_ITERATOR_NEXT(&iterator); ax != NULL; ax = SET_ITERATOR_NEXT(&iterator)) {
+		write_id(((EquivalentClassesAxiom*) ax)->lhs->id, file);
+		write_id(((EquivalentClassesAxiom*) ax)->rhs->id, file);
+		++header->equivalent_classes_axioms;
+	}
+	SET_ITERATOR_INIT(&iterator, &(tbox->disjoint_classes_axioms));
+	for (ax = SET_ITERATOR_NEXT(&iterator); ax != NULL; ax = SET_ITERATOR_NEXT(&iterator)) {
+		write_class_list(&(((DisjointClassesAxiom*) ax)->classes), file);
+		++header->disjoint_classes_axioms;
+	}
+	SET_ITERATOR_INIT(&iterator, &(tbox->subobjectproperty_of_axioms));
+	for (ax = SET_ITERATOR_NEXT(&iterator); ax != NULL; ax = SET_ITERATOR_NEXT(&iterator)) {
+		write_id(((SubObjectPropertyOfAxiom*) ax)->lhs->id, file);
+		write_id(((SubObjectPropertyOfAxiom*) ax)->rhs->id, file);
+		++header->subobjectproperty_of_axioms;
+	}
+	SET_ITERATOR_INIT(&iterator, &(tbox->equivalent_objectproperties_axioms));
+	for (ax = SET_ITERATOR_NEXT(&iterator); ax != NULL; ax = SET_ITERATOR_NEXT(&iterator)) {
+		write_id(((EquivalentObjectPropertiesAxiom*) ax)->lhs->id, file);
+		write_id(((EquivalentObjectPropertiesAxiom*) ax)->rhs->id, file);
+		++header->equivalent_objectproperties_axioms;
+	}
+	SET_ITERATOR_INIT(&iterator, &(tbox->transitive_objectproperty_axioms));
+	for (ax = SET_ITERATOR_NEXT(&iterator); ax != NULL; ax = SET_ITERATOR_NEXT(&iterator)) {
+		write_id(((TransitiveObjectPropertyAxiom*) ax)->r->id, file);
+		++header->transitive_objectproperty_axioms;
+	}
+	SET_ITERATOR_INIT(&iterator, &(tbox->objectproperty_domain_axioms));
+	for (ax = SET_ITERATOR_NEXT(&iterator); ax != NULL; ax = SET_ITERATOR_NEXT(&iterator)) {
+		write_id(((ObjectPropertyDomainAxiom*) ax)->object_property_expression->id, file);
+		write_id(((ObjectPropertyDomainAxiom*) ax)->class_expression->id, file);
+		++header->objectproperty_domain_axioms;
+	}
+	SET_ITERATOR_INIT(&iterator, &(tbox->same_individual_axioms));
+	for (ax = SET_ITERATOR_NEXT(&iterator); ax != NULL; ax = SET_ITERATOR_NEXT(&iterator)) {
+		write_individual_list(&(((SameIndividualAxiom*) ax)->individuals), file);
+		++header->same_individual_axioms;
+	}
+	SET_ITERATOR_INIT(&iterator, &(tbox->different_individuals_axioms));
+	for (ax = SET_ITERATOR_NEXT(&iterator); ax != NULL; ax = SET_ITERATOR_NEXT(&iterator)) {
+		write_individual_list(&(((DifferentIndividualsAxiom*) ax)->individuals), file);
+		++header->different_individuals_axioms;
+	}
+}
+
+static void write_assertions(ABox* abox, KBSnapshotHeader* header, FILE* file) {
+	int i;
+
+	header->class_assertions = abox->concept_assertion_count;
+	for (i = 0; i < abox->concept_assertion_count; ++i) {
+		write_id(abox->concept_assertions[i]->individual->id, file);
+		write_id(abox->concept_assertions[i]->concept->id, file);
+	}
+	header->object_property_assertions = abox->role_assertion_count;
+	for (i = 0; i < abox->role_assertion_count; ++i) {
+		write_id(abox->role_assertions[i]->role->id, file);
+		write_id(abox->role_assertions[i]->source_individual->id, file);
+		write_id(abox->role_assertions[i]->target_individual->id, file);
+	}
+}
+
+char write_kb_snapshot(KB* kb, char* file_name) {
+	KBSnapshotHeader header;
+	FILE* file;
+	char result;
+
+	file = fopen(file_name, "wb");
+	if (file == NULL)
+		return 0;
+
+	memset(&header, 0, sizeof(KBSnapshotHeader));
+	memcpy(header.magic, KB_SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.version = KB_SNAPSHOT_VERSION;
+	header.byte_order = KB_SNAPSHOT_BYTE_ORDER;
+	header.hash_check = STRING_POOL_HASH(KB_SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.object_some_values_from_exps_count = kb->tbox->object_some_values_from_exps_count;
+	header.object_intersection_of_exps_count = kb->tbox->object_intersection_of_exps_count;
+	header.binary_object_intersection_of_exps_count = kb->tbox->binary_object_intersection_of_exps_count;
+	header.role_composition_count = kb->tbox->role_composition_count;
+	header.binary_role_composition_count = kb->tbox->binary_role_composition_count;
+
+	// the header is written again at the end, with the counts and the offsets
+	fwrite(&header, sizeof(KBSnapshotHeader), 1, file);
+	header.strings = ftell(file);
+	write_strings(kb, &header, file);
+	header.prefixes = ftell(file);
+	write_prefixes(kb, &header, file);
+	header.individuals = ftell(file);
+	write_individuals(kb, &header, file);
+	header.objectproperty_expressions = ftell(file);
+	write_objectproperty_expressions(kb->tbox, &header, file);
+	header.class_expressions = ftell(file);
+	write_class_expressions(kb->tbox, &header, file);
+	header.axioms = ftell(file);
+	write_axioms(kb->tbox, &header, file);
+	header.assertions = ftell(file);
+	write_assertions(kb->abox, &header, file);
+	header.size = ftell(file);
+
+	rewind(file);
+	fwrite(&header, sizeof(KBSnapshotHeader), 1, file);
+	result = !ferror(file);
+	if (fclose(file) != 0)
+		result = 0;
+
+	return result;
+}
+
+/******************************************************************************
+ * reading
+ *****************************************************************************/
+// checks that a section at the given offset with count records of the given
+// number of ids each ends before the given offset
+static inline char check_section(uint64_t offset, uint64_t count, uint32_t ids, uint64_t end) {
+	return offset <= end && offset % sizeof(uint32_t) == 0 && count * ids * sizeof(uint32_t) <= end - offset;
+}
+
+// checks that the sections are in order and that they have room for the
+// counts in the header, which size the tables of the KB. the strings and the
+// n-ary axioms are only checked against their minimum size, the rest is
+// checked while they are read.
+static char check_sections(KBSnapshotHeader* header) {
+	uint64_t axiom_ids = 2 * ((uint64_t) header->subclass_of_axioms + header->equivalent_classes_axioms
+			+ header->subobjectproperty_of_axioms + header->equivalent_objectproperties_axioms + header->objectproperty_domain_axioms)
+			+ (uint64_t) header->transitive_objectproperty_axioms + header->disjoint_classes_axioms
+			+ header->same_individual_axioms + header->different_individuals_axioms;
+
+	return header->strings >= sizeof(KBSnapshotHeader)
+			&& (uint64_t) header->classes + header->object_some_values_from + header->object_intersection_of
+				+ header->object_one_of == header->class_expression_count
+			&& (uint64_t) header->object_properties + header->object_property_chains == header->objectproperty_expression_count
+			&& check_section(header->strings, header->string_count, 2, header->prefixes)
+			&& check_section(header->prefixes, header->prefix_count, 2, header->individuals)
+			&& check_section(header->individuals, header->individual_count, 1, header->objectproperty_expressions)
+			&& check_section(header->objectproperty_expressions, header->objectproperty_expression_count, 3, header->class_expressions)
+			&& check_section(header->class_expressions, header->class_expression_count, 3, header->axioms)
+			&& check_section(header->axioms, axiom_ids, 1, header->assertions)
+			&& check_section(header->assertions, 2 * (uint64_t) header->class_assertions + 3 * (uint64_t) header->object_property_assertions, 1, header->size);
+}
+
+KBSnapshot* open_kb_snapshot(char* file_name) {
+	KBSnapshot* snapshot;
+	KBSnapshotHeader* header;
+	struct stat status;
+	FILE* file;
+
+	file = fopen(file_name, "rb");
+	if (file == NULL) {
+		fprintf(stderr, "%s: cannot open the snapshot\n", file_name);
+		return NULL;
+	}
+	if (fstat(fileno(file), &status) != 0 || (size_t) status.st_size < sizeof(KBSnapshotHeader)) {
+		fprintf(stderr, "%s: not a KB snapshot\n", file_name);
+		fclose(file);
+		return NULL;
+	}
+	snapshot = (KBSnapshot*) malloc(sizeof(KBSnapshot));
+	assert(snapshot != NULL);
+	snapshot->size = status.st_size;
+	snapshot->mapped = 0;
+#ifdef HAVE_MMAP
+	snapshot->start = mmap(NULL, snapshot->size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+	if (snapshot->start != MAP_FAILED) {
+		snapshot->mapped = 1;
+		// the sections are read once in order
+		madvise(snapshot->start, snapshot->size, MADV_SEQUENTIAL);
+	}
+	else
+#endif
+	{
+		snapshot->start = (char*) malloc(snapshot->size);
+		assert(snapshot->start != NULL);
+		if (fread(snapshot->start, 1, snapshot->size, file) != snapshot->size) {
+			fprintf(stderr, "%s: cannot read the snapshot\n", file_name);
+			free(snapshot->start);
+			free(snapshot);
+			fclose(file);
+			return NULL;
+		}
+	}
+	fclose(file);
+
+	header = snapshot->header = (KBSnapshotHeader*) snapshot->start;
+	if (memcmp(header->magic, KB_SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 || header->size != snapshot->size) {
+		fprintf(stderr, "%s: not a KB snapshot\n", file_name);
+		close_kb_snapshot(snapshot);
+		return NULL;
+	}
+	if (header->version != KB_SNAPSHOT_VERSION || header->byte_order != KB_SNAPSHOT_BYTE_ORDER
+			|| header->hash_check != STRING_POOL_HASH(KB_SNAPSHOT_MAGIC, sizeof(header->magic))) {
+		fprintf(stderr, "%s: the snapshot has been written by another version or on another kind of machine\n", file_name);
+		close_kb_snapshot(snapshot);
+		return NULL;
+	}
+	if (!check_sections(header)) {
+		fprintf(stderr, "%s: the snapshot is corrupt\n", file_name);
+		close_kb_snapshot(snapshot);
+		return NULL;
+	}
+
+	return snapshot;
+}
+
+// the strings get the same ids as in the KB the snapshot has been taken of
+static char read_strings(KBSnapshot* snapshot, KB* kb, StringPoolEntry** strings) {
+	KBSnapshotHeader* header = snapshot->header;
+	char* s = snapshot->start + header->strings, * end = snapshot->start + header->prefixes;
+	uint32_t i, length, * p;
+
+	for (i = 0; i < header->string_count; ++i) {
+		if ((size_t) (end - s) < 2 * sizeof(uint32_t))
+			return 0;
+		p = (uint32_t*) s;
+		length = p[0];
+		s += 2 * sizeof(uint32_t);
+		if (length > (size_t) (end - s) || PADDED_LENGTH(length) > (size_t) (end - s))
+			return 0;
+		strings[i] = string_pool_intern_hash(&(kb->iris), s, length, p[1]);
+		// the same string twice
+		if (strings[i]->id != i)
+			return 0;
+		s += PADDED_LENGTH(length);
+	}
+
+	return 1;
+}
+
+static char read_prefixes(KBSnapshot* snapshot, KB* kb, StringPoolEntry** strings) {
+	KBSnapshotHeader* header = snapshot->header;
+	uint32_t i, * p;
+
+	p = (uint32_t*) (snapshot->start + header->prefixes);
+	for (i = 0; i < header->prefix_count; ++i, p += 2) {
+		if (p[0] >= header->string_count || p[1] >= header->string_count)
+			return 0;
+		create_prefix(strings[p[0]]->string, strings[p[0]]->length, strings[p[1]]->string, strings[p[1]]->length, kb);
+	}
+
+	return 1;
+}
+
+static char read_individuals(KBSnapshot* snapshot, KB* kb, StringPoolEntry** strings, Individual** individuals) {
+	KBSnapshotHeader* header = snapshot->header;
+	uint32_t i, * p;
+
+	p = (uint32_t*) (snapshot->start + header->individuals);
+	for (i = 1; i <= header->individual_count; ++i, ++p) {
+		if (*p >= header->string_count)
+			return 0;
+		individuals[i] = get_create_individual(strings[*p], kb->abox);
+		if (individuals[i]->id != i)
+			return 0;
+	}
+
+	return 1;
+}
+
+// the components of a chain and the operands of a class expression have
+// smaller ids, they have already been created
+static char read_objectproperty_expressions(KBSnapshot* snapshot, KB* kb, StringPoolEntry** strings) {
+	KBSnapshotHeader* header = snapshot->header;
+	TBox* tbox = kb->tbox;
+	ObjectPropertyExpression* r;
+	uint32_t i, * p;
+
+	p = (uint32_t*) (snapshot->start + header->objectproperty_expressions);
+	for (i = 0; i < header->objectproperty_expression_count; ++i, p += 3) {
+		if (p[0] == OBJECT_PROPERTY_TYPE && p[1] < header->string_count)
+			r = get_create_atomic_role(strings[p[1]], tbox);
+		else if (p[0] == OBJECT_PROPERTY_CHAIN_TYPE && p[1] < i && p[2] < i)
+			r = get_create_role_composition_binary(tbox->objectproperty_expressions[p[1]], tbox->objectproperty_expressions[p[2]], tbox);
+		else
+			return 0;
+		// the same expression twice
+		if (r->id != i)
+			return 0;
+	}
+
+	return 1;
+}
+
+static char read_class_expressions(KBSnapshot* snapshot, KB* kb, StringPoolEntry** strings, Individual** individuals) {
+	KBSnapshotHeader* header = snapshot->header;
+	TBox* tbox = kb->tbox;
+	ClassExpression* c;
+	uint32_t i, * p;
+
+	p = (uint32_t*) (snapshot->start + header->class_expressions);
+	for (i = 0; i < header->class_expression_count; ++i, p += 3) {
+		if (p[0] == CLASS_TYPE && p[1] < header->string_count)
+			c = get_create_atomic_concept(strings[p[1]], tbox);
+		else if (p[0] == OBJECT_INTERSECTION_OF_TYPE && p[1] < i && p[2] < i)
+			c = get_create_conjunction_binary(tbox->class_expressions[p[1]], tbox->class_expressions[p[2]], tbox);
+		else if (p[0] == OBJECT_SOME_VALUES_FROM_TYPE && p[1] < header->objectproperty_expression_count && p[2] < i)
+			c = get_create_exists_restriction(tbox->objectproperty_expressions[p[1]], tbox->class_expressions[p[2]], tbox);
+		else if (p[0] == OBJECT_ONE_OF_TYPE && p[1] >= 1 && p[1] <= header->individual_count)
+			c = get_create_nominal(individuals[p[1]], tbox);
+		else
+			return 0;
+		if (c->id != i)
+			return 0;
+	}
+
+	return 1;
+}
+
+// the ids of the given number of class expressions in the axioms section,
+// the number is checked against the rest of the section
+#define CLASS_IDS_VALID(p, n)			ids_valid(p, n, end, 0, header->class_expression_count)
+#define ROLE_IDS_VALID(p, n)			ids_valid(p, n, end, 0, header->objectproperty_expression_count)
+#define INDIVIDUAL_IDS_VALID(p, n)		ids_valid(p, n, end, 1, header->individual_count + 1)
+
+// returns 1 if there are count ids at p before end, and they are at least
+// first and less than limit
+static inline char ids_valid(uint32_t* p, uint32_t count, uint32_t* end, uint32_t first, uint32_t limit) {
+	uint32_t i;
+
+	if (count > (size_t) (end - p))
+		return 0;
+	for (i = 0; i < count; ++i)
+		if (p[i] < first || p[i] >= limit)
+			return 0;
+
+	return 1;
+}
+
+// the axioms, in the order of write_axioms. operands is an empty list for
+// the operands of the n-ary ones.
+static char read_axioms(KBSnapshot* snapshot, KB* kb, Individual** individuals, List* operands) {
+	KBSnapshotHeader* header = snapshot->header;
+	TBox* tbox = kb->tbox;
+	uint32_t i, j, count, * p, * end;
+
+	p = (uint32_t*) (snapshot->start + header->axioms);
+	end = (uint32_t*) (snapshot->start + header->assertions);
+	for (i = 0; i < header->subclass_of_axioms; ++i, p += 2) {
+		if (!CLASS_IDS_VALID(p, 2))
+			return 0;
+		ADD_SUBCLASS_OF_AXIOM(create_subclass_axiom(tbox->class_expressions[p[0]], tbox->class_expressions[p[1]], tbox), tbox);
+	}
+	for (i = 0; i < header->equivalent_classes_axioms; ++i, p += 2) {
+		if (!CLASS_IDS_VALID(p, 2))
+			return 0;
+		ADD_EQUIVALENT_CLASSES_AXIOM(create_eqclass_axiom(tbox->class_expressions[p[0]], tbox->class_expressions[p[1]], tbox), tbox);
+	}
+	for (i = 0; i < header->disjoint_classes_axioms; ++i) {
+		if (p >= end)
+			return 0;
+		count = *p++;
+		if (!CLASS_IDS_VALID(p, count))
+			return 0;
+		for (j = 0; j < count; ++j)
+			list_add(tbox->class_expressions[*p++], operands);
+		ADD_DISJOINT_CLASSES_AXIOM(create_disjointclasses_axiom(operands->size, (ClassExpression**) operands->elements, tbox), tbox);
+		operands->size = 0;
+	}
+	for (i = 0; i < header->subobjectproperty_of_axioms; ++i, p += 2) {
+		if (!ROLE_IDS_VALID(p, 2))
+			return 0;
+		ADD_SUBOBJECTPROPERTY_OF_AXIOM(create_subrole_axiom(tbox->objectproperty_expressions[p[0]], tbox->objectproperty_expressions[p[1]], tbox), tbox);
+	}
+	for (i = 0; i < header->equivalent_objectproperties_axioms; ++i, p += 2) {
+		if (!ROLE_IDS_VALID(p, 2))
+			return 0;
+		ADD_EQUIVALENT_OBJECTPROPERTIES_AXIOM(create_eqrole_axiom(tbox->objectproperty_expressions[p[0]], tbox->objectproperty_expressions[p[1]], tbox), tbox);
+	}
+	for (i = 0; i < header->transitive_objectproperty_axioms; ++i, ++p) {
+		if (!ROLE_IDS_VALID(p, 1))
+			return 0;
+		ADD_TRANSITIVE_OBJECTPROPERTY_AXIOM(create_transitive_role_axiom(tbox->objectproperty_expressions[*p], tbox), tbox);
+	}
+	for (i = 0; i < header->objectproperty_domain_axioms; ++i, p += 2) {
+		if (!ROLE_IDS_VALID(p, 1) || !CLASS_IDS_VALID(p + 1, 1))
+			return 0;
+		ADD_OBJECTPROPERTY_DOMAIN_AXIOM(create_objectproperty_domain_axiom(tbox->objectproperty_expressions[p[0]], tbox->class_expressions[p[1]], tbox), tbox);
+	}
+	for (i = 0; i < header->same_individual_axioms; ++i) {
+		if (p >= end)
+			return 0;
+		count = *p++;
+		if (!INDIVIDUAL_IDS_VALID(p, count))
+			return 0;
+		for (j = 0; j < count; ++j)
+			list_add(individuals[*p++], operands);
+		ADD_SAME_INDIVIDUAL_AXIOM(create_same_individual_axiom(operands->size, (Individual**) operands->elements, tbox), tbox);
+		operands->size = 0;
+	}
+	for (i = 0; i < header->different_individuals_axioms; ++i) {
+		if (p >= end)
+			return 0;
+		count = *p++;
+		if (!INDIVIDUAL_IDS_VALID(p, count))
+			return 0;
+		for (j = 0; j < count; ++j)
+			list_add(individuals[*p++], operands);
+		ADD_DIFFERENT_INDIVIDUALS_AXIOM(create_different_individuals_axiom(operands->size, (Individual**) operands->elements, tbox), tbox);
+		operands->size = 0;
+	}
+
+	return 1;
+}
+
+static char read_assertions(KBSnapshot* snapshot, KB* kb, Individual** individuals) {
+	KBSnapshotHeader* header = snapshot->header;
+	TBox* tbox = kb->tbox;
+	uint32_t i, * p, * end;
+
+	// check_sections has checked that they fit
+	p = (uint32_t*) (snapshot->start + header->assertions);
+	end = (uint32_t*) (snapshot->start + header->size);
+	for (i = 0; i < header->class_assertions; ++i, p += 2) {
+		if (!INDIVIDUAL_IDS_VALID(p, 1) || !CLASS_IDS_VALID(p + 1, 1))
+			return 0;
+		add_concept_assertion(create_concept_assertion(individuals[p[0]], tbox->class_expressions[p[1]], kb->abox), kb->abox);
+	}
+	for (i = 0; i < header->object_property_assertions; ++i, p += 3) {
+		if (!ROLE_IDS_VALID(p, 1) || !INDIVIDUAL_IDS_VALID(p + 1, 2))
+			return 0;
+		add_role_assertion(create_role_assertion(tbox->objectproperty_expressions[p[0]], individuals[p[1]], individuals[p[2]], kb->abox), kb->abox);
+	}
+
+	return 1;
+}
+
+char read_kb_snapshot(KBSnapshot* snapshot, KB* kb) {
+	KBSnapshotHeader* header = snapshot->header;
+	TBox* tbox = kb->tbox;
+	StringPoolEntry** strings;
+	Individual** individuals;
+	List operands;
+	char result;
+
+	strings = (StringPoolEntry**) malloc((header->string_count + 1) * sizeof(StringPoolEntry*));
+	assert(strings != NULL);
+	individuals = (Individual**) malloc((header->individual_count + 1) * sizeof(Individual*));
+	assert(individuals != NULL);
+	LIST_INIT(&operands);
+
+	result = read_strings(snapshot, kb, strings)
+			&& read_prefixes(snapshot, kb, strings)
+			&& read_individuals(snapshot, kb, strings, individuals)
+			&& read_objectproperty_expressions(snapshot, kb, strings)
+			&& read_class_expressions(snapshot, kb, strings, individuals)
+			&& read_axioms(snapshot, kb, individuals, &operands)
+			&& read_assertions(snapshot, kb, individuals);
+	list_reset(&operands);
+	free(strings);
+	free(individuals);
+
+	// creating the expressions again has counted them once more
+	tbox->object_some_values_from_exps_count = header->object_some_values_from_exps_count;
+	tbox->object_intersection_of_exps_count = header->object_intersection_of_exps_count;
+	tbox->binary_object_intersection_of_exps_count = header->binary_object_intersection_of_exps_count;
+	tbox->role_composition_count = header->role_composition_count;
+	tbox->binary_role_composition_count = header->binary_role_composition_count;
+
+	return result;
+}
+
+void close_kb_snapshot(KBSnapshot* snapshot) {
+#ifdef HAVE_MMAP
+	if (snapshot->mapped)
+		munmap(snapshot->start, snapshot->size);
+	else
+#endif
+		free(snapshot->start);
+	free(snapshot);
+}
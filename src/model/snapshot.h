@@ -0,0 +1,153 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SNAPSHOT_H_
+#define SNAPSHOT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "datatypes.h"
+
+/**
+ * Binary snapshot of a loaded KB. The IRIs, the class and object property
+ * expressions, the individuals, the axioms and the assertions are stored
+ * in arrays of 32-bit ids, in the order of their ids. Loading a snapshot
+ * does not lex or parse anything: the file is mapped into memory and the
+ * expressions are created again from the arrays, with the same ids. The
+ * string hashes are stored as well, the IRIs are not hashed again.
+ *
+ * The snapshot is taken right after loading, preprocessing and indexing
+ * run as usual on the KB read from it.
+ *
+ * The file starts with a KBSnapshotHeader, the sections follow at the
+ * offsets given in the header:
+ *	strings: per string its length, its hash value and the string itself,
+ *		padded to a multiple of 4 bytes
+ *	prefixes: pairs of string ids, the prefix name and the prefix
+ *	individuals: the string id of the IRI of each individual
+ *	object property expressions: type and two operands each, the string
+ *		id of the IRI or the ids of the two components of a chain
+ *	class expressions: type and two operands each, the string id of the IRI,
+ *		the ids of the conjuncts, the role and filler ids, or the individual id
+ *	axioms: the operands of each kind of axiom one after the other. the
+ *		n-ary axioms are preceded by the number of their operands.
+ *	assertions: pairs of individual and class ids, then triples of role,
+ *		source and target ids
+ */
+
+#define KB_SNAPSHOT_MAGIC			"ELPHKB\r\n"
+// increased whenever the format changes, older snapshots are not read
+#define KB_SNAPSHOT_VERSION			2
+// written in the byte order of the machine, snapshots are not portable
+#define KB_SNAPSHOT_BYTE_ORDER		0x01020304
+
+typedef struct kb_snapshot_header KBSnapshotHeader;
+typedef struct kb_snapshot KBSnapshot;
+
+struct kb_snapshot_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	// STRING_POOL_HASH of the magic, the stored hash values are only valid
+	// if the hash function is the same
+	uint32_t hash_check;
+
+	uint32_t string_count;
+	uint32_t prefix_count;
+	uint32_t individual_count;
+	uint32_t objectproperty_expression_count;
+	uint32_t class_expression_count;
+
+	// the number of expressions of each type, for sizing the tables
+	uint32_t classes;
+	uint32_t object_properties;
+	uint32_t object_property_chains;
+	uint32_t object_some_values_from;
+	uint32_t object_intersection_of;
+	uint32_t object_one_of;
+
+	uint32_t subclass_of_axioms;
+	uint32_t equivalent_classes_axioms;
+	uint32_t disjoint_classes_axioms;
+	uint32_t subobjectproperty_of_axioms;
+	uint32_t equivalent_objectproperties_axioms;
+	uint32_t transitive_objectproperty_axioms;
+	uint32_t objectproperty_domain_axioms;
+	uint32_t same_individual_axioms;
+	uint32_t different_individuals_axioms;
+	uint32_t class_assertions;
+	uint32_t object_property_assertions;
+
+	// the counters of the parser for the statistics, see TBox
+	uint32_t object_some_values_from_exps_count;
+	uint32_t object_intersection_of_exps_count;
+	uint32_t binary_object_intersection_of_exps_count;
+	uint32_t role_composition_count;
+	uint32_t binary_role_composition_count;
+
+	// offsets of the sections from the start of the file
+	uint64_t strings;
+	uint64_t prefixes;
+	uint64_t individuals;
+	uint64_t objectproperty_expressions;
+	uint64_t class_expressions;
+	uint64_t axioms;
+	uint64_t assertions;
+	// size of the file
+	uint64_t size;
+};
+
+struct kb_snapshot {
+	KBSnapshotHeader* header;
+	char* start;
+	size_t size;
+	char mapped;		// 0 if the file has been read into a buffer
+};
+
+/**
+ * Write a snapshot of the given KB, which has just been loaded, to the
+ * file with the given name.
+ * Returns 1 on success, 0 if the file cannot be written.
+ */
+char write_kb_snapshot(KB* kb, char* file_name);
+
+/**
+ * Map the snapshot in the file with the given name into memory and check
+ * its header.
+ * Returns the snapshot, NULL if the file cannot be read, is not a
+ * snapshot of this version written on this kind of machine, or its
+ * sections do not fit in the file.
+ */
+KBSnapshot* open_kb_snapshot(char* file_name);
+
+/**
+ * Create the contents of the snapshot in the given KB, which has just been
+ * initialized. The ids in the snapshot are checked against the counts in
+ * the header.
+ * Returns 1 on success, 0 if the snapshot is corrupt. The KB is only
+ * partially created in this case.
+ */
+char read_kb_snapshot(KBSnapshot* snapshot, KB* kb);
+
+/**
+ * Unmap the snapshot and free it.
+ */
+void close_kb_snapshot(KBSnapshot* snapshot);
+
+#endif /* SNAPSHOT_H_ */
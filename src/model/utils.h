@@ -28,18 +28,20 @@
 #include "../utils/map.h"
 #include "datatypes.h"
 
+// The names and IRIs below are interned, i.e., of type StringPoolEntry*
+
 // returns the prefix with the given prefix name
-#define GET_ONTOLOGY_PREFIX(prefix_name, kb)			MAP_GET(HASH_STRING(prefix_name), &(kb->prefixes))
+#define GET_ONTOLOGY_PREFIX(prefix_name, kb)			MAP_GET((prefix_name)->id, &(kb->prefixes))
 
 // inserts the prefix with the given prefix name into the prefixes hash
-#define PUT_ONTOLOGY_PREFIX(prefix_name, prefix, kb)	MAP_PUT(HASH_STRING(prefix_name), prefix, &(kb->prefixes))
+#define PUT_ONTOLOGY_PREFIX(prefix_name, prefix, kb)	MAP_PUT((prefix_name)->id, prefix, &(kb->prefixes))
 
 // returns the atomic concept with the given name if it exists
 // NULL if it does not exist
-#define GET_ATOMIC_CONCEPT(IRI, tbox)					MAP_GET(HASH_STRING(IRI), &(tbox->classes))
+#define GET_ATOMIC_CONCEPT(IRI, tbox)					MAP_GET((IRI)->id, &(tbox->classes))
 
 // inserts the atomic concept with the given name to the hash
-#define PUT_ATOMIC_CONCEPT(IRI, c, tbox)				MAP_PUT(HASH_STRING(IRI), c, &(tbox->classes))
+#define PUT_ATOMIC_CONCEPT(IRI, c, tbox)				MAP_PUT((IRI)->id, c, &(tbox->classes))
 
 // get the existential restriction with role r and filler f from hash
 #define GET_EXISTS_RESTRICTION(role_id, filler_id, tbox)		MAP_GET(HASH_INTEGERS(role_id, filler_id), &(tbox->object_some_values_from_exps))
@@ -62,10 +64,10 @@
 
 // return the atomic role with the given name if it exists
 // NULL if it does not exist
-#define GET_ATOMIC_ROLE(IRI, tbox)			MAP_GET(HASH_STRING(IRI), &(tbox->objectproperties))
+#define GET_ATOMIC_ROLE(IRI, tbox)			MAP_GET((IRI)->id, &(tbox->objectproperties))
 
 // insert the atomic role with the given name to the hash
-#define PUT_ATOMIC_ROLE(IRI, r, tbox)		MAP_PUT(HASH_STRING(IRI), r, &(tbox->objectproperties))
+#define PUT_ATOMIC_ROLE(IRI, r, tbox)		MAP_PUT((IRI)->id, r, &(tbox->objectproperties))
 
 
 // get the role compoisiton with the given roles
@@ -74,13 +76,19 @@
 // put the role composition with the given roles into the role compositions hash
 #define PUT_ROLE_COMPOSITION(r, tbox)		MAP_PUT(HASH_INTEGERS(r->description.object_property_chain.role1->id, r->description.object_property_chain.role2->id), r, &(tbox->objectproperty_chains))
 
+// returns the class expression with the given id
+#define GET_CLASS_EXPRESSION(id, tbox)			(tbox->class_expressions[id])
+
+// returns the object property expression with the given id
+#define GET_OBJECTPROPERTY_EXPRESSION(id, tbox)	(tbox->objectproperty_expressions[id])
+
 /******************************************************************************/
 // Returns the individual with the given name if it exists
 // NULL if it does not exist
-#define GET_INDIVIDUAL(IRI, abox)			hash_map_get(abox->individuals, HASH_STRING(IRI))
+#define GET_INDIVIDUAL(IRI, abox)			MAP_GET((IRI)->id, abox->individuals)
 
 // Inserts the given individual into the hash of individuals.
 // Individual name is the key.
-#define PUT_INDIVIDUAL(IRI, i, abox)		hash_map_put(abox->individuals, HASH_STRING(IRI), i)
+#define PUT_INDIVIDUAL(IRI, i, abox)		MAP_PUT((IRI)->id, i, abox->individuals)
 
 #endif
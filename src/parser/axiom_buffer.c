@@ -0,0 +1,265 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "../model/datatypes.h"
+#include "../model/model.h"
+#include "../utils/list.h"
+#include "axiom_buffer.h"
+
+// size of the index of the names at first, it grows with them, and of the
+// first block of their strings
+#define NAMES_SIZE				1024
+#define NAMES_BLOCK_SIZE		(1 << 16)
+// number of operations there is space for at first, doubled when full
+#define OPERATIONS_SIZE			(1 << 16)
+
+// the state of a replay. the entities are created when their name is
+// first used, and then kept by the id of the name.
+typedef struct {
+	KB* kb;
+	// the names by id, and their entries in the kb
+	StringPoolEntry** names;
+	StringPoolEntry** iris;
+	ClassExpression** classes;
+	ObjectPropertyExpression** objectproperties;
+	Individual** individuals;
+	// the expressions and individuals that are operands of the operations
+	// to come
+	List stack;
+	// the operands of an n-ary expression or axiom
+	List operands;
+} Replay;
+
+#define POP(replay)			((replay)->stack.elements[--(replay)->stack.size])
+
+AxiomBuffer* axiom_buffer_create() {
+	AxiomBuffer* buffer = (AxiomBuffer*) malloc(sizeof(AxiomBuffer));
+	assert(buffer != NULL);
+
+	string_pool_init(&(buffer->names), NAMES_SIZE, NAMES_BLOCK_SIZE);
+	buffer->operations = (uint32_t*) malloc(OPERATIONS_SIZE * sizeof(uint32_t));
+	assert(buffer->operations != NULL);
+	buffer->size = 0;
+	buffer->capacity = OPERATIONS_SIZE;
+
+	return buffer;
+}
+
+void axiom_buffer_add(AxiomBuffer* buffer, uint32_t operation) {
+	if (buffer->size == buffer->capacity) {
+		buffer->capacity *= 2;
+		buffer->operations = realloc(buffer->operations, buffer->capacity * sizeof(uint32_t));
+		assert(buffer->operations != NULL);
+	}
+	buffer->operations[buffer->size++] = operation;
+}
+
+static StringPoolEntry* kb_iri(Replay* replay, uint32_t id) {
+	if (replay->iris[id] == NULL)
+		replay->iris[id] = string_pool_intern(&(replay->kb->iris), replay->names[id]->string, replay->names[id]->length);
+
+	return replay->iris[id];
+}
+
+// move the given number of operands from the stack to the operand list, in
+// the order the parser collects them: the ones after the first two in
+// reverse order, then the first two. the components of an object property
+// chain are all in reverse order.
+static void collect_operands(Replay* replay, uint32_t count, char chain) {
+	int first = replay->stack.size - count;
+	int i;
+
+	replay->operands.size = 0;
+	for (i = replay->stack.size - 1; i >= first + 2; --i)
+		list_add(replay->stack.elements[i], &(replay->operands));
+	if (chain) {
+		list_add(replay->stack.elements[first + 1], &(replay->operands));
+		list_add(replay->stack.elements[first], &(replay->operands));
+	}
+	else {
+		list_add(replay->stack.elements[first], &(replay->operands));
+		list_add(replay->stack.elements[first + 1], &(replay->operands));
+	}
+	replay->stack.size = first;
+}
+
+void axiom_buffer_replay(AxiomBuffer* buffer, IndexPipeline* pipeline, KB* kb) {
+	uint32_t name_count = buffer->names.string_count;
+	Replay replay;
+	TBox* tbox = kb->tbox;
+	uint32_t* operations = buffer->operations;
+	uint32_t i, id;
+	StringPoolEntry* name;
+	int j;
+	ClassExpression* lhs;
+	ClassExpression* rhs;
+	ObjectPropertyExpression* role;
+	Individual* individual;
+	Individual* source;
+	SubClassOfAxiom* subclass_axiom;
+	SubObjectPropertyOfAxiom* subrole_axiom;
+
+	replay.kb = kb;
+	// one more, the pool can be empty
+	replay.names = (StringPoolEntry**) malloc((name_count + 1) * sizeof(StringPoolEntry*));
+	assert(replay.names != NULL);
+	string_pool_entries(&(buffer->names), replay.names);
+	replay.iris = (StringPoolEntry**) calloc(name_count + 1, sizeof(StringPoolEntry*));
+	assert(replay.iris != NULL);
+	replay.classes = (ClassExpression**) calloc(name_count + 1, sizeof(ClassExpression*));
+	assert(replay.classes != NULL);
+	replay.objectproperties = (ObjectPropertyExpression**) calloc(name_count + 1, sizeof(ObjectPropertyExpression*));
+	assert(replay.objectproperties != NULL);
+	replay.individuals = (Individual**) calloc(name_count + 1, sizeof(Individual*));
+	assert(replay.individuals != NULL);
+	LIST_INIT(&(replay.stack));
+	LIST_INIT(&(replay.operands));
+
+	for (i = 0; i < buffer->size; ++i) {
+		switch (operations[i]) {
+		case BUFFER_CLASS:
+			id = operations[++i];
+			if (replay.classes[id] == NULL)
+				replay.classes[id] = get_create_atomic_concept(kb_iri(&replay, id), tbox);
+			list_add(replay.classes[id], &(replay.stack));
+			break;
+		case BUFFER_OBJECT_PROPERTY:
+			id = operations[++i];
+			if (replay.objectproperties[id] == NULL)
+				replay.objectproperties[id] = get_create_atomic_role(kb_iri(&replay, id), tbox);
+			list_add(replay.objectproperties[id], &(replay.stack));
+			break;
+		case BUFFER_INDIVIDUAL:
+			id = operations[++i];
+			if (replay.individuals[id] == NULL)
+				replay.individuals[id] = get_create_individual(kb_iri(&replay, id), kb->abox);
+			list_add(replay.individuals[id], &(replay.stack));
+			break;
+		case BUFFER_THING:
+			replay.stack.size -= operations[++i];
+			list_add(tbox->top_concept, &(replay.stack));
+			break;
+		case BUFFER_OBJECT_INTERSECTION_OF:
+			collect_operands(&replay, operations[++i], 0);
+			list_add(get_create_conjunction(replay.operands.size, (ClassExpression**) replay.operands.elements, tbox), &(replay.stack));
+			break;
+		case BUFFER_OBJECT_PROPERTY_CHAIN:
+			collect_operands(&replay, operations[++i], 1);
+			list_add(get_create_role_composition(replay.operands.size, (ObjectPropertyExpression**) replay.operands.elements, tbox), &(replay.stack));
+			break;
+		case BUFFER_EQUIVALENT_CLASSES:
+			collect_operands(&replay, operations[++i], 0);
+			for (j = 0; j < replay.operands.size - 1; ++j)
+				ADD_EQUIVALENT_CLASSES_AXIOM(create_eqclass_axiom((ClassExpression*) replay.operands.elements[j], (ClassExpression*) replay.operands.elements[j + 1], tbox), tbox);
+			break;
+		case BUFFER_DISJOINT_CLASSES:
+			collect_operands(&replay, operations[++i], 0);
+			ADD_DISJOINT_CLASSES_AXIOM(create_disjointclasses_axiom(replay.operands.size, (ClassExpression**) replay.operands.elements, tbox), tbox);
+			break;
+		case BUFFER_EQUIVALENT_OBJECT_PROPERTIES:
+			collect_operands(&replay, operations[++i], 0);
+			for (j = 0; j < replay.operands.size - 1; ++j)
+				ADD_EQUIVALENT_OBJECTPROPERTIES_AXIOM(create_eqrole_axiom((ObjectPropertyExpression*) replay.operands.elements[j], (ObjectPropertyExpression*) replay.operands.elements[j + 1], tbox), tbox);
+			break;
+		case BUFFER_SAME_INDIVIDUAL:
+			collect_operands(&replay, operations[++i], 0);
+			ADD_SAME_INDIVIDUAL_AXIOM(create_same_individual_axiom(replay.operands.size, (Individual**) replay.operands.elements, tbox), tbox);
+			break;
+		case BUFFER_DIFFERENT_INDIVIDUALS:
+			collect_operands(&replay, operations[++i], 0);
+			ADD_DIFFERENT_INDIVIDUALS_AXIOM(create_different_individuals_axiom(replay.operands.size, (Individual**) replay.operands.elements, tbox), tbox);
+			break;
+		case BUFFER_OBJECT_ONE_OF:
+			individual = (Individual*) POP(&replay);
+			list_add(get_create_nominal(individual, tbox), &(replay.stack));
+			break;
+		case BUFFER_OBJECT_SOME_VALUES_FROM:
+			rhs = (ClassExpression*) POP(&replay);
+			role = (ObjectPropertyExpression*) POP(&replay);
+			list_add(get_create_exists_restriction(role, rhs, tbox), &(replay.stack));
+			break;
+		case BUFFER_SUB_CLASS_OF:
+			rhs = (ClassExpression*) POP(&replay);
+			lhs = (ClassExpression*) POP(&replay);
+			subclass_axiom = create_subclass_axiom(lhs, rhs, tbox);
+			ADD_SUBCLASS_OF_AXIOM(subclass_axiom, tbox);
+			if (pipeline != NULL)
+				index_pipeline_add_subclass_axiom(pipeline, subclass_axiom);
+			break;
+		case BUFFER_SUB_OBJECT_PROPERTY_OF:
+			role = (ObjectPropertyExpression*) POP(&replay);
+			subrole_axiom = create_subrole_axiom((ObjectPropertyExpression*) POP(&replay), role, tbox);
+			ADD_SUBOBJECTPROPERTY_OF_AXIOM(subrole_axiom, tbox);
+			if (pipeline != NULL)
+				index_pipeline_add_subrole_axiom(pipeline, subrole_axiom);
+			break;
+		case BUFFER_OBJECT_PROPERTY_DOMAIN:
+			rhs = (ClassExpression*) POP(&replay);
+			role = (ObjectPropertyExpression*) POP(&replay);
+			ADD_OBJECTPROPERTY_DOMAIN_AXIOM(create_objectproperty_domain_axiom(role, rhs, tbox), tbox);
+			break;
+		case BUFFER_TRANSITIVE_OBJECT_PROPERTY:
+			role = (ObjectPropertyExpression*) POP(&replay);
+			ADD_TRANSITIVE_OBJECTPROPERTY_AXIOM(create_transitive_role_axiom(role, tbox), tbox);
+			break;
+		case BUFFER_CLASS_ASSERTION:
+			individual = (Individual*) POP(&replay);
+			lhs = (ClassExpression*) POP(&replay);
+			add_concept_assertion(create_concept_assertion(individual, lhs, kb->abox), kb->abox);
+			break;
+		case BUFFER_OBJECT_PROPERTY_ASSERTION:
+			individual = (Individual*) POP(&replay);
+			source = (Individual*) POP(&replay);
+			role = (ObjectPropertyExpression*) POP(&replay);
+			add_role_assertion(create_role_assertion(role, source, individual, kb->abox), kb->abox);
+			break;
+		case BUFFER_PREFIX:
+			id = operations[++i];
+			name = replay.names[operations[++i]];
+			create_prefix(replay.names[id]->string, replay.names[id]->length, name->string, name->length, kb);
+			break;
+		case BUFFER_AXIOM_END:
+			replay.stack.size = 0;
+			break;
+		case BUFFER_UNSUPPORTED:
+			fprintf(stderr, "unsupported feature: %s\n", replay.names[operations[++i]]->string);
+			break;
+		default:
+			fprintf(stderr, "unknown buffered operation %u, aborting\n", operations[i]);
+			exit(-1);
+		}
+	}
+
+	free(replay.names);
+	free(replay.iris);
+	free(replay.classes);
+	free(replay.objectproperties);
+	free(replay.individuals);
+	list_reset(&(replay.stack));
+	list_reset(&(replay.operands));
+}
+
+void axiom_buffer_free(AxiomBuffer* buffer) {
+	string_pool_reset(&(buffer->names));
+	free(buffer->operations);
+	free(buffer);
+}
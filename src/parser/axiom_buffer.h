@@ -0,0 +1,109 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef AXIOM_BUFFER_H_
+#define AXIOM_BUFFER_H_
+
+#include <stdint.h>
+
+#include "../model/datatypes.h"
+#include "../hashing/string_pool.h"
+#include "../index/pipeline.h"
+
+/**
+ * The axioms of an imported ontology, parsed without touching the KB so
+ * that several ontologies can be parsed at the same time. The parser
+ * resolves the names, i.e., expands the prefixes and finds the names the
+ * IRIs are stored with in the KB, and interns them in the pool of the
+ * buffer. The expressions and the axioms are stored as a sequence of
+ * operations in postfix order, the operands of an expression or an axiom
+ * come before it.
+ *
+ * Replaying the buffer creates the expressions, the axioms and the
+ * assertions in the KB in the order they have been parsed, the KB is the
+ * same as if the ontology had been parsed into it. The warnings about the
+ * unsupported features are printed then too.
+ */
+
+// a class, an object property or an individual, followed by the id of its
+// name in the pool
+#define BUFFER_CLASS							0
+#define BUFFER_OBJECT_PROPERTY					1
+#define BUFFER_INDIVIDUAL						2
+// owl:Thing in place of an unsupported class expression, followed by the
+// number of operands of the expression
+#define BUFFER_THING							3
+// followed by the number of operands
+#define BUFFER_OBJECT_INTERSECTION_OF			4
+#define BUFFER_OBJECT_PROPERTY_CHAIN			5
+#define BUFFER_EQUIVALENT_CLASSES				6
+#define BUFFER_DISJOINT_CLASSES					7
+#define BUFFER_EQUIVALENT_OBJECT_PROPERTIES		8
+#define BUFFER_SAME_INDIVIDUAL					9
+#define BUFFER_DIFFERENT_INDIVIDUALS			10
+// the operands are the fixed ones of the expression or the axiom
+#define BUFFER_OBJECT_ONE_OF					11
+#define BUFFER_OBJECT_SOME_VALUES_FROM			12
+#define BUFFER_SUB_CLASS_OF						13
+#define BUFFER_SUB_OBJECT_PROPERTY_OF			14
+#define BUFFER_OBJECT_PROPERTY_DOMAIN			15
+#define BUFFER_TRANSITIVE_OBJECT_PROPERTY		16
+#define BUFFER_CLASS_ASSERTION					17
+#define BUFFER_OBJECT_PROPERTY_ASSERTION		18
+// followed by the ids of the prefix name and of the prefix
+#define BUFFER_PREFIX							19
+// the end of an axiom. the operands of unsupported axioms and the entities
+// of declarations are dropped.
+#define BUFFER_AXIOM_END						20
+// a warning about an unsupported feature, followed by the id of its name
+#define BUFFER_UNSUPPORTED						21
+
+typedef struct axiom_buffer AxiomBuffer;
+
+struct axiom_buffer {
+	// the names, '<' and '>' are kept for full IRIs
+	StringPool names;
+	// the operations and their arguments
+	uint32_t* operations;
+	uint32_t size;
+	uint32_t capacity;
+};
+
+/**
+ * Create an empty buffer.
+ */
+AxiomBuffer* axiom_buffer_create();
+
+/**
+ * Append an operation or an argument of it to the buffer.
+ */
+void axiom_buffer_add(AxiomBuffer* buffer, uint32_t operation);
+
+/**
+ * Create the expressions, the axioms and the assertions in the buffer in
+ * the given KB. The told axioms are passed to the given pipeline for
+ * indexing if it is not NULL.
+ */
+void axiom_buffer_replay(AxiomBuffer* buffer, IndexPipeline* pipeline, KB* kb);
+
+/**
+ * Free the buffer and its names.
+ */
+void axiom_buffer_free(AxiomBuffer* buffer);
+
+#endif /* AXIOM_BUFFER_H_ */
@@ -23,13 +23,22 @@
 #include "../model/datatypes.h"
 #include "../model/limits.h"
 
+// a token from the lexer. the text points into the input, it is not '\0'
+// terminated. the hash is only computed for IRIs and prefix names.
+typedef struct token Token;
+struct token {
+	char* text;
+	uint32_t length;
+	uint32_t hash;
+};
+
 // for lexer and parser
 typedef union expression Expression;
 union expression {
 	ClassExpression* concept;
 	ObjectPropertyExpression* role;
 	Individual* individual;
-	char* text;
+	Token token;
 };
 
 
@@ -0,0 +1,220 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <assert.h>
+#include <sys/stat.h>
+
+#include "../utils/list.h"
+#include "imports.h"
+
+// the extensions tried for a file in a directory, the compressed files are
+// decompressed when they are read
+static const char* extensions[] = { "", ".gz", ".zst", ".owl", ".owl.gz", ".owl.zst", ".ofn", ".ofn.gz", ".ofn.zst", NULL };
+
+struct catalog {
+	// the IRIs of the XML catalogs and their files, '\0' terminated
+	List iris;
+	List files;
+	// the directories
+	List directories;
+};
+
+Catalog* catalog_create() {
+	Catalog* catalog = (Catalog*) malloc(sizeof(Catalog));
+	assert(catalog != NULL);
+
+	LIST_INIT(&(catalog->iris));
+	LIST_INIT(&(catalog->files));
+	LIST_INIT(&(catalog->directories));
+
+	return catalog;
+}
+
+static char* copy_string(const char* s, size_t length) {
+	char* copy = (char*) malloc(length + 1);
+	assert(copy != NULL);
+
+	memcpy(copy, s, length);
+	copy[length] = '\0';
+
+	return copy;
+}
+
+// returns the concatenation of the given directory, a '/' and the given name
+static char* join_path(const char* directory, size_t directory_length, const char* name, size_t name_length) {
+	char* path = (char*) malloc(directory_length + name_length + 2);
+	assert(path != NULL);
+
+	memcpy(path, directory, directory_length);
+	path[directory_length] = '/';
+	memcpy(path + directory_length + 1, name, name_length);
+	path[directory_length + name_length + 1] = '\0';
+
+	return path;
+}
+
+static char is_regular_file(const char* file_name) {
+	struct stat status;
+
+	return stat(file_name, &status) == 0 && S_ISREG(status.st_mode);
+}
+
+// returns the value of the attribute with the given name in the element
+// between start and end, NULL if it has no such attribute
+static char* attribute_value(char* start, char* end, const char* name, size_t* length) {
+	size_t name_length = strlen(name);
+	char* p;
+	char* value_end;
+	char quote;
+
+	for (p = start; p + name_length < end; ++p) {
+		if (!isspace((unsigned char) p[-1]) || memcmp(p, name, name_length) != 0)
+			continue;
+		p += name_length;
+		while (p < end && isspace((unsigned char) *p))
+			++p;
+		if (p == end || *p != '=')
+			continue;
+		for (++p; p < end && isspace((unsigned char) *p); ++p)
+			;
+		if (p == end || (*p != '"' && *p != '\''))
+			continue;
+		quote = *p++;
+		value_end = memchr(p, quote, end - p);
+		if (value_end == NULL)
+			return NULL;
+		*length = value_end - p;
+		return p;
+	}
+
+	return NULL;
+}
+
+char catalog_add_file(Catalog* catalog, char* file_name) {
+	FILE* file = fopen(file_name, "r");
+	char* text;
+	char* p;
+	char* end;
+	char* iri;
+	char* uri;
+	char* directory_end;
+	size_t size = 0, capacity = 1 << 16, n, iri_length, uri_length;
+
+	if (file == NULL)
+		return 0;
+	text = (char*) malloc(capacity);
+	assert(text != NULL);
+	// one byte is left for the '\0'
+	while ((n = fread(text + size, 1, capacity - size - 1, file)) > 0) {
+		size += n;
+		if (size == capacity - 1) {
+			capacity *= 2;
+			text = realloc(text, capacity);
+			assert(text != NULL);
+		}
+	}
+	fclose(file);
+	text[size] = '\0';
+
+	// the relative file names are relative to the directory of the catalog
+	directory_end = strrchr(file_name, '/');
+
+	// the uri elements, <uri ... name="IRI" uri="file"/>
+	for (p = text; (p = strstr(p, "<uri")) != NULL; p = end) {
+		p += 4;
+		end = memchr(p, '>', text + size - p);
+		if (end == NULL)
+			break;
+		if (!isspace((unsigned char) *p))
+			continue;
+		iri = attribute_value(p, end, "name", &iri_length);
+		uri = attribute_value(p, end, "uri", &uri_length);
+		if (iri == NULL || uri == NULL)
+			continue;
+
+		list_add(copy_string(iri, iri_length), &(catalog->iris));
+		if (uri_length > 7 && memcmp(uri, "file://", 7) == 0)
+			list_add(copy_string(uri + 7, uri_length - 7), &(catalog->files));
+		else if (uri_length > 5 && memcmp(uri, "file:", 5) == 0)
+			list_add(copy_string(uri + 5, uri_length - 5), &(catalog->files));
+		else if (uri[0] == '/' || directory_end == NULL)
+			list_add(copy_string(uri, uri_length), &(catalog->files));
+		else
+			list_add(join_path(file_name, directory_end - file_name, uri, uri_length), &(catalog->files));
+	}
+	free(text);
+
+	return 1;
+}
+
+void catalog_add_directory(Catalog* catalog, char* directory) {
+	list_add(copy_string(directory, strlen(directory)), &(catalog->directories));
+}
+
+char* catalog_resolve(Catalog* catalog, const char* iri, size_t length) {
+	const char* segment;
+	char* name;
+	char* path;
+	size_t segment_length;
+	int i, j;
+
+	for (i = 0; i < catalog->iris.size; ++i)
+		if (strlen((char*) catalog->iris.elements[i]) == length && memcmp(catalog->iris.elements[i], iri, length) == 0)
+			return copy_string((char*) catalog->files.elements[i], strlen((char*) catalog->files.elements[i]));
+
+	// the last segment of the IRI
+	for (segment = iri + length; segment > iri && segment[-1] != '/'; --segment)
+		;
+	segment_length = iri + length - segment;
+	if (segment_length == 0 || segment == iri)
+		return NULL;
+
+	for (i = 0; i < catalog->directories.size; ++i)
+		for (j = 0; extensions[j] != NULL; ++j) {
+			name = (char*) malloc(segment_length + strlen(extensions[j]) + 1);
+			assert(name != NULL);
+			memcpy(name, segment, segment_length);
+			strcpy(name + segment_length, extensions[j]);
+			path = join_path((char*) catalog->directories.elements[i], strlen((char*) catalog->directories.elements[i]), name, strlen(name));
+			free(name);
+			if (is_regular_file(path))
+				return path;
+			free(path);
+		}
+
+	return NULL;
+}
+
+static void free_strings(List* l) {
+	int i;
+
+	for (i = 0; i < l->size; ++i)
+		free(l->elements[i]);
+	list_reset(l);
+}
+
+void catalog_free(Catalog* catalog) {
+	free_strings(&(catalog->iris));
+	free_strings(&(catalog->files));
+	free_strings(&(catalog->directories));
+	free(catalog);
+}
@@ -0,0 +1,65 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMPORTS_H_
+#define IMPORTS_H_
+
+#include <stddef.h>
+
+/**
+ * The catalog maps the IRIs of imported ontologies to local files, the
+ * imports are never loaded over the network. An IRI is looked up
+ * - in the mappings of the XML catalogs that have been added, in the
+ *   format written by Protégé (catalog-v001.xml): the uri elements with
+ *   their name and uri attributes, relative file names are relative to
+ *   the catalog,
+ * - then in the directories that have been added, by the last segment of
+ *   the IRI, as it is or with ".owl" or ".ofn" appended, and compressed
+ *   with ".gz" or ".zst" appended to these.
+ */
+typedef struct catalog Catalog;
+
+/**
+ * Create an empty catalog.
+ */
+Catalog* catalog_create();
+
+/**
+ * Add the mappings in the XML catalog in the given file.
+ * Returns 0 if the file cannot be read.
+ */
+char catalog_add_file(Catalog* catalog, char* file_name);
+
+/**
+ * Look for the imported ontologies in the given directory.
+ */
+void catalog_add_directory(Catalog* catalog, char* directory);
+
+/**
+ * Returns the file of the ontology with the given IRI, without '<' and
+ * '>', NULL if it is not in the catalog. The file name has to be freed by
+ * the caller.
+ */
+char* catalog_resolve(Catalog* catalog, const char* iri, size_t length);
+
+/**
+ * Free the catalog.
+ */
+void catalog_free(Catalog* catalog);
+
+#endif /* IMPORTS_H_ */
@@ -0,0 +1,585 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "datatypes.h"
+#include "../hashing/string_pool.h"
+#include "owl2fsLexer.h"
+
+#define YYSTYPE Expression
+#include "y.tab.h"
+
+// size of the first buffer for an input that cannot be mapped, doubled when full
+#define INPUT_BUFFER_SIZE		(1 << 20)
+
+typedef struct {
+	char* name;
+	int length;
+	int token;
+	// set for the keywords that start an axiom, the input is split before them
+	char axiom;
+} Keyword;
+
+#define KEYWORD(name, token)	{ name, sizeof(name) - 1, token, 0 }
+#define AXIOM(name, token)		{ name, sizeof(name) - 1, token, 1 }
+
+static Keyword keywords[] = {
+	KEYWORD("Prefix", PREFIX),
+	KEYWORD("Ontology", ONTOLOGY),
+	KEYWORD("Import", IMPORT),
+	AXIOM("Declaration", DECLARATION),
+	KEYWORD("Class", CLASS),
+	KEYWORD("Datatype", DATATYPE),
+	KEYWORD("ObjectProperty", OBJECT_PROPERTY),
+	KEYWORD("DataProperty", DATA_PROPERTY),
+	KEYWORD("AnnotationProperty", ANNOTATION_PROPERTY),
+	KEYWORD("NamedIndividual", NAMED_INDIVIDUAL),
+	KEYWORD("DataIntersectionOf", DATA_INTERSECTION_OF),
+	KEYWORD("DataOneOf", DATA_ONE_OF),
+	KEYWORD("ObjectIntersectionOf", OBJECT_INTERSECTION_OF),
+	KEYWORD("ObjectOneOf", OBJECT_ONE_OF),
+	KEYWORD("ObjectSomeValuesFrom", OBJECT_SOME_VALUES_FROM),
+	KEYWORD("ObjectHasValue", OBJECT_HAS_VALUE),
+	KEYWORD("ObjectHasSelf", OBJECT_HAS_SELF),
+	KEYWORD("DataSomeValuesFrom", DATA_SOME_VALUES_FROM),
+	KEYWORD("DataHasValue", DATA_HAS_VALUE),
+	AXIOM("SubClassOf", SUB_CLASS_OF),
+	AXIOM("EquivalentClasses", EQUIVALENT_CLASSES),
+	AXIOM("DisjointClasses", DISJOINT_CLASSES),
+	AXIOM("SubObjectPropertyOf", SUB_OBJECT_PROPERTY_OF),
+	KEYWORD("ObjectPropertyChain", OBJECT_PROPERTY_CHAIN),
+	AXIOM("EquivalentObjectProperties", EQUIVALENT_OBJECT_PROPERTIES),
+	AXIOM("ObjectPropertyDomain", OBJECT_PROPERTY_DOMAIN),
+	AXIOM("ObjectPropertyRange", OBJECT_PROPERTY_RANGE),
+	AXIOM("ReflexiveObjectProperty", REFLEXIVE_OBJECT_PROPERTY),
+	AXIOM("TransitiveObjectProperty", TRANSITIVE_OBJECT_PROPERTY),
+	AXIOM("SubDataPropertyOf", SUB_DATA_PROPERTY_OF),
+	AXIOM("EquivalentDataProperties", EQUIVALENT_DATA_PROPERTIES),
+	AXIOM("DataPropertyDomain", DATA_PROPERTY_DOMAIN),
+	AXIOM("DataPropertyRange", DATA_PROPERTY_RANGE),
+	AXIOM("FunctionalDataProperty", FUNCTIONAL_DATA_PROPERTY),
+	AXIOM("DatatypeDefinition", DATATYPE_DEFINITION),
+	AXIOM("HasKey", HAS_KEY),
+	AXIOM("SameIndividual", SAME_INDIVIDUAL),
+	AXIOM("DifferentIndividuals", DIFFERENT_INDIVIDUALS),
+	AXIOM("ClassAssertion", CLASS_ASSERTION),
+	AXIOM("ObjectPropertyAssertion", OBJECT_PROPERTY_ASSERTION),
+	AXIOM("NegativeObjectPropertyAssertion", NEGATIVE_OBJECT_PROPERTY_ASSERTION),
+	AXIOM("DataPropertyAssertion", DATA_PROPERTY_ASSERTION),
+	AXIOM("NegativeDataPropertyAssertion", NEGATIVE_DATA_PROPERTY_ASSERTION),
+	AXIOM("AnnotationAssertion", ANNOTATION_ASSERTION),
+	KEYWORD("Annotation", ANNOTATION),
+	AXIOM("SubAnnotationPropertyOf", SUB_ANNOTATION_PROPERTY_OF),
+	AXIOM("AnnotationPropertyDomain", ANNOTATION_PROPERTY_DOMAIN),
+	AXIOM("AnnotationPropertyRange", ANNOTATION_PROPERTY_RANGE),
+	{ NULL, 0, 0, 0 }
+};
+
+struct lexer {
+	// the input, and the position of the lexer in it
+	char* start;
+	char* end;
+	char* position;
+	size_t mapped_bytes;	// 0 if the input has been read into a buffer
+
+	// the last token
+	char* text;
+	int length;
+
+	// the chunks the input has been split into, see lexer_split. the first
+	// one starts where the lexer was, the last one ends at the end.
+	char** splits;
+	uint32_t split_count;
+	// the tokens from here on belong to the next chunk, NULL if the lexer
+	// reads up to the end
+	char* limit;
+	// returned there, 0 for the lexer of a chunk
+	int limit_token;
+	// returned before the first token, 0 if there is none
+	int first_token;
+	// set for the lexer of a chunk, the input belongs to another lexer
+	char shared;
+};
+
+// read the rest of the given file into a buffer
+static void read_input(Lexer* lexer, FILE* file) {
+	size_t size = INPUT_BUFFER_SIZE, length = 0, n;
+	char* buffer = (char*) malloc(size);
+	assert(buffer != NULL);
+
+	while ((n = fread(buffer + length, 1, size - length, file)) > 0) {
+		length += n;
+		if (length == size) {
+			size *= 2;
+			buffer = realloc(buffer, size);
+			assert(buffer != NULL);
+		}
+	}
+
+	lexer->start = buffer;
+	lexer->end = buffer + length;
+	lexer->mapped_bytes = 0;
+}
+
+#ifdef HAVE_MMAP
+// map the given file from the given offset on, returns 0 if it cannot be mapped
+static char map_input(Lexer* lexer, FILE* file, long offset) {
+	struct stat status;
+	char* start;
+
+	if (fstat(fileno(file), &status) != 0 || !S_ISREG(status.st_mode) || status.st_size <= offset)
+		return 0;
+	start = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+	if (start == MAP_FAILED)
+		return 0;
+	// the input is read once from the beginning to the end
+	madvise(start, status.st_size, MADV_SEQUENTIAL);
+
+	lexer->start = start;
+	lexer->end = start + status.st_size;
+	lexer->mapped_bytes = status.st_size;
+	lexer->position = start + offset;
+
+	return 1;
+}
+#endif
+
+// the characters that end a name: white space, control characters and ( ) = < > " #
+static inline char is_delimiter(unsigned char c) {
+	return c <= ' ' || c == '(' || c == ')' || c == '=' || c == '<' || c == '>' || c == '"' || c == '#';
+}
+
+// returns the first delimiter from p on, end if there is none
+static inline char* find_delimiter(char* p, char* end) {
+#ifdef __SSE2__
+	// 16 characters at a time
+	const __m128i space = _mm_set1_epi8(' ');
+	const __m128i open_paren = _mm_set1_epi8('(');
+	const __m128i close_paren = _mm_set1_epi8(')');
+	const __m128i equals = _mm_set1_epi8('=');
+	const __m128i less = _mm_set1_epi8('<');
+	const __m128i greater = _mm_set1_epi8('>');
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i hash = _mm_set1_epi8('#');
+	__m128i chars, mask;
+	int bits;
+
+	for (; p + 16 <= end; p += 16) {
+		chars = _mm_loadu_si128((const __m128i*) p);
+		// c <= ' ', unsigned
+		mask = _mm_cmpeq_epi8(_mm_min_epu8(chars, space), chars);
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, open_paren));
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, close_paren));
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, equals));
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, less));
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, greater));
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, quote));
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, hash));
+		bits = _mm_movemask_epi8(mask);
+		if (bits != 0)
+			return p + __builtin_ctz(bits);
+	}
+#endif
+	while (p < end && !is_delimiter(*p))
+		++p;
+
+	return p;
+}
+
+// returns the token for the given name, 0 if it is not a keyword
+static int keyword_token(char* name, int length) {
+	Keyword* keyword;
+
+	for (keyword = keywords; keyword->name != NULL; ++keyword)
+		if (keyword->length == length && memcmp(keyword->name, name, length) == 0)
+			return keyword->token;
+
+	return 0;
+}
+
+// skip white space and comments from p on
+static inline char* skip_blanks(char* p, char* end) {
+	while (p < end) {
+		if (*p == '#') {
+			p = memchr(p, '\n', end - p);
+			if (p == NULL)
+				return end;
+		}
+		else if (*p != ' ' && *p != '\t' && *p != '\n' && *p != '\r')
+			break;
+		++p;
+	}
+
+	return p;
+}
+
+// returns the quote that ends the string starting at the quote p, NULL if there is none
+static inline char* find_string_end(char* p, char* end) {
+	char* start = p;
+	char* escape;
+
+	// the quotes that are not escaped end the string
+	for (++p; (p = memchr(p, '"', end - p)) != NULL; ++p) {
+		// an even number of backslashes before it
+		for (escape = p; escape > start + 1 && escape[-1] == '\\'; --escape)
+			;
+		if ((p - escape) % 2 == 0)
+			break;
+	}
+
+	return p;
+}
+
+// the characters that matter when an annotation is skipped: ( ) " < #
+static inline char is_annotation_delimiter(char c) {
+	return c == '(' || c == ')' || c == '"' || c == '<' || c == '#';
+}
+
+// returns the first of ( ) " < # from p on, end if there is none
+static inline char* find_annotation_delimiter(char* p, char* end) {
+#ifdef __SSE2__
+	const __m128i open_paren = _mm_set1_epi8('(');
+	const __m128i close_paren = _mm_set1_epi8(')');
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i less = _mm_set1_epi8('<');
+	const __m128i hash = _mm_set1_epi8('#');
+	__m128i chars, mask;
+	int bits;
+
+	for (; p + 16 <= end; p += 16) {
+		chars = _mm_loadu_si128((const __m128i*) p);
+		mask = _mm_cmpeq_epi8(chars, open_paren);
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, close_paren));
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, quote));
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, less));
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi8(chars, hash));
+		bits = _mm_movemask_epi8(mask);
+		if (bits != 0)
+			return p + __builtin_ctz(bits);
+	}
+#endif
+	while (p < end && !is_annotation_delimiter(*p))
+		++p;
+
+	return p;
+}
+
+// the keywords of the annotations and the annotation axioms. the parser
+// does not use them, they are skipped without being tokenized.
+#define IS_ANNOTATION(token)	((token) == ANNOTATION || (token) == ANNOTATION_ASSERTION || (token) == SUB_ANNOTATION_PROPERTY_OF \
+		|| (token) == ANNOTATION_PROPERTY_DOMAIN || (token) == ANNOTATION_PROPERTY_RANGE)
+
+// skip the annotation whose keyword ends at p up to the matching closing
+// parenthesis. the parentheses in strings, IRIs and comments do not count.
+// returns the character after the annotation, NULL if the keyword is not
+// followed by '('.
+static char* skip_annotation(char* p, char* end) {
+	int depth = 1;
+
+	p = skip_blanks(p, end);
+	if (p == end || *p != '(')
+		return NULL;
+	for (p = find_annotation_delimiter(p + 1, end); p < end; p = find_annotation_delimiter(p, end)) {
+		switch (*p) {
+		case '(':
+			++depth;
+			break;
+		case ')':
+			if (--depth == 0)
+				return p + 1;
+			break;
+		case '"':
+			p = find_string_end(p, end);
+			break;
+		case '<':
+			p = memchr(p + 1, '>', end - p - 1);
+			break;
+		default:
+			// a comment
+			p = memchr(p, '\n', end - p);
+			break;
+		}
+		// an unterminated string, IRI or comment, let the parser report it
+		if (p == NULL)
+			return end;
+		++p;
+	}
+
+	return end;
+}
+
+// scan the token that starts at p, which is not a blank. returns its type
+// and sets token_end to the character after it.
+static int scan_token(char* p, char* end, char** token_end) {
+	char* start = p;
+	char* colon;
+	int token;
+
+	switch (*p) {
+	case '(':
+	case ')':
+	case '=':
+		*token_end = p + 1;
+		return *p;
+	case '<':
+		// memchr is vectorized in the C library
+		p = memchr(p + 1, '>', end - p - 1);
+		if (p == NULL) {
+			*token_end = end;
+			return '<';
+		}
+		*token_end = p + 1;
+		return IRI_REF;
+	case '"':
+		p = find_string_end(p, end);
+		if (p == NULL) {
+			*token_end = end;
+			return '"';
+		}
+		*token_end = p + 1;
+		return QUOTED_STRING;
+	case '^':
+		if (p + 1 < end && p[1] == '^') {
+			*token_end = p + 2;
+			return DOUBLE_CARET;
+		}
+		*token_end = p + 1;
+		return '^';
+	case '@':
+		*token_end = find_delimiter(p + 1, end);
+		return LANGTAG;
+	default:
+		break;
+	}
+
+	// a keyword, a prefix name, a prefixed name or a blank node
+	p = find_delimiter(p, end);
+	if (p == start) {
+		// not a token, let the parser report it
+		*token_end = p + 1;
+		return (unsigned char) *start;
+	}
+	*token_end = p;
+	colon = memchr(start, ':', p - start);
+	if (colon == NULL) {
+		if ((token = keyword_token(start, p - start)) == 0)
+			return (unsigned char) *start;
+		return token;
+	}
+	if (colon == start + 1 && *start == '_')
+		return BLANK_NODE_LABEL;
+	return (colon == p - 1) ? PNAME_NS : PNAME_LN;
+}
+
+// the tokens whose text is hashed for interning, see intern_iri
+#define IS_IRI(token)		((token) == IRI_REF || (token) == PNAME_LN || (token) == PNAME_NS)
+
+// returns the token for the given name, 0 if it is not a keyword that
+// starts an axiom
+static int axiom_token(char* name, int length) {
+	Keyword* keyword;
+
+	for (keyword = keywords; keyword->name != NULL; ++keyword)
+		if (keyword->axiom && keyword->length == length && memcmp(keyword->name, name, length) == 0)
+			return keyword->token;
+
+	return 0;
+}
+
+// returns the first keyword from p on that starts an axiom at the beginning
+// of a line, after blanks. end if there is none.
+static char* find_axiom_line(char* p, char* end) {
+	char* name;
+	char* name_end;
+
+	while (p < end && (p = memchr(p, '\n', end - p)) != NULL) {
+		for (name = p + 1; name < end && (*name == ' ' || *name == '\t'); ++name)
+			;
+		name_end = find_delimiter(name, end);
+		if (name_end < end && *name_end == '(' && axiom_token(name, name_end - name) != 0)
+			return name;
+		p = name;
+	}
+
+	return end;
+}
+
+Lexer* lexer_create(FILE* file) {
+	Lexer* lexer = (Lexer*) calloc(1, sizeof(Lexer));
+	assert(lexer != NULL);
+
+#ifdef HAVE_MMAP
+	long offset = ftell(file);
+	if (offset < 0 || !map_input(lexer, file, offset))
+#endif
+	{
+		read_input(lexer, file);
+		lexer->position = lexer->start;
+	}
+
+	// skip the UTF-8 byte order mark
+	if (lexer->end - lexer->position >= 3 && memcmp(lexer->position, "\xEF\xBB\xBF", 3) == 0)
+		lexer->position += 3;
+	lexer->text = lexer->position;
+
+	return lexer;
+}
+
+uint32_t lexer_split(Lexer* lexer, size_t size) {
+	size_t chunks = (lexer->end - lexer->position) / size + 1;
+	char* split;
+	uint32_t i;
+
+	lexer->splits = (char**) malloc((chunks + 1) * sizeof(char*));
+	assert(lexer->splits != NULL);
+	lexer->splits[0] = lexer->position;
+	lexer->split_count = 1;
+	for (i = 1; i < chunks; ++i) {
+		split = find_axiom_line(lexer->position + i * size, lexer->end);
+		if (split == lexer->end)
+			break;
+		// a line longer than the chunks
+		if (split > lexer->splits[lexer->split_count - 1])
+			lexer->splits[lexer->split_count++] = split;
+	}
+	lexer->splits[lexer->split_count] = lexer->end;
+
+	if (lexer->split_count > 1) {
+		lexer->limit = lexer->splits[1];
+		lexer->limit_token = PARSED_CHUNKS;
+	}
+
+	return lexer->split_count;
+}
+
+Lexer* lexer_chunk(Lexer* lexer, uint32_t chunk) {
+	Lexer* chunk_lexer = (Lexer*) calloc(1, sizeof(Lexer));
+	assert(chunk_lexer != NULL);
+
+	// the whole input, for the line numbers of the errors
+	chunk_lexer->start = lexer->start;
+	chunk_lexer->end = lexer->end;
+	chunk_lexer->position = lexer->splits[chunk];
+	chunk_lexer->text = chunk_lexer->position;
+	chunk_lexer->limit = lexer->splits[chunk + 1];
+	chunk_lexer->first_token = CHUNK_START;
+	chunk_lexer->shared = 1;
+
+	return chunk_lexer;
+}
+
+char lexer_stop(Lexer* lexer, char** position) {
+	*position = lexer->text;
+	return lexer->text == lexer->limit;
+}
+
+void lexer_resume(Lexer* lexer, char* position) {
+	lexer->position = position;
+	lexer->limit = NULL;
+}
+
+void lexer_free(Lexer* lexer) {
+	free(lexer->splits);
+	if (lexer->shared) {
+		free(lexer);
+		return;
+	}
+#ifdef HAVE_MMAP
+	if (lexer->mapped_bytes > 0)
+		munmap(lexer->start, lexer->mapped_bytes);
+	else
+#endif
+		free(lexer->start);
+	free(lexer);
+}
+
+int lexer_next(Lexer* lexer, Token* value) {
+	char* token_end;
+	char* annotation_end;
+	int token;
+
+	if (lexer->first_token != 0) {
+		token = lexer->first_token;
+		lexer->first_token = 0;
+		value->text = lexer->position;
+		value->length = 0;
+		return token;
+	}
+
+	for (;;) {
+		lexer->text = skip_blanks(lexer->position, lexer->end);
+		if (lexer->limit != NULL && lexer->text >= lexer->limit) {
+			lexer->position = lexer->text;
+			lexer->length = 0;
+			// the next chunk starts here
+			if (lexer->limit_token == 0)
+				return 0;
+			if (lexer->text == lexer->limit) {
+				lexer->limit = NULL;
+				return lexer->limit_token;
+			}
+			// the chunk has been split in the middle of a token or of an
+			// annotation, the lexer reads on
+			lexer->limit = NULL;
+		}
+		if (lexer->text == lexer->end) {
+			lexer->position = lexer->end;
+			lexer->length = 0;
+			return 0;
+		}
+		token = scan_token(lexer->text, lexer->end, &token_end);
+		if (!IS_ANNOTATION(token) || (annotation_end = skip_annotation(token_end, lexer->end)) == NULL)
+			break;
+		lexer->position = annotation_end;
+	}
+	lexer->length = token_end - lexer->text;
+	lexer->position = token_end;
+
+	value->text = lexer->text;
+	value->length = lexer->length;
+	if (IS_IRI(token))
+		value->hash = STRING_POOL_HASH(value->text, value->length);
+
+	return token;
+}
+
+StringPoolEntry* intern_iri(Token* token, StringPool* pool) {
+	return string_pool_intern_hash(pool, token->text, token->length, token->hash);
+}
+
+void lexer_error(Lexer* lexer, char* message) {
+	char* p;
+	int line = 1;
+
+	for (p = lexer->start; p < lexer->text && (p = memchr(p, '\n', lexer->text - p)) != NULL; ++p)
+		++line;
+	fprintf(stderr, "\nline %d near %.*s: %s\n", line, lexer->length, lexer->text, message);
+}
@@ -0,0 +1,113 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OWL2FS_LEXER_H_
+#define OWL2FS_LEXER_H_
+
+#include <stdio.h>
+
+#include "datatypes.h"
+
+/**
+ * Lexer for the OWL 2 functional syntax. The input is mapped into memory
+ * and scanned in place, the tokens are not copied. The parser gets the
+ * position, the length and, for IRIs, the hash value of a token, the IRIs
+ * are interned in the string pool straight from the input. Inputs that
+ * cannot be mapped, like pipes, are read into a buffer first.
+ *
+ * The annotations and the annotation axioms are not used by the reasoner.
+ * The lexer skips them up to the matching closing parenthesis without
+ * tokenizing them, the parser does not see them. Syntax errors in them are
+ * not reported.
+ *
+ * For parsing on several threads, the rest of the input can be split into
+ * chunks that start with an axiom, see lexer_split. Each chunk is read by a
+ * lexer of its own, which can be used on another thread.
+ *
+ * The lexer has no global state, several inputs can be read at the same
+ * time by different lexers.
+ */
+typedef struct lexer Lexer;
+
+/**
+ * Create a lexer for reading the given input from its current position.
+ * Returns the lexer created.
+ */
+Lexer* lexer_create(FILE* input);
+
+/**
+ * Split the rest of the input into chunks of about the given size. The
+ * chunks after the first one start at a line that starts with an axiom.
+ * The lexer reads the first chunk and returns PARSED_CHUNKS where the
+ * second one starts, the other chunks are read by the lexers from
+ * lexer_chunk. If the first chunk has been split in the middle of a token
+ * or of an annotation, the lexer reads on instead.
+ * Returns the number of chunks, 1 if the input has not been split.
+ */
+uint32_t lexer_split(Lexer* lexer, size_t size);
+
+/**
+ * Create a lexer for the given chunk of the split input, the first one is
+ * 0. It returns CHUNK_START first, then the tokens of the chunk, and 0
+ * where the next chunk starts. It can be used while the given lexer is
+ * read, and is freed before it.
+ * Returns the lexer created.
+ */
+Lexer* lexer_chunk(Lexer* lexer, uint32_t chunk);
+
+/**
+ * Store in position where the lexer of a chunk has stopped, the start of
+ * the first token after the chunk.
+ * Returns 1 if the next chunk starts there, 0 if the chunk has been split
+ * in the middle of a token or of an annotation.
+ */
+char lexer_stop(Lexer* lexer, char** position);
+
+/**
+ * Let the lexer read the input from the given position up to the end,
+ * without stopping at the next chunk.
+ */
+void lexer_resume(Lexer* lexer, char* position);
+
+/**
+ * Free the lexer. The input is unmapped, or the buffer it has been read
+ * into is freed, the tokens returned so far become invalid. The lexer of
+ * a chunk does not free the input.
+ */
+void lexer_free(Lexer* lexer);
+
+/**
+ * Store the next token in the given Token. The text points into the input,
+ * it is not '\0' terminated.
+ * Returns the type of the token, 0 at the end of the input.
+ */
+int lexer_next(Lexer* lexer, Token* token);
+
+/**
+ * Returns the entry of the IRI in the given token in the pool. The IRI is
+ * interned if it is not already there.
+ */
+StringPoolEntry* intern_iri(Token* token, StringPool* pool);
+
+/**
+ * Print the given message together with the line and the text of the
+ * last token.
+ */
+void lexer_error(Lexer* lexer, char* message);
+
+#endif /* OWL2FS_LEXER_H_ */
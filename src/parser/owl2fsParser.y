@@ -18,77 +18,268 @@
 
 
 %{
+	#include "config.h"
+
 	#include <stdio.h>
+	#include <stdlib.h>
 	#include <assert.h>
 	#include <string.h>
+	#include <unistd.h>
+	#ifdef HAVE_PTHREAD_H
+	#include <pthread.h>
+	#endif
 	#include "datatypes.h"
 	#include "../model/datatypes.h"
 	#include "../model/model.h"
-	#include "../model/limits.h"
 	
+	#include "../utils/list.h"
+	#include "owl2fsLexer.h"
+	#include "imports.h"
+	#include "axiom_buffer.h"
+	#include "../utils/compressed_file.h"
+	#include "parser.h"
+
 	#define YYSTYPE Expression
 
-	extern char* yytext;
-	int yylex(void);
-	extern int yylineno;
-	// void yyerror(TBox* tbox, ABox* abox, char* msg);
-	void yyerror(KB* kb, char* msg);
-	extern FILE *yyin;
-	// extern TBox* tbox;
-	extern KB* kb;
-
-	// for parsing conjunction
-	// number of conjuncts in an ObjectIntersectionOf expression
-	int conjunct_count;
-	// the conjuncts in an ObjectIntersectionOf expression
-	ClassExpression* conjuncts[MAX_CONJUNCT_COUNT];
-
-	// for parsing EquivalentClasses axioms containing more than 2 class expressions
-	// number of class expressions in an EquivalentClasses axiom 
-	int equivalent_classes_count;
-	// the number of class expressions in an EquivalentClasses axiom
-	ClassExpression* equivalent_classes[MAX_EQ_CLASS_EXP_COUNT];
-	
-	// for parsing EquivalentObjectProperties axioms containing more than 2 object properties
-	// the number of object property expressions in an EquivalentObjectProperties axiom
-	int equivalent_objectproperties_count;
-	// the object property expressions in an EquivalentObjectProperties axiom
-	ObjectPropertyExpression* equivalent_objectproperties[MAX_EQ_ROLE_EXP_COUNT];
-	
-	// for parsing ObjectPropertyChain expressions
-	// the number of object property expressions in an object property chain expression
-	int objectproperty_chain_components_count;
-	// the object property expressions in an object property chain expression
-	ObjectPropertyExpression* objectproperty_chain_components[MAX_ROLE_COMPOSITION_SIZE];
-	
-	// for parsing HasKey expressions
-	// the number of object properties in an HasKey expression
-	int haskey_objectproperty_expression_count;
-	// the object properties in an HasKey expression
-	ObjectPropertyExpression* haskey_objectproperties[MAX_ROLE_COMPOSITION_SIZE];
-	
-	// for parsing DisjointClasses axioms
-	// number of classes in a DisjointClasses axiom 
-	int disjoint_classes_count;
-	// the class expressions in a DisjointClasses axiom
-	ClassExpression* disjoint_classes[MAX_DISJ_CLASS_EXP_COUNT];
-
-	// for parsing SameIndividual axioms
-	int same_individuals_count;
-	// the individuals in a SameIndividual axiom
-	Individual* same_individuals[MAX_SAME_INDIVIDUAL_COUNT];
-
-	// for parsing DifferentIndividuals axioms
-	int different_individuals_count;
-	// the individuals in a DifferentIndividuals axiom
-	Individual* different_individuals[MAX_DIFFERENT_INDIVIDUALS_COUNT];
-
-	void unsupported_feature(char* feature);
+	// the states of an imported ontology
+	#define IMPORT_FOUND		0
+	#define IMPORT_PARSING		1
+	#define IMPORT_PARSED		2
+
+	// an ontology of the imports closure. the imported ones are parsed into
+	// buffers by the parser threads. the thread that adds them to the kb
+	// parses the ones no parser thread has taken yet straight into the kb.
+	typedef struct imported_ontology ImportedOntology;
+	struct imported_ontology {
+		// NULL for the importing ontology
+		char* file_name;
+		CompressedFile* file;
+		// the ontologies in its Import declarations, in their order, also the
+		// ones that have been found before
+		List imports;
+		// the axioms, NULL if it is parsed into the kb
+		AxiomBuffer* buffer;
+		char state;
+		// the result of the parse
+		int result;
+		// set when it is in the imports closure that is added to the kb
+		char added;
+	};
+
+	// a prefix the IRIs are stored with in the kb, see datatypes.h. these are
+	// the prefixes declared in the importing ontology. the imported ontologies
+	// are parsed when IRIs have already been stored, their prefixes are not
+	// namespaces, the names with them are stored as the full IRIs are.
+	typedef struct {
+		// the name of the prefix in the kb
+		StringPoolEntry* name;
+		// the prefix with '<' and '>'
+		StringPoolEntry* prefix;
+		// set for the prefix of the OWL vocabulary
+		char owl;
+	} Namespace;
+
+	// a prefix declared in an ontology document
+	typedef struct {
+		// the name with the ':' and the prefix with '<' and '>'
+		StringPoolEntry* name;
+		StringPoolEntry* prefix;
+		// the namespace with this prefix, NULL if there is none
+		Namespace* namespace;
+		// set if a longer namespace starts with the prefix, a name with this
+		// prefix can be in that one
+		char nested;
+		// set if the names with the prefix are stored as they are written:
+		// the prefix has this name in the kb, and it is not the OWL vocabulary
+		char as_written;
+	} DeclaredPrefix;
+
+	// the imports closure of the ontology being parsed. the imported ontologies
+	// are parsed at the same time into buffers, and added to the kb one after
+	// the other in the order they are found.
+	typedef struct {
+		// NULL if the imports are ignored
+		Catalog* catalog;
+		int threads;
+		// the kb and the pipeline the ontologies are parsed into
+		KB* kb;
+		IndexPipeline* pipeline;
+		// the importing ontology
+		ImportedOntology root;
+		// the imported ontologies in the order they have been found
+		List ontologies;
+		// the first one that can still be waiting for a parser
+		int next;
+		// set when no more ontologies are parsed
+		char done;
+		// the IRIs of the ontologies and the imports seen so far, without '<'
+		// and '>', and their ontologies, NULL if they have not been loaded
+		List iris;
+		List iri_ontologies;
+		// the namespaces of the kb. they are declared before the imports are
+		// found, the parser threads only read them.
+		List namespaces;
+	#ifdef HAVE_PTHREAD_H
+		// for the ontologies and their states, the imports and the IRIs
+		pthread_mutex_t lock;
+		// an ontology has been found or parsed
+		pthread_cond_t changed;
+		pthread_t* parsers;
+		int parser_count;
+	#endif
+	} Imports;
+
+	#ifdef HAVE_PTHREAD_H
+	#define LOCK_IMPORTS(imports)		pthread_mutex_lock(&((imports)->lock))
+	#define UNLOCK_IMPORTS(imports)		pthread_mutex_unlock(&((imports)->lock))
+	#else
+	#define LOCK_IMPORTS(imports)
+	#define UNLOCK_IMPORTS(imports)
+	#endif
+
+	// size of the chunks the input is split into for parsing on several threads
+	#define CHUNK_SIZE			(1 << 18)
+	// the chunk parsers parse at most this many chunks per thread ahead of
+	// the one that is added to the kb
+	#define CHUNKS_AHEAD		2
+
+	// the states of a chunk
+	#define CHUNK_WAITING		0
+	#define CHUNK_PARSING		1
+	#define CHUNK_PARSED		2
+
+	// a chunk of the input after the first one, see lexer_split
+	typedef struct {
+		// the axioms, NULL before the chunk is parsed and after it is added
+		AxiomBuffer* buffer;
+		char state;
+		// the result of the parse
+		int result;
+		// where the chunk starts, where its lexer has stopped, and whether the
+		// next chunk starts there
+		char* start;
+		char* stop;
+		char exact;
+		// the ')' that closes the ontology, NULL if it is not in the chunk
+		char* closing;
+	} Chunk;
+
+	// the chunks of the ontology being parsed. the chunk parsers parse them
+	// into buffers while the first one is parsed, the buffers are added to
+	// the kb in the order of the chunks.
+	typedef struct {
+		// the parser of the first chunk
+		struct parser* parser;
+		Chunk* chunks;
+		uint32_t chunk_count;
+		// the next one that can be waiting for a chunk parser
+		uint32_t next;
+		// the one that is added to the kb
+		uint32_t current;
+		// set when no more chunks are parsed
+		char done;
+	#ifdef HAVE_PTHREAD_H
+		// for the states of the chunks, next, current and done
+		pthread_mutex_t lock;
+		// a chunk has been parsed or added
+		pthread_cond_t changed;
+		pthread_t* parsers;
+		int parser_count;
+	#endif
+	} Chunks;
+
+	#ifdef HAVE_PTHREAD_H
+	#define LOCK_CHUNKS(chunks)			pthread_mutex_lock(&((chunks)->lock))
+	#define UNLOCK_CHUNKS(chunks)		pthread_mutex_unlock(&((chunks)->lock))
+	#else
+	#define LOCK_CHUNKS(chunks)
+	#define UNLOCK_CHUNKS(chunks)
+	#endif
+
+	#define OWL_PREFIX			"<http://www.w3.org/2002/07/owl#>"
+	#define OWL_THING_IRI		"<http://www.w3.org/2002/07/owl#Thing>"
+	#define OWL_NOTHING_IRI		"<http://www.w3.org/2002/07/owl#Nothing>"
+
+	// the state of a parse. the operands of the n-ary expressions and axioms are
+	// collected in growable lists, which are cleared after use and keep their
+	// space for the next expression or axiom of the same kind. one list per kind
+	// is enough: the operand lists are right recursive, a nested expression is
+	// reduced before the first operand of the enclosing one is added.
+	typedef struct parser {
+		Lexer* lexer;
+		// indexes the told axioms while parsing, NULL if they are indexed later
+		IndexPipeline* pipeline;
+		// the ontology being parsed
+		ImportedOntology* ontology;
+		// the buffer of an imported ontology, the expressions and the axioms
+		// are created in the kb when it is replayed. NULL if they are created
+		// while parsing.
+		AxiomBuffer* buffer;
+		// the pool the names are interned in, the one of the buffer or of the kb
+		StringPool* iris;
+		// set if the syntax errors are not reported, the input is parsed again
+		// from the start of the chunk if the parse of a chunk fails
+		char quiet;
+		// the other chunks of the input, NULL if it has not been split
+		Chunks* chunks;
+		// the ')' that closes the ontology if it is in the chunk
+		char* closing;
+		// the conjuncts in an ObjectIntersectionOf expression
+		List conjuncts;
+		// the class expressions in an EquivalentClasses axiom
+		List equivalent_classes;
+		// the object property expressions in an EquivalentObjectProperties axiom
+		List equivalent_objectproperties;
+		// the object property expressions in an object property chain expression
+		List objectproperty_chain_components;
+		// the object properties in an HasKey expression
+		List haskey_objectproperties;
+		// the class expressions in a DisjointClasses axiom
+		List disjoint_classes;
+		// the individuals in a SameIndividual axiom
+		List same_individuals;
+		// the individuals in a DifferentIndividuals axiom
+		List different_individuals;
+		// the imports closure
+		Imports* imports;
+		// the prefixes declared in the ontology document. the parsers of its
+		// chunks share them, they only read them.
+		List prefixes;
+		// the buffers for expanding a prefixed name and for the name an IRI
+		// is stored with
+		char* expanded_iri;
+		size_t expanded_iri_size;
+		char* stored_name;
+		size_t stored_name_size;
+	} Parser;
+
+	static int yylex(YYSTYPE* value, Parser* parser);
+	static void yyerror(KB* kb, Parser* parser, char* msg);
+
+	// intern the IRI in the given token with the name it is stored with
+	#define INTERN_IRI(token)		stored_name(parser, &(token))
+
+	static StringPoolEntry* stored_name(Parser* parser, Token* token);
+	static void* buffer_name(Parser* parser, uint32_t operation, Token* token);
+	static void* buffer_operation(Parser* parser, uint32_t operation);
+	static void* buffer_operands(Parser* parser, uint32_t operation, uint32_t count);
+	static void declare_prefix(Parser* parser, Token* name, Token* prefix, KB* kb);
+	static void add_ontology_iri(Parser* parser, Token* iri);
+	static void import_ontology(Parser* parser, Token* iri);
+	static void init_parser(Parser* parser, Lexer* lexer, Imports* imports, ImportedOntology* ontology, AxiomBuffer* buffer);
+	static void reset_parser(Parser* parser);
+	static int helper_count(int threads);
+	static void split_input(Parser* parser);
+	static void add_chunks(Parser* parser);
+
+	static void unsupported_feature(Parser* parser, char* feature);
 %}
 
-%parse-param {KB* kb} 
+%define api.pure full
+%parse-param {KB* kb} {Parser* parser}
+%lex-param {Parser* parser}
 
-%start ontologyDocument
+%start input
 
 %token PNAME_NS PNAME_LN IRI_REF BLANK_NODE_LABEL LANGTAG QUOTED_STRING
 %token DOUBLE_CARET
@@ -114,6 +305,9 @@
 %token SUB_CLASS_OF EQUIVALENT_CLASSES DISJOINT_CLASSES
 %token SUB_OBJECT_PROPERTY_OF TRANSITIVE_OBJECT_PROPERTY EQUIVALENT_OBJECT_PROPERTIES REFLEXIVE_OBJECT_PROPERTY
 
+/* the chunks of the input, see lexer_split */
+%token CHUNK_START PARSED_CHUNKS
+
 %%
 
 /*****************************************************************************/
@@ -126,14 +320,10 @@ nodeID:
 	BLANK_NODE_LABEL;	
 
 fullIRI:
-	IRI_REF { 
-		$$.text = strdup(yytext); 
-	};	
+	IRI_REF;
 	
 prefixName:
-	PNAME_NS { 
-		$$.text = strdup(yytext); 
-	};
+	PNAME_NS;
 	
 abbreviatedIRI:
 	PNAME_LN;
@@ -144,17 +334,17 @@ IRI:
 
 /*****************************************************************************/
 /* Ontology */
+input:
+	ontologyDocument
+	| CHUNK_START chunkAxioms chunkEnd;
+
 ontologyDocument:
 	prefixDeclaration ontology;
 	
 prefixDeclaration:
 	| prefixDeclaration PREFIX '(' prefixName '=' fullIRI ')' {
-		create_prefix($4.text, $6.text, kb);
-		/*
-		// free the name, no need to keep it in the hash of prefixes
-		// do not free the prefix itself, we need to store it in the hash
-		free($4.text);
-		*/
+		// both are copied to the string pool of the kb
+		declare_prefix(parser, &($4.token), &($6.token), kb);
 	};
 	
 ontology:
@@ -163,19 +353,38 @@ ontology:
 	| ONTOLOGY '(' directlyImportsDocuments ontologyAnnotations axioms ')';
 
 ontologyIRI:
-	IRI;
+	IRI { add_ontology_iri(parser, &($1.token)); };
 
 versionIRI:
-	IRI;
+	IRI { add_ontology_iri(parser, &($1.token)); };
 	
 directlyImportsDocuments:
-	| directlyImportsDocuments IMPORT '(' IRI ')';
+	| directlyImportsDocuments IMPORT '(' IRI ')' { import_ontology(parser, &($4.token)); };
 	
 ontologyAnnotations:
 	| ontologyAnnotations annotation;
 	
 axioms:
-	| axioms Axiom;
+	{
+		// the prefixes are known, the chunks after the first one can be
+		// parsed on other threads
+		split_input(parser);
+	}
+	| axioms Axiom {
+		if (parser->buffer != NULL)
+			buffer_operation(parser, BUFFER_AXIOM_END);
+	}
+	| axioms PARSED_CHUNKS { add_chunks(parser); };
+
+/* a chunk of the input after the first one */
+chunkAxioms:
+	| chunkAxioms Axiom {
+		if (parser->buffer != NULL)
+			buffer_operation(parser, BUFFER_AXIOM_END);
+	};
+
+chunkEnd:
+	| ')' { parser->closing = $1.token.text; };
 
 Declaration:
 	DECLARATION '(' axiomAnnotations Entity ')'
@@ -240,17 +449,27 @@ annotationPropertyRange:
 	
 
 Class:
-	IRI	{ $$.concept = get_create_atomic_concept(yytext, kb->tbox); };
+	IRI	{
+		if (parser->buffer == NULL)
+			$$.concept = get_create_atomic_concept(INTERN_IRI($1.token), kb->tbox);
+		else
+			$$.concept = buffer_name(parser, BUFFER_CLASS, &($1.token));
+	};
 
 Datatype:
 	IRI;
 
 ObjectProperty:
-	IRI	{ $$.role = get_create_atomic_role(yytext, kb->tbox); };
+	IRI	{
+		if (parser->buffer == NULL)
+			$$.role = get_create_atomic_role(INTERN_IRI($1.token), kb->tbox);
+		else
+			$$.role = buffer_name(parser, BUFFER_OBJECT_PROPERTY, &($1.token));
+	};
 
 DataProperty:
 	IRI { 
-		unsupported_feature("DataProperty");
+		unsupported_feature(parser, "DataProperty");
 	};
 
 AnnotationProperty:
@@ -260,7 +479,12 @@ Individual:
 	NamedIndividual;
 
 NamedIndividual:
-	IRI	{ $$.individual = get_create_individual(yytext, kb->abox); };
+	IRI	{
+		if (parser->buffer == NULL)
+			$$.individual = get_create_individual(INTERN_IRI($1.token), kb->abox);
+		else
+			$$.individual = buffer_name(parser, BUFFER_INDIVIDUAL, &($1.token));
+	};
 
 Literal:
 	typedLiteral 
@@ -295,7 +519,7 @@ DataRange:
 	// TODO:
 DataIntersectionOf:
 	DATA_INTERSECTION_OF '(' DataRange DataRange dataRanges ')' {
-		unsupported_feature("DataIntersectionOf");
+		unsupported_feature(parser, "DataIntersectionOf");
 	};
 
 dataRanges:
@@ -305,7 +529,7 @@ dataRanges:
 	// TODO:
 DataOneOf:
 	DATA_ONE_OF '(' Literal ')' {
-		unsupported_feature("DataOneOf");
+		unsupported_feature(parser, "DataOneOf");
 	}
 
 
@@ -322,60 +546,75 @@ ClassExpression:
 conjuncts:
 	| ClassExpression conjuncts {
 		if ($1.concept != NULL)
-			conjuncts[conjunct_count++] = $1.concept;
+			list_add($1.concept, &(parser->conjuncts));
 	};
 
 
 ObjectIntersectionOf:
 	OBJECT_INTERSECTION_OF '(' ClassExpression ClassExpression conjuncts ')' {
-		conjuncts[conjunct_count++] = $3.concept;
-		conjuncts[conjunct_count++] = $4.concept;
-		$$.concept = get_create_conjunction(conjunct_count, conjuncts, kb->tbox);
-		conjunct_count = 0;
+		list_add($3.concept, &(parser->conjuncts));
+		list_add($4.concept, &(parser->conjuncts));
+		if (parser->buffer == NULL)
+			$$.concept = get_create_conjunction(parser->conjuncts.size, (ClassExpression**) parser->conjuncts.elements, kb->tbox);
+		else
+			$$.concept = buffer_operands(parser, BUFFER_OBJECT_INTERSECTION_OF, parser->conjuncts.size);
+		parser->conjuncts.size = 0;
 	};
 
 
 // OWL2 EL allows only one individual in an ObjectOneOf description
 ObjectOneOf:
 	OBJECT_ONE_OF '(' Individual ')' {
-		$$.concept = get_create_nominal($3.individual, kb->tbox);
+		if (parser->buffer == NULL)
+			$$.concept = get_create_nominal($3.individual, kb->tbox);
+		else
+			$$.concept = buffer_operation(parser, BUFFER_OBJECT_ONE_OF);
 	};
 
 ObjectSomeValuesFrom:
 	OBJECT_SOME_VALUES_FROM '(' ObjectPropertyExpression ClassExpression ')' {
-		$$.concept = get_create_exists_restriction($3.role, $4.concept, kb->tbox);
+		if (parser->buffer == NULL)
+			$$.concept = get_create_exists_restriction($3.role, $4.concept, kb->tbox);
+		else
+			$$.concept = buffer_operation(parser, BUFFER_OBJECT_SOME_VALUES_FROM);
 	};
 
 	// TODO:
 ObjectHasValue:
 	OBJECT_HAS_VALUE '(' ObjectPropertyExpression Individual ')' {
-		unsupported_feature("ObjecHasValue");
+		unsupported_feature(parser, "ObjecHasValue");
+		// for now just return the top concept
+		$$.concept = (parser->buffer == NULL) ? kb->tbox->top_concept : buffer_operands(parser, BUFFER_THING, 2);
 	};
 
 	// TODO:
 ObjectHasSelf:
 	OBJECT_HAS_SELF '(' ObjectPropertyExpression ')' {
-		unsupported_feature("ObjecHasSelf");
+		unsupported_feature(parser, "ObjecHasSelf");
+		// for now just return the top concept
+		$$.concept = (parser->buffer == NULL) ? kb->tbox->top_concept : buffer_operands(parser, BUFFER_THING, 1);
 	};
 
 	// 4 shift/reduce conflicts due to the dataPropertyExpressions in the middle
 DataSomeValuesFrom:
 	DATA_SOME_VALUES_FROM '(' DataPropertyExpression dataPropertyExpressions DataRange ')' {
-		unsupported_feature("DataSomeValuesFrom");
+		unsupported_feature(parser, "DataSomeValuesFrom");
+		// for now just return the top concept
+		$$.concept = (parser->buffer == NULL) ? kb->tbox->top_concept : buffer_operands(parser, BUFFER_THING, 0);
 	};
 
 	// TODO:
 dataPropertyExpressions:
 	| DataPropertyExpression dataPropertyExpressions {
-		unsupported_feature("dataPropertyExpressions");
+		unsupported_feature(parser, "dataPropertyExpressions");
 	};
 
 	// TODO:
 DataHasValue:
 	DATA_HAS_VALUE '(' DataPropertyExpression Literal ')' {
-		unsupported_feature("DataHasValue");
+		unsupported_feature(parser, "DataHasValue");
 		// for now just return the top concept
-		$$.concept = kb->tbox->top_concept;
+		$$.concept = (parser->buffer == NULL) ? kb->tbox->top_concept : buffer_operands(parser, BUFFER_THING, 0);
 	};
 
 Axiom:
@@ -395,7 +634,14 @@ ClassAxiom:
 
 SubClassOf:
 	SUB_CLASS_OF '(' axiomAnnotations subClassExpression superClassExpression ')' {
-		ADD_SUBCLASS_OF_AXIOM(create_subclass_axiom($4.concept, $5.concept), kb->tbox);
+		if (parser->buffer != NULL)
+			buffer_operation(parser, BUFFER_SUB_CLASS_OF);
+		else {
+			SubClassOfAxiom* ax = create_subclass_axiom($4.concept, $5.concept, kb->tbox);
+			ADD_SUBCLASS_OF_AXIOM(ax, kb->tbox);
+			if (parser->pipeline != NULL)
+				index_pipeline_add_subclass_axiom(parser->pipeline, ax);
+		}
 	};
 
 subClassExpression:
@@ -407,34 +653,40 @@ superClassExpression:
 // TODO: move the creation of binary axioms to preprocessing
 EquivalentClasses:
 	EQUIVALENT_CLASSES '(' axiomAnnotations ClassExpression ClassExpression equivalentClassExpressions ')' {
-		equivalent_classes[equivalent_classes_count++] = $4.concept;
-		equivalent_classes[equivalent_classes_count++] = $5.concept;
+		list_add($4.concept, &(parser->equivalent_classes));
+		list_add($5.concept, &(parser->equivalent_classes));
 		int i;
-		for (i = 0; i < equivalent_classes_count - 1; ++i)
-			ADD_EQUIVALENT_CLASSES_AXIOM(create_eqclass_axiom(equivalent_classes[i], equivalent_classes[i+1]), kb->tbox);
-		equivalent_classes_count = 0;
+		if (parser->buffer != NULL)
+			buffer_operands(parser, BUFFER_EQUIVALENT_CLASSES, parser->equivalent_classes.size);
+		else
+			for (i = 0; i < parser->equivalent_classes.size - 1; ++i)
+				ADD_EQUIVALENT_CLASSES_AXIOM(create_eqclass_axiom((ClassExpression*) parser->equivalent_classes.elements[i], (ClassExpression*) parser->equivalent_classes.elements[i+1], kb->tbox), kb->tbox);
+		parser->equivalent_classes.size = 0;
 	};
 
 // for parsing EquivalentClasses axioms containing more than 2 class expressions
 equivalentClassExpressions:
 	| ClassExpression equivalentClassExpressions {
 		if ($1.concept != NULL)
-			equivalent_classes[equivalent_classes_count++] = $1.concept;
+			list_add($1.concept, &(parser->equivalent_classes));
 	};
 
 DisjointClasses:
 	DISJOINT_CLASSES '(' axiomAnnotations ClassExpression ClassExpression disjointClassExpressions ')' {
-		disjoint_classes[disjoint_classes_count++] = $4.concept;
-		disjoint_classes[disjoint_classes_count++] = $5.concept;
-		ADD_DISJOINT_CLASSES_AXIOM(create_disjointclasses_axiom(disjoint_classes_count, disjoint_classes), kb->tbox);
-		disjoint_classes_count = 0;
+		list_add($4.concept, &(parser->disjoint_classes));
+		list_add($5.concept, &(parser->disjoint_classes));
+		if (parser->buffer != NULL)
+			buffer_operands(parser, BUFFER_DISJOINT_CLASSES, parser->disjoint_classes.size);
+		else
+			ADD_DISJOINT_CLASSES_AXIOM(create_disjointclasses_axiom(parser->disjoint_classes.size, (ClassExpression**) parser->disjoint_classes.elements, kb->tbox), kb->tbox);
+		parser->disjoint_classes.size = 0;
 	};
 
 
 disjointClassExpressions:
 	| ClassExpression disjointClassExpressions {
 		if ($1.concept != NULL)
-			disjoint_classes[disjoint_classes_count++] = $1.concept;
+			list_add($1.concept, &(parser->disjoint_classes));
 	};
 
 
@@ -449,7 +701,14 @@ ObjectPropertyAxiom:
 	
 SubObjectPropertyOf:
 	SUB_OBJECT_PROPERTY_OF '(' axiomAnnotations subObjectPropertyExpression superObjectPropertyExpression ')' {
-		ADD_SUBOBJECTPROPERTY_OF_AXIOM(create_subrole_axiom($4.role, $5.role), kb->tbox);
+		if (parser->buffer != NULL)
+			buffer_operation(parser, BUFFER_SUB_OBJECT_PROPERTY_OF);
+		else {
+			SubObjectPropertyOfAxiom* ax = create_subrole_axiom($4.role, $5.role, kb->tbox);
+			ADD_SUBOBJECTPROPERTY_OF_AXIOM(ax, kb->tbox);
+			if (parser->pipeline != NULL)
+				index_pipeline_add_subrole_axiom(parser->pipeline, ax);
+		}
 	};
 
 subObjectPropertyExpression:
@@ -458,16 +717,19 @@ subObjectPropertyExpression:
 
 propertyExpressionChain:
 	OBJECT_PROPERTY_CHAIN '(' ObjectPropertyExpression ObjectPropertyExpression chainObjectPropertyExpressions ')' {
-		objectproperty_chain_components[objectproperty_chain_components_count++] = $4.role;
-		objectproperty_chain_components[objectproperty_chain_components_count++] = $3.role;
-		$$.role = get_create_role_composition(objectproperty_chain_components_count, objectproperty_chain_components, kb->tbox);
-		objectproperty_chain_components_count = 0;
+		list_add($4.role, &(parser->objectproperty_chain_components));
+		list_add($3.role, &(parser->objectproperty_chain_components));
+		if (parser->buffer == NULL)
+			$$.role = get_create_role_composition(parser->objectproperty_chain_components.size, (ObjectPropertyExpression**) parser->objectproperty_chain_components.elements, kb->tbox);
+		else
+			$$.role = buffer_operands(parser, BUFFER_OBJECT_PROPERTY_CHAIN, parser->objectproperty_chain_components.size);
+		parser->objectproperty_chain_components.size = 0;
 	}
 
 chainObjectPropertyExpressions:
 	| ObjectPropertyExpression chainObjectPropertyExpressions {
 		if ($1.role != NULL)
-			objectproperty_chain_components[objectproperty_chain_components_count++] = $1.role;
+			list_add($1.role, &(parser->objectproperty_chain_components));
 	};
 
 superObjectPropertyExpression:
@@ -476,38 +738,47 @@ superObjectPropertyExpression:
 // TODO: move the creation of binary axioms to preprocessing
 EquivalentObjectProperties:
 	EQUIVALENT_OBJECT_PROPERTIES '(' axiomAnnotations ObjectPropertyExpression ObjectPropertyExpression equivalentObjectPropertyExpressions ')' {
-		equivalent_objectproperties[equivalent_objectproperties_count++] = $4.role;
-		equivalent_objectproperties[equivalent_objectproperties_count++] = $5.role;
+		list_add($4.role, &(parser->equivalent_objectproperties));
+		list_add($5.role, &(parser->equivalent_objectproperties));
 		int i;
-		for (i = 0; i < equivalent_objectproperties_count - 1; ++i)
-			ADD_EQUIVALENT_OBJECTPROPERTIES_AXIOM(create_eqrole_axiom(equivalent_objectproperties[i], equivalent_objectproperties[i+1]), kb->tbox);
-		equivalent_objectproperties_count = 0;
+		if (parser->buffer != NULL)
+			buffer_operands(parser, BUFFER_EQUIVALENT_OBJECT_PROPERTIES, parser->equivalent_objectproperties.size);
+		else
+			for (i = 0; i < parser->equivalent_objectproperties.size - 1; ++i)
+				ADD_EQUIVALENT_OBJECTPROPERTIES_AXIOM(create_eqrole_axiom((ObjectPropertyExpression*) parser->equivalent_objectproperties.elements[i], (ObjectPropertyExpression*) parser->equivalent_objectproperties.elements[i+1], kb->tbox), kb->tbox);
+		parser->equivalent_objectproperties.size = 0;
 	};
 	
 equivalentObjectPropertyExpressions:
 	| ObjectPropertyExpression equivalentObjectPropertyExpressions {
 		if ($1.role != NULL)
-			equivalent_objectproperties[equivalent_objectproperties_count++] = $1.role;
+			list_add($1.role, &(parser->equivalent_objectproperties));
 	};
 
 ObjectPropertyDomain:
 	OBJECT_PROPERTY_DOMAIN '(' axiomAnnotations ObjectPropertyExpression ClassExpression ')' {
-		ADD_OBJECTPROPERTY_DOMAIN_AXIOM(create_objectproperty_domain_axiom($4.role, $5.concept), kb->tbox);
+		if (parser->buffer != NULL)
+			buffer_operation(parser, BUFFER_OBJECT_PROPERTY_DOMAIN);
+		else
+			ADD_OBJECTPROPERTY_DOMAIN_AXIOM(create_objectproperty_domain_axiom($4.role, $5.concept, kb->tbox), kb->tbox);
 	};
 
 ObjectPropertyRange:
 	OBJECT_PROPERTY_RANGE '(' axiomAnnotations ObjectPropertyExpression ClassExpression ')' {
-		unsupported_feature("ObjectPropertyRange");
+		unsupported_feature(parser, "ObjectPropertyRange");
 	};
 
 ReflexiveObjectProperty:
 	REFLEXIVE_OBJECT_PROPERTY '(' axiomAnnotations ObjectPropertyExpression ')' {
-		unsupported_feature("ReflexiveObjectProperty");
+		unsupported_feature(parser, "ReflexiveObjectProperty");
 	};
 
 TransitiveObjectProperty:
 	TRANSITIVE_OBJECT_PROPERTY '(' axiomAnnotations ObjectPropertyExpression ')' {
-		ADD_TRANSITIVE_OBJECTPROPERTY_AXIOM(create_transitive_role_axiom($4.role), kb->tbox);
+		if (parser->buffer != NULL)
+			buffer_operation(parser, BUFFER_TRANSITIVE_OBJECT_PROPERTY);
+		else
+			ADD_TRANSITIVE_OBJECTPROPERTY_AXIOM(create_transitive_role_axiom($4.role, kb->tbox), kb->tbox);
 	};
 
 DataPropertyAxiom:
@@ -519,7 +790,7 @@ DataPropertyAxiom:
     
 SubDataPropertyOf:
 	SUB_DATA_PROPERTY_OF '(' axiomAnnotations subDataPropertyExpression superDataPropertyExpression ')' {
-		unsupported_feature("SubDataPropertyOf");
+		unsupported_feature(parser, "SubDataPropertyOf");
 	};
 
 subDataPropertyExpression:
@@ -530,38 +801,39 @@ superDataPropertyExpression:
 	
 EquivalentDataProperties:
 	EQUIVALENT_DATA_PROPERTIES '(' axiomAnnotations DataPropertyExpression DataPropertyExpression dataPropertyExpressions ')' {
-		unsupported_feature("EquivalentDataProperties");
+		unsupported_feature(parser, "EquivalentDataProperties");
 	};
 	
 DataPropertyDomain:
 	DATA_PROPERTY_DOMAIN '(' axiomAnnotations DataPropertyExpression ClassExpression ')' {
-		unsupported_feature("DataPropertyDomain");
+		unsupported_feature(parser, "DataPropertyDomain");
 	};
 
 DataPropertyRange:
 	DATA_PROPERTY_RANGE '(' axiomAnnotations DataPropertyExpression DataRange ')' {
-		unsupported_feature("DataPropertyRange");
+		unsupported_feature(parser, "DataPropertyRange");
 	};
 
 FunctionalDataProperty:
 	FUNCTIONAL_DATA_PROPERTY '(' axiomAnnotations DataPropertyExpression ')' {
-		unsupported_feature("FunctionalDataProperty");
+		unsupported_feature(parser, "FunctionalDataProperty");
 	};
 
 DatatypeDefinition:
 	DATATYPE_DEFINITION '(' axiomAnnotations Datatype DataRange ')' {
-		unsupported_feature("DatatypeDefinition");
+		unsupported_feature(parser, "DatatypeDefinition");
 	};
 
 HasKey:
 	HAS_KEY '(' axiomAnnotations ClassExpression '(' hasKeyObjectPropertyExpressions ')' '(' dataPropertyExpressions ')' ')' {
-		unsupported_feature("HasKey");
+		unsupported_feature(parser, "HasKey");
+		parser->haskey_objectproperties.size = 0;
 	};
 
 hasKeyObjectPropertyExpressions:
 	| ObjectPropertyExpression hasKeyObjectPropertyExpressions {
 		if ($1.role != NULL)
-			haskey_objectproperties[haskey_objectproperty_expression_count++] = $1.role;
+			list_add($1.role, &(parser->haskey_objectproperties));
 	};
 
 Assertion:
@@ -584,63 +856,878 @@ targetValue:
 	
 SameIndividual:
 	SAME_INDIVIDUAL '(' axiomAnnotations Individual Individual sameIndividuals ')' {
-		same_individuals[same_individuals_count++] = $4.individual;
-		same_individuals[same_individuals_count++] = $5.individual;
-		ADD_SAME_INDIVIDUAL_AXIOM(create_same_individual_axiom(same_individuals_count, same_individuals), kb->tbox);
-		same_individuals_count = 0;
+		list_add($4.individual, &(parser->same_individuals));
+		list_add($5.individual, &(parser->same_individuals));
+		if (parser->buffer != NULL)
+			buffer_operands(parser, BUFFER_SAME_INDIVIDUAL, parser->same_individuals.size);
+		else
+			ADD_SAME_INDIVIDUAL_AXIOM(create_same_individual_axiom(parser->same_individuals.size, (Individual**) parser->same_individuals.elements, kb->tbox), kb->tbox);
+		parser->same_individuals.size = 0;
 	};
 	
 sameIndividuals:
 	| Individual sameIndividuals {
 		if ($1.individual != NULL)
-			same_individuals[same_individuals_count++] = $1.individual;
+			list_add($1.individual, &(parser->same_individuals));
 	};
 
 DifferentIndividuals:
 	DIFFERENT_INDIVIDUALS '(' axiomAnnotations Individual Individual differentIndividuals  ')' {
-		different_individuals[different_individuals_count++] = $4.individual;
-		different_individuals[different_individuals_count++] = $5.individual;
-		ADD_DIFFERENT_INDIVIDUALS_AXIOM(create_different_individuals_axiom(different_individuals_count, different_individuals), kb->tbox);
-		different_individuals_count = 0;
+		list_add($4.individual, &(parser->different_individuals));
+		list_add($5.individual, &(parser->different_individuals));
+		if (parser->buffer != NULL)
+			buffer_operands(parser, BUFFER_DIFFERENT_INDIVIDUALS, parser->different_individuals.size);
+		else
+			ADD_DIFFERENT_INDIVIDUALS_AXIOM(create_different_individuals_axiom(parser->different_individuals.size, (Individual**) parser->different_individuals.elements, kb->tbox), kb->tbox);
+		parser->different_individuals.size = 0;
 	};
 
 differentIndividuals:
 	| Individual differentIndividuals {
 		if ($1.individual != NULL)
-			different_individuals[different_individuals_count++] = $1.individual;
+			list_add($1.individual, &(parser->different_individuals));
 	};
 
 ClassAssertion:
 	CLASS_ASSERTION '(' axiomAnnotations ClassExpression Individual ')' {
-		add_concept_assertion(create_concept_assertion($5.individual, $4.concept), kb->abox);
+		if (parser->buffer != NULL)
+			buffer_operation(parser, BUFFER_CLASS_ASSERTION);
+		else
+			add_concept_assertion(create_concept_assertion($5.individual, $4.concept, kb->abox), kb->abox);
 	};
 
 ObjectPropertyAssertion:
 	OBJECT_PROPERTY_ASSERTION '(' axiomAnnotations ObjectPropertyExpression sourceIndividual targetIndividual ')' {
-		add_role_assertion(create_role_assertion($4.role, $5.individual, $6.individual), kb->abox);
+		if (parser->buffer != NULL)
+			buffer_operation(parser, BUFFER_OBJECT_PROPERTY_ASSERTION);
+		else
+			add_role_assertion(create_role_assertion($4.role, $5.individual, $6.individual, kb->abox), kb->abox);
 	};
 
 NegativeObjectPropertyAssertion:
 	NEGATIVE_OBJECT_PROPERTY_ASSERTION '(' axiomAnnotations ObjectPropertyExpression sourceIndividual targetIndividual ')' {
-		unsupported_feature("NegativeObjectPropertyAssertion");
+		unsupported_feature(parser, "NegativeObjectPropertyAssertion");
 	};
 
 DataPropertyAssertion:
 	DATA_PROPERTY_ASSERTION '(' axiomAnnotations DataPropertyExpression sourceIndividual targetValue ')' {
-		unsupported_feature("DataPropertyAssertion");
+		unsupported_feature(parser, "DataPropertyAssertion");
 	};
 	
 NegativeDataPropertyAssertion:
 	NEGATIVE_DATA_PROPERTY_ASSERTION '(' axiomAnnotations DataPropertyExpression sourceIndividual targetValue ')' {
-		unsupported_feature("NegativeDataPropertyAssertion");
+		unsupported_feature(parser, "NegativeDataPropertyAssertion");
 	};
 
 %%
 
-void yyerror(KB* kb, char* msg) {
-	fprintf(stderr, "\nline %d near %s: %s\n", yylineno, yytext, msg);
+static int yylex(YYSTYPE* value, Parser* parser) {
+	return lexer_next(parser->lexer, &(value->token));
+}
+
+// the kb is passed to yyerror with the other %parse-param arguments
+static void yyerror(KB* kb, Parser* parser, char* msg) {
+	(void) kb;
+	if (!parser->quiet)
+		lexer_error(parser->lexer, msg);
+}
+
+/******************************************************************************
+ * prefixes
+ *****************************************************************************/
+// returns the namespace with the given prefix, NULL if there is none. the
+// prefix can be in the pool of a buffer.
+static Namespace* find_namespace(Imports* imports, StringPoolEntry* prefix) {
+	Namespace* namespace;
+	int i;
+
+	for (i = 0; i < imports->namespaces.size; ++i) {
+		namespace = (Namespace*) imports->namespaces.elements[i];
+		if (namespace->prefix->length == prefix->length && memcmp(namespace->prefix->string, prefix->string, prefix->length) == 0)
+			return namespace;
+	}
+
+	return NULL;
+}
+
+// returns 1 if a namespace is longer than the given prefix and starts with it
+static char is_nested(Imports* imports, StringPoolEntry* prefix) {
+	Namespace* namespace;
+	int i;
+
+	for (i = 0; i < imports->namespaces.size; ++i) {
+		namespace = (Namespace*) imports->namespaces.elements[i];
+		if (namespace->prefix->length > prefix->length && memcmp(namespace->prefix->string, prefix->string, prefix->length - 1) == 0)
+			return 1;
+	}
+
+	return 0;
+}
+
+static void declare_prefix(Parser* parser, Token* name, Token* prefix, KB* kb) {
+	Imports* imports = parser->imports;
+	DeclaredPrefix* declared = (DeclaredPrefix*) malloc(sizeof(DeclaredPrefix));
+	StringPoolEntry* kb_name;
+	Namespace* namespace;
+	int i;
+
+	assert(declared != NULL);
+	if (parser->buffer != NULL) {
+		declared->name = string_pool_intern(parser->iris, name->text, name->length);
+		declared->prefix = string_pool_intern(parser->iris, prefix->text, prefix->length);
+		// it is created in the kb when the buffer is replayed
+		buffer_operation(parser, BUFFER_PREFIX);
+		axiom_buffer_add(parser->buffer, declared->name->id);
+		axiom_buffer_add(parser->buffer, declared->prefix->id);
+	}
+	else {
+		kb_name = create_prefix(name->text, name->length, prefix->text, prefix->length, kb);
+		declared->name = string_pool_intern(parser->iris, name->text, name->length);
+		declared->prefix = string_pool_intern(parser->iris, prefix->text, prefix->length);
+		// the IRIs are stored with the prefixes of the importing ontology
+		if (parser->ontology == &(imports->root) && find_namespace(imports, declared->prefix) == NULL) {
+			namespace = (Namespace*) malloc(sizeof(Namespace));
+			assert(namespace != NULL);
+			namespace->name = kb_name;
+			namespace->prefix = declared->prefix;
+			namespace->owl = (strcmp(declared->prefix->string, OWL_PREFIX) == 0);
+			list_add(namespace, &(imports->namespaces));
+		}
+	}
+	declared->namespace = find_namespace(imports, declared->prefix);
+	declared->as_written = declared->namespace != NULL && !declared->namespace->owl
+			&& declared->namespace->name->length == declared->name->length
+			&& memcmp(declared->namespace->name->string, declared->name->string, declared->name->length) == 0;
+
+	list_add(declared, &(parser->prefixes));
+	for (i = 0; i < parser->prefixes.size; ++i) {
+		declared = (DeclaredPrefix*) parser->prefixes.elements[i];
+		declared->nested = is_nested(imports, declared->prefix);
+	}
+}
+
+// returns the declared prefix of the given prefixed name, NULL if it has
+// not been declared
+static DeclaredPrefix* find_prefix(Parser* parser, Token* token) {
+	uint32_t name_length = (char*) memchr(token->text, ':', token->length) - token->text + 1;
+	DeclaredPrefix* declared;
+	int i;
+
+	// the last declaration counts
+	for (i = parser->prefixes.size - 1; i >= 0; --i) {
+		declared = (DeclaredPrefix*) parser->prefixes.elements[i];
+		if (declared->name->length == name_length && memcmp(declared->name->string, token->text, name_length) == 0)
+			return declared;
+	}
+
+	return NULL;
+}
+
+static char is_iri(const char* text, uint32_t length, const char* iri) {
+	return length == strlen(iri) && memcmp(text, iri, length) == 0;
+}
+
+// returns the entry of the given local name in the given namespace.
+// owl:Thing and owl:Nothing are interned as OWL_THING and OWL_NOTHING, the
+// reasoner looks them up with these.
+static StringPoolEntry* intern_local_name(Parser* parser, Namespace* namespace, const char* local_name, uint32_t length) {
+	uint32_t name_length = namespace->name->length;
+
+	if (namespace->owl && is_iri(local_name, length, "Thing"))
+		return string_pool_intern(parser->iris, OWL_THING, strlen(OWL_THING));
+	if (namespace->owl && is_iri(local_name, length, "Nothing"))
+		return string_pool_intern(parser->iris, OWL_NOTHING, strlen(OWL_NOTHING));
+
+	if (name_length + length > parser->stored_name_size) {
+		parser->stored_name_size = 2 * (name_length + length);
+		parser->stored_name = realloc(parser->stored_name, parser->stored_name_size);
+		assert(parser->stored_name != NULL);
+	}
+	memcpy(parser->stored_name, namespace->name->string, name_length);
+	memcpy(parser->stored_name + name_length, local_name, length);
+
+	return string_pool_intern(parser->iris, parser->stored_name, name_length + length);
+}
+
+// returns the entry of the given IRI, which is written in full with '<' and
+// '>'. it is stored in the longest namespace it is in, or as it is written.
+// the hash value of the token is used in the latter case if it is not NULL.
+static StringPoolEntry* intern_full_iri(Parser* parser, const char* text, uint32_t length, Token* token) {
+	Namespace* namespace = NULL;
+	Namespace* candidate;
+	uint32_t prefix_length = 0;
+	int i;
+
+	for (i = 0; i < parser->imports->namespaces.size; ++i) {
+		candidate = (Namespace*) parser->imports->namespaces.elements[i];
+		// without the '>'
+		if (candidate->prefix->length - 1 > prefix_length && candidate->prefix->length <= length
+				&& memcmp(candidate->prefix->string, text, candidate->prefix->length - 1) == 0) {
+			namespace = candidate;
+			prefix_length = candidate->prefix->length - 1;
+		}
+	}
+	if (namespace != NULL)
+		return intern_local_name(parser, namespace, text + prefix_length, length - prefix_length - 1);
+
+	if (is_iri(text, length, OWL_THING_IRI))
+		return string_pool_intern(parser->iris, OWL_THING, strlen(OWL_THING));
+	if (is_iri(text, length, OWL_NOTHING_IRI))
+		return string_pool_intern(parser->iris, OWL_NOTHING, strlen(OWL_NOTHING));
+
+	return (token != NULL) ? intern_iri(token, parser->iris) : string_pool_intern(parser->iris, text, length);
+}
+
+static StringPoolEntry* stored_name(Parser* parser, Token* token) {
+	DeclaredPrefix* declared;
+	uint32_t prefix_length, length;
+
+	if (token->text[0] == '<')
+		return intern_full_iri(parser, token->text, token->length, token);
+	// an undeclared prefix is stored as it is written
+	if ((declared = find_prefix(parser, token)) == NULL)
+		return intern_iri(token, parser->iris);
+
+	if (declared->namespace != NULL && !declared->nested) {
+		// the usual case, it is stored as it is written
+		if (declared->as_written)
+			return intern_iri(token, parser->iris);
+		return intern_local_name(parser, declared->namespace, token->text + declared->name->length, token->length - declared->name->length);
+	}
+
+	// the prefix is not a namespace or the name can be in a longer one,
+	// expand it and look for the namespace. the prefix without the '>', the
+	// local name and the '>'.
+	prefix_length = declared->prefix->length - 1;
+	length = prefix_length + token->length - declared->name->length + 1;
+	if (length > parser->expanded_iri_size) {
+		parser->expanded_iri_size = 2 * length;
+		parser->expanded_iri = realloc(parser->expanded_iri, parser->expanded_iri_size);
+		assert(parser->expanded_iri != NULL);
+	}
+	memcpy(parser->expanded_iri, declared->prefix->string, prefix_length);
+	memcpy(parser->expanded_iri + prefix_length, token->text + declared->name->length, token->length - declared->name->length);
+	parser->expanded_iri[length - 1] = '>';
+
+	return intern_full_iri(parser, parser->expanded_iri, length, NULL);
+}
+
+/******************************************************************************
+ * buffers
+ *****************************************************************************/
+// the functions return the value of an expression that has been added to the
+// buffer. it is only created when the buffer is replayed, the value is not
+// NULL so that it is added to the operand lists.
+
+// add an entity with the name in the given token
+static void* buffer_name(Parser* parser, uint32_t operation, Token* token) {
+	axiom_buffer_add(parser->buffer, operation);
+	axiom_buffer_add(parser->buffer, stored_name(parser, token)->id);
+
+	return parser->buffer;
+}
+
+// add an expression or an axiom with fixed operands
+static void* buffer_operation(Parser* parser, uint32_t operation) {
+	axiom_buffer_add(parser->buffer, operation);
+
+	return parser->buffer;
+}
+
+// add an expression or an axiom with the given number of operands
+static void* buffer_operands(Parser* parser, uint32_t operation, uint32_t count) {
+	axiom_buffer_add(parser->buffer, operation);
+	axiom_buffer_add(parser->buffer, count);
+
+	return parser->buffer;
+}
+
+/******************************************************************************
+ * imports
+ *****************************************************************************/
+// returns the IRI in the given token without '<' and '>', '\0' terminated.
+// a prefixed name is expanded, NULL if its prefix has not been declared.
+static char* full_iri(Parser* parser, Token* token) {
+	DeclaredPrefix* declared;
+	char* iri;
+	size_t prefix_length, name_length;
+
+	if (token->text[0] == '<') {
+		iri = (char*) malloc(token->length - 1);
+		assert(iri != NULL);
+		memcpy(iri, token->text + 1, token->length - 2);
+		iri[token->length - 2] = '\0';
+		return iri;
+	}
+
+	if ((declared = find_prefix(parser, token)) == NULL)
+		return NULL;
+	prefix_length = declared->prefix->length - 2;
+	name_length = declared->name->length;
+	iri = (char*) malloc(prefix_length + token->length - name_length + 1);
+	assert(iri != NULL);
+	memcpy(iri, declared->prefix->string + 1, prefix_length);
+	memcpy(iri + prefix_length, token->text + name_length, token->length - name_length);
+	iri[prefix_length + token->length - name_length] = '\0';
+
+	return iri;
+}
+
+// returns the index of the given IRI in the ones seen so far, -1 if it has
+// not been seen
+static int find_iri(Imports* imports, char* iri) {
+	int i;
+
+	for (i = 0; i < imports->iris.size; ++i)
+		if (strcmp((char*) imports->iris.elements[i], iri) == 0)
+			return i;
+
+	return -1;
+}
+
+// the IRI and the version IRI of the ontology. an import of them is not loaded again.
+static void add_ontology_iri(Parser* parser, Token* token) {
+	Imports* imports = parser->imports;
+	char* iri;
+
+	if (imports->catalog == NULL || (iri = full_iri(parser, token)) == NULL)
+		return;
+	LOCK_IMPORTS(imports);
+	if (find_iri(imports, iri) == -1) {
+		list_add(iri, &(imports->iris));
+		list_add(parser->ontology, &(imports->iri_ontologies));
+	}
+	else
+		free(iri);
+	UNLOCK_IMPORTS(imports);
+}
+
+static void parse_found(Imports* imports, ImportedOntology* ontology, char buffered);
+
+#ifdef HAVE_PTHREAD_H
+// the parser threads take the imported ontologies in the order they have
+// been found
+static void* parse_imports(void* arg) {
+	Imports* imports = (Imports*) arg;
+
+	pthread_mutex_lock(&(imports->lock));
+	while (!imports->done) {
+		// skip the ones that have been taken
+		while (imports->next < imports->ontologies.size && ((ImportedOntology*) imports->ontologies.elements[imports->next])->state != IMPORT_FOUND)
+			++imports->next;
+		if (imports->next < imports->ontologies.size)
+			parse_found(imports, (ImportedOntology*) imports->ontologies.elements[imports->next], 1);
+		else
+			pthread_cond_wait(&(imports->changed), &(imports->lock));
+	}
+	pthread_mutex_unlock(&(imports->lock));
+
+	return NULL;
+}
+#endif
+
+// returns the ontology in the given file, which is opened if it has not been
+// found before. NULL if it cannot be opened. called with the lock held.
+static ImportedOntology* find_ontology(Imports* imports, char* iri, char* file_name) {
+	ImportedOntology* ontology;
+	CompressedFile* file;
+	char* real_name;
+	int i;
+
+	// the same file under another IRI
+	if ((real_name = realpath(file_name, NULL)) != NULL) {
+		free(file_name);
+		file_name = real_name;
+	}
+	for (i = 0; i < imports->ontologies.size; ++i) {
+		ontology = (ImportedOntology*) imports->ontologies.elements[i];
+		if (strcmp(ontology->file_name, file_name) == 0) {
+			free(file_name);
+			return ontology;
+		}
+	}
+	// the reason is printed
+	if ((file = compressed_file_open(file_name, "r")) == NULL) {
+		fprintf(stderr, "the import of <%s> is ignored\n", iri);
+		free(file_name);
+		return NULL;
+	}
+
+	ontology = (ImportedOntology*) malloc(sizeof(ImportedOntology));
+	assert(ontology != NULL);
+	ontology->file_name = file_name;
+	ontology->file = file;
+	LIST_INIT(&(ontology->imports));
+	ontology->buffer = NULL;
+	ontology->state = IMPORT_FOUND;
+	ontology->result = 0;
+	ontology->added = 0;
+	list_add(ontology, &(imports->ontologies));
+
+#ifdef HAVE_PTHREAD_H
+	int result;
+
+	// the parser threads are started with the first import. one thread less
+	// than the given number of threads, at most one less than there are
+	// processors, the thread that adds the ontologies to the kb is the last
+	// one.
+	if (imports->parsers == NULL) {
+		imports->parser_count = helper_count(imports->threads);
+		imports->parsers = (pthread_t*) malloc((imports->parser_count + 1) * sizeof(pthread_t));
+		assert(imports->parsers != NULL);
+		for (i = 0; i < imports->parser_count; ++i) {
+			result = pthread_create(&(imports->parsers[i]), NULL, parse_imports, imports);
+			assert(result == 0);
+		}
+	}
+	pthread_cond_broadcast(&(imports->changed));
+#endif
+
+	return ontology;
+}
+
+static void import_ontology(Parser* parser, Token* token) {
+	Imports* imports = parser->imports;
+	ImportedOntology* ontology;
+	char* iri;
+	char* file_name;
+	int i;
+
+	if (imports->catalog == NULL)
+		return;
+	if ((iri = full_iri(parser, token)) == NULL) {
+		lexer_error(parser->lexer, "undeclared prefix, the import is ignored");
+		return;
+	}
+
+	LOCK_IMPORTS(imports);
+	if ((i = find_iri(imports, iri)) != -1) {
+		ontology = (ImportedOntology*) imports->iri_ontologies.elements[i];
+		free(iri);
+	}
+	else {
+		file_name = catalog_resolve(imports->catalog, iri, strlen(iri));
+		if (file_name == NULL) {
+			fprintf(stderr, "\nimport <%s> is not in the catalog, it is ignored\n", iri);
+			ontology = NULL;
+		}
+		else
+			ontology = find_ontology(imports, iri, file_name);
+		list_add(iri, &(imports->iris));
+		list_add(ontology, &(imports->iri_ontologies));
+	}
+	// also if it has been found before, the order of the imports closure
+	// follows the Import declarations
+	if (ontology != NULL)
+		list_add(ontology, &(parser->ontology->imports));
+	UNLOCK_IMPORTS(imports);
+}
+
+/******************************************************************************
+ * chunks
+ *****************************************************************************/
+// the number of threads that help the calling one: one less than the given
+// number of threads, at most one less than there are processors
+static int helper_count(int threads) {
+	int processors = (int) sysconf(_SC_NPROCESSORS_ONLN);
+
+	if (processors >= 1 && processors < threads)
+		threads = processors;
+
+	return (threads > 1) ? threads - 1 : 0;
+}
+
+
+// parse the given chunk into a buffer. called with the lock held, it is
+// released while parsing.
+static void parse_chunk(Chunks* chunks, uint32_t i) {
+	Parser* parser = chunks->parser;
+	Chunk* chunk = &(chunks->chunks[i]);
+	Parser chunk_parser;
+	int result;
+
+	chunk->state = CHUNK_PARSING;
+	UNLOCK_CHUNKS(chunks);
+
+	chunk->buffer = axiom_buffer_create();
+	init_parser(&chunk_parser, lexer_chunk(parser->lexer, i), parser->imports, parser->ontology, chunk->buffer);
+	lexer_stop(chunk_parser.lexer, &(chunk->start));
+	chunk_parser.quiet = 1;
+	chunk_parser.prefixes = parser->prefixes;
+	result = yyparse(parser->imports->kb, &chunk_parser);
+	chunk->exact = lexer_stop(chunk_parser.lexer, &(chunk->stop));
+	chunk->closing = chunk_parser.closing;
+	// the prefixes are freed by the parser of the first chunk
+	LIST_INIT(&(chunk_parser.prefixes));
+	reset_parser(&chunk_parser);
+
+	LOCK_CHUNKS(chunks);
+	chunk->result = result;
+	chunk->state = CHUNK_PARSED;
+#ifdef HAVE_PTHREAD_H
+	pthread_cond_broadcast(&(chunks->changed));
+#endif
+}
+
+#ifdef HAVE_PTHREAD_H
+// the chunk parsers take the chunks in their order, at most CHUNKS_AHEAD
+// per thread ahead of the one that is added
+static void* parse_chunks(void* arg) {
+	Chunks* chunks = (Chunks*) arg;
+
+	pthread_mutex_lock(&(chunks->lock));
+	while (!chunks->done) {
+		// skip the ones that have been taken
+		while (chunks->next < chunks->chunk_count && chunks->chunks[chunks->next].state != CHUNK_WAITING)
+			++chunks->next;
+		if (chunks->next < chunks->chunk_count && chunks->next < chunks->current + CHUNKS_AHEAD * chunks->parser_count)
+			parse_chunk(chunks, chunks->next);
+		else
+			pthread_cond_wait(&(chunks->changed), &(chunks->lock));
+	}
+	pthread_mutex_unlock(&(chunks->lock));
+
+	return NULL;
+}
+#endif
+
+// split the rest of the input into chunks when the axioms start, if there
+// are threads to parse them. the imported ontologies that are parsed into
+// buffers are not split.
+static void split_input(Parser* parser) {
+#ifdef HAVE_PTHREAD_H
+	Chunks* chunks;
+	uint32_t count;
+	int threads, i, result;
+
+	if (parser->buffer != NULL || (threads = helper_count(parser->imports->threads)) == 0)
+		return;
+	if ((count = lexer_split(parser->lexer, CHUNK_SIZE)) < 2)
+		return;
+
+	chunks = (Chunks*) malloc(sizeof(Chunks));
+	assert(chunks != NULL);
+	chunks->parser = parser;
+	chunks->chunks = (Chunk*) calloc(count, sizeof(Chunk));
+	assert(chunks->chunks != NULL);
+	chunks->chunk_count = count;
+	// the first one is parsed by this parser
+	chunks->next = 1;
+	chunks->current = 1;
+	chunks->done = 0;
+	pthread_mutex_init(&(chunks->lock), NULL);
+	pthread_cond_init(&(chunks->changed), NULL);
+	chunks->parser_count = threads;
+	chunks->parsers = (pthread_t*) malloc(threads * sizeof(pthread_t));
+	assert(chunks->parsers != NULL);
+	for (i = 0; i < threads; ++i) {
+		result = pthread_create(&(chunks->parsers[i]), NULL, parse_chunks, chunks);
+		assert(result == 0);
+	}
+	parser->chunks = chunks;
+#else
+	(void) parser;
+#endif
+}
+
+// stop the chunk parsers, the chunks that are still waiting are not parsed
+static void stop_chunk_parsers(Chunks* chunks) {
+	LOCK_CHUNKS(chunks);
+	if (chunks->done) {
+		UNLOCK_CHUNKS(chunks);
+		return;
+	}
+	chunks->done = 1;
+#ifdef HAVE_PTHREAD_H
+	pthread_cond_broadcast(&(chunks->changed));
+#endif
+	UNLOCK_CHUNKS(chunks);
+#ifdef HAVE_PTHREAD_H
+	int i;
+
+	for (i = 0; i < chunks->parser_count; ++i)
+		pthread_join(chunks->parsers[i], NULL);
+#endif
+}
+
+static void free_chunks(Chunks* chunks) {
+	uint32_t i;
+
+	stop_chunk_parsers(chunks);
+	for (i = 0; i < chunks->chunk_count; ++i)
+		if (chunks->chunks[i].buffer != NULL)
+			axiom_buffer_free(chunks->chunks[i].buffer);
+	free(chunks->chunks);
+#ifdef HAVE_PTHREAD_H
+	free(chunks->parsers);
+	pthread_mutex_destroy(&(chunks->lock));
+	pthread_cond_destroy(&(chunks->changed));
+#endif
+	free(chunks);
 }
 
-void unsupported_feature(char* feature) {
-	fprintf(stderr, "unsupported feature: %s\n", feature);
+// add the chunks after the first one to the kb in their order, this thread
+// parses the ones no chunk parser has taken yet. the lexer reads on from
+// the ')' that closes the ontology, or from where a chunk parser has stopped
+// if the next chunk does not start there. if the parse of a chunk fails, it
+// reads on from the start of the chunk and the syntax error is reported
+// there. the chunks after that are not used.
+static void add_chunks(Parser* parser) {
+	Chunks* chunks = parser->chunks;
+	Chunk* chunk;
+	char* resume = NULL;
+	uint32_t i;
+
+	// the first chunk has ended where the second one starts
+	for (i = 1; i < chunks->chunk_count && resume == NULL; ++i) {
+		chunk = &(chunks->chunks[i]);
+		LOCK_CHUNKS(chunks);
+		chunks->current = i;
+#ifdef HAVE_PTHREAD_H
+		pthread_cond_broadcast(&(chunks->changed));
+#endif
+		if (chunk->state == CHUNK_WAITING)
+			parse_chunk(chunks, i);
+#ifdef HAVE_PTHREAD_H
+		while (chunk->state != CHUNK_PARSED)
+			pthread_cond_wait(&(chunks->changed), &(chunks->lock));
+#endif
+		UNLOCK_CHUNKS(chunks);
+
+		if (chunk->result != 0) {
+			resume = chunk->start;
+			break;
+		}
+		axiom_buffer_replay(chunk->buffer, parser->pipeline, parser->imports->kb);
+		axiom_buffer_free(chunk->buffer);
+		chunk->buffer = NULL;
+		if (chunk->closing != NULL)
+			resume = chunk->closing;
+		else if (!chunk->exact || i == chunks->chunk_count - 1)
+			resume = chunk->stop;
+	}
+	stop_chunk_parsers(chunks);
+	lexer_resume(parser->lexer, resume);
+}
+
+/******************************************************************************
+ * parsing
+ *****************************************************************************/
+static void init_parser(Parser* parser, Lexer* lexer, Imports* imports, ImportedOntology* ontology, AxiomBuffer* buffer) {
+	parser->lexer = lexer;
+	parser->pipeline = (buffer == NULL) ? imports->pipeline : NULL;
+	parser->ontology = ontology;
+	parser->buffer = buffer;
+	parser->iris = (buffer != NULL) ? &(buffer->names) : &(imports->kb->iris);
+	parser->quiet = 0;
+	parser->chunks = NULL;
+	parser->closing = NULL;
+	parser->imports = imports;
+	LIST_INIT(&(parser->conjuncts));
+	LIST_INIT(&(parser->equivalent_classes));
+	LIST_INIT(&(parser->equivalent_objectproperties));
+	LIST_INIT(&(parser->objectproperty_chain_components));
+	LIST_INIT(&(parser->haskey_objectproperties));
+	LIST_INIT(&(parser->disjoint_classes));
+	LIST_INIT(&(parser->same_individuals));
+	LIST_INIT(&(parser->different_individuals));
+	LIST_INIT(&(parser->prefixes));
+	parser->expanded_iri = NULL;
+	parser->expanded_iri_size = 0;
+	parser->stored_name = NULL;
+	parser->stored_name_size = 0;
+}
+
+// free the lists, the prefixes and the lexer of the given parser
+static void reset_parser(Parser* parser) {
+	int i;
+
+	list_reset(&(parser->conjuncts));
+	list_reset(&(parser->equivalent_classes));
+	list_reset(&(parser->equivalent_objectproperties));
+	list_reset(&(parser->objectproperty_chain_components));
+	list_reset(&(parser->haskey_objectproperties));
+	list_reset(&(parser->disjoint_classes));
+	list_reset(&(parser->same_individuals));
+	list_reset(&(parser->different_individuals));
+	for (i = 0; i < parser->prefixes.size; ++i)
+		free(parser->prefixes.elements[i]);
+	list_reset(&(parser->prefixes));
+	free(parser->expanded_iri);
+	free(parser->stored_name);
+	lexer_free(parser->lexer);
+}
+
+// parse the given ontology document scanned by the given lexer into the kb,
+// or into its buffer if it has one. the lexer is freed.
+static int parse(Lexer* lexer, Imports* imports, ImportedOntology* ontology) {
+	Parser parser;
+	int result;
+
+	init_parser(&parser, lexer, imports, ontology, ontology->buffer);
+	result = yyparse(imports->kb, &parser);
+	// the chunk parsers use the prefixes and the lexer
+	if (parser.chunks != NULL)
+		free_chunks(parser.chunks);
+	reset_parser(&parser);
+
+	return result;
+}
+
+// parse the given imported ontology into a buffer, or into the kb if it is
+// its turn to be added. called with the lock held, it is released while
+// parsing.
+static void parse_found(Imports* imports, ImportedOntology* ontology, char buffered) {
+	int result;
+
+	ontology->state = IMPORT_PARSING;
+	UNLOCK_IMPORTS(imports);
+
+	if (buffered)
+		ontology->buffer = axiom_buffer_create();
+	result = parse(lexer_create(compressed_file_stream(ontology->file)), imports, ontology);
+	if (result != 0)
+		fprintf(stderr, "in the imported ontology %s\n", ontology->file_name);
+	// the reason has been printed when the input was read
+	if (compressed_file_close(ontology->file) != 0)
+		result = -1;
+	ontology->file = NULL;
+
+	LOCK_IMPORTS(imports);
+	ontology->result = result;
+	ontology->state = IMPORT_PARSED;
+#ifdef HAVE_PTHREAD_H
+	pthread_cond_broadcast(&(imports->changed));
+#endif
+}
+
+// wait until the given imported ontology is parsed. it is parsed into the
+// kb by this thread if no parser thread has taken it yet. returns the result
+// of the parse.
+static int wait_parsed(Imports* imports, ImportedOntology* ontology) {
+	LOCK_IMPORTS(imports);
+	if (ontology->state == IMPORT_FOUND)
+		parse_found(imports, ontology, 0);
+#ifdef HAVE_PTHREAD_H
+	while (ontology->state != IMPORT_PARSED)
+		pthread_cond_wait(&(imports->changed), &(imports->lock));
+#endif
+	UNLOCK_IMPORTS(imports);
+
+	return ontology->result;
+}
+
+// append the imports of the given ontology to the imports closure, unless
+// they are already in it
+static void add_imports(ImportedOntology* ontology, List* closure) {
+	ImportedOntology* imported;
+	int i;
+
+	for (i = 0; i < ontology->imports.size; ++i) {
+		imported = (ImportedOntology*) ontology->imports.elements[i];
+		if (!imported->added) {
+			imported->added = 1;
+			list_add(imported, closure);
+		}
+	}
+}
+
+int parse_ontology(FILE* input, Catalog* catalog, int threads, IndexPipeline* pipeline, KB* kb) {
+	Imports imports;
+	ImportedOntology* ontology;
+	List closure;
+	int result, i;
+
+	imports.catalog = catalog;
+	imports.threads = threads;
+	imports.kb = kb;
+	imports.pipeline = pipeline;
+	imports.root.file_name = NULL;
+	imports.root.file = NULL;
+	LIST_INIT(&(imports.root.imports));
+	imports.root.buffer = NULL;
+	imports.root.state = IMPORT_PARSING;
+	imports.root.result = 0;
+	imports.root.added = 1;
+	LIST_INIT(&(imports.ontologies));
+	imports.next = 0;
+	imports.done = 0;
+	LIST_INIT(&(imports.iris));
+	LIST_INIT(&(imports.iri_ontologies));
+	LIST_INIT(&(imports.namespaces));
+#ifdef HAVE_PTHREAD_H
+	pthread_mutex_init(&(imports.lock), NULL);
+	pthread_cond_init(&(imports.changed), NULL);
+	imports.parsers = NULL;
+	imports.parser_count = 0;
+#endif
+
+	// the imported ontologies are parsed by the parser threads while this
+	// one is parsed
+	result = parse(lexer_create(input), &imports, &(imports.root));
+
+	// the imports closure is added to the kb in the order the ontologies are
+	// found if they are parsed one after the other, breadth-first from the
+	// importing ontology. the kb is the same whichever thread parses them.
+	LIST_INIT(&closure);
+	add_imports(&(imports.root), &closure);
+	for (i = 0; i < closure.size && result == 0; ++i) {
+		ontology = (ImportedOntology*) closure.elements[i];
+		if ((result = wait_parsed(&imports, ontology)) == 0) {
+			if (ontology->buffer != NULL) {
+				axiom_buffer_replay(ontology->buffer, pipeline, kb);
+				axiom_buffer_free(ontology->buffer);
+				ontology->buffer = NULL;
+			}
+			add_imports(ontology, &closure);
+		}
+	}
+	list_reset(&closure);
+
+	// the ontologies that are still waiting are not parsed anymore
+	LOCK_IMPORTS(&imports);
+	imports.done = 1;
+#ifdef HAVE_PTHREAD_H
+	pthread_cond_broadcast(&(imports.changed));
+#endif
+	UNLOCK_IMPORTS(&imports);
+#ifdef HAVE_PTHREAD_H
+	for (i = 0; i < imports.parser_count; ++i)
+		pthread_join(imports.parsers[i], NULL);
+	free(imports.parsers);
+	pthread_mutex_destroy(&(imports.lock));
+	pthread_cond_destroy(&(imports.changed));
+#endif
+
+	for (i = 0; i < imports.ontologies.size; ++i) {
+		ontology = (ImportedOntology*) imports.ontologies.elements[i];
+		if (ontology->file != NULL)
+			compressed_file_close(ontology->file);
+		if (ontology->buffer != NULL)
+			axiom_buffer_free(ontology->buffer);
+		list_reset(&(ontology->imports));
+		free(ontology->file_name);
+		free(ontology);
+	}
+	list_reset(&(imports.ontologies));
+	list_reset(&(imports.root.imports));
+	for (i = 0; i < imports.iris.size; ++i)
+		free(imports.iris.elements[i]);
+	list_reset(&(imports.iris));
+	list_reset(&(imports.iri_ontologies));
+	for (i = 0; i < imports.namespaces.size; ++i)
+		free(imports.namespaces.elements[i]);
+	list_reset(&(imports.namespaces));
+
+	return result;
+}
+
+// the warning is printed when the buffer is replayed, in the order of the input
+static void unsupported_feature(Parser* parser, char* feature) {
+	if (parser->buffer == NULL) {
+		fprintf(stderr, "unsupported feature: %s\n", feature);
+		return;
+	}
+	axiom_buffer_add(parser->buffer, BUFFER_UNSUPPORTED);
+	axiom_buffer_add(parser->buffer, string_pool_intern(parser->iris, feature, strlen(feature))->id);
 }
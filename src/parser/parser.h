@@ -0,0 +1,58 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARSER_H_
+#define PARSER_H_
+
+#include <stdio.h>
+
+#include "../model/datatypes.h"
+#include "../index/pipeline.h"
+#include "imports.h"
+
+/**
+ * Parse the ontology in functional syntax from the current position of the
+ * given input into the given KB, with the given number of threads. The
+ * axioms after the first chunk of the input are parsed by the other threads
+ * into axiom buffers, which are added to the KB in the order of the input.
+ * The told axioms are passed to the given pipeline for
+ * indexing if it is not NULL. The parser keeps its state in the call,
+ * several ontologies can be parsed at the same time into different KBs.
+ *
+ * If the catalog is not NULL, the imports closure is loaded into the same
+ * KB: the imported ontologies are looked up in the catalog and parsed
+ * while the ontologies that import them are parsed, each one on a thread of
+ * its own, into an axiom buffer (see axiom_buffer.h). The buffers are added
+ * to the KB on the calling thread in the order the ontologies are found,
+ * the KB is the same as if they were parsed one after the other. The
+ * imports that no thread has taken when it is their turn are parsed into
+ * the KB directly. The given number of threads, at most as many as there
+ * are processors, includes the calling one. Each one is parsed once, an
+ * import that is not in the catalog is ignored with a warning.
+ *
+ * The IRIs are stored in the KB with the prefixes declared in the input
+ * ontology, see datatypes.h: an IRI in the namespace of such a prefix,
+ * written in full or with any prefix name, is stored as the name of the
+ * prefix in the KB and the local name. The other IRIs are stored in full.
+ * A prefix name that an imported ontology declares for another IRI than
+ * the ontologies before gets another name in the KB.
+ * Returns 0 on success, nonzero if there is a syntax error.
+ */
+int parse_ontology(FILE* input, Catalog* catalog, int threads, IndexPipeline* pipeline, KB* kb);
+
+#endif /* PARSER_H_ */
@@ -0,0 +1,158 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "prescan.h"
+
+#define PRESCAN_BUFFER_SIZE		(1 << 16)
+
+// longest keyword that is counted, longer words are ignored
+#define MAX_KEYWORD_LENGTH		32
+
+typedef struct {
+	const char* keyword;
+	size_t length;
+	size_t offset;			// offset of the counter in OntologyCounts
+} Keyword;
+
+#define KEYWORD(keyword, field)		{keyword, sizeof(keyword) - 1, offsetof(OntologyCounts, field)}
+
+static const Keyword keywords[] = {
+		KEYWORD("SubClassOf", subclass_of_axioms),
+		KEYWORD("Class", classes),
+		KEYWORD("ObjectSomeValuesFrom", object_some_values_from),
+		KEYWORD("ObjectIntersectionOf", object_intersection_of),
+		KEYWORD("ObjectProperty", object_properties),
+		KEYWORD("NamedIndividual", individuals),
+		KEYWORD("EquivalentClasses", equivalent_classes_axioms),
+		KEYWORD("DisjointClasses", disjoint_classes_axioms),
+		KEYWORD("ClassAssertion", class_assertions),
+		KEYWORD("ObjectPropertyAssertion", object_property_assertions),
+		KEYWORD("ObjectOneOf", object_one_of),
+		KEYWORD("ObjectPropertyChain", object_property_chains),
+		KEYWORD("SubObjectPropertyOf", subobject_property_of_axioms),
+		KEYWORD("EquivalentObjectProperties", equivalent_object_properties_axioms),
+		KEYWORD("TransitiveObjectProperty", transitive_object_property_axioms),
+		KEYWORD("ObjectPropertyDomain", object_property_domain_axioms),
+		KEYWORD("SameIndividual", same_individual_axioms),
+		KEYWORD("DifferentIndividuals", different_individuals_axioms),
+		KEYWORD("Prefix", prefixes)
+};
+
+#define KEYWORD_COUNT			(sizeof(keywords) / sizeof(Keyword))
+
+static inline void count_keyword(const char* word, size_t length, OntologyCounts* counts) {
+	size_t i;
+
+	for (i = 0; i < KEYWORD_COUNT; ++i)
+		if (keywords[i].length == length && memcmp(keywords[i].keyword, word, length) == 0) {
+			++*((uint32_t*) ((char*) counts + keywords[i].offset));
+			return;
+		}
+}
+
+// skip the literal in the buffer from i on, up to n. a literal ends at a
+// quote that is not escaped. returns the position after the literal, n if
+// it goes on in the next buffer.
+static inline size_t skip_literal(const char* buffer, size_t i, size_t n, char* in_literal, char* escaped) {
+	const char* quote;
+	size_t end, j;
+
+	// the last character of the previous buffer was a backslash
+	if (*escaped) {
+		*escaped = 0;
+		++i;
+	}
+	while (i < n) {
+		quote = memchr(buffer + i, '"', n - i);
+		end = (quote == NULL) ? n : (size_t) (quote - buffer);
+		// the backslashes right before the quote, or at the end of the buffer
+		for (j = end; j > i && buffer[j - 1] == '\\'; --j)
+			;
+		if (quote == NULL) {
+			*escaped = (end - j) % 2;
+			return n;
+		}
+		if ((end - j) % 2 == 0) {
+			*in_literal = 0;
+			return end + 1;
+		}
+		i = end + 1;
+	}
+
+	return n;
+}
+
+char prescan_ontology(FILE* input, OntologyCounts* counts) {
+	char buffer[PRESCAN_BUFFER_SIZE];
+	char word[MAX_KEYWORD_LENGTH];
+	size_t word_length = 0, read_bytes, i;
+	char in_iri = 0, in_literal = 0, escaped = 0, c;
+	char* end;
+	long start = ftell(input);
+
+	memset(counts, 0, sizeof(OntologyCounts));
+	if (start < 0)
+		return 0;
+
+	while ((read_bytes = fread(buffer, 1, PRESCAN_BUFFER_SIZE, input)) > 0) {
+		counts->bytes += read_bytes;
+		for (i = 0; i < read_bytes; ++i) {
+			// the literals and the IRIs are skipped with memchr, most of the
+			// bytes of annotated ontologies are in them
+			if (in_literal) {
+				i = skip_literal(buffer, i, read_bytes, &in_literal, &escaped) - 1;
+				continue;
+			}
+			if (in_iri) {
+				end = memchr(buffer + i, '>', read_bytes - i);
+				if (end == NULL) {
+					i = read_bytes - 1;
+					continue;
+				}
+				i = end - buffer;
+				in_iri = 0;
+				continue;
+			}
+			c = buffer[i];
+			if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) {
+				// a word that fills the buffer is longer than any keyword
+				if (word_length < MAX_KEYWORD_LENGTH)
+					word[word_length++] = c;
+				continue;
+			}
+			if (c == '(' && word_length < MAX_KEYWORD_LENGTH)
+				count_keyword(word, word_length, counts);
+			else if (c == '<')
+				in_iri = 1;
+			else if (c == '"')
+				in_literal = 1;
+			word_length = 0;
+		}
+	}
+
+	if (fseek(input, start, SEEK_SET) != 0) {
+		memset(counts, 0, sizeof(OntologyCounts));
+		return 0;
+	}
+
+	return 1;
+}
@@ -0,0 +1,76 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PRESCAN_H_
+#define PRESCAN_H_
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * A quick pass over an ontology in functional syntax that counts the
+ * declarations, axioms and class expressions without parsing them. The
+ * counts are used for sizing the tables of the KB before loading.
+ * A keyword is counted wherever it is followed by an opening parenthesis
+ * outside IRIs and literals, i.e., class expressions are counted once per
+ * occurrence, not once per distinct expression.
+ */
+
+typedef struct ontology_counts OntologyCounts;
+
+struct ontology_counts {
+	size_t bytes;						// size of the input
+
+	uint32_t prefixes;
+
+	// declarations
+	uint32_t classes;
+	uint32_t object_properties;
+	uint32_t individuals;
+
+	// class and object property expressions
+	uint32_t object_some_values_from;
+	uint32_t object_intersection_of;
+	uint32_t object_one_of;
+	uint32_t object_property_chains;
+
+	// axioms
+	uint32_t subclass_of_axioms;
+	uint32_t equivalent_classes_axioms;
+	uint32_t disjoint_classes_axioms;
+	uint32_t subobject_property_of_axioms;
+	uint32_t equivalent_object_properties_axioms;
+	uint32_t transitive_object_property_axioms;
+	uint32_t object_property_domain_axioms;
+	uint32_t same_individual_axioms;
+	uint32_t different_individuals_axioms;
+
+	// assertions
+	uint32_t class_assertions;
+	uint32_t object_property_assertions;
+};
+
+/**
+ * Count the keywords in the given input and rewind it.
+ * Returns 1 on success, 0 if the input cannot be rewound (e.g. a pipe).
+ * Nothing is read in that case.
+ */
+char prescan_ontology(FILE* input, OntologyCounts* counts);
+
+#endif /* PRESCAN_H_ */
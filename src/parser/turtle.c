@@ -0,0 +1,803 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <assert.h>
+
+#include "../model/datatypes.h"
+#include "../model/model.h"
+#include "../model/utils.h"
+#include "../hashing/string_pool.h"
+#include "../utils/list.h"
+#include "turtle.h"
+
+// size of the block of the input in memory. it is only enlarged for a token
+// that does not fit into it, like a very long literal.
+#define TRIPLES_BUFFER_SIZE		(1 << 20)
+
+// the tokens, the punctuation is returned as the character itself
+#define TOKEN_END				0
+#define TOKEN_IRI				256		// <...>
+#define TOKEN_PREFIXED_NAME		257		// prefix:local
+#define TOKEN_BLANK_NODE		258		// _:label
+#define TOKEN_LITERAL			259		// a string with its language tag, a number, true or false
+#define TOKEN_DATATYPE			260		// ^^
+#define TOKEN_A					261
+#define TOKEN_PREFIX			262		// @prefix or PREFIX
+#define TOKEN_BASE				263		// @base or BASE
+#define TOKEN_ERROR				-1
+// the token goes on in the next block of the input
+#define TOKEN_INCOMPLETE		-2
+
+// the kinds of predicates
+#define PREDICATE_TYPE			0		// rdf:type, the triple is a class assertion
+#define PREDICATE_ROLE			1		// the triple is an object property assertion
+#define PREDICATE_SKIPPED		2		// the RDF, RDFS and OWL vocabulary
+
+#define RDF_TYPE				"<http://www.w3.org/1999/02/22-rdf-syntax-ns#type>"
+#define RDF_NAMESPACE			"<http://www.w3.org/1999/02/22-rdf-syntax-ns#"
+#define RDFS_NAMESPACE			"<http://www.w3.org/2000/01/rdf-schema#"
+#define OWL_NAMESPACE			"<http://www.w3.org/2002/07/owl#"
+#define OWL_THING_IRI			"<http://www.w3.org/2002/07/owl#Thing>"
+#define OWL_NOTHING_IRI			"<http://www.w3.org/2002/07/owl#Nothing>"
+
+// a growable string, not '\0' terminated
+typedef struct {
+	char* text;
+	size_t length;
+	size_t size;
+} Text;
+
+typedef struct {
+	FILE* input;
+	KB* kb;
+	TripleCounts* counts;
+
+	// the block of the input in memory, the part from position to end has
+	// not been read yet
+	char* buffer;
+	size_t size;
+	char* position;
+	char* end;
+	char eof;
+	// number of lines before the block, for the error messages
+	uint64_t line;
+
+	// the last token. it is valid until the next one is read.
+	int type;
+	char* text;
+	size_t length;
+	// the last token has been put back, it is returned once more
+	char pushed_back;
+
+	// the prefixes of the input, '\0' terminated. the names include the ':',
+	// the IRIs are without '<' and '>'.
+	List prefix_names;
+	List prefixes;
+	char* base;
+
+	// the IRI of the last token with '<' and '>', and its prefixed name in the KB
+	Text iri;
+	Text prefixed_name;
+
+	// the subject and the predicate of the current triple. the individual
+	// and the object property are only created for an assertion.
+	StringPoolEntry* subject_iri;
+	Individual* subject;
+	StringPoolEntry* predicate_iri;
+	ObjectPropertyExpression* predicate;
+	char predicate_kind;
+} TripleReader;
+
+static void text_append(Text* text, const char* s, size_t length) {
+	if (text->length + length > text->size) {
+		text->size = 2 * (text->length + length);
+		text->text = realloc(text->text, text->size);
+		assert(text->text != NULL);
+	}
+	memcpy(text->text + text->length, s, length);
+	text->length += length;
+}
+
+static inline char starts_with(Text* text, const char* prefix) {
+	size_t length = strlen(prefix);
+
+	return text->length >= length && memcmp(text->text, prefix, length) == 0;
+}
+
+static inline char equals(Text* text, const char* s) {
+	return text->length == strlen(s) && memcmp(text->text, s, text->length) == 0;
+}
+
+/******************************************************************************
+ * the tokens
+ *****************************************************************************/
+// move the rest of the block to the start of the buffer and read the next
+// block behind it
+static void fill(TripleReader* r) {
+	size_t rest = r->end - r->position, n;
+	char* p;
+
+	for (p = r->buffer; (p = memchr(p, '\n', r->position - p)) != NULL; ++p)
+		++r->line;
+	memmove(r->buffer, r->position, rest);
+	// a token that does not fit into the buffer
+	if (rest == r->size) {
+		r->size *= 2;
+		r->buffer = realloc(r->buffer, r->size);
+		assert(r->buffer != NULL);
+	}
+	n = fread(r->buffer + rest, 1, r->size - rest, r->input);
+	if (n == 0)
+		r->eof = 1;
+	r->position = r->buffer;
+	r->end = r->buffer + rest + n;
+}
+
+// skip white space and comments from p on. returns the '#' of a comment that
+// goes on in the next block.
+static inline char* skip_blanks(char* p, char* end, char eof) {
+	char* newline;
+
+	while (p < end) {
+		if (*p == '#') {
+			newline = memchr(p, '\n', end - p);
+			if (newline == NULL)
+				return eof ? end : p;
+			p = newline;
+		}
+		else if (*p != ' ' && *p != '\t' && *p != '\n' && *p != '\r')
+			break;
+		++p;
+	}
+
+	return p;
+}
+
+// the characters that end a prefixed name, a blank node label or a keyword
+static inline char is_delimiter(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '<' || c == '>' || c == '"' || c == '\''
+			|| c == '(' || c == ')' || c == '[' || c == ']' || c == ',' || c == ';' || c == '#' || c == '^';
+}
+
+// returns 1 if the quote at q is escaped, i.e., there is an odd number of
+// backslashes between start and q
+static inline char is_escaped(char* q, char* start) {
+	char* p;
+
+	for (p = q; p > start && p[-1] == '\\'; --p)
+		;
+	return (q - p) % 2;
+}
+
+// scan the string that starts at the quote p, and its language tag
+static int scan_string(char* p, char* end, char eof, char** token_end) {
+	char quote = *p;
+	char is_long;
+	char* start;
+	char* q;
+
+	// """ or ''' start a long string, which may contain line breaks
+	if (p + 3 > end && !eof)
+		return TOKEN_INCOMPLETE;
+	is_long = (p + 2 < end && p[1] == quote && p[2] == quote);
+	start = p = p + (is_long ? 3 : 1);
+	for (;;) {
+		q = memchr(p, quote, end - p);
+		if (q == NULL || (is_long && q + 3 > end)) {
+			// not closed in the block
+			*token_end = end;
+			return eof ? TOKEN_ERROR : TOKEN_INCOMPLETE;
+		}
+		p = q + 1;
+		if (is_escaped(q, start))
+			continue;
+		if (!is_long)
+			break;
+		if (q[1] == quote && q[2] == quote) {
+			// the quotes before the last three belong to the string
+			for (p = q + 3; p < end && *p == quote; ++p)
+				;
+			break;
+		}
+	}
+
+	// the language tag
+	if (p == end && !eof)
+		return TOKEN_INCOMPLETE;
+	if (p < end && *p == '@')
+		for (++p; p < end && (isalnum((unsigned char) *p) || *p == '-'); ++p)
+			;
+	if (p == end && !eof)
+		return TOKEN_INCOMPLETE;
+	*token_end = p;
+
+	return TOKEN_LITERAL;
+}
+
+// returns the end of the word that starts at p, NULL if it goes on in the
+// next block. a '.' at the end of a word ends the statement.
+static char* scan_word(char* p, char* end, char eof) {
+	for (; p < end; ++p) {
+		if (*p == '\\') {
+			// an escaped character in a local name
+			if (++p == end)
+				break;
+		}
+		else if (*p == '.') {
+			if (p + 1 == end)
+				return eof ? p : NULL;
+			if (is_delimiter(p[1]) || p[1] == '.')
+				return p;
+		}
+		else if (is_delimiter(*p))
+			return p;
+	}
+
+	return eof ? end : NULL;
+}
+
+static inline char word_equals(char* word, size_t length, const char* keyword) {
+	return length == strlen(keyword) && memcmp(word, keyword, length) == 0;
+}
+
+static inline char word_equals_ignore_case(char* word, size_t length, const char* keyword) {
+	return length == strlen(keyword) && strncasecmp(word, keyword, length) == 0;
+}
+
+// scan the token that starts at p, which is not a blank. returns its type
+// and sets token_end to the character after it.
+static int scan_token(char* p, char* end, char eof, char** token_end) {
+	char* q;
+	size_t length;
+
+	switch (*p) {
+	case '<':
+		q = memchr(p + 1, '>', end - p - 1);
+		if (q == NULL) {
+			*token_end = end;
+			return eof ? TOKEN_ERROR : TOKEN_INCOMPLETE;
+		}
+		*token_end = q + 1;
+		return TOKEN_IRI;
+	case '"':
+	case '\'':
+		return scan_string(p, end, eof, token_end);
+	case '.':
+	case ';':
+	case ',':
+	case '[':
+	case ']':
+	case '(':
+	case ')':
+		*token_end = p + 1;
+		return *p;
+	case '^':
+		if (p + 1 == end && !eof)
+			return TOKEN_INCOMPLETE;
+		if (p + 1 < end && p[1] == '^') {
+			*token_end = p + 2;
+			return TOKEN_DATATYPE;
+		}
+		*token_end = p + 1;
+		return TOKEN_ERROR;
+	default:
+		break;
+	}
+
+	// @prefix and @base, the language tags are scanned with the strings
+	q = scan_word(*p == '@' ? p + 1 : p, end, eof);
+	if (q == NULL)
+		return TOKEN_INCOMPLETE;
+	*token_end = q;
+	length = q - p;
+	if (length == 0) {
+		*token_end = p + 1;
+		return TOKEN_ERROR;
+	}
+	if (*p == '@') {
+		if (word_equals(p, length, "@prefix"))
+			return TOKEN_PREFIX;
+		if (word_equals(p, length, "@base"))
+			return TOKEN_BASE;
+		return TOKEN_ERROR;
+	}
+	if (memchr(p, ':', length) != NULL)
+		return (p[0] == '_' && p[1] == ':') ? TOKEN_BLANK_NODE : TOKEN_PREFIXED_NAME;
+	if (word_equals(p, length, "a"))
+		return TOKEN_A;
+	if (word_equals(p, length, "true") || word_equals(p, length, "false"))
+		return TOKEN_LITERAL;
+	if (word_equals_ignore_case(p, length, "PREFIX"))
+		return TOKEN_PREFIX;
+	if (word_equals_ignore_case(p, length, "BASE"))
+		return TOKEN_BASE;
+	// a number
+	if (isdigit((unsigned char) *p) || *p == '+' || *p == '-' || *p == '.')
+		return TOKEN_LITERAL;
+
+	return TOKEN_ERROR;
+}
+
+static int next_token(TripleReader* r) {
+	char* p;
+	char* token_end = NULL;
+	int type;
+
+	if (r->pushed_back) {
+		r->pushed_back = 0;
+		return r->type;
+	}
+
+	for (;;) {
+		p = r->position = skip_blanks(r->position, r->end, r->eof);
+		if (p == r->end) {
+			if (r->eof) {
+				type = TOKEN_END;
+				token_end = p;
+				break;
+			}
+		}
+		else if (*p != '#') {
+			type = scan_token(p, r->end, r->eof, &token_end);
+			if (type != TOKEN_INCOMPLETE)
+				break;
+		}
+		// the blanks or the token go on in the next block
+		fill(r);
+	}
+
+	r->type = type;
+	r->text = r->position;
+	r->length = token_end - r->position;
+	r->position = token_end;
+
+	return type;
+}
+
+// the last token is returned once more by next_token
+static inline void push_back(TripleReader* r) {
+	r->pushed_back = 1;
+}
+
+static int syntax_error(TripleReader* r, char* message) {
+	uint64_t line = r->line + 1;
+	char* p;
+
+	for (p = r->buffer; (p = memchr(p, '\n', r->text - p)) != NULL; ++p)
+		++line;
+	fprintf(stderr, "\nline %llu near %.*s: %s\n", (unsigned long long) line, (int) (r->length < 80 ? r->length : 80), r->text, message);
+
+	return -1;
+}
+
+/******************************************************************************
+ * the IRIs
+ *****************************************************************************/
+// returns 1 if the IRI of the given length starts with a scheme
+static char has_scheme(char* iri, size_t length) {
+	size_t i;
+
+	for (i = 0; i < length; ++i) {
+		if (iri[i] == ':')
+			return i > 0;
+		if (!isalnum((unsigned char) iri[i]) && iri[i] != '+' && iri[i] != '-' && iri[i] != '.')
+			return 0;
+	}
+
+	return 0;
+}
+
+// append the relative IRI of the given length, resolved against the given
+// base, to the given text. the dot segments are not removed.
+static void append_resolved(Text* iri, char* base, char* relative, size_t length) {
+	size_t scheme = strcspn(base, ":");
+	size_t path, end;
+
+	// parse_base only keeps bases with a scheme, it is not relied on here
+	if (base[scheme] == ':')
+		++scheme;
+	path = scheme;
+
+	// the authority
+	if (base[scheme] == '/' && base[scheme + 1] == '/')
+		path = scheme + 2 + strcspn(base + scheme + 2, "/?#");
+
+	if (length > 0 && relative[0] == '#')
+		end = strcspn(base, "#");
+	else if (length > 0 && relative[0] == '?')
+		end = strcspn(base, "?#");
+	else if (length > 1 && relative[0] == '/' && relative[1] == '/')
+		end = scheme;
+	else if (length > 0 && relative[0] == '/')
+		end = path;
+	else {
+		// the directory of the base
+		for (end = strcspn(base, "?#"); end > path && base[end - 1] != '/'; --end)
+			;
+		if (end == path && path > scheme) {
+			// an empty path
+			text_append(iri, base, end);
+			text_append(iri, "/", 1);
+			text_append(iri, relative, length);
+			return;
+		}
+	}
+	text_append(iri, base, end);
+	text_append(iri, relative, length);
+}
+
+// store the IRI of the last token, an IRI or a prefixed name, in r->iri.
+// returns 0 if the prefix has not been declared.
+static char expand_iri(TripleReader* r) {
+	char* colon;
+	char* p;
+	char* prefix = NULL;
+	size_t name_length;
+	int i;
+
+	r->iri.length = 0;
+	text_append(&(r->iri), "<", 1);
+	if (r->type == TOKEN_IRI) {
+		if (r->base != NULL && !has_scheme(r->text + 1, r->length - 2))
+			append_resolved(&(r->iri), r->base, r->text + 1, r->length - 2);
+		else
+			text_append(&(r->iri), r->text + 1, r->length - 2);
+		text_append(&(r->iri), ">", 1);
+		return 1;
+	}
+
+	colon = memchr(r->text, ':', r->length);
+	name_length = colon - r->text + 1;
+	for (i = r->prefix_names.size - 1; i >= 0 && prefix == NULL; --i)
+		if (word_equals(r->text, name_length, (char*) r->prefix_names.elements[i]))
+			prefix = (char*) r->prefixes.elements[i];
+	if (prefix == NULL)
+		return 0;
+	text_append(&(r->iri), prefix, strlen(prefix));
+	// the escapes of the local name
+	for (p = colon + 1; p < r->text + r->length; ++p) {
+		if (*p == '\\')
+			++p;
+		text_append(&(r->iri), p, 1);
+	}
+	text_append(&(r->iri), ">", 1);
+
+	return 1;
+}
+
+// returns the entry of r->iri in the string pool. an IRI in the namespace of
+// a prefix is stored under the prefixed name, see datatypes.h.
+static StringPoolEntry* iri_entry(TripleReader* r) {
+	KB* kb = r->kb;
+	StringPoolEntry* entry;
+	StringPoolEntry* name;
+	StringPoolEntry* longest = NULL;
+	char* prefix;
+	size_t prefix_length, longest_length = 0;
+	int i;
+
+	if ((entry = string_pool_get(&(kb->iris), r->iri.text, r->iri.length)) != NULL)
+		return entry;
+
+	for (i = 0; i < kb->prefix_names.size; ++i) {
+		name = STRING_POOL_ENTRY((char*) kb->prefix_names.elements[i]);
+		prefix = (char*) GET_ONTOLOGY_PREFIX(name, kb);
+		// the prefix without the '>'
+		prefix_length = STRING_POOL_ENTRY(prefix)->length - 1;
+		if (prefix_length >= r->iri.length || memcmp(prefix, r->iri.text, prefix_length) != 0)
+			continue;
+		r->prefixed_name.length = 0;
+		text_append(&(r->prefixed_name), name->string, name->length);
+		text_append(&(r->prefixed_name), r->iri.text + prefix_length, r->iri.length - prefix_length - 1);
+		if ((entry = string_pool_get(&(kb->iris), r->prefixed_name.text, r->prefixed_name.length)) != NULL)
+			return entry;
+		if (prefix_length > longest_length) {
+			longest = name;
+			longest_length = prefix_length;
+		}
+	}
+
+	// a new IRI is stored with the longest prefix it has, like the parser does
+	if (longest == NULL)
+		return string_pool_intern(&(kb->iris), r->iri.text, r->iri.length);
+	r->prefixed_name.length = 0;
+	text_append(&(r->prefixed_name), longest->string, longest->length);
+	text_append(&(r->prefixed_name), r->iri.text + longest_length, r->iri.length - longest_length - 1);
+
+	return string_pool_intern(&(kb->iris), r->prefixed_name.text, r->prefixed_name.length);
+}
+
+/******************************************************************************
+ * the statements
+ *****************************************************************************/
+// skip the blank node property list or the collection that has just been
+// opened. returns 0 if it is not closed.
+static char skip_nested(TripleReader* r) {
+	int depth = 1;
+
+	while (depth > 0)
+		switch (next_token(r)) {
+		case '[':
+		case '(':
+			++depth;
+			break;
+		case ']':
+		case ')':
+			--depth;
+			break;
+		case TOKEN_END:
+		case TOKEN_ERROR:
+			return 0;
+		default:
+			break;
+		}
+
+	return 1;
+}
+
+// @prefix name: <IRI> . or PREFIX name: <IRI>
+static int parse_prefix(TripleReader* r) {
+	char at = (r->text[0] == '@');
+	char* name;
+	char* prefix;
+	int i;
+
+	if (next_token(r) != TOKEN_PREFIXED_NAME || r->text[r->length - 1] != ':')
+		return syntax_error(r, "prefix name expected");
+	name = (char*) malloc(r->length + 1);
+	assert(name != NULL);
+	memcpy(name, r->text, r->length);
+	name[r->length] = '\0';
+	if (next_token(r) != TOKEN_IRI) {
+		free(name);
+		return syntax_error(r, "IRI expected");
+	}
+	expand_iri(r);
+	prefix = (char*) malloc(r->iri.length - 1);
+	assert(prefix != NULL);
+	memcpy(prefix, r->iri.text + 1, r->iri.length - 2);
+	prefix[r->iri.length - 2] = '\0';
+
+	// a prefix name can be declared again, the last declaration counts
+	for (i = 0; i < r->prefix_names.size && strcmp(name, (char*) r->prefix_names.elements[i]) != 0; ++i)
+		;
+	if (i < r->prefix_names.size) {
+		free(name);
+		free(r->prefixes.elements[i]);
+		r->prefixes.elements[i] = prefix;
+	}
+	else {
+		list_add(name, &(r->prefix_names));
+		list_add(prefix, &(r->prefixes));
+	}
+
+	if (at && next_token(r) != '.')
+		return syntax_error(r, "'.' expected");
+	return 1;
+}
+
+// @base <IRI> . or BASE <IRI>
+static int parse_base(TripleReader* r) {
+	char at = (r->text[0] == '@');
+
+	if (next_token(r) != TOKEN_IRI)
+		return syntax_error(r, "IRI expected");
+	// a relative base is resolved against the current one
+	if (r->base == NULL && !has_scheme(r->text + 1, r->length - 2))
+		return syntax_error(r, "relative base IRI without a base");
+	expand_iri(r);
+	free(r->base);
+	r->base = (char*) malloc(r->iri.length - 1);
+	assert(r->base != NULL);
+	memcpy(r->base, r->iri.text + 1, r->iri.length - 2);
+	r->base[r->iri.length - 2] = '\0';
+
+	if (at && next_token(r) != '.')
+		return syntax_error(r, "'.' expected");
+	return 1;
+}
+
+static char predicate_kind(Text* iri) {
+	if (equals(iri, RDF_TYPE))
+		return PREDICATE_TYPE;
+	if (starts_with(iri, RDF_NAMESPACE) || starts_with(iri, RDFS_NAMESPACE) || starts_with(iri, OWL_NAMESPACE))
+		return PREDICATE_SKIPPED;
+	return PREDICATE_ROLE;
+}
+
+// the class of an rdf:type triple, NULL for the other classes of the vocabulary
+static ClassExpression* type_class(TripleReader* r) {
+	TBox* tbox = r->kb->tbox;
+
+	if (equals(&(r->iri), OWL_THING_IRI))
+		return tbox->top_concept;
+	if (equals(&(r->iri), OWL_NOTHING_IRI))
+		return tbox->bottom_concept;
+	if (starts_with(&(r->iri), RDF_NAMESPACE) || starts_with(&(r->iri), RDFS_NAMESPACE) || starts_with(&(r->iri), OWL_NAMESPACE))
+		return NULL;
+	return get_create_atomic_concept(iri_entry(r), tbox);
+}
+
+// the object of a triple with the current subject and predicate
+static int parse_object(TripleReader* r) {
+	ABox* abox = r->kb->abox;
+	ClassExpression* type;
+	Individual* object;
+
+	++r->counts->triples;
+	switch (next_token(r)) {
+	case TOKEN_IRI:
+	case TOKEN_PREFIXED_NAME:
+		if (!expand_iri(r))
+			return syntax_error(r, "undeclared prefix");
+		if (r->subject_iri == NULL || r->predicate_kind == PREDICATE_SKIPPED)
+			break;
+		if (r->predicate_kind == PREDICATE_TYPE) {
+			if ((type = type_class(r)) == NULL)
+				break;
+			if (r->subject == NULL)
+				r->subject = get_create_individual(r->subject_iri, abox);
+			add_concept_assertion(create_concept_assertion(r->subject, type, abox), abox);
+			++r->counts->class_assertions;
+			return 1;
+		}
+		object = get_create_individual(iri_entry(r), abox);
+		if (r->subject == NULL)
+			r->subject = get_create_individual(r->subject_iri, abox);
+		if (r->predicate == NULL)
+			r->predicate = get_create_atomic_role(r->predicate_iri, r->kb->tbox);
+		add_role_assertion(create_role_assertion(r->predicate, r->subject, object, abox), abox);
+		++r->counts->object_property_assertions;
+		return 1;
+	case TOKEN_LITERAL:
+		// the datatype of the literal
+		if (next_token(r) == TOKEN_DATATYPE) {
+			next_token(r);
+			if (r->type != TOKEN_IRI && r->type != TOKEN_PREFIXED_NAME)
+				return syntax_error(r, "datatype expected");
+		}
+		else
+			push_back(r);
+		break;
+	case TOKEN_BLANK_NODE:
+		break;
+	case '[':
+	case '(':
+		// the triples in it are not counted
+		if (!skip_nested(r))
+			return syntax_error(r, "']' or ')' expected");
+		break;
+	default:
+		return syntax_error(r, "object expected");
+	}
+
+	++r->counts->skipped;
+	return 1;
+}
+
+// a directive or the triples of a subject. returns 1 if a statement has been
+// read, 0 at the end of the input and -1 if there is a syntax error.
+static int parse_statement(TripleReader* r) {
+	int type;
+
+	r->subject_iri = NULL;
+	r->subject = NULL;
+	switch (next_token(r)) {
+	case TOKEN_END:
+		return 0;
+	case TOKEN_PREFIX:
+		return parse_prefix(r);
+	case TOKEN_BASE:
+		return parse_base(r);
+	case TOKEN_IRI:
+	case TOKEN_PREFIXED_NAME:
+		if (!expand_iri(r))
+			return syntax_error(r, "undeclared prefix");
+		r->subject_iri = iri_entry(r);
+		break;
+	case TOKEN_BLANK_NODE:
+		break;
+	case '[':
+		if (!skip_nested(r))
+			return syntax_error(r, "']' expected");
+		// [ ... ] . is a statement of its own
+		if (next_token(r) == '.')
+			return 1;
+		push_back(r);
+		break;
+	case '(':
+		if (!skip_nested(r))
+			return syntax_error(r, "')' expected");
+		break;
+	default:
+		return syntax_error(r, "subject expected");
+	}
+
+	// the predicates and their objects, separated by ';'
+	for (;;) {
+		r->predicate_iri = NULL;
+		r->predicate = NULL;
+		type = next_token(r);
+		if (type == TOKEN_A)
+			r->predicate_kind = PREDICATE_TYPE;
+		else if (type == TOKEN_IRI || type == TOKEN_PREFIXED_NAME) {
+			if (!expand_iri(r))
+				return syntax_error(r, "undeclared prefix");
+			r->predicate_kind = predicate_kind(&(r->iri));
+			if (r->predicate_kind == PREDICATE_ROLE)
+				r->predicate_iri = iri_entry(r);
+		}
+		else
+			return syntax_error(r, "predicate expected");
+
+		do {
+			if (parse_object(r) < 0)
+				return -1;
+		} while ((type = next_token(r)) == ',');
+
+		if (type == '.')
+			return 1;
+		if (type != ';')
+			return syntax_error(r, "'.' expected");
+		// ';' can be repeated and can end the list
+		while ((type = next_token(r)) == ';')
+			;
+		if (type == '.')
+			return 1;
+		push_back(r);
+	}
+}
+
+int parse_triples(FILE* input, KB* kb, TripleCounts* counts) {
+	TripleReader reader;
+	int result, i;
+
+	memset(counts, 0, sizeof(TripleCounts));
+	memset(&reader, 0, sizeof(TripleReader));
+	reader.input = input;
+	reader.kb = kb;
+	reader.counts = counts;
+	reader.size = TRIPLES_BUFFER_SIZE;
+	reader.buffer = (char*) malloc(reader.size);
+	assert(reader.buffer != NULL);
+	reader.position = reader.end = reader.buffer;
+	LIST_INIT(&(reader.prefix_names));
+	LIST_INIT(&(reader.prefixes));
+
+	while ((result = parse_statement(&reader)) > 0)
+		;
+
+	for (i = 0; i < reader.prefix_names.size; ++i) {
+		free(reader.prefix_names.elements[i]);
+		free(reader.prefixes.elements[i]);
+	}
+	list_reset(&(reader.prefix_names));
+	list_reset(&(reader.prefixes));
+	free(reader.base);
+	free(reader.iri.text);
+	free(reader.prefixed_name.text);
+	free(reader.buffer);
+
+	return result != 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TURTLE_H_
+#define TURTLE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "../model/datatypes.h"
+
+/**
+ * Loader for ABoxes in N-Triples or Turtle. The triples are added to the
+ * ABox of the KB as they are read, there is no intermediate file:
+ * - rdf:type triples become class assertions,
+ * - the other triples whose object is an IRI become object property
+ *   assertions.
+ * Triples with a literal or a blank node, and the ones whose predicate or
+ * type is in the RDF, RDFS or OWL vocabulary (declarations, labels,
+ * subClassOf etc.) are skipped. owl:Thing and owl:Nothing are the classes
+ * of the KB.
+ *
+ * An IRI that the ontology has written with one of its prefixes is found
+ * under the prefixed name, i.e., the classes, object properties and
+ * individuals of the ontology are the ones of the triples.
+ *
+ * The input is read in blocks of fixed size, only the current block is in
+ * memory. Of Turtle, the directives, the prefixed names, "a" and the
+ * predicate and object lists are supported, the blank node property lists
+ * and the collections are skipped. Relative IRIs are resolved against the
+ * base without removing the dot segments, the escapes in IRIs are not
+ * decoded.
+ */
+
+typedef struct triple_counts TripleCounts;
+
+struct triple_counts {
+	uint64_t triples;
+	uint64_t class_assertions;
+	uint64_t object_property_assertions;
+	uint64_t skipped;
+};
+
+/**
+ * Parse the triples in the given input into the ABox of the given KB, and
+ * count them in the given counts.
+ * Returns 0 on success, nonzero if there is a syntax error.
+ */
+int parse_triples(FILE* input, KB* kb, TripleCounts* counts);
+
+#endif /* TURTLE_H_ */
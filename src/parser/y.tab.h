@@ -92,7 +92,9 @@
      SUB_OBJECT_PROPERTY_OF = 309,
      TRANSITIVE_OBJECT_PROPERTY = 310,
      EQUIVALENT_OBJECT_PROPERTIES = 311,
-     REFLEXIVE_OBJECT_PROPERTY = 312
+     REFLEXIVE_OBJECT_PROPERTY = 312,
+     CHUNK_START = 313,
+     PARSED_CHUNKS = 314
    };
 #endif
 /* Tokens.  */
@@ -151,6 +153,8 @@
 #define TRANSITIVE_OBJECT_PROPERTY 310
 #define EQUIVALENT_OBJECT_PROPERTIES 311
 #define REFLEXIVE_OBJECT_PROPERTY 312
+#define CHUNK_START 313
+#define PARSED_CHUNKS 314
 
 
 
@@ -162,6 +166,5 @@ typedef int YYSTYPE;
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
-extern YYSTYPE yylval;
 
 
@@ -21,7 +21,7 @@
 #include "../model/model.h"
 #include "../model/limits.h"
 #include "../model/print_utils.h"
-#include "../hashing/hash_map.h"
+#include "../utils/map.h"
 #include "utils.h"
 
 // Preprocess axioms that are syntactic shortcuts, like equivalent classes/roles, disjoint classes and
@@ -29,18 +29,16 @@
 void preprocess_tbox(KB* kb) {
 	TBox* tbox = kb->tbox;
 
-	// Initialize the hash of existential restrictions that are generated as a result of
-	// translating role assertions.
-	// TODO: think about the size. maybe take the number of target individuals?
-	kb->generated_exists_restrictions = hash_map_create(DEFAULT_EXISTS_RESTRICTIONS_HASH_SIZE);
+	// The hash of existential restrictions that are generated as a result of translating
+	// role assertions is created in init_kb, sized for the number of role assertions.
 
 	// Convert equivalent classes axioms to subclass axioms
 	SetIterator set_iterator;
 	SET_ITERATOR_INIT(&set_iterator, &(tbox->equivalent_classes_axioms));
 	void* ax = SET_ITERATOR_NEXT(&set_iterator);
 	while (ax) {
-		add_generated_subclass_axiom(kb, create_subclass_axiom(((EquivalentClassesAxiom*) ax)->lhs, ((EquivalentClassesAxiom*) ax)->rhs));
-		add_generated_subclass_axiom(kb, create_subclass_axiom(((EquivalentClassesAxiom*) ax)->rhs, ((EquivalentClassesAxiom*) ax)->lhs));
+		add_generated_subclass_axiom(kb, create_subclass_axiom(((EquivalentClassesAxiom*) ax)->lhs, ((EquivalentClassesAxiom*) ax)->rhs, tbox));
+		add_generated_subclass_axiom(kb, create_subclass_axiom(((EquivalentClassesAxiom*) ax)->rhs, ((EquivalentClassesAxiom*) ax)->lhs, tbox));
 		ax = SET_ITERATOR_NEXT(&set_iterator);
 	}
 
@@ -48,8 +46,8 @@ void preprocess_tbox(KB* kb) {
 	SET_ITERATOR_INIT(&set_iterator, &(tbox->equivalent_objectproperties_axioms));
 	ax = SET_ITERATOR_NEXT(&set_iterator);
 	while (ax) {
-		add_generated_subrole_axiom(kb, create_subrole_axiom(((EquivalentObjectPropertiesAxiom*) ax)->lhs, ((EquivalentObjectPropertiesAxiom*) ax)->rhs));
-		add_generated_subrole_axiom(kb, create_subrole_axiom(((EquivalentObjectPropertiesAxiom*) ax)->rhs, ((EquivalentObjectPropertiesAxiom*) ax)->lhs));
+		add_generated_subrole_axiom(kb, create_subrole_axiom(((EquivalentObjectPropertiesAxiom*) ax)->lhs, ((EquivalentObjectPropertiesAxiom*) ax)->rhs, tbox));
+		add_generated_subrole_axiom(kb, create_subrole_axiom(((EquivalentObjectPropertiesAxiom*) ax)->rhs, ((EquivalentObjectPropertiesAxiom*) ax)->lhs, tbox));
 		ax = SET_ITERATOR_NEXT(&set_iterator);
 	}
 
@@ -59,7 +57,7 @@ void preprocess_tbox(KB* kb) {
 	ax = SET_ITERATOR_NEXT(&set_iterator);
 	while (ax) {
 		composition = get_create_role_composition_binary(((TransitiveObjectPropertyAxiom*) ax)->r, ((TransitiveObjectPropertyAxiom*) ax)->r, tbox);
-		add_generated_subrole_axiom(kb, create_subrole_axiom(composition, ((TransitiveObjectPropertyAxiom*) ax)->r));
+		add_generated_subrole_axiom(kb, create_subrole_axiom(composition, ((TransitiveObjectPropertyAxiom*) ax)->r, tbox));
 		ax = SET_ITERATOR_NEXT(&set_iterator);
 	}
 
@@ -81,7 +79,7 @@ void preprocess_tbox(KB* kb) {
 				conjunction = get_create_conjunction_binary(
 						(ClassExpression*) ((DisjointClassesAxiom*) ax)->classes.elements[i],
 						(ClassExpression*) ((DisjointClassesAxiom*) ax)->classes.elements[j], tbox);
-				add_generated_subclass_axiom(kb, create_subclass_axiom(conjunction, tbox->bottom_concept));
+				add_generated_subclass_axiom(kb, create_subclass_axiom(conjunction, tbox->bottom_concept, tbox));
 			}
 		ax = SET_ITERATOR_NEXT(&set_iterator);
 	}
@@ -91,7 +89,7 @@ void preprocess_tbox(KB* kb) {
 	ax = SET_ITERATOR_NEXT(&set_iterator);
 	while (ax) {
 		ClassExpression* lhs = get_create_exists_restriction(((ObjectPropertyDomainAxiom*) ax)->object_property_expression, tbox->top_concept, tbox);
-		add_generated_subclass_axiom(kb, create_subclass_axiom(lhs, ((ObjectPropertyDomainAxiom*) ax)->class_expression));
+		add_generated_subclass_axiom(kb, create_subclass_axiom(lhs, ((ObjectPropertyDomainAxiom*) ax)->class_expression, tbox));
 		ax = SET_ITERATOR_NEXT(&set_iterator);
 	}
 
@@ -103,10 +101,10 @@ void preprocess_tbox(KB* kb) {
 		for (i = 0; i < same_individual_ax->individuals.size - 1; ++i) {
 			add_generated_subclass_axiom(kb, create_subclass_axiom(
 					get_create_generated_nominal(kb, same_individual_ax->individuals.elements[i]),
-					get_create_generated_nominal(kb, same_individual_ax->individuals.elements[i+1])));
+					get_create_generated_nominal(kb, same_individual_ax->individuals.elements[i+1]), tbox));
 			add_generated_subclass_axiom(kb, create_subclass_axiom(
 					get_create_generated_nominal(kb, same_individual_ax->individuals.elements[i+1]),
-					get_create_generated_nominal(kb, same_individual_ax->individuals.elements[i])));
+					get_create_generated_nominal(kb, same_individual_ax->individuals.elements[i]), tbox));
 		}
 		same_individual_ax = SET_ITERATOR_NEXT(&set_iterator);
 	}
@@ -122,7 +120,7 @@ void preprocess_tbox(KB* kb) {
 				conjunction = get_create_conjunction_binary(
 						get_create_generated_nominal(kb, different_individuals_ax->individuals.elements[i]),
 						get_create_generated_nominal(kb, different_individuals_ax->individuals.elements[j]), tbox);
-				add_generated_subclass_axiom(kb, create_subclass_axiom(conjunction, tbox->bottom_concept));
+				add_generated_subclass_axiom(kb, create_subclass_axiom(conjunction, tbox->bottom_concept, tbox));
 				printf("%s\n", class_expression_to_string(kb, conjunction));
 			}
 		printf("--------------------\n");
@@ -142,7 +140,7 @@ void preprocess_abox(KB* kb) {
 		add_generated_subclass_axiom(
 				kb,
 				create_subclass_axiom(
-						get_create_generated_nominal(kb, abox->concept_assertions[i]->individual), abox->concept_assertions[i]->concept));
+						get_create_generated_nominal(kb, abox->concept_assertions[i]->individual), abox->concept_assertions[i]->concept, kb->tbox));
 
 	// Translate the role assertions to subclass axioms.
 	// Individuals translated to generated nominals.
@@ -153,7 +151,8 @@ void preprocess_abox(KB* kb) {
 						get_create_generated_nominal(kb, abox->role_assertions[i]->source_individual),
 						get_create_generated_exists_restriction(kb, abox->role_assertions[i]->role,
 								get_create_generated_nominal(kb, abox->role_assertions[i]->target_individual)
-						)
+						),
+						kb->tbox
 				)
 		);
 }
@@ -24,6 +24,7 @@
 
 #include "../model/datatypes.h"
 #include "../model/limits.h"
+#include "../model/model.h"
 #include "../hashing/utils.h"
 
 /*
@@ -79,18 +80,17 @@ ClassExpression* get_create_generated_nominal(KB* kb, Individual* ind) {
 		return c;
 
 	// if a nominal with the individual does not already exist, create it
-	c = (ClassExpression*) malloc(sizeof(ClassExpression));
-	assert(c != NULL);
+	c = (ClassExpression*) arena_allocate(kb->tbox->expressions, sizeof(ClassExpression));
 
 	c->description.nominal.individual = ind;
 
 	c->type = OBJECT_ONE_OF_TYPE;
 	// c->id = ind->id;
-	c->id = kb->tbox->next_class_expression_id++;
+	assign_class_expression_id(c, kb->tbox);
 
 	LIST_INIT(&(c->told_subsumers));
 
-	SET_INIT(&(c->subsumers), DEFAULT_SUBSUMERS_HASH_SIZE);
+	ID_SET_INIT(&(c->subsumers), DEFAULT_SUBSUMERS_HASH_SIZE);
 
 	c->filler_of_negative_exists = NULL;
 
@@ -102,10 +102,7 @@ ClassExpression* get_create_generated_nominal(KB* kb, Individual* ind) {
 	c->successor_r_count = 0;
 
 	LIST_INIT(&(c->first_conjunct_of_list));
-	c->first_conjunct_of = NULL;
-
 	LIST_INIT(&(c->second_conjunct_of_list));
-	c->second_conjunct_of = NULL;
 
 	MAP_PUT(ind->id, c, &(kb->generated_nominals));
 
@@ -119,23 +116,22 @@ ClassExpression* get_create_generated_exists_restriction(KB* kb, ObjectPropertyE
 
 	// first check if we already created an existential
 	// restriction with the same role and filler
-	if ((c = hash_map_get(kb->generated_exists_restrictions, HASH_INTEGERS(r->id, f->id))) != NULL)
+	if ((c = MAP_GET(HASH_INTEGERS(r->id, f->id), kb->generated_exists_restrictions)) != NULL)
 		return c;
 
 	// if it does not already exist, create it
-	c = (ClassExpression*) malloc(sizeof(ClassExpression));
-	assert(c != NULL);
+	c = (ClassExpression*) arena_allocate(kb->tbox->expressions, sizeof(ClassExpression));
 
 	c->type = OBJECT_SOME_VALUES_FROM_TYPE;
 
 	c->description.exists.role = r;
 	c->description.exists.filler = f;
 	// c->id = (kb->generated_exists_restriction_count)++;
-	c->id = kb->tbox->next_class_expression_id++;
+	assign_class_expression_id(c, kb->tbox);
 
 	LIST_INIT(&(c->told_subsumers));
 
-	SET_INIT(&(c->subsumers), DEFAULT_SUBSUMERS_HASH_SIZE);
+	ID_SET_INIT(&(c->subsumers), DEFAULT_SUBSUMERS_HASH_SIZE);
 
 	c->filler_of_negative_exists = NULL;
 
@@ -147,14 +143,11 @@ ClassExpression* get_create_generated_exists_restriction(KB* kb, ObjectPropertyE
 	c->successor_r_count = 0;
 
 	LIST_INIT(&(c->first_conjunct_of_list));
-	c->first_conjunct_of = NULL;
-
 	LIST_INIT(&(c->second_conjunct_of_list));
-	c->second_conjunct_of = NULL;
 
 	++kb->generated_exists_restriction_count;
 
-	hash_map_put(kb->generated_exists_restrictions, HASH_INTEGERS(r->id, f->id), c);
+	MAP_PUT(HASH_INTEGERS(r->id, f->id), c, kb->generated_exists_restrictions);
 
 	return c;
 }
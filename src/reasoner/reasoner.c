@@ -19,6 +19,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
 #include <assert.h>
 #include <unistd.h>
 #include <sys/time.h>
@@ -27,21 +29,182 @@
 #include "../model/limits.h"
 #include "../model/model.h"
 #include "../model/print_utils.h"
+#include "../model/memory_utils.h"
+#include "../model/memory_stats.h"
+#include "../model/snapshot.h"
 #include "../preprocessing/preprocessing.h"
 #include "../index/index.h"
 #include "../saturation/saturation.h"
+#include "../saturation/checkpoint.h"
 #include "../hierarchy/hierarchy.h"
 #include "../utils/timer.h"
 #include "../utils/map.h"
+#include "../hashing/utils.h"
+#include "../parser/parser.h"
+#include "../parser/turtle.h"
 #include "reasoner.h"
 
-// the parser
-extern int yyparse(KB* kb);
-// file pointer for the parser
-extern FILE* yyin;
+// Initial sizes of the tables and the arena blocks of a KB. They are taken from
+// limits.h, or estimated from the counts of a pre-scan of the input.
+typedef struct {
+	uint32_t iris;
+	size_t iris_block;
+	uint32_t classes;
+	uint32_t object_properties;
+	uint32_t individuals;
+	uint32_t exists_restrictions;
+	uint32_t conjunctions;
+	uint32_t nominals;
+	uint32_t role_compositions;
+	uint32_t generated_exists_restrictions;
+
+	uint32_t class_expressions;
+	uint32_t objectproperty_expressions;
+
+	uint32_t subclass_of_axioms;
+	uint32_t equivalent_classes_axioms;
+	uint32_t disjoint_classes_axioms;
+	uint32_t subobjectproperty_of_axioms;
+	uint32_t equivalent_objectproperties_axioms;
+	uint32_t transitive_objectproperty_axioms;
+	uint32_t objectproperty_domain_axioms;
+	uint32_t same_individual_axioms;
+	uint32_t different_individuals_axioms;
+
+	size_t expressions_arena_block;
+	size_t axioms_arena_block;
+} KBSizes;
+
+static void default_kb_sizes(KBSizes* sizes) {
+	sizes->iris = DEFAULT_IRIS_POOL_SIZE;
+	sizes->iris_block = STRING_POOL_BLOCK_SIZE;
+	sizes->classes = DEFAULT_ATOMIC_CONCEPTS_HASH_SIZE;
+	sizes->object_properties = DEFAULT_ATOMIC_ROLES_HASH_SIZE;
+	sizes->individuals = DEFAULT_INDIVIDUALS_HASH_SIZE;
+	sizes->exists_restrictions = DEFAULT_EXISTS_RESTRICTIONS_HASH_SIZE;
+	sizes->conjunctions = DEFAULT_CONJUNCTIONS_HASH_SIZE;
+	sizes->nominals = DEFAULT_NOMINALS_HASH_SIZE;
+	sizes->role_compositions = DEFAULT_ROLE_COMPOSITIONS_HASH_SIZE;
+	sizes->generated_exists_restrictions = DEFAULT_EXISTS_RESTRICTIONS_HASH_SIZE;
+
+	sizes->class_expressions = DEFAULT_CLASS_EXPRESSIONS_TABLE_SIZE;
+	sizes->objectproperty_expressions = DEFAULT_OBJECTPROPERTY_EXPRESSIONS_TABLE_SIZE;
+
+	sizes->subclass_of_axioms = DEFAULT_SUBCLASS_OF_AXIOMS_SET_SIZE;
+	sizes->equivalent_classes_axioms = DEFAULT_EQUIVALENT_CLASSES_AXIOMS_SET_SIZE;
+	sizes->disjoint_classes_axioms = DEFAULT_DISJOINT_CLASSES_AXIOMS_SET_SIZE;
+	sizes->subobjectproperty_of_axioms = DEFAULT_SUBOBJECTPROPERTY_OF_AXIOMS_SET_SIZE;
+	sizes->equivalent_objectproperties_axioms = DEFAULT_EQUIVALENT_OBJECTPROPERTIES_AXIOMS_SET_SIZE;
+	sizes->transitive_objectproperty_axioms = DEFAULT_TRANSITIVE_OBJECTPROPERTY_AXIOMS_SET_SIZE;
+	sizes->objectproperty_domain_axioms = DEFAULT_OBJECTPROPERTY_DOMAIN_AXIOMS_SET_SIZE;
+	sizes->same_individual_axioms = DEFAULT_SAME_INDIVIDUAL_AXIOMS_SET_SIZE;
+	sizes->different_individuals_axioms = DEFAULT_DIFFERENT_INDIVIDUALS_AXIOMS_SET_SIZE;
+
+	sizes->expressions_arena_block = EXPRESSIONS_ARENA_BLOCK_SIZE;
+	sizes->axioms_arena_block = AXIOMS_ARENA_BLOCK_SIZE;
+}
+
+// the sets and the maps start with at least this size
+#define MIN_PRESIZE				16
+#define PRESIZE(count)			((count) < MIN_PRESIZE ? MIN_PRESIZE : (count))
+// the arena blocks
+#define MIN_ARENA_BLOCK_SIZE	(1 << 16)
+#define ARENA_PRESIZE(bytes)	((bytes) < MIN_ARENA_BLOCK_SIZE ? MIN_ARENA_BLOCK_SIZE : (bytes))
+// the first block of the IRIs
+#define IRI_BYTES				64
+#define MIN_IRIS_BLOCK_SIZE		(1 << 12)
+#define IRIS_PRESIZE(bytes)		((bytes) < MIN_IRIS_BLOCK_SIZE ? MIN_IRIS_BLOCK_SIZE : (bytes))
+
+static void estimate_kb_sizes(OntologyCounts* counts, KBSizes* sizes) {
+	uint32_t axioms = counts->subclass_of_axioms + counts->equivalent_classes_axioms + counts->disjoint_classes_axioms
+			+ counts->subobject_property_of_axioms + counts->equivalent_object_properties_axioms
+			+ counts->transitive_object_property_axioms + counts->object_property_domain_axioms
+			+ counts->same_individual_axioms + counts->different_individuals_axioms;
+	uint32_t assertions = counts->class_assertions + counts->object_property_assertions;
+
+	// without declarations, assume a new class in every axiom
+	uint32_t classes = (counts->classes > 0 ? counts->classes : axioms) + 2;
+	uint32_t object_properties = counts->object_properties > 0 ? counts->object_properties : DEFAULT_ATOMIC_ROLES_HASH_SIZE;
+	uint32_t individuals = counts->individuals > 0 ? counts->individuals : counts->class_assertions + 2 * counts->object_property_assertions;
+
+	sizes->classes = PRESIZE(classes);
+	sizes->object_properties = PRESIZE(object_properties);
+	sizes->individuals = PRESIZE(individuals);
+	// the expressions are counted per occurrence, this is an upper bound.
+	// the n-ary conjunctions become binary ones, assume 3 conjuncts on average,
+	// i.e., 2 binary conjunctions per conjunction.
+	sizes->exists_restrictions = PRESIZE(counts->object_some_values_from);
+	sizes->conjunctions = PRESIZE(2 * counts->object_intersection_of);
+	sizes->role_compositions = PRESIZE(counts->object_property_chains + counts->transitive_object_property_axioms);
+	// preprocessing generates a nominal for every individual in an assertion,
+	// and an existential restriction for every role assertion
+	sizes->nominals = PRESIZE(counts->object_one_of + individuals);
+	sizes->generated_exists_restrictions = PRESIZE(counts->object_property_assertions);
+	// the index of the string pool grows at load factor 0.75. the strings
+	// are assumed to take 64 bytes on average, as in estimate_kb_memory.
+	// string_pool_init caps the block at STRING_POOL_BLOCK_SIZE.
+	sizes->iris = PRESIZE((classes + object_properties + individuals + 2 * counts->prefixes) / 3 * 4 + 1);
+	sizes->iris_block = IRIS_PRESIZE((size_t) (classes + object_properties + individuals + 2 * counts->prefixes) * IRI_BYTES);
+
+	sizes->class_expressions = PRESIZE(classes + counts->object_some_values_from + 2 * counts->object_intersection_of
+			+ sizes->nominals + counts->object_property_assertions);
+	sizes->objectproperty_expressions = PRESIZE(object_properties + counts->object_property_chains + counts->transitive_object_property_axioms);
+
+	sizes->subclass_of_axioms = PRESIZE(counts->subclass_of_axioms);
+	sizes->equivalent_classes_axioms = PRESIZE(counts->equivalent_classes_axioms);
+	sizes->disjoint_classes_axioms = PRESIZE(counts->disjoint_classes_axioms);
+	sizes->subobjectproperty_of_axioms = PRESIZE(counts->subobject_property_of_axioms);
+	sizes->equivalent_objectproperties_axioms = PRESIZE(counts->equivalent_object_properties_axioms);
+	sizes->transitive_objectproperty_axioms = PRESIZE(counts->transitive_object_property_axioms);
+	sizes->objectproperty_domain_axioms = PRESIZE(counts->object_property_domain_axioms);
+	sizes->same_individual_axioms = PRESIZE(counts->same_individual_axioms);
+	sizes->different_individuals_axioms = PRESIZE(counts->different_individuals_axioms);
+
+	// the class hierarchy is allocated in the expressions arena as well. every
+	// assertion is translated to a subclass axiom in preprocessing.
+	sizes->expressions_arena_block = ARENA_PRESIZE(sizes->class_expressions * sizeof(ClassExpression)
+			+ sizes->objectproperty_expressions * sizeof(ObjectPropertyExpression)
+			+ individuals * sizeof(Individual) + classes * sizeof(ClassHierarchy));
+	sizes->axioms_arena_block = ARENA_PRESIZE((size_t) (axioms + assertions) * sizeof(SubClassOfAxiom)
+			+ counts->class_assertions * sizeof(ClassAssertion)
+			+ counts->object_property_assertions * sizeof(ObjectPropertyAssertion));
+}
+
+// bytes taken by a map of the given size with the given number of elements
+static size_t estimate_map_memory(uint32_t size, uint32_t elements) {
+#if MAP_BACKEND == MAP_BACKEND_FLAT
+	return roundup_pow2(size) * sizeof(uint32_t) + elements * 2 * sizeof(void*);
+#else
+	return roundup_pow2(size) * (sizeof(void*) + sizeof(unsigned int)) + elements * (sizeof(HashMapElement) + sizeof(void*));
+#endif
+}
 
+// estimate of the memory the loaded KB takes, see print_memory_stats for the real one.
+// the IRIs are assumed to take 64 bytes on average. the memory of the saturation
+// is not included, it depends on the inferences.
+static size_t estimate_kb_memory(KBSizes* sizes) {
+	size_t bytes = sizes->expressions_arena_block + sizes->axioms_arena_block;
+
+	bytes += (size_t) sizes->iris * (IRI_BYTES + 2 * sizeof(uint32_t));
+	bytes += (size_t) sizes->class_expressions * sizeof(ClassExpression*);
+	bytes += (size_t) sizes->objectproperty_expressions * sizeof(ObjectPropertyExpression*);
+	bytes += estimate_map_memory(sizes->classes, sizes->classes);
+	bytes += estimate_map_memory(sizes->object_properties, sizes->object_properties);
+	bytes += estimate_map_memory(sizes->individuals, sizes->individuals);
+	bytes += estimate_map_memory(sizes->exists_restrictions, sizes->exists_restrictions);
+	bytes += estimate_map_memory(sizes->conjunctions, sizes->conjunctions);
+	bytes += estimate_map_memory(sizes->nominals, sizes->nominals);
+	bytes += estimate_map_memory(sizes->role_compositions, sizes->role_compositions);
+	bytes += estimate_map_memory(sizes->generated_exists_restrictions, sizes->generated_exists_restrictions);
+	// the axiom sets keep the load factor below 0.75
+	bytes += (size_t) (sizes->subclass_of_axioms + sizes->equivalent_classes_axioms + sizes->disjoint_classes_axioms
+			+ sizes->subobjectproperty_of_axioms + sizes->equivalent_objectproperties_axioms + sizes->transitive_objectproperty_axioms
+			+ sizes->objectproperty_domain_axioms + sizes->same_individual_axioms + sizes->different_individuals_axioms) * 2 * sizeof(void*);
+
+	return bytes;
+}
 
-TBox* init_tbox() {
+static TBox* init_tbox(StringPool* iris, Arena* expressions, Arena* axioms, KBSizes* sizes) {
 
 	TBox* tbox = (TBox*) malloc(sizeof(TBox));
 	assert(tbox != NULL);
@@ -49,49 +212,64 @@ TBox* init_tbox() {
 	tbox->next_class_expression_id = 0;
 	tbox->next_objectproperty_expression_id = 0;
 
-	MAP_INIT(&(tbox->classes), DEFAULT_ATOMIC_CONCEPTS_HASH_SIZE);
+	tbox->iris = iris;
+	tbox->expressions = expressions;
+	tbox->axioms = axioms;
+
+	// the id tables double when they are full
+	tbox->class_expressions_size = sizes->class_expressions;
+	tbox->class_expressions = (ClassExpression**) malloc(tbox->class_expressions_size * sizeof(ClassExpression*));
+	assert(tbox->class_expressions != NULL);
+	tbox->objectproperty_expressions_size = sizes->objectproperty_expressions;
+	tbox->objectproperty_expressions = (ObjectPropertyExpression**) malloc(tbox->objectproperty_expressions_size * sizeof(ObjectPropertyExpression*));
+	assert(tbox->objectproperty_expressions != NULL);
+
+	MAP_INIT(&(tbox->classes), sizes->classes);
 
-	MAP_INIT(&(tbox->objectproperties), DEFAULT_ATOMIC_ROLES_HASH_SIZE);
+	MAP_INIT(&(tbox->objectproperties), sizes->object_properties);
 
 	tbox->object_some_values_from_exps_count = 0;
-	MAP_INIT(&(tbox->object_some_values_from_exps), DEFAULT_EXISTS_RESTRICTIONS_HASH_SIZE);
+	MAP_INIT(&(tbox->object_some_values_from_exps), sizes->exists_restrictions);
 
-	MAP_INIT(&(tbox->object_one_of_exps), DEFAULT_NOMINALS_HASH_SIZE);
+	MAP_INIT(&(tbox->object_one_of_exps), sizes->nominals);
 
 	tbox->object_intersection_of_exps_count = 0;
 	// tbox->unique_conjunction_count = 0;
 	tbox->binary_object_intersection_of_exps_count = 0;
-	MAP_INIT(&(tbox->object_intersection_of_exps), DEFAULT_CONJUNCTIONS_HASH_SIZE);
+	MAP_INIT(&(tbox->object_intersection_of_exps), sizes->conjunctions);
 
 	tbox->role_composition_count = 0;
 	tbox->binary_role_composition_count = 0;
-	MAP_INIT(&(tbox->objectproperty_chains), DEFAULT_ROLE_COMPOSITIONS_HASH_SIZE);
-
-	SET_INIT(&(tbox->subclass_of_axioms), DEFAULT_SUBCLASS_OF_AXIOMS_SET_SIZE);
-	SET_INIT(&(tbox->equivalent_classes_axioms), DEFAULT_EQUIVALENT_CLASSES_AXIOMS_SET_SIZE);
-	SET_INIT(&(tbox->disjoint_classes_axioms), DEFAULT_DISJOINT_CLASSES_AXIOMS_SET_SIZE);
-	SET_INIT(&(tbox->subobjectproperty_of_axioms), DEFAULT_SUBOBJECTPROPERTY_OF_AXIOMS_SET_SIZE);
-	SET_INIT(&(tbox->equivalent_objectproperties_axioms), DEFAULT_EQUIVALENT_OBJECTPROPERTIES_AXIOMS_SET_SIZE);
-	SET_INIT(&(tbox->transitive_objectproperty_axioms), DEFAULT_TRANSITIVE_OBJECTPROPERTY_AXIOMS_SET_SIZE);
-	SET_INIT(&(tbox->objectproperty_domain_axioms), DEFAULT_OBJECTPROPERTY_DOMAIN_AXIOMS_SET_SIZE);
-	SET_INIT(&(tbox->same_individual_axioms), DEFAULT_SAME_INDIVIDUAL_AXIOMS_SET_SIZE);
-	SET_INIT(&(tbox->different_individuals_axioms), DEFAULT_DIFFERENT_INDIVIDUALS_AXIOMS_SET_SIZE);
+	MAP_INIT(&(tbox->objectproperty_chains), sizes->role_compositions);
+
+	SET_INIT(&(tbox->subclass_of_axioms), sizes->subclass_of_axioms);
+	SET_INIT(&(tbox->equivalent_classes_axioms), sizes->equivalent_classes_axioms);
+	SET_INIT(&(tbox->disjoint_classes_axioms), sizes->disjoint_classes_axioms);
+	SET_INIT(&(tbox->subobjectproperty_of_axioms), sizes->subobjectproperty_of_axioms);
+	SET_INIT(&(tbox->equivalent_objectproperties_axioms), sizes->equivalent_objectproperties_axioms);
+	SET_INIT(&(tbox->transitive_objectproperty_axioms), sizes->transitive_objectproperty_axioms);
+	SET_INIT(&(tbox->objectproperty_domain_axioms), sizes->objectproperty_domain_axioms);
+	SET_INIT(&(tbox->same_individual_axioms), sizes->same_individual_axioms);
+	SET_INIT(&(tbox->different_individuals_axioms), sizes->different_individuals_axioms);
 
 	// add the top and bottom concepts
-	tbox->top_concept = get_create_atomic_concept(OWL_THING, tbox);
-	tbox->bottom_concept = get_create_atomic_concept(OWL_NOTHING, tbox);
+	tbox->top_concept = get_create_atomic_concept(string_pool_intern(iris, OWL_THING, strlen(OWL_THING)), tbox);
+	tbox->bottom_concept = get_create_atomic_concept(string_pool_intern(iris, OWL_NOTHING, strlen(OWL_NOTHING)), tbox);
 
 	return tbox;
 }
 
-ABox* init_abox() {
+static ABox* init_abox(StringPool* iris, Arena* expressions, Arena* axioms, KBSizes* sizes) {
 
 	ABox* abox = (ABox*) malloc(sizeof(ABox));
 	assert(abox != NULL);
 
 	abox->last_individual_id = 1;
 	abox->individual_count = 0;
-	abox->individuals = hash_map_create(DEFAULT_INDIVIDUALS_HASH_SIZE);
+	abox->iris = iris;
+	abox->expressions = expressions;
+	abox->axioms = axioms;
+	abox->individuals = MAP_CREATE(sizes->individuals);
 	// abox->individual_list = NULL;
 
 	abox->concept_assertion_count = 0;
@@ -103,12 +281,23 @@ ABox* init_abox() {
 	return abox;
 }
 
-KB* init_kb() {
+KB* init_kb(OntologyCounts* counts) {
+	KBSizes sizes;
 	KB* kb = (KB*) malloc(sizeof(KB));
 	assert(kb != NULL);
 
-	kb->tbox = init_tbox();
-	kb->abox = init_abox();
+	if (counts != NULL)
+		estimate_kb_sizes(counts, &sizes);
+	else
+		default_kb_sizes(&sizes);
+
+	// the tbox and the abox intern their IRIs in the string pool of the kb,
+	// and allocate their expressions and axioms in the arenas of the kb
+	string_pool_init(&(kb->iris), sizes.iris, sizes.iris_block);
+	arena_init(&(kb->expressions), sizes.expressions_arena_block);
+	arena_init(&(kb->axioms), sizes.axioms_arena_block);
+	kb->tbox = init_tbox(&(kb->iris), &(kb->expressions), &(kb->axioms), &sizes);
+	kb->abox = init_abox(&(kb->iris), &(kb->expressions), &(kb->axioms), &sizes);
 
 	kb->inconsistent = 0;
 
@@ -117,8 +306,8 @@ KB* init_kb() {
 
 	// init the generated axioms, nominals and exists restrictions
 	kb->generated_exists_restriction_count = 0;
-	kb->generated_exists_restrictions = hash_map_create(DEFAULT_EXISTS_RESTRICTIONS_HASH_SIZE);
-	MAP_INIT(&(kb->generated_nominals), DEFAULT_NOMINALS_HASH_SIZE);
+	kb->generated_exists_restrictions = MAP_CREATE(sizes.generated_exists_restrictions);
+	MAP_INIT(&(kb->generated_nominals), sizes.nominals);
 	kb->generated_subclass_axiom_count = 0;
 	kb->generated_subclass_axioms = NULL;
 	kb->generated_subrole_axiom_count = 0;
@@ -126,23 +315,69 @@ KB* init_kb() {
 
 	kb->top_occurs_on_lhs = 0;
 	kb->bottom_occurs_on_rhs = 0;
+	kb->indexed = NULL;
+	kb->indexed_size = 0;
+	kb->told_axioms_indexed = 0;
+
+	return kb;
+}
+
+KB* create_kb(FILE* input_kb) {
+	struct timeval start_time, stop_time;
+	OntologyCounts counts;
+	KBSizes sizes;
+	char scanned;
+	KB* kb;
+
+	printf("Pre-scanning KB....................: ");
+	fflush(stdout);
+	START_TIMER(start_time);
+	scanned = prescan_ontology(input_kb, &counts);
+	STOP_TIMER(stop_time);
+	if (!scanned) {
+		// not a regular file, take the default sizes
+		printf("skipped\n");
+		return init_kb(NULL);
+	}
+	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
+
+	kb = init_kb(&counts);
+	estimate_kb_sizes(&counts, &sizes);
+	printf("Estimated KB size..................: %.3f MB\n", estimate_kb_memory(&sizes) / 1048576.0);
 
 	return kb;
 }
 
-void read_kb(FILE* input_kb, KB* kb) {
+// The data of a phase is freed as soon as the following phases do not need it,
+// this keeps the peak memory down. With hash statistics everything is kept,
+// the statistics of the saturation sets are printed at the end.
+static void release_saturation_data(KB* kb) {
+#ifndef HASH_STATS
+	free_saturation_data(kb);
+#endif
+}
+
+static void release_subsumers(KB* kb) {
+#ifndef HASH_STATS
+	free_subsumers(kb);
+#endif
+}
+
+void read_kb(FILE* input_kb, Catalog* catalog, int threads, char pipelined, KB* kb) {
 	struct timeval start_time, stop_time;
+	IndexPipeline* pipeline = NULL;
 
 	// parser return code
 	int parser;
 
-	yyin = input_kb;
-
 	printf("Loading KB.........................: ");
 	fflush(stdout);
 	START_TIMER(start_time);
-	// parser = yyparse(tbox, abox);
-	parser = yyparse(kb);
+	if (pipelined)
+		pipeline = index_pipeline_create(kb);
+	parser = parse_ontology(input_kb, catalog, threads, pipeline, kb);
+	if (pipeline != NULL)
+		index_pipeline_free(pipeline);
 	STOP_TIMER(stop_time);
 	// total_time += TIME_DIFF(start_time, stop_time);
 	if (parser != 0) {
@@ -151,6 +386,152 @@ void read_kb(FILE* input_kb, KB* kb) {
 		exit(-1);
 	}
 	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
+	record_memory_usage(kb, PHASE_LOADING);
+}
+
+void read_abox(FILE* input_abox, KB* kb) {
+	struct timeval start_time, stop_time;
+	TripleCounts counts;
+
+	printf("Loading ABox.......................: ");
+	fflush(stdout);
+	START_TIMER(start_time);
+	if (parse_triples(input_abox, kb, &counts) != 0) {
+		fprintf(stderr,"aborting\n");
+		exit(-1);
+	}
+	STOP_TIMER(stop_time);
+	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
+	printf("Triples............................: %llu (%llu class assertions, %llu object property assertions, %llu skipped)\n",
+			(unsigned long long) counts.triples, (unsigned long long) counts.class_assertions,
+			(unsigned long long) counts.object_property_assertions, (unsigned long long) counts.skipped);
+	record_memory_usage(kb, PHASE_LOADING);
+}
+
+KB* load_kb(char* file_name) {
+	struct timeval start_time, stop_time;
+	KBSnapshot* snapshot;
+	OntologyCounts counts;
+	KB* kb;
+
+	printf("Loading KB snapshot................: ");
+	fflush(stdout);
+	START_TIMER(start_time);
+	snapshot = open_kb_snapshot(file_name);
+	if (snapshot == NULL) {
+		fprintf(stderr,"aborting\n");
+		exit(-1);
+	}
+	// the snapshot has the exact counts, the tables are sized for them like
+	// for the counts of a pre-scan. the conjunctions there are n-ary ones.
+	memset(&counts, 0, sizeof(OntologyCounts));
+	counts.bytes = snapshot->size;
+	counts.prefixes = snapshot->header->prefix_count;
+	counts.classes = snapshot->header->classes;
+	counts.object_properties = snapshot->header->object_properties;
+	counts.individuals = snapshot->header->individual_count;
+	counts.object_some_values_from = snapshot->header->object_some_values_from;
+	counts.object_intersection_of = (snapshot->header->object_intersection_of + 1) / 2;
+	counts.object_one_of = snapshot->header->object_one_of;
+	counts.object_property_chains = snapshot->header->object_property_chains;
+	counts.subclass_of_axioms = snapshot->header->subclass_of_axioms;
+	counts.equivalent_classes_axioms = snapshot->header->equivalent_classes_axioms;
+	counts.disjoint_classes_axioms = snapshot->header->disjoint_classes_axioms;
+	counts.subobject_property_of_axioms = snapshot->header->subobjectproperty_of_axioms;
+	counts.equivalent_object_properties_axioms = snapshot->header->equivalent_objectproperties_axioms;
+	counts.transitive_object_property_axioms = snapshot->header->transitive_objectproperty_axioms;
+	counts.object_property_domain_axioms = snapshot->header->objectproperty_domain_axioms;
+	counts.same_individual_axioms = snapshot->header->same_individual_axioms;
+	counts.different_individuals_axioms = snapshot->header->different_individuals_axioms;
+	counts.class_assertions = snapshot->header->class_assertions;
+	counts.object_property_assertions = snapshot->header->object_property_assertions;
+	kb = init_kb(&counts);
+	if (!read_kb_snapshot(snapshot, kb)) {
+		fprintf(stderr, "%s: the snapshot is corrupt\n", file_name);
+		fprintf(stderr,"aborting\n");
+		exit(-1);
+	}
+	close_kb_snapshot(snapshot);
+	STOP_TIMER(stop_time);
+	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
+	record_memory_usage(kb, PHASE_LOADING);
+
+	return kb;
+}
+
+void save_kb(KB* kb, char* file_name) {
+	struct timeval start_time, stop_time;
+
+	printf("Saving KB snapshot.................: ");
+	fflush(stdout);
+	START_TIMER(start_time);
+	if (!write_kb_snapshot(kb, file_name)) {
+		fprintf(stderr, "%s: cannot write the snapshot\n", file_name);
+		fprintf(stderr,"aborting\n");
+		exit(-1);
+	}
+	STOP_TIMER(stop_time);
+	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
+}
+
+// the key of the checkpoint of the KB, computed before indexing. the key of
+// its TBox is stored in tbox_key unless it is NULL.
+static uint64_t compute_checkpoint_key(KB* kb, ReasoningTask reasoning_task, uint64_t* tbox_key, double* total_time) {
+	struct timeval start_time, stop_time;
+	uint64_t key;
+
+	if (tbox_key != NULL)
+		*tbox_key = 0;
+	if (!checkpoints_enabled())
+		return 0;
+	printf("Computing checkpoint key...........: ");
+	fflush(stdout);
+	START_TIMER(start_time);
+	key = checkpoint_key(kb, reasoning_task);
+	if (tbox_key != NULL)
+		*tbox_key = checkpoint_tbox_key(kb);
+	STOP_TIMER(stop_time);
+	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
+	*total_time += TIME_DIFF(start_time, stop_time);
+
+	return key;
+}
+
+// restores the result of the reasoning task from its checkpoint if there is one.
+// returns 1 in this case, 0 otherwise.
+static char restore_checkpoint(KB* kb, ReasoningTask reasoning_task, uint64_t key, double* total_time) {
+	struct timeval start_time, stop_time;
+	char restored;
+
+	if (!checkpoints_enabled())
+		return 0;
+	START_TIMER(start_time);
+	restored = load_checkpoint(kb, reasoning_task, key);
+	STOP_TIMER(stop_time);
+	if (restored) {
+		printf("Loading checkpoint.................: %.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
+		*total_time += TIME_DIFF(start_time, stop_time);
+	}
+
+	return restored;
+}
+
+static void store_checkpoint(KB* kb, ReasoningTask reasoning_task, uint64_t key, char tbox, double* total_time) {
+	struct timeval start_time, stop_time;
+
+	if (!checkpoints_enabled())
+		return;
+	printf(tbox ? "Saving TBox checkpoint.............: " : "Saving checkpoint..................: ");
+	fflush(stdout);
+	START_TIMER(start_time);
+	if (!save_checkpoint(kb, reasoning_task, key)) {
+		// the result is still there, only the next run cannot use it
+		printf("failed: %s\n", strerror(errno));
+		return;
+	}
+	STOP_TIMER(stop_time);
+	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
+	*total_time += TIME_DIFF(start_time, stop_time);
 }
 
 void classify(KB* kb) {
@@ -166,6 +547,11 @@ void classify(KB* kb) {
 	STOP_TIMER(stop_time);
 	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
 	total_time += TIME_DIFF(start_time, stop_time);
+	record_memory_usage(kb, PHASE_PREPROCESSING);
+
+	// the indexing may renumber the class expressions, the key does not depend on it
+	uint64_t tbox_checkpoint;
+	uint64_t checkpoint = compute_checkpoint_key(kb, CLASSIFICATION, &tbox_checkpoint, &total_time);
 
 	printf("Indexing...........................: ");
 	fflush(stdout);
@@ -174,6 +560,7 @@ void classify(KB* kb) {
 	STOP_TIMER(stop_time);
 	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
 	total_time += TIME_DIFF(start_time, stop_time);
+	record_memory_usage(kb, PHASE_INDEXING);
 
 	// return if we during indexing already find out that the ontology is inconsistent
 	if (indexing_result == -1) {
@@ -182,17 +569,26 @@ void classify(KB* kb) {
 		return;
 	}
 
+	if (restore_checkpoint(kb, CLASSIFICATION, checkpoint, &total_time)) {
+		printf("Total time.........................: %.3f milisecs\n", total_time / 1000);
+		return;
+	}
+
 	printf("Saturating.........................: ");
 	fflush(stdout);
 	START_TIMER(start_time);
-	char saturation_result = saturate_tbox(kb, CLASSIFICATION);
+	char saturation_result = saturate_tbox(kb, CLASSIFICATION, 0);
 	STOP_TIMER(stop_time);
 	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
 	total_time += TIME_DIFF(start_time, stop_time);
+	record_memory_usage(kb, PHASE_SATURATION);
+	// the hierarchy only needs the subsumers of the classes
+	release_saturation_data(kb);
 
 	// return if we during saturation find out that the ontology is inconsistent
 	if (saturation_result == -1){
 		kb->inconsistent = 1;
+		store_checkpoint(kb, CLASSIFICATION, checkpoint, 0, &total_time);
 		printf("Total time.........................: %.3f milisecs\n", total_time / 1000);
 		return;
 	}
@@ -205,6 +601,13 @@ void classify(KB* kb) {
 	STOP_TIMER(stop_time);
 	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
 	total_time += TIME_DIFF(start_time, stop_time);
+	record_memory_usage(kb, PHASE_HIERARCHY);
+	store_checkpoint(kb, CLASSIFICATION, checkpoint, 0, &total_time);
+	// the hierarchy is the same for other ABoxes as long as the KB is consistent
+	if (tbox_checkpoint != 0 && tbox_checkpoint != checkpoint)
+		store_checkpoint(kb, CLASSIFICATION, tbox_checkpoint, 1, &total_time);
+	// the output only needs the hierarchy
+	release_subsumers(kb);
 
 	printf("Total time.........................: %.3f milisecs\n", total_time / 1000);
 
@@ -225,6 +628,10 @@ char check_consistency(KB* kb) {
 	STOP_TIMER(stop_time);
 	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
 	total_time += TIME_DIFF(start_time, stop_time);
+	record_memory_usage(kb, PHASE_PREPROCESSING);
+
+	// the indexing may renumber the class expressions, the key does not depend on it
+	uint64_t checkpoint = compute_checkpoint_key(kb, CONSISTENCY, NULL, &total_time);
 
 	printf("Indexing...........................: ");
 	fflush(stdout);
@@ -233,6 +640,7 @@ char check_consistency(KB* kb) {
 	STOP_TIMER(stop_time);
 	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
 	total_time += TIME_DIFF(start_time, stop_time);
+	record_memory_usage(kb, PHASE_INDEXING);
 	// Return inconsistent if indexing returned inconsistent
 	if (indexing_result == -1) {
 		kb->inconsistent = 1;
@@ -246,23 +654,31 @@ char check_consistency(KB* kb) {
 		return 0;
 	}
 
+	if (restore_checkpoint(kb, CONSISTENCY, checkpoint, &total_time)) {
+		printf("Total time.........................: %.3f milisecs\n", total_time / 1000);
+		return kb->inconsistent;
+	}
+
 	// Indexing did not provide enough information for checking consistency.
 	// Saturate the KB.
 	printf("Saturating.........................: ");
 	fflush(stdout);
 	START_TIMER(start_time);
-	char saturation_result = saturate_tbox(kb, CONSISTENCY);
+	char saturation_result = saturate_tbox(kb, CONSISTENCY, 0);
 	STOP_TIMER(stop_time);
 	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
 	total_time += TIME_DIFF(start_time, stop_time);
-	printf("Total time.........................: %.3f milisecs\n", total_time / 1000);
+	record_memory_usage(kb, PHASE_SATURATION);
+	// nothing of the saturation is needed for the output
+	release_saturation_data(kb);
+	release_subsumers(kb);
 	// return inconsistent if saturation returned inconsistent
-	if (saturation_result == -1) {
+	if (saturation_result == -1)
 		kb->inconsistent = 1;
-		return 1;
-	}
+	store_checkpoint(kb, CONSISTENCY, checkpoint, 0, &total_time);
+	printf("Total time.........................: %.3f milisecs\n", total_time / 1000);
 
-	return 0;
+	return kb->inconsistent;
 }
 
 // Returns
@@ -280,6 +696,11 @@ char realize_kb(KB* kb) {
 	STOP_TIMER(stop_time);
 	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
 	total_time += TIME_DIFF(start_time, stop_time);
+	record_memory_usage(kb, PHASE_PREPROCESSING);
+
+	// the indexing may renumber the class expressions, the key does not depend on it
+	uint64_t tbox_checkpoint;
+	uint64_t checkpoint = compute_checkpoint_key(kb, REALISATION, &tbox_checkpoint, &total_time);
 
 	printf("Indexing...........................: ");
 	fflush(stdout);
@@ -288,6 +709,7 @@ char realize_kb(KB* kb) {
 	STOP_TIMER(stop_time);
 	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
 	total_time += TIME_DIFF(start_time, stop_time);
+	record_memory_usage(kb, PHASE_INDEXING);
 	// Return inconsistent if indexing returned inconsistent
 	if (indexing_result == -1) {
 		kb->inconsistent = 1;
@@ -295,20 +717,45 @@ char realize_kb(KB* kb) {
 		return 1;
 	}
 
-	printf("Saturating.........................: ");
+	if (restore_checkpoint(kb, REALISATION, checkpoint, &total_time)) {
+		printf("Total time.........................: %.3f milisecs\n", total_time / 1000);
+		return kb->inconsistent;
+	}
+
+	// the output only needs the subsumers of the nominals. if the hierarchy of
+	// this TBox has been stored, the classes the nominals do not reach are not
+	// saturated, otherwise the hierarchy is computed to be stored.
+	char individuals_only = tbox_checkpoint != 0 && checkpoint_consistent(tbox_checkpoint, CLASSIFICATION);
+	printf(individuals_only ? "Saturating individuals.............: " : "Saturating.........................: ");
 	fflush(stdout);
 	START_TIMER(start_time);
-	char saturation_result = saturate_tbox(kb, REALISATION);
+	char saturation_result = saturate_tbox(kb, REALISATION, individuals_only);
 	STOP_TIMER(stop_time);
 	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
 	total_time += TIME_DIFF(start_time, stop_time);
+	record_memory_usage(kb, PHASE_SATURATION);
+	// the output only needs the subsumers of the nominals
+	release_saturation_data(kb);
 	// return inconsistent if saturation returned inconsistent
 	if (saturation_result == -1) {
-		printf("Total time.........................: %.3f milisecs\n", total_time / 1000);
 		kb->inconsistent = 1;
+		store_checkpoint(kb, REALISATION, checkpoint, 0, &total_time);
+		printf("Total time.........................: %.3f milisecs\n", total_time / 1000);
 		return 1;
 	}
 
+	store_checkpoint(kb, REALISATION, checkpoint, 0, &total_time);
+	if (tbox_checkpoint != 0 && !individuals_only) {
+		printf("Computing concept hierarchy........: ");
+		fflush(stdout);
+		START_TIMER(start_time);
+		compute_concept_hierarchy(kb);
+		STOP_TIMER(stop_time);
+		printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
+		total_time += TIME_DIFF(start_time, stop_time);
+		record_memory_usage(kb, PHASE_HIERARCHY);
+		store_checkpoint(kb, CLASSIFICATION, tbox_checkpoint, 1, &total_time);
+	}
 	printf("Total time.........................: %.3f milisecs\n", total_time / 1000);
 
 	return 0;
@@ -20,16 +20,42 @@
 #ifndef REASONER_H_
 #define REASONER_H_
 
+#include <stdio.h>
+
 #include "../model/datatypes.h"
+#include "../parser/prescan.h"
+#include "../parser/imports.h"
 
 // for saturation statistics
 extern int saturation_unique_subsumption_count, saturation_total_subsumption_count;
 extern int saturation_unique_link_count, saturation_total_link_count;
 
-// initializes the TBox and the ABox
-KB* init_kb();
+// initializes the TBox and the ABox. the tables are sized for the given
+// counts of a pre-scan, or with the defaults in limits.h if they are NULL.
+KB* init_kb(OntologyCounts* counts);
+
+// pre-scans the given input, prints the estimated size of the KB and
+// returns a KB that is initialized for it. the input is rewound.
+KB* create_kb(FILE* input_kb);
+
+// parses the given input into the kb. with more than one thread, the
+// input is scanned in parallel, the parsing itself is sequential. if
+// pipelined is set, the told axioms are indexed on another thread while
+// they are parsed. the imported ontologies are looked up in the catalog,
+// they are ignored if it is NULL.
+void read_kb(FILE* input_kb, Catalog* catalog, int threads, char pipelined, KB* kb);
+
+// parses the triples in N-Triples or Turtle in the given input into the
+// abox of the kb, see parser/turtle.h. exits if there is a syntax error.
+void read_abox(FILE* input_abox, KB* kb);
+
+// returns a KB created from the snapshot in the given file, see
+// model/snapshot.h. exits if the file is not a valid snapshot.
+KB* load_kb(char* file_name);
 
-void read_kb(FILE* input_kb, KB* kb);
+// writes a snapshot of the given KB, which has just been read, to the
+// given file. exits if the file cannot be written.
+void save_kb(KB* kb, char* file_name);
 
 void classify(KB* kb);
 
@@ -0,0 +1,553 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "../model/datatypes.h"
+#include "../model/limits.h"
+#include "../model/utils.h"
+#include "../hashing/utils.h"
+#include "../hashing/string_pool.h"
+#include "../hierarchy/utils.h"
+#include "../utils/arena.h"
+#include "../utils/list.h"
+#include "../utils/map.h"
+#include "../utils/set.h"
+#include "../utils/id_set.h"
+#include "checkpoint.h"
+
+// checkpoints are not portable between machines with different byte orders
+#define CHECKPOINT_BYTE_ORDER		0x01020304
+
+// the strings are padded to a multiple of 4 bytes
+#define PADDED_LENGTH(length)		(((length) + 3) & ~((uint32_t) 3))
+
+// the file starts with the header, the IRIs of the classes and the
+// individuals follow, then the entries, see checkpoint.h
+typedef struct {
+	char magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	uint64_t key;
+	uint32_t reasoning_task;
+	uint32_t inconsistent;
+	uint32_t class_count;
+	uint32_t individual_count;
+	// size of the file
+	uint64_t size;
+} CheckpointHeader;
+
+// the directory of the checkpoints, NULL if they are not enabled
+static char* checkpoint_directory = NULL;
+
+char enable_checkpoints(char* directory) {
+	struct stat status;
+
+	if (mkdir(directory, 0755) != 0 && errno != EEXIST)
+		return 0;
+	// it can be a file
+	if (stat(directory, &status) != 0)
+		return 0;
+	if (!S_ISDIR(status.st_mode)) {
+		errno = ENOTDIR;
+		return 0;
+	}
+	checkpoint_directory = directory;
+
+	return 1;
+}
+
+char checkpoints_enabled() {
+	return checkpoint_directory != NULL;
+}
+
+/******************************************************************************
+ * the key
+ *****************************************************************************/
+static inline uint64_t combine(uint64_t hash, uint64_t value) {
+	return hash_fmix64(hash ^ (value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2)));
+}
+
+// the IRIs are hashed by their contents, their ids depend on the order of the input
+static inline uint64_t iri_hash(char* IRI) {
+	StringPoolEntry* entry = STRING_POOL_ENTRY(IRI);
+
+	return HASH_STRING_LENGTH(entry->string, entry->length);
+}
+
+// the axioms generated from the assertions and from SameIndividual and
+// DifferentIndividuals, their lhs is a generated nominal or a conjunction of two
+static inline char is_abox_axiom(SubClassOfAxiom* ax) {
+	return ax->lhs->type == OBJECT_ONE_OF_TYPE
+			|| (ax->lhs->type == OBJECT_INTERSECTION_OF_TYPE && ax->lhs->description.conj.conjunct1->type == OBJECT_ONE_OF_TYPE);
+}
+
+// the key of the KB, without the classes, the nominals and the axioms generated
+// from the ABox if tbox_only is set
+static uint64_t compute_key(KB* kb, ReasoningTask reasoning_task, char tbox_only) {
+	TBox* tbox = kb->tbox;
+	uint64_t* class_hashes, * role_hashes, h1, h2;
+	uint64_t classes = 0, nominals = 0, subclass_axioms = 0, subrole_axioms = 0, key;
+	ObjectPropertyExpression* r;
+	ClassExpression* c;
+	SetIterator set_iterator;
+	MapIterator map_iterator;
+	SubClassOfAxiom* subclass_ax;
+	SubObjectPropertyOfAxiom* subrole_ax;
+	uint32_t i;
+	int j;
+
+	// the operands of an expression are created before it, they have smaller ids
+	role_hashes = (uint64_t*) malloc((tbox->next_objectproperty_expression_id + 1) * sizeof(uint64_t));
+	assert(role_hashes != NULL);
+	for (i = 0; i < tbox->next_objectproperty_expression_id; ++i) {
+		r = tbox->objectproperty_expressions[i];
+		if (r->type == OBJECT_PROPERTY_TYPE)
+			role_hashes[i] = combine(r->type, iri_hash(r->description.atomic.IRI));
+		else
+			role_hashes[i] = combine(combine(r->type, role_hashes[r->description.object_property_chain.role1->id]),
+					role_hashes[r->description.object_property_chain.role2->id]);
+	}
+
+	class_hashes = (uint64_t*) malloc((tbox->next_class_expression_id + 1) * sizeof(uint64_t));
+	assert(class_hashes != NULL);
+	for (i = 0; i < tbox->next_class_expression_id; ++i) {
+		c = tbox->class_expressions[i];
+		switch (c->type) {
+		case CLASS_TYPE:
+			class_hashes[i] = combine(c->type, iri_hash(c->description.atomic.IRI));
+			break;
+		case OBJECT_INTERSECTION_OF_TYPE:
+			// the order of the conjuncts does not matter
+			h1 = class_hashes[c->description.conj.conjunct1->id];
+			h2 = class_hashes[c->description.conj.conjunct2->id];
+			class_hashes[i] = (h1 <= h2) ? combine(combine(c->type, h1), h2) : combine(combine(c->type, h2), h1);
+			break;
+		case OBJECT_SOME_VALUES_FROM_TYPE:
+			class_hashes[i] = combine(combine(c->type, role_hashes[c->description.exists.role->id]),
+					class_hashes[c->description.exists.filler->id]);
+			break;
+		case OBJECT_ONE_OF_TYPE:
+			class_hashes[i] = combine(c->type, iri_hash(c->description.nominal.individual->IRI));
+			break;
+		}
+	}
+
+	// the sets are iterated in an order that depends on the addresses of their
+	// elements, the hashes of their elements are summed up
+	if (!tbox_only) {
+		MAP_ITERATOR_INIT(&map_iterator, &(tbox->classes));
+		for (c = MAP_ITERATOR_NEXT(&map_iterator); c != NULL; c = MAP_ITERATOR_NEXT(&map_iterator))
+			classes += class_hashes[c->id];
+		MAP_ITERATOR_INIT(&map_iterator, &(kb->generated_nominals));
+		for (c = MAP_ITERATOR_NEXT(&map_iterator); c != NULL; c = MAP_ITERATOR_NEXT(&map_iterator))
+			nominals += class_hashes[c->id];
+	}
+
+	SET_ITERATOR_INIT(&set_iterator, &(tbox->subclass_of_axioms));
+	while ((subclass_ax = (SubClassOfAxiom*) SET_ITERATOR_NEXT(&set_iterator)) != NULL)
+		subclass_axioms += combine(class_hashes[subclass_ax->lhs->id], class_hashes[subclass_ax->rhs->id]);
+	for (j = 0; j < kb->generated_subclass_axiom_count; ++j)
+		if (!tbox_only || !is_abox_axiom(kb->generated_subclass_axioms[j]))
+			subclass_axioms += combine(class_hashes[kb->generated_subclass_axioms[j]->lhs->id], class_hashes[kb->generated_subclass_axioms[j]->rhs->id]);
+
+	SET_ITERATOR_INIT(&set_iterator, &(tbox->subobjectproperty_of_axioms));
+	while ((subrole_ax = (SubObjectPropertyOfAxiom*) SET_ITERATOR_NEXT(&set_iterator)) != NULL)
+		subrole_axioms += combine(role_hashes[subrole_ax->lhs->id], role_hashes[subrole_ax->rhs->id]);
+	for (j = 0; j < kb->generated_subrole_axiom_count; ++j)
+		subrole_axioms += combine(role_hashes[kb->generated_subrole_axioms[j]->lhs->id], role_hashes[kb->generated_subrole_axioms[j]->rhs->id]);
+
+	free(class_hashes);
+	free(role_hashes);
+
+	key = combine(CHECKPOINT_VERSION, reasoning_task);
+	key = combine(key, kb->top_occurs_on_lhs);
+	key = combine(key, kb->bottom_occurs_on_rhs);
+	key = combine(key, classes);
+	key = combine(key, nominals);
+	key = combine(key, subclass_axioms);
+	key = combine(key, subrole_axioms);
+
+	return key;
+}
+
+uint64_t checkpoint_key(KB* kb, ReasoningTask reasoning_task) {
+	return compute_key(kb, reasoning_task, 0);
+}
+
+uint64_t checkpoint_tbox_key(KB* kb) {
+	MapIterator iterator;
+
+	// with nominals in the TBox, the assertions can change the hierarchy
+	MAP_ITERATOR_INIT(&iterator, &(kb->tbox->object_one_of_exps));
+	if (MAP_ITERATOR_NEXT(&iterator) != NULL)
+		return 0;
+
+	return compute_key(kb, CLASSIFICATION, 1);
+}
+
+// the checkpoint with the given key, the template of a temporary file for it
+// if temporary is set
+static char* checkpoint_file_name(uint64_t key, char temporary) {
+	size_t size = strlen(checkpoint_directory) + 40;
+	char* file_name = (char*) malloc(size);
+	assert(file_name != NULL);
+
+	snprintf(file_name, size, "%s/%016" PRIx64 ".sat%s", checkpoint_directory, key, temporary ? ".XXXXXX" : "");
+
+	return file_name;
+}
+
+/******************************************************************************
+ * writing
+ *****************************************************************************/
+static void write_iri(char* IRI, FILE* file) {
+	StringPoolEntry* entry = STRING_POOL_ENTRY(IRI);
+	uint32_t zero = 0;
+
+	fwrite(&(entry->length), sizeof(uint32_t), 1, file);
+	fwrite(entry->string, 1, entry->length, file);
+	fwrite(&zero, 1, PADDED_LENGTH(entry->length) - entry->length, file);
+}
+
+// the number of classes in the list, then their indexes
+static void write_class_list(List* classes, uint32_t* indexes, FILE* file) {
+	uint32_t index;
+	int i;
+
+	fwrite(&(classes->size), sizeof(uint32_t), 1, file);
+	for (i = 0; i < classes->size; ++i) {
+		index = indexes[((ClassExpression*) classes->elements[i])->id];
+		fwrite(&index, sizeof(uint32_t), 1, file);
+	}
+}
+
+static void write_set(Set* set, List* classes, uint32_t* indexes, FILE* file) {
+	SetIterator iterator;
+	ClassExpression* c;
+
+	classes->size = 0;
+	SET_ITERATOR_INIT(&iterator, set);
+	for (c = SET_ITERATOR_NEXT(&iterator); c != NULL; c = SET_ITERATOR_NEXT(&iterator))
+		list_add(c, classes);
+	write_class_list(classes, indexes, file);
+}
+
+// the class subsumers, the output does not need the others
+static void write_subsumers(IdSet* subsumers, List* classes, uint32_t* indexes, TBox* tbox, FILE* file) {
+	IdSetIterator iterator;
+	ClassExpression* c;
+	uint32_t id;
+
+	classes->size = 0;
+	ID_SET_ITERATOR_INIT(&iterator, subsumers);
+	for (id = ID_SET_ITERATOR_NEXT(&iterator); id != ID_SET_ITERATOR_END; id = ID_SET_ITERATOR_NEXT(&iterator)) {
+		c = GET_CLASS_EXPRESSION(id, tbox);
+		if (c->type == CLASS_TYPE)
+			list_add(c, classes);
+	}
+	write_class_list(classes, indexes, file);
+}
+
+char save_checkpoint(KB* kb, ReasoningTask reasoning_task, uint64_t key) {
+	TBox* tbox = kb->tbox;
+	CheckpointHeader header;
+	MapIterator iterator;
+	ClassExpression* c;
+	uint32_t* indexes;
+	List classes;
+	char* file_name, * temporary_file_name;
+	FILE* file;
+	char result;
+	int fd, error;
+
+	// each writer has its own temporary file, the checkpoint is replaced
+	// atomically by the rename below
+	temporary_file_name = checkpoint_file_name(key, 1);
+	fd = mkstemp(temporary_file_name);
+	if (fd == -1) {
+		error = errno;
+		free(temporary_file_name);
+		errno = error;
+		return 0;
+	}
+	// mkstemp creates it only readable by the owner
+	fchmod(fd, 0644);
+	file = fdopen(fd, "wb");
+	if (file == NULL) {
+		error = errno;
+		close(fd);
+		remove(temporary_file_name);
+		free(temporary_file_name);
+		errno = error;
+		return 0;
+	}
+
+	memset(&header, 0, sizeof(CheckpointHeader));
+	memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+	header.version = CHECKPOINT_VERSION;
+	header.byte_order = CHECKPOINT_BYTE_ORDER;
+	header.key = key;
+	header.reasoning_task = reasoning_task;
+	header.inconsistent = kb->inconsistent;
+	// the header is written again at the end, with the counts and the size
+	fwrite(&header, sizeof(CheckpointHeader), 1, file);
+
+	if (!kb->inconsistent && reasoning_task != CONSISTENCY) {
+		// the classes are numbered in the order of the map
+		indexes = (uint32_t*) malloc((tbox->next_class_expression_id + 1) * sizeof(uint32_t));
+		assert(indexes != NULL);
+		MAP_ITERATOR_INIT(&iterator, &(tbox->classes));
+		for (c = MAP_ITERATOR_NEXT(&iterator); c != NULL; c = MAP_ITERATOR_NEXT(&iterator)) {
+			indexes[c->id] = header.class_count++;
+			write_iri(c->description.atomic.IRI, file);
+		}
+		if (reasoning_task == REALISATION) {
+			MAP_ITERATOR_INIT(&iterator, &(kb->generated_nominals));
+			for (c = MAP_ITERATOR_NEXT(&iterator); c != NULL; c = MAP_ITERATOR_NEXT(&iterator)) {
+				++header.individual_count;
+				write_iri(c->description.nominal.individual->IRI, file);
+			}
+		}
+
+		LIST_INIT(&classes);
+		if (reasoning_task == CLASSIFICATION) {
+			MAP_ITERATOR_INIT(&iterator, &(tbox->classes));
+			for (c = MAP_ITERATOR_NEXT(&iterator); c != NULL; c = MAP_ITERATOR_NEXT(&iterator)) {
+				write_set(&(c->description.atomic.hierarchy->equivalent_classes), &classes, indexes, file);
+				write_set(&(c->description.atomic.hierarchy->direct_subsumers), &classes, indexes, file);
+			}
+		}
+		else {
+			MAP_ITERATOR_INIT(&iterator, &(kb->generated_nominals));
+			for (c = MAP_ITERATOR_NEXT(&iterator); c != NULL; c = MAP_ITERATOR_NEXT(&iterator))
+				write_subsumers(&(c->subsumers), &classes, indexes, tbox, file);
+		}
+		list_reset(&classes);
+		free(indexes);
+	}
+	header.size = ftell(file);
+
+	rewind(file);
+	fwrite(&header, sizeof(CheckpointHeader), 1, file);
+	// errno is kept from the write that has failed
+	result = !ferror(file);
+	error = errno;
+	if (fclose(file) != 0 && result) {
+		result = 0;
+		error = errno;
+	}
+
+	// replace an existing checkpoint only with a complete one
+	file_name = checkpoint_file_name(key, 0);
+	if (result && rename(temporary_file_name, file_name) != 0) {
+		result = 0;
+		error = errno;
+	}
+	if (!result)
+		remove(temporary_file_name);
+	free(temporary_file_name);
+	free(file_name);
+	if (!result)
+		errno = error;
+
+	return result;
+}
+
+/******************************************************************************
+ * reading
+ *****************************************************************************/
+// returns the contents of the checkpoint file with the given key if it is valid
+// for the given reasoning task, NULL otherwise
+static char* read_checkpoint_file(uint64_t key, ReasoningTask reasoning_task) {
+	CheckpointHeader* header;
+	char* file_name, * contents;
+	FILE* file;
+	long size;
+
+	file_name = checkpoint_file_name(key, 0);
+	file = fopen(file_name, "rb");
+	free(file_name);
+	if (file == NULL)
+		return NULL;
+
+	if (fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < (long) sizeof(CheckpointHeader)) {
+		fclose(file);
+		return NULL;
+	}
+	rewind(file);
+	contents = (char*) malloc(size);
+	assert(contents != NULL);
+	if (fread(contents, 1, size, file) != (size_t) size) {
+		free(contents);
+		fclose(file);
+		return NULL;
+	}
+	fclose(file);
+
+	header = (CheckpointHeader*) contents;
+	if (memcmp(header->magic, CHECKPOINT_MAGIC, sizeof(header->magic)) != 0 || header->version != CHECKPOINT_VERSION
+			|| header->byte_order != CHECKPOINT_BYTE_ORDER || header->key != key
+			|| header->reasoning_task != reasoning_task || header->size != (uint64_t) size) {
+		free(contents);
+		return NULL;
+	}
+
+	return contents;
+}
+
+// looks up the IRIs of the classes and the individuals in the KB and stores
+// the classes and the generated nominals. returns the position of the entries,
+// NULL if one of them is not in the KB.
+static uint32_t* resolve_iris(KB* kb, char* contents, ClassExpression** classes, ClassExpression** nominals) {
+	CheckpointHeader* header = (CheckpointHeader*) contents;
+	char* p = contents + sizeof(CheckpointHeader), * end = contents + header->size;
+	StringPoolEntry* entry;
+	Individual* individual;
+	uint32_t i, length;
+
+	for (i = 0; i < header->class_count + header->individual_count; ++i) {
+		if (p + sizeof(uint32_t) > end)
+			return NULL;
+		length = *((uint32_t*) p);
+		p += sizeof(uint32_t);
+		if (p + PADDED_LENGTH(length) > end)
+			return NULL;
+		entry = string_pool_get(&(kb->iris), p, length);
+		p += PADDED_LENGTH(length);
+		if (entry == NULL)
+			return NULL;
+		if (i < header->class_count) {
+			if ((classes[i] = GET_ATOMIC_CONCEPT(entry, kb->tbox)) == NULL)
+				return NULL;
+		}
+		else {
+			if ((individual = GET_INDIVIDUAL(entry, kb->abox)) == NULL
+					|| (nominals[i - header->class_count] = MAP_GET(individual->id, &(kb->generated_nominals))) == NULL)
+				return NULL;
+		}
+	}
+
+	return (uint32_t*) p;
+}
+
+// checks that the given number of lists of class indexes fit in the file
+static char check_class_lists(uint32_t* p, uint32_t list_count, CheckpointHeader* header) {
+	uint32_t* end = (uint32_t*) ((char*) header + header->size);
+	uint32_t i, j, count;
+
+	for (i = 0; i < list_count; ++i) {
+		if (p >= end)
+			return 0;
+		count = *p++;
+		if (count > (uint32_t) (end - p))
+			return 0;
+		for (j = 0; j < count; ++j)
+			if (*p++ >= header->class_count)
+				return 0;
+	}
+
+	return p == end;
+}
+
+static uint32_t count_classes(TBox* tbox) {
+	MapIterator iterator;
+	uint32_t count = 0;
+
+	MAP_ITERATOR_INIT(&iterator, &(tbox->classes));
+	while (MAP_ITERATOR_NEXT(&iterator) != NULL)
+		++count;
+
+	return count;
+}
+
+char checkpoint_consistent(uint64_t key, ReasoningTask reasoning_task) {
+	char* contents;
+	char consistent;
+
+	contents = read_checkpoint_file(key, reasoning_task);
+	if (contents == NULL)
+		return 0;
+	consistent = !((CheckpointHeader*) contents)->inconsistent;
+	free(contents);
+
+	return consistent;
+}
+
+char load_checkpoint(KB* kb, ReasoningTask reasoning_task, uint64_t key) {
+	CheckpointHeader* header;
+	ClassExpression** classes, ** nominals;
+	ClassHierarchy* hierarchy;
+	char* contents;
+	uint32_t* p, i, j, count;
+	char result = 0;
+
+	contents = read_checkpoint_file(key, reasoning_task);
+	if (contents == NULL)
+		return 0;
+	header = (CheckpointHeader*) contents;
+
+	if (header->inconsistent || reasoning_task == CONSISTENCY) {
+		kb->inconsistent = header->inconsistent;
+		free(contents);
+		return 1;
+	}
+
+	classes = (ClassExpression**) malloc((header->class_count + 1) * sizeof(ClassExpression*));
+	assert(classes != NULL);
+	nominals = (ClassExpression**) malloc((header->individual_count + 1) * sizeof(ClassExpression*));
+	assert(nominals != NULL);
+	p = resolve_iris(kb, contents, classes, nominals);
+	// the KB is only modified if the whole checkpoint is valid. every class
+	// needs a hierarchy for the output.
+	if (p != NULL && reasoning_task == CLASSIFICATION && header->class_count == count_classes(kb->tbox)
+			&& check_class_lists(p, 2 * header->class_count, header)) {
+		// see compute_concept_hierarchy
+		for (i = 0; i < header->class_count; ++i) {
+			hierarchy = (ClassHierarchy*) arena_allocate(kb->tbox->expressions, sizeof(ClassHierarchy));
+			SET_INIT(&(hierarchy->equivalent_classes), DEFAULT_EQUIVALENT_CONCEPTS_SET_SIZE);
+			SET_INIT(&(hierarchy->direct_subsumers), DEFAULT_DIRECT_SUBSUMERS_SET_SIZE);
+			classes[i]->description.atomic.hierarchy = hierarchy;
+			for (count = *p++, j = 0; j < count; ++j)
+				ADD_EQUIVALENT_CLASS(classes[*p++], classes[i]);
+			for (count = *p++, j = 0; j < count; ++j)
+				ADD_DIRECT_SUBSUMER(classes[*p++], classes[i]);
+		}
+		result = 1;
+	}
+	else if (p != NULL && reasoning_task == REALISATION && check_class_lists(p, header->individual_count, header)) {
+		for (i = 0; i < header->individual_count; ++i)
+			for (count = *p++, j = 0; j < count; ++j)
+				ID_SET_ADD(classes[*p++]->id, &(nominals[i]->subsumers));
+		result = 1;
+	}
+
+	free(classes);
+	free(nominals);
+	free(contents);
+
+	return result;
+}
@@ -0,0 +1,114 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHECKPOINT_H_
+#define CHECKPOINT_H_
+
+#include <stdint.h>
+
+#include "../model/datatypes.h"
+
+/**
+ * Saturation checkpoints. The result of reasoning on a KB is stored in a
+ * cache directory, in a file named after a content hash of the normalized
+ * axioms. A later run on the same KB finds the file and restores the
+ * result instead of saturating again.
+ *
+ * The key covers the told and the generated subclass and subrole axioms,
+ * the classes, the nominals generated from the assertions and the reasoning
+ * task. The expressions are hashed structurally, the IRIs by their contents,
+ * so the key does not depend on the ids of the expressions.
+ *
+ * The TBox key only covers the axioms that are not generated from the
+ * assertions, SameIndividual and DifferentIndividuals, the classes that only
+ * the assertions use would change it otherwise. The class hierarchy of a
+ * consistent KB is stored under it as well, a KB with the same TBox and
+ * another ABox has the same subsumptions between classes as long as it is
+ * consistent. Realisation then only saturates the individuals. This does not
+ * hold if the TBox has nominals, the assertions on their individuals can add
+ * subsumptions between classes, such KBs have no TBox key.
+ *
+ * What is stored depends on the reasoning task:
+ *	classification: the equivalent classes and the direct subsumers of each
+ *		class, i.e., the computed hierarchy
+ *	realisation: the subsumers of each generated nominal that are classes
+ *	consistency: only whether the KB is inconsistent
+ * The classes and individuals are referred to by their IRIs, which are
+ * stored at the start of the file. If the KB is inconsistent, nothing else
+ * is stored for any task.
+ *
+ * A checkpoint is only valid for the version of ELepHant and the kind of
+ * machine it has been written on. Other ones are ignored and overwritten.
+ */
+
+#define CHECKPOINT_MAGIC			"ELPHSAT\n"
+// increased whenever the format or the key changes
+#define CHECKPOINT_VERSION			1
+
+/**
+ * Enable the checkpoints, they are stored in the given directory. It is
+ * created if it does not exist, its parent has to exist.
+ * Returns 1 on success, 0 if the directory cannot be created or it is not
+ * a directory, errno is set then.
+ */
+char enable_checkpoints(char* directory);
+
+/**
+ * Returns 1 if the checkpoints are enabled, 0 otherwise.
+ */
+char checkpoints_enabled();
+
+/**
+ * Compute the key of the given KB for the given reasoning task. The KB has
+ * to be preprocessed, but not indexed yet.
+ * Returns the key.
+ */
+uint64_t checkpoint_key(KB* kb, ReasoningTask reasoning_task);
+
+/**
+ * Compute the TBox key of the given KB, see above. The KB has to be
+ * preprocessed, but not indexed yet.
+ * Returns the key, 0 if the TBox has nominals.
+ */
+uint64_t checkpoint_tbox_key(KB* kb);
+
+/**
+ * Returns 1 if there is a checkpoint with the given key for the given
+ * reasoning task and the KB has been consistent, 0 otherwise.
+ */
+char checkpoint_consistent(uint64_t key, ReasoningTask reasoning_task);
+
+/**
+ * Restore the result of the given reasoning task from the checkpoint with
+ * the given key. The KB has to be indexed, but not saturated.
+ * Returns 1 if the result has been restored, 0 if there is no checkpoint
+ * with this key or it cannot be read. The KB is not modified in this case.
+ */
+char load_checkpoint(KB* kb, ReasoningTask reasoning_task, uint64_t key);
+
+/**
+ * Store the result of the given reasoning task in a checkpoint with the
+ * given key. For classification, the hierarchy has to be computed already
+ * unless the KB is inconsistent. The checkpoint is written to a temporary
+ * file first and then renamed, concurrent runs never see a partial one.
+ * Returns 1 on success, 0 if the checkpoint cannot be written, errno is set
+ * then.
+ */
+char save_checkpoint(KB* kb, ReasoningTask reasoning_task, uint64_t key);
+
+#endif /* CHECKPOINT_H_ */
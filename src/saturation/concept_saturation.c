@@ -38,7 +38,7 @@ int saturation_unique_subsumption_count = 0, saturation_total_subsumption_count
 int saturation_unique_link_count = 0, saturation_total_link_count = 0;
 
 // marks the axiom with the premise lhs and conclusion rhs as processed
-#define MARK_CONCEPT_SATURATION_AXIOM_PROCESSED(ax)		SET_ADD(ax->rhs, &(ax->lhs->subsumers))
+#define MARK_CONCEPT_SATURATION_AXIOM_PROCESSED(ax)		ID_SET_ADD(ax->rhs->id, &(ax->lhs->subsumers))
 
 static inline void print_saturation_axiom(KB* kb, ConceptSaturationAxiom* ax) {
 	printf("%d: ", ax->type);
@@ -73,7 +73,7 @@ static inline ConceptSaturationAxiom* create_concept_saturation_axiom(ClassExpre
  * 	is cancelled.
  * 	0: Otherwise
  */
-char saturate_concepts(KB* kb, ReasoningTask reasoning_task) {
+char saturate_concepts(KB* kb, ReasoningTask reasoning_task, char individuals_only) {
 	TBox* tbox = kb->tbox;
 
 	ConceptSaturationAxiom* ax;
@@ -82,10 +82,12 @@ char saturate_concepts(KB* kb, ReasoningTask reasoning_task) {
 	// initialize the stack
 	init_stack(&scheduled_axioms);
 
-	// initialization axioms from classes
+	// initialization axioms from classes. the fillers of the existentials are
+	// initialized when they are reached, the classes the nominals do not reach
+	// are not needed for their subsumers.
 	MapIterator iterator;
 	MAP_ITERATOR_INIT(&iterator, &(tbox->classes));
-	void* class = MAP_ITERATOR_NEXT(&iterator);
+	void* class = individuals_only ? NULL : MAP_ITERATOR_NEXT(&iterator);
 	while (class) {
 		push(&scheduled_axioms, create_concept_saturation_axiom((ClassExpression*) class, ((ClassExpression*) class), NULL, SUBSUMPTION_INITIALIZATION));
 		if (kb->top_occurs_on_lhs) {
@@ -106,7 +108,7 @@ char saturate_concepts(KB* kb, ReasoningTask reasoning_task) {
 		// The input axioms generated from concept and role assertions
 		while (nominal) {
 			// add owl:Thing manually to the subsumers of the generated nominals
-			SET_ADD(kb->tbox->top_concept, &(nominal->subsumers));
+			ID_SET_ADD(kb->tbox->top_concept->id, &(nominal->subsumers));
 
 			push(&scheduled_axioms, create_concept_saturation_axiom((ClassExpression*) nominal, ((ClassExpression*) nominal), NULL, SUBSUMPTION_INITIALIZATION));
 			if (kb->top_occurs_on_lhs) {
@@ -150,12 +152,13 @@ char saturate_concepts(KB* kb, ReasoningTask reasoning_task) {
 					for (j = 0; j < ax->lhs->predecessors[i].role->subsumer_list.size; ++j) {
 						ex = GET_NEGATIVE_EXISTS(ax->rhs, ((ObjectPropertyExpression*) ax->lhs->predecessors[i].role->subsumer_list.elements[j]));
 						if (ex != NULL) {
-							SetIterator predecessors_iterator;
-							SET_ITERATOR_INIT(&predecessors_iterator, &(ax->lhs->predecessors[i].fillers));
-							ClassExpression* predecessor = (ClassExpression*) SET_ITERATOR_NEXT(&predecessors_iterator);
-							while (predecessor != NULL) {
+							IdSetIterator predecessors_iterator;
+							ID_SET_ITERATOR_INIT(&predecessors_iterator, &(ax->lhs->predecessors[i].fillers));
+							uint32_t predecessor_id = ID_SET_ITERATOR_NEXT(&predecessors_iterator);
+							while (predecessor_id != ID_SET_ITERATOR_END) {
+								ClassExpression* predecessor = GET_CLASS_EXPRESSION(predecessor_id, tbox);
 								push(&scheduled_axioms, create_concept_saturation_axiom(predecessor, ex, NULL, SUBSUMPTION_EXISTENTIAL_INTRODUCTION));
-								predecessor = (ClassExpression*) SET_ITERATOR_NEXT(&predecessors_iterator);
+								predecessor_id = ID_SET_ITERATOR_NEXT(&predecessors_iterator);
 							}
 						}
 					}
@@ -180,9 +183,15 @@ char saturate_concepts(KB* kb, ReasoningTask reasoning_task) {
 				// bottom rule
 				if (ax->rhs == tbox->bottom_concept) {
 					// If the top concept or a nominal is subsumed by bottom, the kb is inconsistent
-					if (ax->lhs->type == OBJECT_ONE_OF_TYPE || ax->lhs == tbox->top_concept)
-						// return inconsistent immediately
+					if (ax->lhs->type == OBJECT_ONE_OF_TYPE || ax->lhs == tbox->top_concept) {
+						// return inconsistent immediately, the axioms that are
+						// still scheduled are freed
+						do
+							free(ax);
+						while ((ax = pop(&scheduled_axioms)) != NULL);
+						reset_stack(&scheduled_axioms);
 						return -1;
+					}
 					// We push the saturation axiom bottom <= ax->lhs, if we already know ax->lhs <= bottom. This way ax->lhs = bottom
 					// gets computed. The information bottom <= c is not taken into account for any other concept c.
 					push(&scheduled_axioms, create_concept_saturation_axiom(tbox->bottom_concept, ax->lhs, NULL, SUBSUMPTION_BOTTOM));
@@ -191,12 +200,13 @@ char saturate_concepts(KB* kb, ReasoningTask reasoning_task) {
 						for (j = 0; j < ax->lhs->predecessors[i].filler_count; ++j)
 							push(&scheduled_axioms, create_concept_saturation_axiom(ax->lhs->predecessors[i].fillers[j], tbox->bottom_concept, NULL, SUBSUMPTION_BOTTOM));
 						 */
-						SetIterator predecessors_iterator;
-						SET_ITERATOR_INIT(&predecessors_iterator, &(ax->lhs->predecessors[i].fillers));
-						ClassExpression* predecessor = (ClassExpression*) SET_ITERATOR_NEXT(&predecessors_iterator);
-						while (predecessor != NULL) {
+						IdSetIterator predecessors_iterator;
+						ID_SET_ITERATOR_INIT(&predecessors_iterator, &(ax->lhs->predecessors[i].fillers));
+						uint32_t predecessor_id = ID_SET_ITERATOR_NEXT(&predecessors_iterator);
+						while (predecessor_id != ID_SET_ITERATOR_END) {
+							ClassExpression* predecessor = GET_CLASS_EXPRESSION(predecessor_id, tbox);
 							push(&scheduled_axioms, create_concept_saturation_axiom(predecessor, tbox->bottom_concept, NULL, SUBSUMPTION_BOTTOM));
-							predecessor = (ClassExpression*) SET_ITERATOR_NEXT(&predecessors_iterator);
+							predecessor_id = ID_SET_ITERATOR_NEXT(&predecessors_iterator);
 						}
 					}
 				}
@@ -240,12 +250,13 @@ char saturate_concepts(KB* kb, ReasoningTask reasoning_task) {
 					for (j = 0; j < ax->lhs->predecessors[i].role->subsumer_list.size; ++j) {
 						ex = GET_NEGATIVE_EXISTS(ax->rhs, ((ObjectPropertyExpression*) ax->lhs->predecessors[i].role->subsumer_list.elements[j]));
 						if (ex != NULL) {
-							SetIterator predecessors_iterator;
-							SET_ITERATOR_INIT(&predecessors_iterator, &(ax->lhs->predecessors[i].fillers));
-							ClassExpression* predecessor = (ClassExpression*) SET_ITERATOR_NEXT(&predecessors_iterator);
-							while (predecessor != NULL) {
+							IdSetIterator predecessors_iterator;
+							ID_SET_ITERATOR_INIT(&predecessors_iterator, &(ax->lhs->predecessors[i].fillers));
+							uint32_t predecessor_id = ID_SET_ITERATOR_NEXT(&predecessors_iterator);
+							while (predecessor_id != ID_SET_ITERATOR_END) {
+								ClassExpression* predecessor = GET_CLASS_EXPRESSION(predecessor_id, tbox);
 								push(&scheduled_axioms, create_concept_saturation_axiom(predecessor, ex, NULL, SUBSUMPTION_EXISTENTIAL_INTRODUCTION));
-								predecessor = (ClassExpression*) SET_ITERATOR_NEXT(&predecessors_iterator);
+								predecessor_id = ID_SET_ITERATOR_NEXT(&predecessors_iterator);
 							}
 						}
 					}
@@ -275,18 +286,19 @@ char saturate_concepts(KB* kb, ReasoningTask reasoning_task) {
 
 
 				// existential introduction
-				SetIterator subsumers_iterator;
-				SET_ITERATOR_INIT(&subsumers_iterator, &(ax->rhs->subsumers));
-				void* subsumer = SET_ITERATOR_NEXT(&subsumers_iterator);
+				IdSetIterator subsumers_iterator;
+				ID_SET_ITERATOR_INIT(&subsumers_iterator, &(ax->rhs->subsumers));
+				uint32_t subsumer_id = ID_SET_ITERATOR_NEXT(&subsumers_iterator);
 				// TODO: change the order of the loops for better performance
-				while (subsumer != NULL) {
+				while (subsumer_id != ID_SET_ITERATOR_END) {
+					ClassExpression* subsumer = GET_CLASS_EXPRESSION(subsumer_id, tbox);
 					for (j = 0; j < ax->role->subsumer_list.size; ++j) {
-						ClassExpression* ex = GET_NEGATIVE_EXISTS(((ClassExpression*) subsumer), ((ObjectPropertyExpression*) ax->role->subsumer_list.elements[j]));
+						ClassExpression* ex = GET_NEGATIVE_EXISTS(subsumer, ((ObjectPropertyExpression*) ax->role->subsumer_list.elements[j]));
 						if (ex != NULL) {
 							push(&scheduled_axioms, create_concept_saturation_axiom(ax->lhs, ex, NULL, SUBSUMPTION_EXISTENTIAL_INTRODUCTION));
 						}
 					}
-					subsumer = SET_ITERATOR_NEXT(&subsumers_iterator);
+					subsumer_id = ID_SET_ITERATOR_NEXT(&subsumers_iterator);
 				}
 
 				// the role chain rule
@@ -294,17 +306,18 @@ char saturate_concepts(KB* kb, ReasoningTask reasoning_task) {
 				for (i = 0; i < ax->role->second_component_of_count; ++i) {
 					for (j = 0; j < ax->lhs->predecessor_r_count; ++j)
 						if (ax->lhs->predecessors[j].role == ax->role->second_component_of_list[i]->description.object_property_chain.role1) {
-							SetIterator predecessors_iterator;
-							SET_ITERATOR_INIT(&predecessors_iterator, &(ax->lhs->predecessors[j].fillers));
-							ClassExpression* predecessor = (ClassExpression*) SET_ITERATOR_NEXT(&predecessors_iterator);
-							while (predecessor != NULL) {
+							IdSetIterator predecessors_iterator;
+							ID_SET_ITERATOR_INIT(&predecessors_iterator, &(ax->lhs->predecessors[j].fillers));
+							uint32_t predecessor_id = ID_SET_ITERATOR_NEXT(&predecessors_iterator);
+							while (predecessor_id != ID_SET_ITERATOR_END) {
+								ClassExpression* predecessor = GET_CLASS_EXPRESSION(predecessor_id, tbox);
 								int l;
 								for (l = 0; l < ax->role->second_component_of_list[i]->subsumer_list.size; ++l) {
 									push(&scheduled_axioms,
 											create_concept_saturation_axiom(predecessor, ax->rhs, (ObjectPropertyExpression*) ax->role->second_component_of_list[i]->subsumer_list.elements[l], LINK));
 									push(&scheduled_axioms, create_concept_saturation_axiom(ax->rhs, ax->rhs, NULL, SUBSUMPTION_INITIALIZATION));
 								}
-								predecessor = (ClassExpression*) SET_ITERATOR_NEXT(&predecessors_iterator);
+								predecessor_id = ID_SET_ITERATOR_NEXT(&predecessors_iterator);
 							}
 
 
@@ -317,17 +330,18 @@ char saturate_concepts(KB* kb, ReasoningTask reasoning_task) {
 				for (i = 0; i < ax->role->first_component_of_count; ++i) {
 					for (j = 0; j < ax->rhs->successor_r_count; ++j)
 						if (ax->rhs->successors[j].role == ax->role->first_component_of_list[i]->description.object_property_chain.role2) {
-							SetIterator successors_iterator;
-							SET_ITERATOR_INIT(&successors_iterator, &(ax->rhs->successors[j].fillers));
-							ClassExpression* successor= (ClassExpression*) SET_ITERATOR_NEXT(&successors_iterator);
-							while (successor!= NULL) {
+							IdSetIterator successors_iterator;
+							ID_SET_ITERATOR_INIT(&successors_iterator, &(ax->rhs->successors[j].fillers));
+							uint32_t successor_id = ID_SET_ITERATOR_NEXT(&successors_iterator);
+							while (successor_id != ID_SET_ITERATOR_END) {
+								ClassExpression* successor = GET_CLASS_EXPRESSION(successor_id, tbox);
 								int l;
 								for (l = 0; l < ax->role->first_component_of_list[i]->subsumer_list.size; ++l) {
 									push(&scheduled_axioms,
 											create_concept_saturation_axiom( ax->lhs, successor, (ObjectPropertyExpression*) ax->role->first_component_of_list[i]->subsumer_list.elements[l], LINK));
 									push(&scheduled_axioms, create_concept_saturation_axiom(successor, successor, NULL, SUBSUMPTION_INITIALIZATION));
 								}
-								successor= (ClassExpression*) SET_ITERATOR_NEXT(&successors_iterator);
+								successor_id = ID_SET_ITERATOR_NEXT(&successors_iterator);
 							}
 
 						}
@@ -347,6 +361,7 @@ char saturate_concepts(KB* kb, ReasoningTask reasoning_task) {
 		free(ax);
 		ax = pop(&scheduled_axioms);
 	}
+	reset_stack(&scheduled_axioms);
 	// printf("Total subsumptions:%d\nUnique subsumptions:%d\n", saturation_total_subsumption_count, saturation_unique_subsumption_count);
 	// printf("Total links:%d\nUnique links:%d\n", saturation_total_link_count, saturation_unique_link_count);
 
@@ -30,7 +30,9 @@
  * 	subsumer bottom. In this case it immediately returns, i.e., saturation process
  * 	is cancelled.
  * 	0: Otherwise
+ * If individuals_only is set, the classes are not initialized, only the
+ * expressions reached from the generated nominals are saturated.
  */
-char saturate_concepts(KB* kb, ReasoningTask reasoning_task);
+char saturate_concepts(KB* kb, ReasoningTask reasoning_task, char individuals_only);
 
 #endif
@@ -92,21 +92,22 @@ void saturate_roles(KB* kb) {
 	}
 
 	// reflexive transitive closure
-	SetIterator told_subsumers_iterator;
+	IdSetIterator told_subsumers_iterator;
 	ax = pop(&scheduled_axioms);
 	while (ax != NULL) {
 		if (mark_role_saturation_axiom_processed(ax)) {
 			// told subsumers
-			SET_ITERATOR_INIT(&told_subsumers_iterator, &(ax->rhs->told_subsumers));
-			ObjectPropertyExpression* told_subsumer = SET_ITERATOR_NEXT(&told_subsumers_iterator);
-			while (told_subsumer) {
-				push(&scheduled_axioms, create_role_saturation_axiom(ax->lhs, told_subsumer));
-				told_subsumer = SET_ITERATOR_NEXT(&told_subsumers_iterator);
+			ID_SET_ITERATOR_INIT(&told_subsumers_iterator, &(ax->rhs->told_subsumers));
+			uint32_t told_subsumer_id = ID_SET_ITERATOR_NEXT(&told_subsumers_iterator);
+			while (told_subsumer_id != ID_SET_ITERATOR_END) {
+				push(&scheduled_axioms, create_role_saturation_axiom(ax->lhs, GET_OBJECTPROPERTY_EXPRESSION(told_subsumer_id, kb->tbox)));
+				told_subsumer_id = ID_SET_ITERATOR_NEXT(&told_subsumers_iterator);
 			}
 		}
 		free(ax);
 		ax = pop(&scheduled_axioms);
 	}
+	reset_stack(&scheduled_axioms);
 
 	// stack for the object property chain hierarchy computation
 	// Stack scheduled_object_property_chains;
@@ -125,77 +126,74 @@ void saturate_roles(KB* kb) {
 	}
 
 	// object property chain hierarchy computation.
-	ObjectPropertyExpression *subsumee_1, *subsumee_2;
-	SetIterator subsumees_iterator_1, subsumees_iterator_2, component_of_iterator;
+	uint32_t subsumee_1_id, subsumee_2_id;
+	IdSetIterator subsumees_iterator_1, subsumees_iterator_2;
 	// object_property_chain = pop(&scheduled_object_property_chains);
 	object_property_chain = dequeue(&scheduled_object_property_chains);
 	while (object_property_chain != NULL) {
-		SET_ITERATOR_INIT(&subsumees_iterator_1, &(object_property_chain->description.object_property_chain.role1->subsumees));
-		subsumee_1 = (ObjectPropertyExpression*) SET_ITERATOR_NEXT(&subsumees_iterator_1);
-		while (subsumee_1) {
-			SET_ITERATOR_INIT(&subsumees_iterator_2, &(object_property_chain->description.object_property_chain.role2->subsumees));
-			subsumee_2 = (ObjectPropertyExpression*) SET_ITERATOR_NEXT(&subsumees_iterator_2);
-			while (subsumee_2) {
+		ID_SET_ITERATOR_INIT(&subsumees_iterator_1, &(object_property_chain->description.object_property_chain.role1->subsumees));
+		subsumee_1_id = ID_SET_ITERATOR_NEXT(&subsumees_iterator_1);
+		while (subsumee_1_id != ID_SET_ITERATOR_END) {
+			ID_SET_ITERATOR_INIT(&subsumees_iterator_2, &(object_property_chain->description.object_property_chain.role2->subsumees));
+			subsumee_2_id = ID_SET_ITERATOR_NEXT(&subsumees_iterator_2);
+			while (subsumee_2_id != ID_SET_ITERATOR_END) {
 					// new object property chain
 					ObjectPropertyExpression* new_composition = get_create_role_composition_binary(
-							(ObjectPropertyExpression*) subsumee_1,
-							(ObjectPropertyExpression*) subsumee_2,
+							GET_OBJECTPROPERTY_EXPRESSION(subsumee_1_id, kb->tbox),
+							GET_OBJECTPROPERTY_EXPRESSION(subsumee_2_id, kb->tbox),
 							kb->tbox);
 
 					add_to_role_subsumer_list(new_composition, object_property_chain);
 					index_role(new_composition);
-				subsumee_2 = (ObjectPropertyExpression*) SET_ITERATOR_NEXT(&subsumees_iterator_2);
+				subsumee_2_id = ID_SET_ITERATOR_NEXT(&subsumees_iterator_2);
 			}
-			subsumee_1 = (ObjectPropertyExpression*) SET_ITERATOR_NEXT(&subsumees_iterator_1);
+			subsumee_1_id = ID_SET_ITERATOR_NEXT(&subsumees_iterator_1);
 		}
 		// object_property_chain = pop(&scheduled_object_property_chains);
 		object_property_chain = dequeue(&scheduled_object_property_chains);
 	}
+	reset_queue(&scheduled_object_property_chains);
 
 	// remove the redundant subsumers of object property chains
-	Set subsumers_to_remove;
+	IdSet subsumers_to_remove;
 	MAP_ITERATOR_INIT(&map_iterator, &(kb->tbox->objectproperty_chains));
 	object_property_chain = (ObjectPropertyExpression*) MAP_ITERATOR_NEXT(&map_iterator);
 	while (object_property_chain) {
 		// printf("%s:%d\n", object_property_expression_to_string(kb, object_property_chain), object_property_chain->subsumers.element_count);
-		SET_INIT(&subsumers_to_remove, 16);
-		SetIterator subsumers_iterator_1;
-		SET_ITERATOR_INIT(&subsumers_iterator_1, &(object_property_chain->subsumers));
-		ObjectPropertyExpression* subsumer_1 = (ObjectPropertyExpression*) SET_ITERATOR_NEXT(&subsumers_iterator_1);
-		while (subsumer_1 && subsumer_1 != object_property_chain) {
-			if (subsumer_1 == object_property_chain) {
-				subsumer_1 = (ObjectPropertyExpression*) SET_ITERATOR_NEXT(&subsumers_iterator_1);
-				continue;
-			}
+		ID_SET_INIT(&subsumers_to_remove, 16);
+		IdSetIterator subsumers_iterator_1;
+		ID_SET_ITERATOR_INIT(&subsumers_iterator_1, &(object_property_chain->subsumers));
+		uint32_t subsumer_1_id = ID_SET_ITERATOR_NEXT(&subsumers_iterator_1);
+		while (subsumer_1_id != ID_SET_ITERATOR_END && subsumer_1_id != object_property_chain->id) {
+			ObjectPropertyExpression* subsumer_1 = GET_OBJECTPROPERTY_EXPRESSION(subsumer_1_id, kb->tbox);
 			// printf("%s:remove:", object_property_expression_to_string(kb, subsumer_1));
-			SetIterator subsumers_iterator_2;
-			SET_ITERATOR_INIT(&subsumers_iterator_2, &(object_property_chain->subsumers));
-			ObjectPropertyExpression* subsumer_2 = (ObjectPropertyExpression*) SET_ITERATOR_NEXT(&subsumers_iterator_2);
-			while (subsumer_2) {
-				if (subsumer_2 == object_property_chain || subsumer_1 == subsumer_2) {
-					subsumer_2 = (ObjectPropertyExpression*) SET_ITERATOR_NEXT(&subsumers_iterator_2);
+			IdSetIterator subsumers_iterator_2;
+			ID_SET_ITERATOR_INIT(&subsumers_iterator_2, &(object_property_chain->subsumers));
+			uint32_t subsumer_2_id = ID_SET_ITERATOR_NEXT(&subsumers_iterator_2);
+			while (subsumer_2_id != ID_SET_ITERATOR_END) {
+				if (subsumer_2_id == object_property_chain->id || subsumer_1_id == subsumer_2_id) {
+					subsumer_2_id = ID_SET_ITERATOR_NEXT(&subsumers_iterator_2);
 					continue;
 				}
-				if (SET_CONTAINS(subsumer_2, &(subsumer_1->subsumers))) {
-					// printf("%s:", object_property_expression_to_string(kb, subsumer_2));
-					SET_ADD(subsumer_2, &subsumers_to_remove);
+				if (ID_SET_CONTAINS(subsumer_2_id, &(subsumer_1->subsumers))) {
+					// printf("%s:", object_property_expression_to_string(kb, GET_OBJECTPROPERTY_EXPRESSION(subsumer_2_id, kb->tbox)));
+					ID_SET_ADD(subsumer_2_id, &subsumers_to_remove);
 				}
-				subsumer_2 = (ObjectPropertyExpression*) SET_ITERATOR_NEXT(&subsumers_iterator_2);
+				subsumer_2_id = ID_SET_ITERATOR_NEXT(&subsumers_iterator_2);
 			}
 			// printf("\n");
-			subsumer_1 = (ObjectPropertyExpression*) SET_ITERATOR_NEXT(&subsumers_iterator_1);
+			subsumer_1_id = ID_SET_ITERATOR_NEXT(&subsumers_iterator_1);
 		}
 
 		// now remove the elements of the set 'remove' from the subsumers of object_property_chain
-		SetIterator remove_iterator;
-		SET_ITERATOR_INIT(&remove_iterator, &subsumers_to_remove);
-		ObjectPropertyExpression* subsumer_to_remove = (ObjectPropertyExpression*) SET_ITERATOR_NEXT(&remove_iterator);
-		while (subsumer_to_remove) {
-			// list_remove(subsumer_to_remove, &(object_property_chain->subsumer_list));
-			// printf("removed %s from the subsumers of %s\n", object_property_expression_to_string(kb, subsumer_to_remove), object_property_expression_to_string(kb, object_property_chain));
-			subsumer_to_remove = (ObjectPropertyExpression*) SET_ITERATOR_NEXT(&remove_iterator);
+		IdSetIterator remove_iterator;
+		ID_SET_ITERATOR_INIT(&remove_iterator, &subsumers_to_remove);
+		uint32_t subsumer_to_remove_id = ID_SET_ITERATOR_NEXT(&remove_iterator);
+		while (subsumer_to_remove_id != ID_SET_ITERATOR_END) {
+			// list_remove(GET_OBJECTPROPERTY_EXPRESSION(subsumer_to_remove_id, kb->tbox), &(object_property_chain->subsumer_list));
+			subsumer_to_remove_id = ID_SET_ITERATOR_NEXT(&remove_iterator);
 		}
-		SET_RESET(&subsumers_to_remove);
+		ID_SET_RESET(&subsumers_to_remove);
 		object_property_chain = MAP_ITERATOR_NEXT(&map_iterator);
 	}
 }
@@ -30,11 +30,11 @@
  * 	is cancelled.
  * 	0: Otherwise
  */
-char saturate_tbox(KB* kb, ReasoningTask reasoning_task) {
+char saturate_tbox(KB* kb, ReasoningTask reasoning_task, char individuals_only) {
 	char saturation_result = 0;
 
 	saturate_roles(kb);
-	saturation_result = saturate_concepts(kb, reasoning_task);
+	saturation_result = saturate_concepts(kb, reasoning_task, individuals_only);
 
 	return saturation_result;
 }
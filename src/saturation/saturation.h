@@ -29,8 +29,10 @@
  * 	subsumer bottom. In this case it immediately returns, i.e., saturation process
  * 	is cancelled.
  * 	0: Otherwise
+ * If individuals_only is set, only the generated nominals and the expressions
+ * they reach are saturated, not every class.
  */
-char saturate_tbox(KB* kb, ReasoningTask reasoning_task);
+char saturate_tbox(KB* kb, ReasoningTask reasoning_task, char individuals_only);
 
 
 #endif /* SATURATION_H_ */
@@ -47,7 +47,7 @@ int add_predecessor(ClassExpression* c, ObjectPropertyExpression* r, ClassExpres
 			++c->predecessors[i].filler_count;
 			return 1;
 			 */
-			return SET_ADD(p, &(c->predecessors[i].fillers));
+			return ID_SET_ADD(p->id, &(c->predecessors[i].fillers));
 		}
 	// no, we do not already have a link for role r, create it, add p to its filler list
 	// 1) extend the list for links
@@ -62,8 +62,8 @@ int add_predecessor(ClassExpression* c, ObjectPropertyExpression* r, ClassExpres
 	c->predecessors[c->predecessor_r_count].fillers[0] = p;
 	c->predecessors[c->predecessor_r_count].filler_count = 1;
 	*/
-	SET_INIT(&(c->predecessors[c->predecessor_r_count].fillers), DEFAULT_PREDECESSORS_SET__SIZE);
-	SET_ADD(p, &(c->predecessors[c->predecessor_r_count].fillers));
+	ID_SET_INIT(&(c->predecessors[c->predecessor_r_count].fillers), DEFAULT_PREDECESSORS_SET__SIZE);
+	ID_SET_ADD(p->id, &(c->predecessors[c->predecessor_r_count].fillers));
 
 	// finally increment the r_count
 	++c->predecessor_r_count;
@@ -92,7 +92,7 @@ int add_successor(ClassExpression* c, ObjectPropertyExpression* r, ClassExpressi
 			++c->successors[i].filler_count;
 			return 1;
 			*/
-			return SET_ADD(p, &(c->successors[i].fillers));
+			return ID_SET_ADD(p->id, &(c->successors[i].fillers));
 		}
 	// no, we do not already have a link for role r, create it, add p to its filler list
 	// 1) extend the list for links
@@ -107,8 +107,8 @@ int add_successor(ClassExpression* c, ObjectPropertyExpression* r, ClassExpressi
 	c->successors[c->successor_r_count].fillers[0] = p;
 	c->successors[c->successor_r_count].filler_count = 1;
 	*/
-	SET_INIT(&(c->successors[c->successor_r_count].fillers), DEFAULT_SUCCESSORS_SET__SIZE);
-	SET_ADD(p, &(c->successors[c->successor_r_count].fillers));
+	ID_SET_INIT(&(c->successors[c->successor_r_count].fillers), DEFAULT_SUCCESSORS_SET__SIZE);
+	ID_SET_ADD(p->id, &(c->successors[c->successor_r_count].fillers));
 
 	// finally increment the r_count
 	++c->successor_r_count;
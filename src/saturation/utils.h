@@ -27,7 +27,7 @@
 
 // Check if c1 is subsumed by c2. Used both
 // for class and object property expressions.
-#define IS_SUBSUMED_BY(c1,c2)						SET_CONTAINS(c2, &(c1->subsumers))
+#define IS_SUBSUMED_BY(c1,c2)						ID_SET_CONTAINS((c2)->id, &((c1)->subsumers))
 
 // add r-predecessor p to c
 int add_predecessor(ClassExpression* c, ObjectPropertyExpression* r, ClassExpression* p, TBox* tbox);
@@ -0,0 +1,103 @@
+#!/bin/sh
+#
+# Builds the reasoner with every combination of the set and map backends
+# (configure --with-set, --with-map) and classifies the given ontologies with
+# each build. Prints the loading and classification times, the minimum of
+# RUNS runs, and checks that every build computes the same taxonomy.
+#
+# Usage: benchmark_backends.sh source_dir [ontology ...]
+# Without ontologies, the ones in src/test/ontologies are classified.
+#
+# Environment:
+#	SETS, MAPS		the backends to compare (default: all)
+#	RUNS			number of runs per ontology and build (default: 3)
+#	WORK_DIR		where the builds are kept (default: a temporary directory)
+#	CONFIGURE_FLAGS	further options for configure
+
+set -e
+
+if [ $# -lt 1 ]; then
+	echo "Usage: $0 source_dir [ontology ...]" >&2
+	exit 1
+fi
+
+SOURCE_DIR=$(cd "$1" && pwd)
+shift
+if [ $# -eq 0 ]; then
+	set -- "$SOURCE_DIR"/src/test/ontologies/*.owl
+fi
+
+SETS=${SETS:-"dynamic swiss bitset"}
+MAPS=${MAPS:-"chained flat"}
+RUNS=${RUNS:-3}
+WORK_DIR=${WORK_DIR:-$(mktemp -d "${TMPDIR:-/tmp}/elephant-backends.XXXXXX")}
+MAKE=${MAKE:-make}
+
+# builds outside the source tree need an unconfigured copy of it
+echo "Copying the sources to $WORK_DIR/source"
+rm -rf "$WORK_DIR/source"
+mkdir -p "$WORK_DIR"
+cp -R "$SOURCE_DIR" "$WORK_DIR/source"
+(
+	cd "$WORK_DIR/source"
+	if [ -f Makefile ]; then
+		$MAKE distclean >/dev/null 2>&1 || true
+	fi
+	if [ ! -x configure ]; then
+		autoreconf -fi >/dev/null
+	fi
+)
+
+for set_backend in $SETS; do
+	for map_backend in $MAPS; do
+		build="$WORK_DIR/build-$set_backend-$map_backend"
+		echo "Building with --with-set=$set_backend --with-map=$map_backend"
+		mkdir -p "$build"
+		(
+			cd "$build"
+			"$WORK_DIR/source/configure" --with-set="$set_backend" --with-map="$map_backend" $CONFIGURE_FLAGS >configure.log 2>&1
+			$MAKE >make.log 2>&1
+		) || { echo "build failed, see $build" >&2; exit 1; }
+	done
+done
+
+# the minimum of the given numbers
+minimum() {
+	echo "$@" | tr ' ' '\n' | sort -n | head -n 1
+}
+
+printf "\n%-40s %-8s %-8s %12s %12s  %s\n" "ontology" "set" "map" "loading ms" "reasoning ms" "taxonomy"
+for ontology in "$@"; do
+	name=$(basename "$ontology")
+	reference=""
+	for set_backend in $SETS; do
+		for map_backend in $MAPS; do
+			build="$WORK_DIR/build-$set_backend-$map_backend"
+			output="$build/$name.taxonomy"
+			loading_times=""
+			reasoning_times=""
+			run=0
+			while [ $run -lt "$RUNS" ]; do
+				"$build/src/elephant-reasoner" -i "$ontology" -o "$output" -r classification >"$build/$name.log" 2>&1 \
+					|| { echo "classification of $ontology failed, see $build/$name.log" >&2; exit 1; }
+				loading_times="$loading_times $(sed -n 's/^Loading KB[.]*: \([0-9.]*\) milisecs.*/\1/p' "$build/$name.log")"
+				reasoning_times="$reasoning_times $(sed -n 's/^Total time[.]*: \([0-9.]*\) milisecs.*/\1/p' "$build/$name.log")"
+				run=$((run + 1))
+			done
+
+			# the order of the output depends on the backend, compare sorted
+			sort "$output" >"$output.sorted"
+			if [ -z "$reference" ]; then
+				reference="$output.sorted"
+				status="reference"
+			elif cmp -s "$reference" "$output.sorted"; then
+				status="same"
+			else
+				status="DIFFERENT"
+			fi
+
+			printf "%-40s %-8s %-8s %12s %12s  %s\n" "$name" "$set_backend" "$map_backend" \
+				"$(minimum $loading_times)" "$(minimum $reasoning_times)" "$status"
+		done
+	done
+done
@@ -0,0 +1,108 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "../reasoner/reasoner.h"
+#include "../model/datatypes.h"
+
+/*
+ * Counts the calls to the allocation functions while loading and classifying
+ * an ontology:
+ * test_allocation_count ontology.owl
+ * The reasoner libraries are linked with --wrap for malloc, calloc, realloc and
+ * free (see Makefile.am), so only the allocations in the reasoner itself are
+ * counted, not the ones in the C library.
+ */
+
+typedef struct allocation_count AllocationCount;
+
+struct allocation_count {
+	unsigned long malloc_count;
+	unsigned long calloc_count;
+	unsigned long realloc_count;
+	unsigned long free_count;
+};
+
+static AllocationCount counts;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+void* __wrap_malloc(size_t size) {
+	++counts.malloc_count;
+	return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+	++counts.calloc_count;
+	return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+	++counts.realloc_count;
+	return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr) {
+	++counts.free_count;
+	__real_free(ptr);
+}
+
+// print the number of calls between start and stop
+static void print_counts(char* phase, AllocationCount* start, AllocationCount* stop) {
+	printf("%-12s malloc: %10lu calloc: %10lu realloc: %10lu free: %10lu\n", phase,
+			stop->malloc_count - start->malloc_count,
+			stop->calloc_count - start->calloc_count,
+			stop->realloc_count - start->realloc_count,
+			stop->free_count - start->free_count);
+}
+
+int main(int argc, char *argv[]) {
+	AllocationCount start = counts;
+	FILE* input_ontology;
+	KB* kb;
+
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s ontology\n", argv[0]);
+		return 1;
+	}
+	input_ontology = fopen(argv[1], "r");
+	assert(input_ontology != NULL);
+
+	AllocationCount loading, classification;
+
+	kb = init_kb(NULL);
+	read_kb(input_ontology, NULL, 1, 0, kb);
+	fclose(input_ontology);
+	loading = counts;
+	classify(kb);
+	classification = counts;
+
+	// the counts are printed after the timings of the reasoner
+	printf("\n");
+	print_counts("Loading", &start, &loading);
+	print_counts("Classifying", &loading, &classification);
+	print_counts("Total", &start, &classification);
+
+	return 0;
+}
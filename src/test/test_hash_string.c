@@ -17,22 +17,155 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include <assert.h>
 #include <inttypes.h>
+#include <sys/time.h>
 
 #include "../utils/map.h"
+#include "../utils/timer.h"
 #include "../hashing/utils.h"
 
+/*
+ * Without arguments, checks a lookup with HASH_STRING.
+ * With an ontology file, measures the throughput of the string hash functions
+ * on the full and abbreviated IRIs in it:
+ * test_hash_string ontology.owl [rounds]
+ */
+
+#define DEFAULT_ROUNDS	10
+
+static int is_name_char(int c) {
+	return isalnum(c) || c == '_' || c == '-' || c == '.' || c == ':' || c == '/' || c == '#';
+}
+
+// collect the full IRIs (between '<' and '>') and the abbreviated IRIs (names
+// containing a ':') in the given file
+static char** read_iris(char* file_name, uint32_t** lengths, int* count, size_t* total_length) {
+	FILE* input = fopen(file_name, "r");
+	char** iris = NULL;
+	char* buffer;
+	int c, size = 0, capacity = 0, is_iri;
+	size_t length, buffer_size = 1024;
+
+	assert(input != NULL);
+	buffer = malloc(buffer_size);
+	assert(buffer != NULL);
+	*lengths = NULL;
+	*total_length = 0;
+
+	c = getc(input);
+	while (c != EOF) {
+		length = 0;
+		if (c == '<') {
+			is_iri = 1;
+			while (c != EOF && c != '>') {
+				if (length + 2 >= buffer_size) {
+					buffer_size *= 2;
+					buffer = realloc(buffer, buffer_size);
+					assert(buffer != NULL);
+				}
+				buffer[length++] = c;
+				c = getc(input);
+			}
+			buffer[length++] = '>';
+			c = getc(input);
+		} else if (is_name_char(c)) {
+			is_iri = 0;
+			while (c != EOF && is_name_char(c)) {
+				if (length + 2 >= buffer_size) {
+					buffer_size *= 2;
+					buffer = realloc(buffer, buffer_size);
+					assert(buffer != NULL);
+				}
+				is_iri |= (c == ':');
+				buffer[length++] = c;
+				c = getc(input);
+			}
+		} else {
+			// skip quoted strings, they are not IRIs
+			if (c == '"')
+				while ((c = getc(input)) != EOF && c != '"')
+					if (c == '\\')
+						c = getc(input);
+			c = getc(input);
+			continue;
+		}
+		if (!is_iri)
+			continue;
+		buffer[length] = '\0';
+
+		if (size == capacity) {
+			capacity = capacity == 0 ? 1024 : 2 * capacity;
+			iris = realloc(iris, capacity * sizeof(char*));
+			*lengths = realloc(*lengths, capacity * sizeof(uint32_t));
+			assert(iris != NULL && *lengths != NULL);
+		}
+		iris[size] = strdup(buffer);
+		(*lengths)[size++] = length;
+		*total_length += length;
+	}
+	fclose(input);
+	free(buffer);
+
+	*count = size;
+	return iris;
+}
+
 int main(int argc, char *argv[]) {
-	Map map;
-	MAP_INIT(&map, 16);
-	MAP_PUT(HASH_STRING("<http://sadi-ontology.semanticscience.org#D054872>"), "D054872", &map);
+	struct timeval start_time, stop_time;
+	char** iris;
+	uint32_t* lengths;
+	int i, round, rounds, iri_count;
+	size_t total_length;
+	double time;
+	// keeps the compiler from removing the hash computations
+	uint64_t checksum;
+
+	if (argc < 2) {
+		Map map;
+		MAP_INIT(&map, 16);
+		MAP_PUT(HASH_STRING("<http://sadi-ontology.semanticscience.org#D054872>"), "D054872", &map);
+
+		char* value = (char*) MAP_GET(HASH_STRING("<http://sadi-ontology.semanticscience.org#D054872>"), &map);
+		printf("%s\n", value == NULL ? "not found" : value);
+		value = (char*) MAP_GET(HASH_STRING("<http://sadi-ontology.semanticscience.org#D054809>"), &map);
+		printf("%s\n", value == NULL ? "not found" : value);
+		printf("%" PRIu64 "\n%" PRIu64 "\n", HASH_STRING("<http://sadi-ontology.semanticscience.org#D054872>"),
+				HASH_STRING("<http://sadi-ontology.semanticscience.org#D054809>"));
+
+		return 0;
+	}
 
-	printf("%s\n", (char*) MAP_GET(HASH_STRING("<http://sadi-ontology.semanticscience.org#D054872>"), &map));
-	printf("%s\n", (char*) MAP_GET(HASH_STRING("<http://sadi-ontology.semanticscience.org#D054809>"), &map));
-	printf("%" PRIu64 "\n%" PRIu64 "\n", HASH_STRING("<http://sadi-ontology.semanticscience.org#D054872>"),
-			HASH_STRING("<http://sadi-ontology.semanticscience.org#D054809>"));
+	rounds = argc > 2 ? atoi(argv[2]) : DEFAULT_ROUNDS;
+	iris = read_iris(argv[1], &lengths, &iri_count, &total_length);
+	printf("%d IRIs, average length %.1f bytes, %d rounds\n", iri_count, iri_count == 0 ? 0.0 : (double) total_length / iri_count, rounds);
+
+	// the hash functions are wrapped in the same loop for comparison
+#define BENCHMARK(name, hash) \
+	checksum = 0; \
+	printf("%-36s: ", name); \
+	fflush(stdout); \
+	START_TIMER(start_time); \
+	for (round = 0; round < rounds; ++round) \
+		for (i = 0; i < iri_count; ++i) \
+			checksum += (hash); \
+	STOP_TIMER(stop_time); \
+	time = TIME_DIFF(start_time, stop_time); \
+	printf("%8.3f milisecs %8.1f MB/s %6.1f ns/IRI (%016" PRIx64 ")\n", time / 1000, \
+			(double) total_length * rounds / time, time * 1000 / ((double) iri_count * rounds), checksum);
+
+	BENCHMARK("Murmur3 x64 128 with strlen", MurmurHash3_x64_128(iris[i], strlen(iris[i]), 42));
+	BENCHMARK("Murmur3 x64 128 with length", MurmurHash3_x64_128(iris[i], lengths[i], 42));
+	BENCHMARK("HASH_STRING (wyhash with strlen)", HASH_STRING(iris[i]));
+	BENCHMARK("HASH_STRING_LENGTH (wyhash)", HASH_STRING_LENGTH(iris[i], lengths[i]));
+
+	for (i = 0; i < iri_count; ++i)
+		free(iris[i]);
+	free(iris);
+	free(lengths);
 
 	return 0;
 }
-
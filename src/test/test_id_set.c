@@ -0,0 +1,73 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+
+#include "../utils/id_set.h"
+
+int main(int argc, char *argv[]) {
+
+	IdSet* set = ID_SET_CREATE(20);
+
+	uint32_t i;
+	// 0 is a valid id, it is the id of owl:Thing
+	for (i = 0; i < 100; ++i)
+		ID_SET_ADD(i * 7, set);
+
+	ID_SET_REMOVE(0, set);
+	ID_SET_REMOVE(70, set);
+	ID_SET_REMOVE(693, set);
+
+	for (i = 0; i < 100; ++i)
+		if (!ID_SET_CONTAINS(i * 7, set))
+			printf("%u: not found!\n", i * 7);
+	printf("%u elements, table size %u\n", set->element_count, set->size);
+
+	// remove the odd ids while iterating
+	IdSetIterator it;
+	ID_SET_ITERATOR_INIT(&it, set);
+	uint32_t e = ID_SET_ITERATOR_NEXT(&it);
+	uint32_t count = 0;
+	while (e != ID_SET_ITERATOR_END) {
+		++count;
+		if (e % 2 == 1)
+			ID_SET_REMOVE(e, set);
+		e = ID_SET_ITERATOR_NEXT(&it);
+	}
+	printf("iterated %u elements, %u left\n", count, set->element_count);
+	for (i = 0; i < 100; ++i)
+		if (ID_SET_CONTAINS(i * 7, set) != (i != 0 && i != 10 && i != 99 && (i * 7) % 2 == 0))
+			printf("%u: wrong!\n", i * 7);
+
+	printf("shrink freed %d bytes\n", ID_SET_SHRINK(set));
+	ID_SET_FREE(set);
+
+	// a small set keeps its elements inline until the fifth one is added
+	IdSet small_set;
+	ID_SET_INIT(&small_set, 4);
+	for (i = 0; i < 5; ++i) {
+		ID_SET_ADD(i, &small_set);
+		printf("small set: %u elements, table size %u\n", small_set.element_count, small_set.size);
+	}
+	ID_SET_RESET(&small_set);
+
+	return 1;
+}
@@ -53,6 +53,31 @@ int main(int argc, char *argv[]) {
 	}
 	SET_ITERATOR_FREE(it);
 
+	// a small set keeps its elements inline until the fifth one is added
+	Set small_set;
+	SET_INIT(&small_set, 4);
+	for (i = 0; i < 5; ++i) {
+		SET_ADD(tmp[i], &small_set);
+		printf("small set: %d elements, table size %d\n", small_set.element_count, small_set.size);
+	}
+	SET_RESET(&small_set);
+
+	// removing the current element while iterating inline elements
+	SET_INIT(&small_set, 4);
+	for (i = 0; i < 4; ++i)
+		SET_ADD(tmp[i], &small_set);
+	SetIterator small_it;
+	SET_ITERATOR_INIT(&small_it, &small_set);
+	e = SET_ITERATOR_NEXT(&small_it);
+	while (e != NULL) {
+		if (e == tmp[1] || e == tmp[3])
+			SET_REMOVE(e, &small_set);
+		e = SET_ITERATOR_NEXT(&small_it);
+	}
+	for (i = 0; i < 4; ++i)
+		printf("small set %d: %s\n", i, SET_CONTAINS(tmp[i], &small_set) ? "found!" : "not found!");
+	SET_RESET(&small_set);
+
 	return 1;
 }
 
@@ -0,0 +1,128 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <sys/time.h>
+
+#include "../utils/set.h"
+#include "../utils/timer.h"
+
+/**
+ * Delete-heavy benchmark for sets. The set is filled with test_size elements,
+ * then in each round half of the elements are removed and added again. This is
+ * the access pattern of the direct subsumer sets in concept hierarchy computation.
+ * Afterwards the set is shrunk, and contains and iteration are timed again.
+ */
+int main(int argc, char *argv[]) {
+	struct timeval start_time, stop_time;
+	int i, j;
+
+	if (argc != 3) {
+		fprintf(stderr, "usage: %s <test size> <round count>\n", argv[0]);
+		return 1;
+	}
+	int test_size = atoi(argv[1]);
+	int round_count = atoi(argv[2]);
+
+	void** tmp = malloc(test_size * sizeof(void*));
+	assert(tmp != NULL);
+	for (i = 0; i < test_size; ++i) {
+		tmp[i] = malloc(sizeof(void*));
+		assert(tmp[i] != NULL);
+	}
+
+	Set set;
+	SET_INIT(&set, 8);
+	printf("%d add operations .........................: ", test_size);
+	fflush(stdout);
+	START_TIMER(start_time);
+	for (i = 0; i < test_size; ++i)
+		SET_ADD(tmp[i], &set);
+	STOP_TIMER(stop_time);
+	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
+
+	printf("%d rounds of remove/add operations ........: ", round_count);
+	fflush(stdout);
+	START_TIMER(start_time);
+	for (j = 0; j < round_count; ++j) {
+		for (i = j % 2; i < test_size; i += 2)
+			SET_REMOVE(tmp[i], &set);
+		for (i = j % 2; i < test_size; i += 2)
+			SET_ADD(tmp[i], &set);
+	}
+	STOP_TIMER(stop_time);
+	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
+
+	printf("Removing while iterating ..................: ");
+	fflush(stdout);
+	START_TIMER(start_time);
+	SetIterator it;
+	SET_ITERATOR_INIT(&it, &set);
+	void* e = SET_ITERATOR_NEXT(&it);
+	i = 0;
+	while (e != NULL) {
+		// keep every 16th element
+		if (i++ % 16 != 0)
+			SET_REMOVE(e, &set);
+		e = SET_ITERATOR_NEXT(&it);
+	}
+	STOP_TIMER(stop_time);
+	printf("%.3f milisecs, %d elements visited, %d left\n", TIME_DIFF(start_time, stop_time) / 1000, i, set.element_count);
+
+	int size_before_shrink = set.size;
+	printf("Contains before shrinking .................: ");
+	fflush(stdout);
+	START_TIMER(start_time);
+	for (j = 0, e = NULL; j < round_count; ++j)
+		for (i = 0; i < test_size; ++i)
+			if (SET_CONTAINS(tmp[i], &set))
+				e = tmp[i];
+	STOP_TIMER(stop_time);
+	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
+
+	int freed_bytes = SET_SHRINK(&set);
+	printf("Shrinking .................................: size %d -> %d, %d bytes freed\n", size_before_shrink, set.size, freed_bytes);
+
+	printf("Contains after shrinking ..................: ");
+	fflush(stdout);
+	START_TIMER(start_time);
+	int found = 0;
+	for (j = 0; j < round_count; ++j)
+		for (i = 0; i < test_size; ++i)
+			found += SET_CONTAINS(tmp[i], &set);
+	STOP_TIMER(stop_time);
+	printf("%.3f milisecs\n", TIME_DIFF(start_time, stop_time) / 1000);
+
+	printf("Iterating .................................: ");
+	fflush(stdout);
+	START_TIMER(start_time);
+	SET_ITERATOR_INIT(&it, &set);
+	i = 0;
+	while (SET_ITERATOR_NEXT(&it) != NULL)
+		++i;
+	STOP_TIMER(stop_time);
+	printf("done in %.3f milisecs, %d elements (%d found by contains)\n", TIME_DIFF(start_time, stop_time) / 1000, i, found / round_count);
+
+	SET_RESET(&set);
+	for (i = 0; i < test_size; ++i)
+		free(tmp[i]);
+	free(tmp);
+
+	return 0;
+}
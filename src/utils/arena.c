@@ -0,0 +1,76 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+
+#include "arena.h"
+
+extern inline void* arena_allocate(Arena* arena, size_t size);
+
+void arena_init(Arena* arena, size_t block_size) {
+	arena->blocks = NULL;
+	arena->block_count = 0;
+	arena->block_size = (block_size == 0) ? ARENA_DEFAULT_BLOCK_SIZE : block_size;
+	arena->free_space = NULL;
+	arena->free_bytes = 0;
+	arena->used_bytes = 0;
+	arena->arena_bytes = 0;
+}
+
+void* arena_allocate_block(Arena* arena, size_t size) {
+	char** tmp;
+	char* block;
+	// an object that does not fit in a regular block gets its own one,
+	// the current block stays in use then.
+	size_t block_size = (size > arena->block_size) ? size : arena->block_size;
+
+	tmp = realloc(arena->blocks, (arena->block_count + 1) * sizeof(char*));
+	assert(tmp != NULL);
+	arena->blocks = tmp;
+	block = (char*) malloc(block_size);
+	assert(block != NULL);
+	arena->blocks[arena->block_count++] = block;
+	arena->arena_bytes += block_size;
+	arena->used_bytes += size;
+
+	if (block_size == arena->block_size) {
+		arena->free_space = block + size;
+		arena->free_bytes = block_size - size;
+	}
+
+	return block;
+}
+
+int arena_reset(Arena* arena) {
+	int freed_bytes = arena->arena_bytes + arena->block_count * sizeof(char*);
+	uint32_t i;
+
+	for (i = 0; i < arena->block_count; ++i)
+		free(arena->blocks[i]);
+	free(arena->blocks);
+
+	arena->blocks = NULL;
+	arena->block_count = 0;
+	arena->free_space = NULL;
+	arena->free_bytes = 0;
+	arena->used_bytes = 0;
+	arena->arena_bytes = 0;
+
+	return freed_bytes;
+}
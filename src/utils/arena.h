@@ -0,0 +1,93 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * A region allocator. Objects are placed one after the other in large blocks,
+ * allocating is only a pointer bump. The objects cannot be freed individually,
+ * all of them are freed at once by arena_reset.
+ */
+
+typedef struct arena Arena;
+
+/**
+ * Size of a block if not given in arena_init. Larger objects get a block
+ * of their own.
+ */
+#define ARENA_DEFAULT_BLOCK_SIZE	(1 << 20)
+
+/**
+ * Every object is aligned to this many bytes.
+ */
+#define ARENA_ALIGNMENT				8
+
+struct arena {
+	char** blocks;
+	uint32_t block_count;
+	size_t block_size;			// size of a regular block
+	char* free_space;			// start of the free space in the current block
+	size_t free_bytes;			// number of free bytes in the current block
+
+	size_t used_bytes;			// total size of the allocated objects
+	size_t arena_bytes;			// total size of the blocks
+};
+
+/**
+ * Initialize an arena with blocks of the given size. Nothing is allocated
+ * before the first object.
+ */
+void arena_init(Arena* arena, size_t block_size);
+
+/**
+ * Allocate an object of the given size in a new block. Called by arena_allocate
+ * if the current block is full.
+ */
+void* arena_allocate_block(Arena* arena, size_t size);
+
+/**
+ * Allocate space for an object of the given size. The space is not initialized.
+ */
+inline void* arena_allocate(Arena* arena, size_t size) {
+	void* object;
+
+	size = (size + ARENA_ALIGNMENT - 1) & ~((size_t) ARENA_ALIGNMENT - 1);
+	if (size > arena->free_bytes)
+		return arena_allocate_block(arena, size);
+
+	object = arena->free_space;
+	arena->free_space += size;
+	arena->free_bytes -= size;
+	arena->used_bytes += size;
+
+	return object;
+}
+
+/**
+ * Free all blocks of the given arena, the objects in it become invalid.
+ * The arena can be used again afterwards. The space for the arena itself
+ * is not freed.
+ * Returns the number of freed bytes.
+ */
+int arena_reset(Arena* arena);
+
+#endif /* ARENA_H_ */
@@ -0,0 +1,426 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <unistd.h>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "compressed_file.h"
+
+#define NO_COMPRESSION		0
+#define GZIP				1
+#define ZSTD				2
+
+// size of the buffers of the threads
+#define BUFFER_SIZE			(1 << 15)
+
+struct compressed_file {
+	// for the messages
+	char* name;
+	// the file that is read or written by the caller
+	FILE* file;
+	char compression;
+	char writing;
+	// set if the compressed data cannot be read or written
+	char failed;
+	// the compressed file, a gzFile or a FILE*
+	void* compressed;
+	// the end of the pipe, or the temporary file, on the side of the thread
+	int fd;
+#ifdef HAVE_PTHREAD_H
+	pthread_t thread;
+#endif
+};
+
+// the names of the compression methods for the messages
+static char* compression_names[] = {"", "gzip", "zstd"};
+
+static char write_all(int fd, char* buffer, size_t size) {
+	ssize_t written;
+
+	while (size > 0) {
+		written = write(fd, buffer, size);
+		if (written < 0) {
+			if (errno == EINTR)
+				continue;
+			return 0;
+		}
+		buffer += written;
+		size -= written;
+	}
+
+	return 1;
+}
+
+static ssize_t read_some(int fd, char* buffer, size_t size) {
+	ssize_t length;
+
+	do
+		length = read(fd, buffer, size);
+	while (length < 0 && errno == EINTR);
+
+	return length;
+}
+
+/******************************************************************************
+ * gzip
+ *****************************************************************************/
+#ifdef HAVE_ZLIB
+// returns the reason the input cannot be read, NULL if it has been read
+static const char* gzip_decompress(gzFile in, int fd, char* buffer) {
+	const char* message;
+	int length, error;
+
+	while ((length = gzread(in, buffer, BUFFER_SIZE)) > 0)
+		if (!write_all(fd, buffer, length))
+			return strerror(errno);
+	// a truncated input ends with an error as well. the message starts with
+	// the descriptor, "<fd:3>: ".
+	message = gzerror(in, &error);
+	if (error == Z_OK)
+		return NULL;
+
+	return (strstr(message, ": ") != NULL) ? strstr(message, ": ") + 2 : message;
+}
+
+static char gzip_compress(int fd, gzFile out, char* buffer) {
+	ssize_t length;
+
+	while ((length = read_some(fd, buffer, BUFFER_SIZE)) > 0)
+		if (gzwrite(out, buffer, length) != length)
+			return 0;
+
+	return length == 0;
+}
+#endif
+
+/******************************************************************************
+ * zstd
+ *****************************************************************************/
+#ifdef HAVE_ZSTD
+// the contexts take several MB, they are only kept while the data is
+// transferred. returns the reason the input cannot be read, NULL if it has
+// been read.
+static const char* zstd_decompress(FILE* in, int fd, char* buffer, char* in_buffer) {
+	ZSTD_DStream* stream;
+	ZSTD_inBuffer input;
+	ZSTD_outBuffer output;
+	size_t length, result = 0;
+	const char* error = NULL;
+
+	stream = ZSTD_createDStream();
+	assert(stream != NULL);
+	ZSTD_initDStream(stream);
+	while (error == NULL && (length = fread(in_buffer, 1, BUFFER_SIZE, in)) > 0) {
+		input.src = in_buffer;
+		input.size = length;
+		input.pos = 0;
+		// go on while there is input, or the output buffer has been filled
+		// and there may be more in the stream
+		do {
+			output.dst = buffer;
+			output.size = BUFFER_SIZE;
+			output.pos = 0;
+			result = ZSTD_decompressStream(stream, &output, &input);
+			if (ZSTD_isError(result))
+				error = ZSTD_getErrorName(result);
+			else if (!write_all(fd, buffer, output.pos))
+				error = strerror(errno);
+		} while (error == NULL && (input.pos < input.size || output.pos == output.size));
+	}
+	ZSTD_freeDStream(stream);
+
+	if (error == NULL && ferror(in))
+		error = strerror(errno);
+	// the last frame is complete if result is 0
+	if (error == NULL && result != 0)
+		error = "unexpected end of file";
+
+	return error;
+}
+
+static char zstd_compress(int fd, FILE* out, char* buffer, char* out_buffer) {
+	ZSTD_CCtx* context;
+	ZSTD_inBuffer input;
+	ZSTD_outBuffer output;
+	ZSTD_EndDirective mode;
+	size_t remaining;
+	ssize_t length;
+	char ok = 1;
+
+	context = ZSTD_createCCtx();
+	assert(context != NULL);
+	do {
+		length = read_some(fd, buffer, BUFFER_SIZE);
+		if (length < 0) {
+			ok = 0;
+			break;
+		}
+		// the frame is ended at the end of the input
+		mode = (length == 0) ? ZSTD_e_end : ZSTD_e_continue;
+		input.src = buffer;
+		input.size = length;
+		input.pos = 0;
+		do {
+			output.dst = out_buffer;
+			output.size = BUFFER_SIZE;
+			output.pos = 0;
+			remaining = ZSTD_compressStream2(context, &output, &input, mode);
+			if (ZSTD_isError(remaining) || fwrite(out_buffer, 1, output.pos, out) != output.pos)
+				ok = 0;
+		} while (ok && (mode == ZSTD_e_end ? remaining != 0 : input.pos < input.size));
+	} while (ok && length > 0);
+	ZSTD_freeCCtx(context);
+
+	return ok;
+}
+#endif
+
+/******************************************************************************
+ * the transfer between the compressed file and fd
+ *****************************************************************************/
+// a corrupt or truncated input is reported here, before the caller reads
+// the end of the input and takes it for a syntax error
+static void* transfer(void* arg) {
+	CompressedFile* file = (CompressedFile*) arg;
+	char* buffer = (char*) malloc(2 * BUFFER_SIZE);
+	const char* error = NULL;
+	char ok = 0;
+
+	assert(buffer != NULL);
+	switch (file->compression) {
+#ifdef HAVE_ZLIB
+	case GZIP:
+		if (file->writing)
+			ok = gzip_compress(file->fd, (gzFile) file->compressed, buffer);
+		else
+			ok = (error = gzip_decompress((gzFile) file->compressed, file->fd, buffer)) == NULL;
+		break;
+#endif
+#ifdef HAVE_ZSTD
+	case ZSTD:
+		if (file->writing)
+			ok = zstd_compress(file->fd, (FILE*) file->compressed, buffer, buffer + BUFFER_SIZE);
+		else
+			ok = (error = zstd_decompress((FILE*) file->compressed, file->fd, buffer, buffer + BUFFER_SIZE)) == NULL;
+		break;
+#endif
+	}
+	if (error != NULL)
+		fprintf(stderr, "%s: the %s input is corrupt: %s\n", file->name, compression_names[(int) file->compression], error);
+	// the caller must not block on a full pipe if the output cannot be written
+	if (!ok && file->writing)
+		while (read_some(file->fd, buffer, BUFFER_SIZE) > 0)
+			;
+	free(buffer);
+	file->failed = !ok;
+
+	return NULL;
+}
+
+#ifdef HAVE_PTHREAD_H
+static void* transfer_thread(void* arg) {
+	CompressedFile* file = (CompressedFile*) arg;
+
+	transfer(file);
+	// the caller reads up to here
+	if (!file->writing)
+		close(file->fd);
+
+	return NULL;
+}
+#endif
+
+// returns the compression of the given input, NO_COMPRESSION if it is not known.
+// the input is rewound. inputs that cannot be rewound, like pipes, are taken
+// as they are.
+static char input_compression(FILE* input) {
+	unsigned char magic[4];
+	size_t length;
+
+	if (fseek(input, 0, SEEK_CUR) != 0)
+		return NO_COMPRESSION;
+	length = fread(magic, 1, sizeof(magic), input);
+	rewind(input);
+	if (length >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+		return GZIP;
+	if (length == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd)
+		return ZSTD;
+
+	return NO_COMPRESSION;
+}
+
+static char has_extension(char* file_name, char* extension) {
+	size_t length = strlen(file_name), extension_length = strlen(extension);
+
+	return length > extension_length && strcmp(file_name + length - extension_length, extension) == 0;
+}
+
+// opens the compressed side of the given file, returns 0 if it cannot be opened
+static char open_compressed(CompressedFile* file, char* file_name, FILE* plain) {
+	switch (file->compression) {
+#ifdef HAVE_ZLIB
+	case GZIP:
+		// zlib reads from its own descriptor, the FILE* may have read ahead
+		lseek(fileno(plain), 0, SEEK_SET);
+		file->compressed = gzdopen(dup(fileno(plain)), file->writing ? "wb" : "rb");
+		fclose(plain);
+		return file->compressed != NULL;
+#endif
+#ifdef HAVE_ZSTD
+	case ZSTD:
+		file->compressed = plain;
+		return 1;
+#endif
+	}
+	fprintf(stderr, "%s: %s is not supported by this build\n", file_name, compression_names[(int) file->compression]);
+	fclose(plain);
+
+	return 0;
+}
+
+static char close_compressed(CompressedFile* file) {
+	switch (file->compression) {
+#ifdef HAVE_ZLIB
+	case GZIP:
+		return gzclose((gzFile) file->compressed) == Z_OK;
+#endif
+#ifdef HAVE_ZSTD
+	case ZSTD:
+		return fclose((FILE*) file->compressed) == 0;
+#endif
+	}
+
+	return 0;
+}
+
+CompressedFile* compressed_file_open(char* file_name, char* mode) {
+	CompressedFile* file;
+	FILE* plain;
+	char writing = (mode[0] == 'w');
+
+	plain = fopen(file_name, writing ? "wb" : "rb");
+	if (plain == NULL) {
+		fprintf(stderr, "%s: %s\n", file_name, strerror(errno));
+		return NULL;
+	}
+
+	file = (CompressedFile*) calloc(1, sizeof(CompressedFile));
+	assert(file != NULL);
+	file->name = strdup(file_name);
+	assert(file->name != NULL);
+	file->writing = writing;
+	if (writing)
+		file->compression = has_extension(file_name, ".gz") ? GZIP : (has_extension(file_name, ".zst") ? ZSTD : NO_COMPRESSION);
+	else
+		file->compression = input_compression(plain);
+
+	if (file->compression == NO_COMPRESSION) {
+		file->file = plain;
+		return file;
+	}
+	if (!open_compressed(file, file_name, plain)) {
+		free(file->name);
+		free(file);
+		return NULL;
+	}
+
+#ifdef HAVE_PTHREAD_H
+	int fds[2];
+	int error;
+
+	// the thread reads from or writes to the other end
+	error = pipe(fds);
+	assert(error == 0);
+	file->file = fdopen(fds[writing ? 1 : 0], writing ? "w" : "r");
+	assert(file->file != NULL);
+	file->fd = fds[writing ? 0 : 1];
+	error = pthread_create(&(file->thread), NULL, transfer_thread, file);
+	assert(error == 0);
+	(void) error;
+#else
+	file->file = tmpfile();
+	assert(file->file != NULL);
+	file->fd = fileno(file->file);
+	if (!writing) {
+		// nothing is buffered in the FILE* yet
+		transfer(file);
+		lseek(file->fd, 0, SEEK_SET);
+	}
+#endif
+
+	return file;
+}
+
+FILE* compressed_file_stream(CompressedFile* file) {
+	return file->file;
+}
+
+int compressed_file_close(CompressedFile* file) {
+	char buffer[4096];
+	char ok = 1;
+
+	if (file->compression == NO_COMPRESSION) {
+		ok = (fclose(file->file) == 0);
+		free(file->name);
+		free(file);
+		return ok ? 0 : -1;
+	}
+
+#ifdef HAVE_PTHREAD_H
+	if (!file->writing)
+		// the thread may still be writing into the pipe
+		while (fread(buffer, 1, sizeof(buffer), file->file) > 0)
+			;
+	// the thread gets the end of the output
+	if (fclose(file->file) != 0)
+		ok = 0;
+	pthread_join(file->thread, NULL);
+	if (file->writing)
+		close(file->fd);
+#else
+	(void) buffer;
+	if (file->writing) {
+		if (fflush(file->file) != 0)
+			ok = 0;
+		lseek(file->fd, 0, SEEK_SET);
+		transfer(file);
+	}
+	fclose(file->file);
+#endif
+	if (!close_compressed(file) || file->failed)
+		ok = 0;
+	free(file->name);
+	free(file);
+
+	return ok ? 0 : -1;
+}
@@ -0,0 +1,64 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPRESSED_FILE_H_
+#define COMPRESSED_FILE_H_
+
+#include <stdio.h>
+
+/**
+ * Files that are read or written through a compressor. An input compressed
+ * with gzip or zstd is recognized by its magic bytes, an output by the
+ * extension ".gz" or ".zst" of its name. Other files are read and written
+ * as they are, and so are inputs that cannot be rewound, like pipes.
+ *
+ * The caller reads from or writes to an ordinary FILE*. For a compressed
+ * file, it is one end of a pipe, a thread decompresses the input into the
+ * pipe or compresses what is written into it. Nothing is stored on disk
+ * uncompressed. Without threads, the data goes through a temporary file
+ * instead, which is decompressed when the file is opened or compressed
+ * when it is closed.
+ *
+ * A pipe cannot be rewound, i.e., with threads compressed inputs are not
+ * pre-scanned and they are read into memory instead of being mapped.
+ */
+typedef struct compressed_file CompressedFile;
+
+/**
+ * Open the file with the given name for reading with mode "r", or for
+ * writing with mode "w".
+ * Returns the file opened, NULL if it cannot be opened or it is compressed
+ * with a method this build does not support. The reason is printed.
+ */
+CompressedFile* compressed_file_open(char* file_name, char* mode);
+
+/**
+ * Returns the FILE* the caller reads from or writes to.
+ */
+FILE* compressed_file_stream(CompressedFile* file);
+
+/**
+ * Close the given file and free it. The rest of the input is discarded,
+ * the output is flushed and compressed.
+ * Returns 0 on success, -1 if the compressed data is corrupt or cannot be
+ * written. A corrupt or truncated input has been reported when it was read,
+ * before the end of the input the caller reads.
+ */
+int compressed_file_close(CompressedFile* file);
+
+#endif /* COMPRESSED_FILE_H_ */
@@ -0,0 +1,128 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * A set of 32-bit ids. Same interface as Set, but stores the ids of the
+ * class and object property expressions instead of pointers to them.
+ * The objects are looked up by id in the TBox.
+ */
+
+#ifndef ID_SET_H_
+#define ID_SET_H_
+
+#include "../hashing/hash_stats.h"
+#include "set.h"
+
+// the backend is selected with SET_BACKEND, see set.h
+#if SET_BACKEND == SET_BACKEND_SWISS
+#include "../hashing/swiss_id_hash_table.h"
+typedef SwissIdHashTable IdSet;
+typedef SwissIdHashTableIterator IdSetIterator;
+#define ID_SET_IMPL(function)		swiss_id_hash_table_##function
+#elif SET_BACKEND == SET_BACKEND_BITSET
+#include "../hashing/id_bitset.h"
+typedef IdBitset IdSet;
+typedef IdBitsetIterator IdSetIterator;
+#define ID_SET_IMPL(function)		id_bitset_##function
+#else
+#include "../hashing/dynamic_id_hash_table.h"
+typedef DynamicIdHashTable IdSet;
+typedef DynamicIdHashTableIterator IdSetIterator;
+#define ID_SET_IMPL(function)		dynamic_id_hash_table_##function
+#endif
+
+/**
+ * Returned by ID_SET_ITERATOR_NEXT when there are no more ids.
+ * The same in all backends.
+ */
+#define ID_SET_ITERATOR_END			UINT32_MAX
+
+/**
+ * Create an id set with an underlying hash table of the given size.
+ * Returns the set created
+ */
+#define ID_SET_CREATE(size)			ID_SET_IMPL(create)(size)
+
+/**
+ * Initialize an id set with an underlying hash table of the given size.
+ */
+#define ID_SET_INIT(set, size)		ID_SET_IMPL(init)(set, size)
+
+/**
+ * Adds the id e to the set s.
+ * Returns 1 if e is successfully added, 0 if it already exists.
+ */
+#define ID_SET_ADD(e, s)			ID_SET_IMPL(insert)(e, s)
+
+/**
+ * Removes the id e if it is present. While iterating, only the id
+ * that has just been returned by the iterator can be removed.
+ * Returns 1 if e is removed, 0 otherwise.
+ */
+#define ID_SET_REMOVE(e, s)			ID_SET_IMPL(remove)(e, s)
+
+/**
+ * Checks if a given id exists.
+ * Returns 1 if this is the case, 0 otherwise.
+ */
+#define ID_SET_CONTAINS(e, s)		ID_SET_IMPL(contains)(e, s)
+
+/**
+ * Shrink the space allocated for the ids of the set.
+ * Iterators of the set become invalid.
+ * Returns the number of freed bytes.
+ */
+#define ID_SET_SHRINK(s)			ID_SET_IMPL(shrink)(s)
+
+/**
+ * Free the space allocated for the ids of the given set
+ * and the set itself.
+ * Returns the number of freed bytes.
+ */
+#define ID_SET_FREE(s)				ID_SET_IMPL(free)(s)
+
+/**
+ * Free the space allocated for the ids of the given set.
+ * The space for the set itself is not freed.
+ * Returns the number of freed bytes.
+ */
+#define ID_SET_RESET(s)				ID_SET_IMPL(reset)(s)
+
+/**
+ * Returns the number of bytes allocated for the ids of the given set.
+ */
+#define ID_SET_MEMORY(s)			ID_SET_IMPL(memory)(s)
+
+/**
+ * Add the load factor and the probe lengths of the set to the
+ * given HashStats.
+ */
+#define ID_SET_COLLECT_STATS(s, stats)	ID_SET_IMPL(collect_stats)(s, stats)
+
+/**
+ * Initialize an iterator for the ids of the set.
+ */
+#define ID_SET_ITERATOR_INIT(it, s)	ID_SET_IMPL(iterator_init)(it, s)
+
+/**
+ * Get the next id in the set, ID_SET_ITERATOR_END if there is none.
+ */
+#define ID_SET_ITERATOR_NEXT(si)	ID_SET_IMPL(iterator_next)(si)
+
+#endif
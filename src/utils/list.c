@@ -25,6 +25,7 @@ List* list_create() {
 	List* l = (List*) malloc(sizeof(List));
 	assert(l != NULL);
  	l->size = 0;
+ 	l->capacity = 0;
 	l->elements = NULL;
 
 	return l;
@@ -32,7 +33,7 @@ List* list_create() {
 
 int list_free(List* l) {
 	free(l->elements);
-	int freed_bytes = l->size * sizeof(void*);
+	int freed_bytes = l->capacity * sizeof(void*);
 	free(l);
 	freed_bytes+= sizeof(List);
 
@@ -41,8 +42,9 @@ int list_free(List* l) {
 
 int list_reset(List* l) {
 	free(l->elements);
-	int freed_bytes = l->size * sizeof(void*);
+	int freed_bytes = l->capacity * sizeof(void*);
 	l->size = 0;
+	l->capacity = 0;
 	l->elements = NULL;
 
 	return freed_bytes;
@@ -19,6 +19,7 @@
 
 /**
  * A simple list implementation that supports adding and removing elements.
+ * The space for the elements grows geometrically, appending is amortized O(1).
  */
 
 #ifndef LIST_H_
@@ -28,10 +29,16 @@ typedef struct list List;
 typedef struct list_iterator ListIterator;
 
 struct list {
-	int size;
+	int size;			// number of elements
+	int capacity;		// number of elements the allocated space can hold
 	void** elements;
 };
 
+/**
+ * Capacity of a list after the first element is added.
+ */
+#define LIST_INITIAL_CAPACITY	2
+
 struct list_iterator {
 	List* list;
 	int current_index;
@@ -48,15 +55,20 @@ List* list_create();
  * lists.
  */
 // inline void list_init(List* l);
-#define LIST_INIT(l)		do {((List*) l)->size=0; ((List*) l)->elements=NULL;} while(0)
+#define LIST_INIT(l)		do {((List*) l)->size=0; ((List*) l)->capacity=0; ((List*) l)->elements=NULL;} while(0)
 /**
  * Appends element e to list l. Does not check for duplicates.
  * Returns 1.
  */
 inline char list_add(void* e, List* l) {
-	void** tmp = realloc(l->elements, (l->size + 1) * sizeof(void*));
-	assert(tmp != NULL);
-	l->elements = tmp;
+	if (l->size == l->capacity) {
+		// no space left, double it
+		int new_capacity = (l->capacity == 0) ? LIST_INITIAL_CAPACITY : 2 * l->capacity;
+		void** tmp = realloc(l->elements, new_capacity * sizeof(void*));
+		assert(tmp != NULL);
+		l->elements = tmp;
+		l->capacity = new_capacity;
+	}
 	l->elements[l->size] = e;
 	++l->size;
 
@@ -65,36 +77,40 @@ inline char list_add(void* e, List* l) {
 
 /**
  * Removes the first occurrence of the element e if it is present. The list stays unchanged
- * if e does not occur in l.
+ * if e does not occur in l. The allocated space is halved when the list becomes
+ * a quarter full, so that alternating adds and removes do not reallocate.
  * Returns 1 if e is removed, 0 otherwise.
  */
-/**
- * TODO
- */
 inline char list_remove(void* e, List* l) {
-	int i;
+	int i, j;
 
 	for (i = 0; i < l->size; ++i) {
 		if (e == l->elements[i])
 			// the element is at index i
 			break;
 	}
-	// if we reached the last element and it is not e,
-	// then e does not exist in l.
-	if ((i == l->size - 1) && (l->elements[i] != e))
-		return 1;
+	// e does not exist in l
+	if (i == l->size)
+		return 0;
 	// now shift the elements, overwrite index i
-	int j;
 	for (j = i; j < l->size - 1; ++j) {
 		l->elements[j] = l->elements[j + 1];
 	}
-	// shrink the allocated space
-	void** tmp = realloc(l->elements, (l->size - 1) * sizeof(void*));
-	assert(l->size == 1 || tmp != NULL);
-	l->elements = tmp;
 	// decrement the element count
 	--l->size;
-	return 0;
+	// shrink the allocated space
+	if (l->size == 0) {
+		free(l->elements);
+		l->elements = NULL;
+		l->capacity = 0;
+	}
+	else if (l->capacity > LIST_INITIAL_CAPACITY && 4 * l->size <= l->capacity) {
+		void** tmp = realloc(l->elements, (l->capacity / 2) * sizeof(void*));
+		assert(tmp != NULL);
+		l->elements = tmp;
+		l->capacity /= 2;
+	}
+	return 1;
 }
 /**
  * Free the space allocated for this list.
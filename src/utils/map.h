@@ -19,52 +19,73 @@
 
 /**
  * A simple map interface. Just a macro for hash map.
+ * The hash map is selected at build time, see --with-map in configure.ac.
  */
 
 #ifndef MAP_H_
 #define MAP_H_
 
-#include "../hashing/hash_map.h"
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "../hashing/hash_stats.h"
+
+#define MAP_BACKEND_CHAINED		0	// HashMap, a chain of nodes per bucket
+#define MAP_BACKEND_FLAT		1	// FlatHashMap, an element array and an index
 
+#ifndef MAP_BACKEND
+#define MAP_BACKEND				MAP_BACKEND_CHAINED
+#endif
+
+#if MAP_BACKEND == MAP_BACKEND_FLAT
+#include "../hashing/flat_hash_map.h"
+typedef FlatHashMap Map;
+typedef FlatHashMapIterator MapIterator;
+#define MAP_IMPL(function)		flat_hash_map_##function
+#else
+#include "../hashing/hash_map.h"
 typedef HashMap Map;
 typedef HashMapIterator MapIterator;
+#define MAP_IMPL(function)		hash_map_##function
+#endif
 
 
 /**
  * Create a map with an underlying hash map of the given size.
  * Returns the map created.
  */
-#define MAP_CREATE(size)				hash_map_create(size)
+#define MAP_CREATE(size)				MAP_IMPL(create)(size)
 
 /**
  * Initialize a map with an underlying hash map of the given size.
  */
-#define MAP_INIT(map, size)				hash_map_init(map, size)
+#define MAP_INIT(map, size)				MAP_IMPL(init)(map, size)
 
 /**
  * Adds the pair (key,value) to the map m.
  * Returns 1 if e is successfully added, 0 otherwise.
  */
-#define MAP_PUT(key, value, map)		hash_map_put(map, key, value)
+#define MAP_PUT(key, value, map)		MAP_IMPL(put)(map, key, value)
 
 /**
  * Removes the element with the given key if it is present. The map stays unchanged
  * if the key does not occur in map.
  * Returns 1 if key is removed, 0 otherwise.
  */
-#define MAP_REMOVE(key, map)			hash_map_remove(key, map)
+#define MAP_REMOVE(key, map)			MAP_IMPL(remove)(key, map)
 
 /**
  * Get the value associated with the given key.
  * Returns 1 if the key occurs, 0 otherwise
  */
-#define MAP_GET(key, map)				hash_map_get(map, key)
+#define MAP_GET(key, map)				MAP_IMPL(get)(map, key)
 
 /**
  * Free the space allocated for the given map.
  * Returns the number of freed bytes.
  */
-#define MAP_FREE(map)					hash_map_free(map)
+#define MAP_FREE(map)					MAP_IMPL(free)(map)
 
 /**
  * Free the space allocated for the elements of the given map.
@@ -72,30 +93,41 @@ typedef HashMapIterator MapIterator;
  * maps that are not dynamically created.
  * Returns the number of freed bytes.
  */
-#define MAP_RESET(s)					hash_map_reset(s)
+#define MAP_RESET(s)					MAP_IMPL(reset)(s)
+
+/**
+ * Returns the number of bytes allocated for the elements of the given map.
+ */
+#define MAP_MEMORY(map)					MAP_IMPL(memory)(map)
+
+/**
+ * Add the load factor and the chain lengths of the map to the
+ * given HashStats. Print them with hash_stats_print.
+ */
+#define MAP_COLLECT_STATS(map, stats)	MAP_IMPL(collect_stats)(map, stats)
 
 /**
  * Create an iterator for the elements of the map.
  * It is the iterator of the underlying hash map.
  */
-#define MAP_ITERATOR_CREATE(map)		hash_map_iterator_create(map)
+#define MAP_ITERATOR_CREATE(map)		MAP_IMPL(iterator_create)(map)
 
 /**
  * Create an iterator for the elements of the map.
  * It is the iterator of the underlying hash map.
  */
-#define MAP_ITERATOR_INIT(map_it, map)	hash_map_iterator_init(map_it, map)
+#define MAP_ITERATOR_INIT(map_it, map)	MAP_IMPL(iterator_init)(map_it, map)
 
 /**
  * Get the next element in the map.
  * Gets the next element in the underlying hash map.
  * Elements are not necessarily returned in the order of addition.
  */
-#define MAP_ITERATOR_NEXT(map_it)		hash_map_iterator_next(map_it)
+#define MAP_ITERATOR_NEXT(map_it)		MAP_IMPL(iterator_next)(map_it)
 
 /**
  * Free the space for the given map iterator.
  */
-#define MAP_ITERATOR_FREE(map_it)		hash_map_iterator_free(map_it)
+#define MAP_ITERATOR_FREE(map_it)		MAP_IMPL(iterator_free)(map_it)
 
 #endif
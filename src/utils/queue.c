@@ -26,90 +26,53 @@
 #define IS_QUEUE_FULL(q) 	((q)->size == (q)->count)
 #define IS_QUEUE_EMPTY(q) 	((q)->count == 0)
 
-/*
- * Linked list implementation
-*/
-
-void init_queue(Queue* q) {
-	q->front = NULL;
-	q->rear = NULL;
-}
-
-void enqueue(Queue* queue, void* data) {
-	QueueElement* new_qe;
-
-	new_qe = (QueueElement*) malloc(sizeof(QueueElement));
-	assert(new_qe != NULL);
-
-	new_qe->data = data;
-	new_qe->next = NULL;
-
-	if (queue->rear == NULL) {
-		queue->front = new_qe;
-		queue->rear = new_qe;
-	}
-	else {
-		queue->rear->next = new_qe;
-		queue->rear = new_qe;
-	}
-}
-
-void* dequeue(Queue* queue) {
-	void* data;
-	QueueElement* tmp;
-
-	if (queue->front == NULL && queue->rear == NULL)
-		// the queue is empty
-		return NULL;
-
-	data = queue->front->data;
-	if (queue->rear == queue->front)
-		// we are dequeuing the last element
-		queue->rear = NULL;
-	tmp = queue->front;
-	queue->front = queue->front->next;
-	free(tmp);
-
-	return data;
+void init_queue(Queue* queue) {
+	queue->size = 0;
+	queue->count = 0;
+	queue->front = 0;
+	queue->elements = NULL;
 }
 
-
-/*
- * Circular queue implementation
-*/
-/*
-void init_queue(Queue* queue, int size) {
+// double the space, the elements are moved to the beginning in queue order
+static void grow_queue(Queue* queue) {
+	int i, new_size = (queue->size == 0) ? QUEUE_INITIAL_SIZE : 2 * queue->size;
+	void** elements = (void**) malloc(new_size * sizeof(void*));
+	assert(elements != NULL);
+
+	for (i = 0; i < queue->count; ++i)
+		elements[i] = queue->elements[(queue->front + i) % queue->size];
+	free(queue->elements);
+	queue->elements = elements;
+	queue->size = new_size;
 	queue->front = 0;
-	queue->rear = 0;
-	queue->size = size;
-	queue->count = 0;
-	queue->elements = (void**) malloc(queue->size * sizeof(void*));
-	assert(queue->elements != NULL);
 }
 
 void enqueue(Queue* queue, void* element) {
-	// if (IS_QUEUE_FULL(queue)) {
-	// 	fprintf(stderr, "Queue full, aborting\n");
-	// 	exit(EXIT_FAILURE);
-	// }
-
-	queue->elements[queue->rear] = element;
-	queue->rear = (queue->rear + 1) % queue->size;
-	if (queue->rear == queue->front)
-		queue->front = (queue->front + 1) % queue->size;
+	if (IS_QUEUE_FULL(queue))
+		grow_queue(queue);
+
+	queue->elements[(queue->front + queue->count) % queue->size] = element;
 	++queue->count;
 }
 
 void* dequeue(Queue* queue) {
 	void *tmp;
-	
+
 	if (IS_QUEUE_EMPTY(queue))
 		return NULL;
-	
+
 	tmp = queue->elements[queue->front];
 	queue->front = (queue->front + 1) % queue->size;
 	--queue->count;
-	
+
 	return tmp;
 }
-*/
+
+int reset_queue(Queue* queue) {
+	int freed_bytes = queue->size * sizeof(void*);
+
+	free(queue->elements);
+	init_queue(queue);
+
+	return freed_bytes;
+}
@@ -20,42 +20,33 @@
 #ifndef QUEUE_H_
 #define QUEUE_H_
 
-typedef struct queue_element QueueElement;
 typedef struct queue Queue;
 
-
-// #define DEQUEUE(qe,q) 		qe = (q)->data[(q)->front++]
-// #define IS_EMPTY_QUEUE(q) 	((q)->front == (q)->rear)
-// #define ENQUEUE(qe,q) 		(q)->data[(q)->rear++] = qe
-
-
-struct queue_element {
-	void* data;
-	QueueElement* next;
-};
-
-struct queue {
-	QueueElement* front;
-	QueueElement* rear;
-};
-
-/*
-// circular queue
+/**
+ * Circular queue. When it is full, the space is doubled and the elements are
+ * moved to the beginning of the new space in queue order. Dequeuing does not
+ * give back space, it is freed in reset_queue.
+ */
 struct queue {
 	int size;		// max number of elements
 	int count;		// number of elements
-	int front;
-	int rear;
+	int front;		// index of the next element to dequeue
 	void** elements;
 };
-*/
+
+/**
+ * Capacity of a queue after the first enqueue.
+ */
+#define QUEUE_INITIAL_SIZE	64
+
 void init_queue(Queue* q);
 void enqueue(Queue* queue, void* data);
 void* dequeue(Queue* queue);
 
-
-
-
-
+/**
+ * Free the space allocated for the elements of the given queue.
+ * Returns the number of freed bytes.
+ */
+int reset_queue(Queue* queue);
 
 #endif /* QUEUE_H_ */
@@ -0,0 +1,62 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <unistd.h>
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+#include "rss.h"
+
+size_t get_peak_rss() {
+#ifdef HAVE_SYS_RESOURCE_H
+	struct rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#ifdef __APPLE__
+	// in bytes on Mac OS X
+	return (size_t) usage.ru_maxrss;
+#else
+	// in kilobytes on Linux and the BSDs
+	return (size_t) usage.ru_maxrss * 1024;
+#endif
+#else
+	return 0;
+#endif
+}
+
+size_t get_current_rss() {
+	// the second field of statm is the number of resident pages.
+	// only available on Linux.
+	FILE* statm = fopen("/proc/self/statm", "r");
+	unsigned long size, resident;
+
+	if (statm == NULL)
+		return 0;
+	if (fscanf(statm, "%lu %lu", &size, &resident) != 2)
+		resident = 0;
+	fclose(statm);
+
+	return (size_t) resident * (size_t) sysconf(_SC_PAGESIZE);
+}
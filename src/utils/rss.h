@@ -0,0 +1,39 @@
+/*
+ * The ELepHant Reasoner
+ *
+ * Copyright (C) Baris Sertkaya (sertkaya@fb2.fra-uas.de)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSS_H_
+#define RSS_H_
+
+#include <stddef.h>
+
+/**
+ * The resident set size of the process, i.e., the memory it actually
+ * occupies, in bytes. 0 if the system does not provide it.
+ */
+
+/**
+ * The largest resident set size the process has had so far.
+ */
+size_t get_peak_rss();
+
+/**
+ * The current resident set size.
+ */
+size_t get_current_rss();
+
+#endif /* RSS_H_ */
@@ -19,46 +19,77 @@
 
 /**
  * A simple set implementation. Just a macro for hash table.
+ * The hash table is selected at build time, see --with-set in configure.ac.
  */
 
 #ifndef SET_H_
 #define SET_H_
 
-#include "../hashing/dynamic_hash_table.h"
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "../hashing/hash_stats.h"
 
+#define SET_BACKEND_DYNAMIC		0	// DynamicHashTable, linear probing
+#define SET_BACKEND_SWISS		1	// SwissHashTable, control bytes probed in groups
+#define SET_BACKEND_BITSET		2	// IdBitset for id sets, pointer sets are dynamic
+
+#ifndef SET_BACKEND
+#define SET_BACKEND				SET_BACKEND_DYNAMIC
+#endif
+
+#if SET_BACKEND == SET_BACKEND_SWISS
+#include "../hashing/swiss_hash_table.h"
+typedef SwissHashTable Set;
+typedef SwissHashTableIterator SetIterator;
+#define SET_IMPL(function)		swiss_hash_table_##function
+#else
+#include "../hashing/dynamic_hash_table.h"
 typedef DynamicHashTable Set;
 typedef DynamicHashTableIterator SetIterator;
+#define SET_IMPL(function)		dynamic_hash_table_##function
+#endif
 
 
 /**
  * Create a set with an underlying hash table of the given size.
  * Returns the set created
  */
-#define SET_CREATE(size)		dynamic_hash_table_create(size)
+#define SET_CREATE(size)		SET_IMPL(create)(size)
 
 /**
  * Initialize a set with an underlying hash table of the given size.
  */
-#define SET_INIT(set, size)		dynamic_hash_table_init(set, size)
+#define SET_INIT(set, size)		SET_IMPL(init)(set, size)
 
 /**
  * Adds element e to the set s. Duplicates are not allowed.
  * Returns 1 if e is successfully added, 0 otherwise.
  */
-#define SET_ADD(e, s)			dynamic_hash_table_insert(e, s)
+#define SET_ADD(e, s)			SET_IMPL(insert)(e, s)
 
 /**
  * Removes the element e if it is present. The set stays unchanged
- * if e does not occur in s.
+ * if e does not occur in s. While iterating, only the element that
+ * has just been returned by the iterator can be removed.
  * Returns 1 if e is removed, 0 otherwise.
  */
-#define SET_REMOVE(e, s)		dynamic_hash_table_remove(e, s)
+#define SET_REMOVE(e, s)		SET_IMPL(remove)(e, s)
 
 /**
  * Checks if a given element exists.
  * Returns 1 if this is the case, 0 otherwise.
  */
-#define SET_CONTAINS(e, s)		dynamic_hash_table_contains(e, s)
+#define SET_CONTAINS(e, s)		SET_IMPL(contains)(e, s)
+
+/**
+ * Shrink the space allocated for the elements of the set to the
+ * number of elements it currently has. Sets never shrink on SET_REMOVE.
+ * Iterators of the set become invalid.
+ * Returns the number of freed bytes.
+ */
+#define SET_SHRINK(s)			SET_IMPL(shrink)(s)
 
 /**
  * Free the space allocated for the elements of the given set
@@ -66,7 +97,7 @@ typedef DynamicHashTableIterator SetIterator;
  * dynamically created.
  * Returns the number of freed bytes.
  */
-#define SET_FREE(s)				dynamic_hash_table_free(s)
+#define SET_FREE(s)				SET_IMPL(free)(s)
 
 /**
  * Free the space allocated for the elements of the given set.
@@ -74,7 +105,18 @@ typedef DynamicHashTableIterator SetIterator;
  * sets that are not dynamically created.
  * Returns the number of freed bytes.
  */
-#define SET_RESET(s)			dynamic_hash_table_reset(s)
+#define SET_RESET(s)			SET_IMPL(reset)(s)
+
+/**
+ * Returns the number of bytes allocated for the elements of the given set.
+ */
+#define SET_MEMORY(s)			SET_IMPL(memory)(s)
+
+/**
+ * Add the load factor and the probe lengths of the set to the
+ * given HashStats. Print them with hash_stats_print.
+ */
+#define SET_COLLECT_STATS(s, stats)	SET_IMPL(collect_stats)(s, stats)
 
 /**
  * Return an array containing the elements of the given set.
@@ -86,24 +128,24 @@ typedef DynamicHashTableIterator SetIterator;
  * Create an iterator for the elements of the set.
  * It is the iterator of the underlying hash table.
  */
-#define SET_ITERATOR_CREATE(s)		dynamic_hash_table_iterator_create(s)
+#define SET_ITERATOR_CREATE(s)		SET_IMPL(iterator_create)(s)
 
 /**
  * Create an iterator for the elements of the set.
  * It is the iterator of the underlying hash table.
  */
-#define SET_ITERATOR_INIT(it, s)	dynamic_hash_table_iterator_init(it, s)
+#define SET_ITERATOR_INIT(it, s)	SET_IMPL(iterator_init)(it, s)
 
 /**
  * Get the next element in the set.
  * Gets the next element in the underlying hash table.
  * Elements are not necessarily returned in the order of addition.
  */
-#define SET_ITERATOR_NEXT(si)		dynamic_hash_table_iterator_next(si)
+#define SET_ITERATOR_NEXT(si)		SET_IMPL(iterator_next)(si)
 
 /**
  * Free the space for the given set iterator.
  */
-#define SET_ITERATOR_FREE(si)		dynamic_hash_table_iterator_free(si)
+#define SET_ITERATOR_FREE(si)		SET_IMPL(iterator_free)(si)
 
 #endif
@@ -26,6 +26,18 @@ extern inline void* pop(Stack* s);
 
 void init_stack(Stack* s) {
 	s->size = 0;
+	s->capacity = 0;
 	s->elements = NULL;
 }
 
+int reset_stack(Stack* s) {
+	int freed_bytes = s->capacity * sizeof(void*);
+
+	free(s->elements);
+	s->size = 0;
+	s->capacity = 0;
+	s->elements = NULL;
+
+	return freed_bytes;
+}
+
@@ -22,34 +22,47 @@
 
 typedef struct stack Stack;
 
+/**
+ * A stack whose space grows geometrically. Popping does not give back
+ * space, it is freed in reset_stack.
+ */
 struct stack {
-	int size;
+	int size;			// number of elements
+	int capacity;		// number of elements the allocated space can hold
 	void** elements;
 };
 
+/**
+ * Capacity of a stack after the first push.
+ */
+#define STACK_INITIAL_CAPACITY	1024
+
 void init_stack(Stack* s);
 
+/**
+ * Free the space allocated for the elements of the given stack.
+ * Returns the number of freed bytes.
+ */
+int reset_stack(Stack* s);
+
 inline void push(Stack* s, void* e) {
-	void** tmp = realloc(s->elements, (s->size + 1) * sizeof(void*));
-	assert(tmp != NULL);
-	s->elements = tmp;
+	if (s->size == s->capacity) {
+		// no space left, double it
+		int new_capacity = (s->capacity == 0) ? STACK_INITIAL_CAPACITY : 2 * s->capacity;
+		void** tmp = realloc(s->elements, new_capacity * sizeof(void*));
+		assert(tmp != NULL);
+		s->elements = tmp;
+		s->capacity = new_capacity;
+	}
 	s->elements[s->size] = e;
 	++s->size;
 }
 
 inline void* pop(Stack* s) {
-	void* e;
-	void** tmp;
-
 	if (s->size == 0)
 		return NULL;
 
 	--s->size;
-	e = s->elements[s->size];
-	tmp = realloc(s->elements, (s->size) * sizeof(void*));
-	assert(tmp != NULL || s->size == 0);
-	s->elements = tmp;
-
-	return e;
+	return s->elements[s->size];
 }
 #endif /* STACK_H_ */